@@ -58,8 +58,8 @@ g++ -std=c++17 -O3 -march=native -fopenmp -flto -ffast-math -mwindows ^
     -I"C:\msys64\mingw64\include\tesseract" ^
     -DOPENCV_CUDA_AVAILABLE=0 ^
     src/main.cpp src/ui_framework.cpp src/popup_dialogs.cpp ^
-    src/advanced_ocr.cpp src/optimized_screen_capture.cpp ^
-    src/game_analytics.cpp src/thread_manager.cpp src/cuda_support.cpp src/performance_monitor.cpp ^
+    src/advanced_ocr.cpp src/crnn_recognizer.cpp src/static_hud_mask.cpp src/frame_deduplicator.cpp src/highlight_recorder.cpp src/optimized_screen_capture.cpp ^
+    src/game_analytics.cpp src/forecasting_models.cpp src/stats_kernels.cpp src/signal_rules.cpp src/trigram_index.cpp src/visual_fingerprint.cpp src/file_hasher.cpp src/mapped_file.cpp src/profile_database.cpp src/profile_watcher.cpp src/session_exporter.cpp src/text_serializer.cpp src/startup_graph.cpp src/thread_manager.cpp src/cuda_support.cpp src/performance_monitor.cpp src/anomaly_detector.cpp ^
     -o GameAnalyzer.exe ^
     -L"C:\msys64\mingw64\lib" ^
     -lopencv_core -lopencv_imgproc -lopencv_imgcodecs -lopencv_highgui -lopencv_dnn -lopencv_video ^
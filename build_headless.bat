@@ -0,0 +1,46 @@
+@echo off
+echo ========================================
+echo   Game Analyzer - Headless Daemon Build
+echo ========================================
+echo.
+
+REM Set up MSYS2 environment
+set PATH=C:\msys64\mingw64\bin;C:\msys64\usr\bin;%PATH%
+
+echo Building GameAnalyzerHeadless.exe (console, no UI)...
+g++ -std=c++17 -O3 -march=native -fopenmp -flto -ffast-math ^
+    -I"C:\msys64\mingw64\include" ^
+    -I"C:\msys64\mingw64\include\opencv4" ^
+    -I"C:\msys64\mingw64\include\tesseract" ^
+    -DOPENCV_CUDA_AVAILABLE=0 ^
+    src/headless_main.cpp src/headless_pipeline.cpp src/game_simulator.cpp src/optimized_screen_capture.cpp ^
+    src/advanced_ocr.cpp src/crnn_recognizer.cpp src/static_hud_mask.cpp src/frame_deduplicator.cpp src/highlight_recorder.cpp src/game_analytics.cpp src/forecasting_models.cpp src/stats_kernels.cpp src/signal_rules.cpp src/trigram_index.cpp src/visual_fingerprint.cpp src/file_hasher.cpp src/mapped_file.cpp src/profile_database.cpp src/session_exporter.cpp src/text_serializer.cpp src/thread_manager.cpp src/cuda_support.cpp src/performance_monitor.cpp src/anomaly_detector.cpp ^
+    -o GameAnalyzerHeadless.exe ^
+    -L"C:\msys64\mingw64\lib" ^
+    -lopencv_core -lopencv_imgproc -lopencv_imgcodecs -lopencv_highgui -lopencv_videoio -lopencv_dnn -lopencv_video ^
+    -ltesseract -lleptonica ^
+    -lgdi32 -luser32 -lkernel32 -lpsapi -ld3d11 -ldxgi -lole32 -ldwmapi ^
+    -lws2_32 -lwinmm -loleaut32 -luuid -ladvapi32 -static-libgcc -static-libstdc++
+
+if %errorlevel% neq 0 (
+    echo Build failed!
+    echo Install dependencies: pacman -S mingw-w64-x86_64-opencv mingw-w64-x86_64-tesseract-ocr
+    exit /b 1
+)
+
+echo Building GameSimulator.exe...
+g++ -std=c++17 -O3 -march=native ^
+    -I"C:\msys64\mingw64\include" ^
+    -I"C:\msys64\mingw64\include\opencv4" ^
+    -DOPENCV_CUDA_AVAILABLE=0 ^
+    src/simulator_main.cpp src/game_simulator.cpp src/text_serializer.cpp ^
+    -o GameSimulator.exe ^
+    -L"C:\msys64\mingw64\lib" ^
+    -lopencv_core -lopencv_imgproc -lopencv_imgcodecs -static-libgcc -static-libstdc++
+
+if %errorlevel% neq 0 (
+    echo Simulator build failed!
+    exit /b 1
+)
+
+echo Build successful: GameAnalyzerHeadless.exe --help, GameSimulator.exe --help
@@ -0,0 +1,30 @@
+#!/bin/sh
+# Builds game_analyzer_headless, the UI-free analysis daemon, and game_simulator,
+# the synthetic game it can be tested against, on Linux.
+# Needs g++ (C++17), OpenCV 4 and Tesseract development packages, e.g.
+#   apt install g++ pkg-config libopencv-dev libtesseract-dev libleptonica-dev
+set -e
+
+cd "$(dirname "$0")"
+
+if ! pkg-config --exists opencv4 tesseract lept; then
+    echo "ERROR: OpenCV 4 / Tesseract / Leptonica development packages not found (pkg-config)"
+    exit 1
+fi
+
+echo "Building game_analyzer_headless..."
+g++ -std=c++17 -O3 -march=native -DOPENCV_CUDA_AVAILABLE=0 \
+    $(pkg-config --cflags opencv4 tesseract lept) \
+    src/headless_main.cpp src/headless_pipeline.cpp src/game_simulator.cpp \
+    src/advanced_ocr.cpp src/crnn_recognizer.cpp src/static_hud_mask.cpp src/frame_deduplicator.cpp src/highlight_recorder.cpp src/game_analytics.cpp src/forecasting_models.cpp src/stats_kernels.cpp src/signal_rules.cpp src/trigram_index.cpp src/visual_fingerprint.cpp src/file_hasher.cpp src/mapped_file.cpp src/profile_database.cpp src/session_exporter.cpp src/text_serializer.cpp src/thread_manager.cpp src/cuda_support.cpp src/performance_monitor.cpp src/anomaly_detector.cpp \
+    -o game_analyzer_headless \
+    $(pkg-config --libs opencv4 tesseract lept) -lpthread
+
+echo "Building game_simulator..."
+g++ -std=c++17 -O3 -march=native -DOPENCV_CUDA_AVAILABLE=0 \
+    $(pkg-config --cflags opencv4) \
+    src/simulator_main.cpp src/game_simulator.cpp src/text_serializer.cpp \
+    -o game_simulator \
+    $(pkg-config --libs opencv4)
+
+echo "Build successful: ./game_analyzer_headless --help, ./game_simulator --help"
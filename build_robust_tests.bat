@@ -20,12 +20,12 @@ C:\msys64\mingw64\bin\g++.exe -std=c++17 -O2 -march=native -fopenmp -ffast-math
     -I"C:\msys64\mingw64\include\tesseract" ^
     -DOPENCV_CUDA_AVAILABLE=0 ^
     src/test_framework.cpp src/robust_test_runner.cpp ^
-    src/performance_monitor.cpp src/cuda_support.cpp ^
-    src/advanced_ocr.cpp src/game_analytics.cpp ^
+    src/performance_monitor.cpp src/anomaly_detector.cpp src/cuda_support.cpp ^
+    src/advanced_ocr.cpp src/game_analytics.cpp src/forecasting_models.cpp src/stats_kernels.cpp src/signal_rules.cpp src/trigram_index.cpp src/visual_fingerprint.cpp src/file_hasher.cpp src/mapped_file.cpp src/profile_database.cpp src/profile_watcher.cpp src/session_exporter.cpp src/text_serializer.cpp src/startup_graph.cpp src/headless_pipeline.cpp src/game_simulator.cpp src/crnn_recognizer.cpp src/static_hud_mask.cpp src/frame_deduplicator.cpp src/highlight_recorder.cpp ^
     src/optimized_screen_capture.cpp src/thread_manager.cpp src/ui_framework.cpp ^
     -o RobustTestSuite.exe ^
     -L"C:\msys64\mingw64\lib" ^
-    -lopencv_core -lopencv_imgproc -lopencv_imgcodecs -lopencv_highgui -lopencv_dnn -lopencv_video ^
+    -lopencv_core -lopencv_imgproc -lopencv_imgcodecs -lopencv_highgui -lopencv_videoio -lopencv_dnn -lopencv_video ^
     -ltesseract -lleptonica -lboost_thread-mt -lboost_filesystem-mt ^
     -lgdi32 -luser32 -lkernel32 -lpsapi -lcomctl32 -ld3d11 -ldxgi -lole32 -ldwmapi -lmsimg32 ^
     -lws2_32 -lwinmm -loleaut32 -luuid -lcomdlg32 -ladvapi32 -static-libgcc -static-libstdc++
@@ -10,7 +10,10 @@
 // AdvancedOCR Implementation
 AdvancedOCR::AdvancedOCR()
     : currentBackend(OCRBackend::TESSERACT), initialized(false),
-      useCaching(true), confidenceThreshold(0.5f) {
+      useCaching(true), confidenceThreshold(0.5f),
+      backendLoaded(false), backendFailed(false), backendLoadTimeMs(0.0),
+      modelSource(ModelSource::FILE), crnnPrecision(CrnnRecognizer::Precision::FP32),
+      incrementalHud(true), hudReadsVersion(0), hudRegionsRead(0), hudRegionsReused(0), hudFieldReads(0) {
     lastProcessTime = std::chrono::milliseconds(0);
 }
 
@@ -18,67 +21,112 @@ AdvancedOCR::~AdvancedOCR() {
     cleanup();
 }
 
-bool AdvancedOCR::initialize(OCRBackend backend) {
+bool AdvancedOCR::initialize(OCRBackend backend, LoadMode mode) {
     currentBackend = backend;
     
     switch (backend) {
         case OCRBackend::TESSERACT:
-            return initializeTesseract();
+            // Finding the traineddata is cheap; reading it is what takes the time
+            if (!locateTessdata()) return false;
+            break;
         case OCRBackend::OPENCV_EAST:
-            return initializeOpenCV();
+            break;
+        case OCRBackend::CRNN: {
+            std::error_code error;
+            if (!std::filesystem::exists(CRNN_MODEL_PATH, error) || !std::filesystem::exists(CRNN_VOCABULARY_PATH, error)) {
+                std::cerr << "CRNN model not found: " << CRNN_MODEL_PATH << " and " << CRNN_VOCABULARY_PATH << std::endl;
+                return false;
+            }
+            break;
+        }
         default:
             return false;
     }
+    
+    initialized = true;
+    loadDefaultGameTemplates();
+    
+    return mode == LoadMode::LAZY || warmUp();
+}
+
+bool AdvancedOCR::warmUp() {
+    if (backendLoaded.load(std::memory_order_acquire)) return true;
+    
+    std::lock_guard<std::mutex> lock(backendMutex);
+    if (backendLoaded.load(std::memory_order_relaxed)) return true;
+    if (backendFailed || !initialized) return false;
+    
+    auto start = std::chrono::steady_clock::now();
+    bool loaded = currentBackend == OCRBackend::TESSERACT ? initializeTesseract()
+                : currentBackend == OCRBackend::CRNN ? initializeCrnn() : initializeOpenCV();
+    backendLoadTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    // Don't retry a failed load on every frame
+    backendFailed = !loaded;
+    backendLoaded.store(loaded, std::memory_order_release);
+    return loaded;
+}
+
+bool AdvancedOCR::locateTessdata() {
+    // Search for tessdata in multiple locations
+    auto envPath = [](const char* name) {
+        const char* value = std::getenv(name);
+        return std::filesystem::path(value ? value : "");
+    };
+    std::vector<std::filesystem::path> tessdataPaths = {
+        std::filesystem::current_path() / "tessdata",
+        envPath("PROGRAMFILES") / "Tesseract-OCR" / "tessdata",
+        std::filesystem::path("C:/msys64/mingw64/share/tessdata"),
+        envPath("LOCALAPPDATA") / "Tesseract" / "tessdata",
+        envPath("APPDATA") / "Tesseract" / "tessdata"
+    };
+    
+    // Also check environment variable
+    if (const char* tessdataPrefix = std::getenv("TESSDATA_PREFIX")) {
+        tessdataPaths.insert(tessdataPaths.begin(), 
+            std::filesystem::path(tessdataPrefix));
+    }
+    
+    for (const auto& path : tessdataPaths) {
+        std::error_code error;
+        if (std::filesystem::exists(path / "eng.traineddata", error)) {
+            tessdataPath = path.string();
+            return true;
+        }
+    }
+    
+    std::cerr << "Tessdata not found. Please download from: "
+              << "https://github.com/tesseract-ocr/tessdata" << std::endl;
+    std::cerr << "Searched paths:" << std::endl;
+    for (const auto& path : tessdataPaths) {
+        std::cerr << "  " << path << std::endl;
+    }
+    return false;
 }
 
 bool AdvancedOCR::initializeTesseract() {
     try {
-        tesseractAPI = std::make_unique<tesseract::TessBaseAPI>();
-        
-        // Search for tessdata in multiple locations
-        std::vector<std::filesystem::path> tessdataPaths = {
-            std::filesystem::current_path() / "tessdata",
-            std::filesystem::path(std::getenv("PROGRAMFILES")) / "Tesseract-OCR" / "tessdata",
-            std::filesystem::path("C:/msys64/mingw64/share/tessdata"),
-            std::filesystem::path(std::getenv("LOCALAPPDATA")) / "Tesseract" / "tessdata",
-            std::filesystem::path(std::getenv("APPDATA")) / "Tesseract" / "tessdata"
-        };
-        
-        // Also check environment variable
-        if (const char* tessdataPrefix = std::getenv("TESSDATA_PREFIX")) {
-            tessdataPaths.insert(tessdataPaths.begin(), 
-                std::filesystem::path(tessdataPrefix));
+        if (tessdataPath.empty() && !locateTessdata()) {
+            return false;
         }
         
-        bool initialized = false;
-        for (const auto& path : tessdataPaths) {
-            if (std::filesystem::exists(path / "eng.traineddata")) {
-                std::string pathStr = path.string();
-                if (tesseractAPI->Init(pathStr.c_str(), "eng") == 0) {
-                    // Configure for game text
-                    tesseractAPI->SetPageSegMode(tesseract::PSM_SPARSE_TEXT);
-                    tesseractAPI->SetVariable("tessedit_char_whitelist",
-                        "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz:/ ");
-                    tesseractAPI->SetVariable("preserve_interword_spaces", "1");
-                    
-                    this->initialized = true;
-                    loadDefaultGameTemplates();
-                    initialized = true;
-                    break;
-                }
-            }
+        std::shared_ptr<const MappedFile> model;
+        if (modelSource == ModelSource::SHARED_MAPPING) {
+            std::string modelPath = (std::filesystem::path(tessdataPath) / "eng.traineddata").string();
+            model = TraineddataCache::getInstance().acquire(modelPath);
         }
         
-        if (!initialized) {
-            std::cerr << "Tessdata not found. Please download from: "
-                      << "https://github.com/tesseract-ocr/tessdata" << std::endl;
-            std::cerr << "Searched paths:" << std::endl;
-            for (const auto& path : tessdataPaths) {
-                std::cerr << "  " << path << std::endl;
-            }
+        auto api = createTesseractEngine(model.get(), FieldType::GENERAL);
+        if (!api) {
+            std::cerr << "Tesseract could not load eng.traineddata from " << tessdataPath << std::endl;
             return false;
         }
+        tesseractAPI = std::move(api);
         
+        // Field engines are optional; a HUD field without one is read by the general engine
+        for (size_t type = 1; type < static_cast<size_t>(FieldType::COUNT); ++type) {
+            fieldEngines[type] = createTesseractEngine(model.get(), static_cast<FieldType>(type));
+        }
         return true;
         
     } catch (const std::exception& e) {
@@ -87,27 +135,90 @@ bool AdvancedOCR::initializeTesseract() {
     }
 }
 
+std::unique_ptr<tesseract::TessBaseAPI> AdvancedOCR::createTesseractEngine(const MappedFile* model, FieldType type) {
+    // Dictionaries are init-only settings; HUD fields are never dictionary words,
+    // and the word lists only pull numbers towards wrong "corrections"
+    std::vector<std::string> settingNames, settingValues;
+    if (type != FieldType::GENERAL) {
+        for (const char* dictionary : {"load_system_dawg", "load_freq_dawg", "load_punc_dawg",
+                                       "load_number_dawg", "load_unambig_dawg", "load_bigram_dawg"}) {
+            settingNames.push_back(dictionary);
+            settingValues.push_back("0");
+        }
+    }
+    
+    // Falls back to reading the file if it could not be mapped
+    auto api = std::make_unique<tesseract::TessBaseAPI>();
+    int status = model
+        ? api->Init(model->data(), static_cast<int>(model->size()), "eng", tesseract::OEM_DEFAULT,
+                    nullptr, 0, &settingNames, &settingValues, false, nullptr)
+        : api->Init(tessdataPath.c_str(), "eng", tesseract::OEM_DEFAULT,
+                    nullptr, 0, &settingNames, &settingValues, false);
+    if (status != 0) return nullptr;
+    
+    api->SetVariable("tessedit_char_whitelist", fieldCharacters(type));
+    if (type == FieldType::GENERAL) {
+        // Configure for game text
+        api->SetPageSegMode(tesseract::PSM_SPARSE_TEXT);
+        api->SetVariable("preserve_interword_spaces", "1");
+        return api;
+    }
+    api->SetPageSegMode(tesseract::PSM_SINGLE_LINE);
+    api->SetVariable("tessedit_enable_doc_dict", "0");
+    api->SetVariable("classify_enable_learning", "0");
+    return api;
+}
+
 bool AdvancedOCR::initializeOpenCV() {
-    try {
-        // Load EAST text detector model (if available)
-        // For now, we'll use basic OpenCV text detection
-        initialized = true;
-        loadDefaultGameTemplates();
+    // The EAST model is optional; without it text regions come from contours
+    std::error_code error;
+    if (!std::filesystem::exists(EAST_MODEL_PATH, error)) {
         return true;
-    } catch (const std::exception& e) {
-        std::cerr << "OpenCV initialization error: " << e.what() << std::endl;
-        return false;
     }
+    
+    try {
+        auto detector = std::make_unique<cv::dnn::TextDetectionModel_EAST>(EAST_MODEL_PATH);
+        detector->setConfidenceThreshold(0.5f).setNMSThreshold(0.4f);
+        detector->setInputParams(1.0, cv::Size(320, 320), cv::Scalar(123.68, 116.78, 103.94), true);
+        eastDetector = std::move(detector);
+    } catch (const cv::Exception& e) {
+        std::cerr << "EAST model could not be loaded, using contour detection: " << e.what() << std::endl;
+    }
+    return true;
+}
+
+bool AdvancedOCR::initializeCrnn() {
+    CrnnRecognizer::Options options;
+    options.modelPath = CRNN_MODEL_PATH;
+    options.int8ModelPath = CRNN_INT8_MODEL_PATH;
+    options.vocabularyPath = CRNN_VOCABULARY_PATH;
+    options.precision = crnnPrecision;
+    
+    auto recognizer = std::make_unique<CrnnRecognizer>();
+    if (!recognizer->load(options)) return false;
+    crnnRecognizer = std::move(recognizer);
+    return true;
 }
 
 void AdvancedOCR::cleanup() {
     std::lock_guard<std::mutex> lock(processingMutex);
+    std::lock_guard<std::mutex> backendLock(backendMutex);
     
     if (tesseractAPI) {
         tesseractAPI->End();
         tesseractAPI.reset();
     }
+    for (auto& engine : fieldEngines) {
+        if (engine) {
+            engine->End();
+            engine.reset();
+        }
+    }
+    eastDetector.reset();
+    crnnRecognizer.reset();
     
+    backendLoaded.store(false, std::memory_order_release);
+    backendFailed = false;
     initialized = false;
 }
 
@@ -115,7 +226,8 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::detectText(const cv::Mat& fram
     TIMED_OPERATION("OCR Text Detection");
     std::lock_guard<std::mutex> lock(processingMutex);
     
-    if (!initialized) return {};
+    // A lazily initialised backend loads here if nothing warmed it up first
+    if (!initialized || !warmUp()) return {};
     
     // Check cache first
     if (useCaching && !cachedResults.empty()) {
@@ -126,23 +238,16 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::detectText(const cv::Mat& fram
         }
     }
     
+    // With a profile's HUD regions the layout says where the text is: those regions are
+    // read directly, and reused while unchanged, instead of searching the whole frame
+    auto config = templateConfig.read();
     std::vector<TextRegion> results;
-    
-    // Process based on current backend
-    switch (currentBackend) {
-        case OCRBackend::TESSERACT:
-            results = processWithTesseract(frame);
-            break;
-        case OCRBackend::OPENCV_EAST:
-            results = processWithOpenCV(frame);
-            break;
-        default:
-            return {};
-    }
-    
-    // Apply game-specific detection if game name provided
     if (!gameName.empty()) {
-        results = detectGameUI(frame, gameName);
+        results = detectGameUILocked(frame, *config);
+    } else if (!config->hudRegions.empty()) {
+        results = matchGameTemplates(frame, *config);
+    } else {
+        results = processWithBackend(frame);
     }
     
     // Cache results
@@ -155,10 +260,23 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::detectText(const cv::Mat& fram
     return results;
 }
 
+std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithBackend(const cv::Mat& frame) {
+    switch (currentBackend) {
+        case OCRBackend::TESSERACT:
+            return processWithTesseract(frame);
+        case OCRBackend::OPENCV_EAST:
+            return processWithOpenCV(frame);
+        case OCRBackend::CRNN:
+            return processWithCrnn(frame);
+        default:
+            return {};
+    }
+}
+
 std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithTesseract(const cv::Mat& frame) {
     std::vector<TextRegion> results;
     
-    if (!tesseractAPI) return results;
+    if (!warmUp() || !tesseractAPI) return results;
     
     try {
         // Preprocess frame for better OCR
@@ -185,9 +303,22 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithTesseract(const cv:
                 std::string textStr(text);
                 float confidence = tesseractAPI->MeanTextConf() / 100.0f;
                 
-                if (confidence >= confidenceThreshold) {
-                    TextRegion textRegion(region, textStr, confidence);
-                    textRegion.detectedType = classifyTextType(textStr);
+                TextRegion textRegion(region, textStr, confidence);
+                textRegion.detectedType = classifyTextType(textStr);
+                
+                // Text that looks like a known field is read again by that field's engine,
+                // whose whitelist cannot mistake 0 for O or 5 for S
+                FieldType fieldType = textStr.find('/') != std::string::npos ? FieldType::RATIO
+                                                                             : fieldTypeForName(textRegion.detectedType);
+                if (fieldType != FieldType::GENERAL) {
+                    TextRegion fieldRead = recognizeField(frame(region), fieldType);
+                    if (!fieldRead.text.empty() && fieldRead.confidence > textRegion.confidence) {
+                        textRegion.text = fieldRead.text;
+                        textRegion.confidence = fieldRead.confidence;
+                    }
+                }
+                
+                if (textRegion.confidence >= confidenceThreshold) {
                     textRegion.color = detectTextColor(frame, region);
                     results.push_back(textRegion);
                 }
@@ -202,6 +333,143 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithTesseract(const cv:
     return results;
 }
 
+AdvancedOCR::TextRegion AdvancedOCR::recognizeField(const cv::Mat& field, FieldType type) {
+    TextRegion result(cv::Rect(0, 0, field.cols, field.rows), "", 0.0f);
+    
+    tesseract::TessBaseAPI* engine = type == FieldType::GENERAL ? nullptr : fieldEngines[static_cast<size_t>(type)].get();
+    if (!engine || field.empty() || !warmUp()) return result;
+    
+    try {
+        cv::Mat prepared = prepareField(field);
+        engine->SetImage(prepared.data, prepared.cols, prepared.rows, prepared.channels(), prepared.step);
+        
+        char* text = engine->GetUTF8Text();
+        if (text) {
+            std::string textStr(text);
+            delete[] text;
+            
+            // A single line still comes back with a trailing newline
+            size_t end = textStr.find_last_not_of(" \n\r\t");
+            textStr.erase(end == std::string::npos ? 0 : end + 1);
+            size_t begin = textStr.find_first_not_of(' ');
+            textStr.erase(0, begin == std::string::npos ? textStr.size() : begin);
+            
+            result.text = textStr;
+            result.confidence = textStr.empty() ? 0.0f : engine->MeanTextConf() / 100.0f;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Tesseract field error: " << e.what() << std::endl;
+    }
+    
+    result.color = detectTextColor(field, result.region);
+    return result;
+}
+
+std::vector<AdvancedOCR::TextRegion> AdvancedOCR::recognizeFields(const cv::Mat& frame, const std::vector<cv::Rect>& boxes,
+                                                                   const std::vector<FieldType>& types) {
+    std::vector<TextRegion> results;
+    results.reserve(boxes.size());
+    cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    
+    if (currentBackend == OCRBackend::CRNN) {
+        std::vector<std::string> allowed;
+        allowed.reserve(types.size());
+        for (FieldType type : types) allowed.push_back(fieldCharacters(type));
+        
+        std::vector<CrnnRecognizer::Result> recognized;
+        if (warmUp() && crnnRecognizer) recognized = crnnRecognizer->recognize(frame, boxes, allowed);
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            cv::Rect area = boxes[i] & frameRect;
+            TextRegion result(area, "", 0.0f);
+            if (i < recognized.size()) {
+                result.text = recognized[i].text;
+                result.confidence = recognized[i].confidence;
+            }
+            if (!area.empty()) result.color = detectTextColor(frame, area);
+            results.push_back(result);
+        }
+        return results;
+    }
+    
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        cv::Rect area = boxes[i] & frameRect;
+        FieldType type = i < types.size() ? types[i] : FieldType::GENERAL;
+        TextRegion result = area.empty() ? TextRegion(area, "", 0.0f) : recognizeField(frame(area), type);
+        result.region = area;
+        results.push_back(result);
+    }
+    return results;
+}
+
+cv::Mat AdvancedOCR::prepareField(const cv::Mat& field) {
+    // Scaled in colour first so the key sees smooth glyph edges, not blocky ones
+    auto config = templateConfig.read();
+    if (!config->textColors.empty() && (field.channels() == 3 || field.channels() == 4)) {
+        cv::Mat scaled = field;
+        if (field.rows < 32) {
+            double scale = 32.0 / field.rows;
+            cv::resize(field, scaled, cv::Size(), scale, scale, cv::INTER_CUBIC);
+        }
+        cv::Mat binary = colorKeyBinarize(scaled, config->textColors);
+        cv::copyMakeBorder(binary, binary, 8, 8, 8, 8, cv::BORDER_CONSTANT, cv::Scalar(255));
+        return binary;
+    }
+    
+    cv::Mat gray;
+    if (field.channels() == 3) {
+        cv::cvtColor(field, gray, cv::COLOR_BGR2GRAY);
+    } else if (field.channels() == 4) {
+        cv::cvtColor(field, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = field;
+    }
+    
+    // LSTM recognition is most accurate with glyphs around 30px tall
+    if (gray.rows < 32) {
+        double scale = 32.0 / gray.rows;
+        cv::resize(gray, gray, cv::Size(), scale, scale, cv::INTER_CUBIC);
+    }
+    
+    // Dark text on a light background, with a margin, as Tesseract expects; HUD text
+    // is usually the minority of the pixels whichever way round it is drawn
+    cv::Mat binary;
+    cv::threshold(gray, binary, 0, 255, cv::THRESH_BINARY | cv::THRESH_OTSU);
+    if (cv::countNonZero(binary) * 2 < binary.rows * binary.cols) {
+        cv::bitwise_not(binary, binary);
+    }
+    cv::copyMakeBorder(binary, binary, 8, 8, 8, 8, cv::BORDER_CONSTANT, cv::Scalar(255));
+    return binary;
+}
+
+const char* AdvancedOCR::fieldCharacters(FieldType type) {
+    switch (type) {
+        case FieldType::DIGITS: return "0123456789";
+        case FieldType::TIME: return "0123456789:";
+        case FieldType::RATIO: return "0123456789/";
+        case FieldType::LABEL: return "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+        default: return "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz:/ ";
+    }
+}
+
+AdvancedOCR::FieldType AdvancedOCR::fieldTypeForName(const std::string& name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    auto contains = [&](std::initializer_list<const char*> keywords) {
+        for (const char* keyword : keywords) {
+            if (lower.find(keyword) != std::string::npos) return true;
+        }
+        return false;
+    };
+    
+    if (contains({"time", "clock"})) return FieldType::TIME;
+    if (contains({"ammo", "ratio", "clip", "magazine"})) return FieldType::RATIO;
+    if (contains({"health", "hp", "score", "kills", "deaths", "money", "gold", "points", "armor", "xp", "digits"})) {
+        return FieldType::DIGITS;
+    }
+    if (contains({"level", "label", "banner", "rank", "status", "mode"})) return FieldType::LABEL;
+    return FieldType::GENERAL;
+}
+
 std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithOpenCV(const cv::Mat& frame) {
     std::vector<TextRegion> results;
     
@@ -209,8 +477,19 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithOpenCV(const cv::Ma
         // Preprocess frame
         cv::Mat processed = preprocessFrame(frame);
         
-        // Detect text regions using OpenCV
-        std::vector<cv::Rect> textRegions = detectTextRegions(processed);
+        // Detect text regions with EAST when its model is loaded, otherwise from contours
+        std::vector<cv::Rect> textRegions;
+        if (warmUp() && eastDetector && frame.channels() == 3) {
+            std::vector<std::vector<cv::Point>> detections;
+            eastDetector->detect(frame, detections);
+            cv::Rect bounds(0, 0, frame.cols, frame.rows);
+            for (const auto& quad : detections) {
+                cv::Rect region = cv::boundingRect(quad) & bounds;
+                if (region.area() > 0) textRegions.push_back(region);
+            }
+        } else {
+            textRegions = detectTextRegions(processed);
+        }
         
         // Process each region
         for (const auto& region : textRegions) {
@@ -227,7 +506,38 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithOpenCV(const cv::Ma
     return results;
 }
 
+std::vector<AdvancedOCR::TextRegion> AdvancedOCR::processWithCrnn(const cv::Mat& frame) {
+    std::vector<TextRegion> results;
+    
+    if (!warmUp() || !crnnRecognizer) return results;
+    
+    try {
+        // Regions from contours, then every region recognised in one batch
+        cv::Mat processed = preprocessFrame(frame);
+        std::vector<cv::Rect> textRegions = detectTextRegions(processed);
+        std::vector<CrnnRecognizer::Result> recognized = crnnRecognizer->recognize(frame, textRegions);
+        
+        for (size_t i = 0; i < textRegions.size(); ++i) {
+            if (recognized[i].text.empty() || recognized[i].confidence < confidenceThreshold) continue;
+            TextRegion textRegion(textRegions[i], recognized[i].text, recognized[i].confidence);
+            textRegion.detectedType = classifyTextType(textRegion.text);
+            textRegion.color = detectTextColor(frame, textRegions[i]);
+            results.push_back(textRegion);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "CRNN processing error: " << e.what() << std::endl;
+    }
+    
+    return results;
+}
+
 cv::Mat AdvancedOCR::preprocessFrame(const cv::Mat& frame) {
+    // Known HUD text colours key the glyphs out directly, whatever is behind them
+    if (frame.channels() == 3 || frame.channels() == 4) {
+        auto config = templateConfig.read();
+        if (!config->textColors.empty()) return colorKeyBinarize(frame, config->textColors);
+    }
+    
     cv::Mat processed;
     
     // Convert to grayscale if needed
@@ -250,6 +560,37 @@ cv::Mat AdvancedOCR::preprocessFrame(const cv::Mat& frame) {
     return processed;
 }
 
+cv::Mat AdvancedOCR::colorKeyBinarize(const cv::Mat& frame, const std::vector<ProfileDefinition::TextColor>& colors) {
+    // Per-channel bounds for each colour; a pixel inside any box is text
+    size_t colorCount = std::min(colors.size(), MAX_TEXT_COLORS);
+    uint8_t low[MAX_TEXT_COLORS][3], high[MAX_TEXT_COLORS][3];
+    for (size_t c = 0; c < colorCount; ++c) {
+        const int bgr[3] = {colors[c].blue, colors[c].green, colors[c].red};
+        for (int channel = 0; channel < 3; ++channel) {
+            low[c][channel] = static_cast<uint8_t>(std::max(0, bgr[channel] - colors[c].tolerance));
+            high[c][channel] = static_cast<uint8_t>(std::min(255, bgr[channel] + colors[c].tolerance));
+        }
+    }
+    
+    // One branch-free pass over the pixels
+    cv::Mat binary(frame.rows, frame.cols, CV_8UC1);
+    const int channels = frame.channels();
+    for (int y = 0; y < frame.rows; ++y) {
+        const uint8_t* in = frame.ptr<uint8_t>(y);
+        uint8_t* out = binary.ptr<uint8_t>(y);
+        for (int x = 0; x < frame.cols; ++x, in += channels) {
+            uint8_t text = 0;
+            for (size_t c = 0; c < colorCount; ++c) {
+                text |= static_cast<uint8_t>((in[0] >= low[c][0]) & (in[0] <= high[c][0]) &
+                                             (in[1] >= low[c][1]) & (in[1] <= high[c][1]) &
+                                             (in[2] >= low[c][2]) & (in[2] <= high[c][2]));
+            }
+            out[x] = static_cast<uint8_t>(text - 1);    // 0 for text, 255 for background
+        }
+    }
+    return binary;
+}
+
 std::vector<cv::Rect> AdvancedOCR::detectTextRegions(const cv::Mat& frame) {
     std::vector<cv::Rect> regions;
     
@@ -270,16 +611,19 @@ std::vector<cv::Rect> AdvancedOCR::detectTextRegions(const cv::Mat& frame) {
 }
 
 std::vector<AdvancedOCR::TextRegion> AdvancedOCR::detectGameUI(const cv::Mat& frame, const std::string& gameName) {
-    std::vector<TextRegion> results;
-    
-    // Load game-specific templates
-    loadGameTemplates(gameName);
+    std::lock_guard<std::mutex> lock(processingMutex);
+    if (!initialized || !warmUp()) return {};
     
-    // Match templates
-    results = matchGameTemplates(frame);
+    auto config = templateConfig.read();
+    return detectGameUILocked(frame, *config);
+}
+
+std::vector<AdvancedOCR::TextRegion> AdvancedOCR::detectGameUILocked(const cv::Mat& frame, const TemplateConfig& config) {
+    // Match templates and HUD regions from the active profile (see applyProfile)
+    std::vector<TextRegion> results = matchGameTemplates(frame, config);
     
     // Also do general text detection
-    std::vector<TextRegion> generalResults = detectText(frame, "");
+    std::vector<TextRegion> generalResults = processWithBackend(frame);
     
     // Filter for game UI text
     for (const auto& result : generalResults) {
@@ -350,16 +694,25 @@ void AdvancedOCR::loadGameTemplates(const std::string& gameName) {
 }
 
 void AdvancedOCR::loadDefaultGameTemplates() {
-    gameTemplates.clear();
-    
     // Add some default game UI templates
     // This would normally load from files or database
+    templateConfig.update([](TemplateConfig& config) {
+        config.templates.clear();
+    });
+}
+
+void AdvancedOCR::applyProfile(const ProfileDefinition& profile) {
+    templateConfig.update([&](TemplateConfig& config) {
+        config.hudRegions = profile.hudRegions;
+        config.textColors = profile.textColors;
+        config.profileName = profile.name;
+    });
 }
 
-std::vector<AdvancedOCR::TextRegion> AdvancedOCR::matchGameTemplates(const cv::Mat& frame) {
+std::vector<AdvancedOCR::TextRegion> AdvancedOCR::matchGameTemplates(const cv::Mat& frame, const TemplateConfig& config) {
     std::vector<TextRegion> results;
     
-    for (const auto& template_ : gameTemplates) {
+    for (const auto& template_ : config.templates) {
         float matchScore = matchTemplate(frame, template_);
         if (matchScore > template_.threshold) {
             TextRegion result(template_.region, template_.expectedTextPattern, matchScore, template_.elementType);
@@ -367,6 +720,103 @@ std::vector<AdvancedOCR::TextRegion> AdvancedOCR::matchGameTemplates(const cv::M
         }
     }
     
+    // Profile HUD regions are recognised directly (bypassing the whole-frame result cache);
+    // text found there takes the region's name as its type
+    if (!initialized) return results;
+    cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    std::vector<cv::Rect> areas;
+    std::vector<FieldType> fieldTypes;
+    std::vector<size_t> hudIndices;
+    for (size_t i = 0; i < config.hudRegions.size(); ++i) {
+        const auto& hudRegion = config.hudRegions[i];
+        cv::Rect area = cv::Rect(cvRound(hudRegion.x * frame.cols), cvRound(hudRegion.y * frame.rows),
+                                 cvRound(hudRegion.width * frame.cols), cvRound(hudRegion.height * frame.rows)) & frameRect;
+        if (area.empty()) continue;
+        areas.push_back(area);
+        fieldTypes.push_back(fieldTypeForName(hudRegion.name));
+        hudIndices.push_back(i);
+    }
+    
+    // While only the world moves behind a region its last read still holds; the mask says
+    // which of the region's pixels are HUD, and reads are refreshed now and then regardless
+    std::lock_guard<std::mutex> hudLock(hudMutex);
+    if (incrementalHud) hudMask.update(frame);
+    if (hudReadsVersion != templateConfig.version() || hudReads.size() != config.hudRegions.size()) {
+        hudReads.assign(config.hudRegions.size(), HudRead());
+        hudReadsVersion = templateConfig.version();
+    }
+    std::vector<size_t> staleRegions;
+    std::vector<cv::Rect> staleAreas;
+    std::vector<FieldType> staleTypes;
+    for (size_t i = 0; i < areas.size(); ++i) {
+        HudRead& read = hudReads[hudIndices[i]];
+        bool reuse = incrementalHud && read.area == areas[i] && read.age < HUD_REREAD_FRAMES &&
+                     !hudMask.hudChanged(areas[i]);
+        if (reuse) {
+            ++read.age;
+            continue;
+        }
+        staleRegions.push_back(i);
+        staleAreas.push_back(areas[i]);
+        staleTypes.push_back(fieldTypes[i]);
+    }
+    hudRegionsRead += staleRegions.size();
+    hudRegionsReused += areas.size() - staleRegions.size();
+    
+    // A field the layout names is one line of known characters: its own engine (or the
+    // CRNN, every stale region of the frame in one batch) reads the whole region instead
+    // of searching it for text
+    std::vector<TextRegion> fieldReads;
+    if (currentBackend == OCRBackend::CRNN) {
+        fieldReads = recognizeFields(frame, staleAreas, staleTypes);
+    } else if (currentBackend == OCRBackend::TESSERACT) {
+        std::vector<cv::Rect> typedAreas;
+        std::vector<FieldType> typedFields;
+        for (size_t i = 0; i < staleAreas.size(); ++i) {
+            if (staleTypes[i] == FieldType::GENERAL) continue;
+            typedAreas.push_back(staleAreas[i]);
+            typedFields.push_back(staleTypes[i]);
+        }
+        std::vector<TextRegion> typedReads = recognizeFields(frame, typedAreas, typedFields);
+        fieldReads.resize(staleAreas.size());
+        for (size_t i = 0, typed = 0; i < staleAreas.size(); ++i) {
+            if (staleTypes[i] != FieldType::GENERAL) fieldReads[i] = typedReads[typed++];
+        }
+    }
+    
+    for (size_t stale = 0; stale < staleRegions.size(); ++stale) {
+        size_t i = staleRegions[stale];
+        const auto& hudRegion = config.hudRegions[hudIndices[i]];
+        HudRead& read = hudReads[hudIndices[i]];
+        read.area = areas[i];
+        read.age = 0;
+        read.results.clear();
+        if (stale < fieldReads.size() && !fieldReads[stale].text.empty() && fieldReads[stale].confidence >= confidenceThreshold) {
+            read.results.push_back(fieldReads[stale]);
+            read.results.back().detectedType = hudRegion.name;
+            ++hudFieldReads;
+            continue;
+        }
+        
+        // The CRNN batch has already read the whole region; searching it again would
+        // cost one more inference per region
+        if (currentBackend == OCRBackend::CRNN) continue;
+        
+        const cv::Rect& area = areas[i];
+        std::vector<TextRegion> regionResults = currentBackend == OCRBackend::OPENCV_EAST ? processWithOpenCV(frame(area))
+            : currentBackend == OCRBackend::CRNN ? processWithCrnn(frame(area)) : processWithTesseract(frame(area));
+        for (auto result : regionResults) {
+            result.region += area.tl();
+            result.detectedType = hudRegion.name;
+            read.results.push_back(result);
+        }
+    }
+    
+    for (size_t i = 0; i < areas.size(); ++i) {
+        const auto& regionResults = hudReads[hudIndices[i]].results;
+        results.insert(results.end(), regionResults.begin(), regionResults.end());
+    }
+    
     return results;
 }
 
@@ -486,6 +936,50 @@ void AdvancedOCR::setBackend(OCRBackend backend) {
         cleanup();
         initialize(backend);
     }
+    std::lock_guard<std::mutex> lock(hudMutex);
+    hudReads.clear();
+}
+
+void AdvancedOCR::enableIncrementalHud(bool enable) {
+    std::lock_guard<std::mutex> lock(hudMutex);
+    incrementalHud = enable;
+    hudMask.reset();
+    hudReads.clear();
+}
+
+// TraineddataCache Implementation
+TraineddataCache& TraineddataCache::getInstance() {
+    static TraineddataCache instance;
+    return instance;
+}
+
+std::shared_ptr<const MappedFile> TraineddataCache::acquire(const std::string& path) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = mappings.find(path);
+    if (it != mappings.end()) {
+        ++hitCount;
+        return it->second;
+    }
+    
+    ++missCount;
+    auto mapping = std::make_shared<MappedFile>();
+    if (!mapping->open(path)) return nullptr;
+    mappings[path] = mapping;
+    return mapping;
+}
+
+void TraineddataCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    mappings.clear();
+}
+
+size_t TraineddataCache::getMappedBytes() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    size_t total = 0;
+    for (const auto& entry : mappings) {
+        total += entry.second->size();
+    }
+    return total;
 }
 
 // FrameCache Implementation
@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/dnn.hpp>
@@ -11,15 +13,22 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <functional>
+#include "profile_database.h"
+#include "mapped_file.h"
+#include "rcu_pointer.h"
+#include "crnn_recognizer.h"
+#include "static_hud_mask.h"
 
 // Advanced OCR System with Multiple Backends
 class AdvancedOCR {
 public:
     enum class OCRBackend {
         TESSERACT,
-        OPENCV_EAST
+        OPENCV_EAST,
+        CRNN            // Small CTC recogniser through cv::dnn; text regions from contours
     };
 
     struct TextRegion {
@@ -42,21 +51,90 @@ public:
         float threshold;
     };
 
+    // Templates and profile HUD regions; replaced as a whole when a profile (re)loads
+    struct TemplateConfig {
+        std::vector<GameUITemplate> templates;
+        std::vector<ProfileDefinition::HudRegion> hudRegions;
+        std::vector<ProfileDefinition::TextColor> textColors;
+        std::string profileName;
+    };
+
+    // EAGER loads the backend inside initialize(). LAZY only checks it is available
+    // and defers the expensive part (traineddata, DNN weights) to warmUp() or the
+    // first detection
+    enum class LoadMode {
+        EAGER,
+        LAZY
+    };
+
+    // Where Tesseract reads traineddata from. SHARED_MAPPING initialises every engine
+    // from one process-wide mapping of the file (see TraineddataCache)
+    enum class ModelSource {
+        FILE,
+        SHARED_MAPPING
+    };
+
+    // HUD field shapes with their own Tesseract engine: single-line page segmentation,
+    // a whitelist of just the characters the field can hold, and no dictionaries
+    enum class FieldType {
+        GENERAL,        // The sparse-text engine, full character set
+        DIGITS,         // 1250
+        TIME,           // 02:45
+        RATIO,          // 30/120
+        LABEL,          // LV 3, ELIMINATED
+        COUNT
+    };
+
+    static constexpr const char* EAST_MODEL_PATH = "models/frozen_east_text_detection.pb";
+    static constexpr const char* CRNN_MODEL_PATH = "models/crnn_cs.onnx";
+    static constexpr const char* CRNN_INT8_MODEL_PATH = "models/crnn_cs_int8.onnx";
+    static constexpr const char* CRNN_VOCABULARY_PATH = "models/alphabet_94.txt";
+    static constexpr size_t MAX_TEXT_COLORS = 8;        // Further @text colours are ignored
+    static constexpr int HUD_REREAD_FRAMES = 30;        // A reused HUD read is refreshed after this many frames
+
     AdvancedOCR();
     ~AdvancedOCR();
 
     // Initialization
-    bool initialize(OCRBackend backend = OCRBackend::TESSERACT);
+    bool initialize(OCRBackend backend = OCRBackend::TESSERACT, LoadMode mode = LoadMode::EAGER);
     bool initializeTesseract();
     bool initializeOpenCV();
+    bool initializeCrnn();
     void cleanup();
 
-    // Main OCR functions
+    // Loads the current backend if it is not loaded yet; callable from any thread
+    bool warmUp();
+    bool isBackendLoaded() const { return backendLoaded.load(std::memory_order_acquire); }
+    double getBackendLoadTimeMs() const { return backendLoadTimeMs; }
+
+    // Takes effect at the next backend load
+    void setModelSource(ModelSource source) { modelSource = source; }
+    void setCrnnPrecision(CrnnRecognizer::Precision precision) { crnnPrecision = precision; }
+
+    // Main OCR functions. With a profile applied only its HUD regions are read (see
+    // enableIncrementalHud); a game name adds whole-frame game UI text, as detectGameUI
     std::vector<TextRegion> detectText(const cv::Mat& frame, const std::string& gameName = "");
 
     // Backend-specific processing
     std::vector<TextRegion> processWithTesseract(const cv::Mat& frame);
     std::vector<TextRegion> processWithOpenCV(const cv::Mat& frame);
+    std::vector<TextRegion> processWithCrnn(const cv::Mat& frame);
+
+    // One HUD field cropped to its region, read as a single line by the engine for its
+    // type; empty text and zero confidence if that engine is not loaded
+    TextRegion recognizeField(const cv::Mat& field, FieldType type);
+
+    // Many fields of one frame: a single batched inference with CRNN, one field engine
+    // call per box with Tesseract. Results are in box order, regions in frame coordinates
+    std::vector<TextRegion> recognizeFields(const cv::Mat& frame, const std::vector<cv::Rect>& boxes,
+                                            const std::vector<FieldType>& types);
+
+    // The characters a field of this type can hold
+    static const char* fieldCharacters(FieldType type);
+
+    // From a profile HUD region name or a classifyTextType result ("ammo" -> RATIO);
+    // a name may also carry the type itself, e.g. "round_time" or "clip_ratio"
+    static FieldType fieldTypeForName(const std::string& name);
 
     // Game-specific detection
     std::vector<TextRegion> detectGameUI(const cv::Mat& frame, const std::string& gameName);
@@ -70,8 +148,24 @@ public:
     void enableCaching(bool enable);
     void setConfidenceThreshold(float threshold);
 
+    // Swaps in the profile's HUD regions; detectText reads them without locking
+    void applyProfile(const ProfileDefinition& profile);
+    uint64_t getTemplateVersion() const { return templateConfig.version(); }
+
+    // Profile HUD regions whose pixels have not changed are not read again: detectText
+    // learns a static-HUD mask from the frames it is given and reuses a region's last read
+    // while only the world behind it moves
+    void enableIncrementalHud(bool enable);
+    const StaticHudMask& getHudMask() const { return hudMask; }
+    uint64_t getHudRegionsRead() const { return hudRegionsRead.load(); }
+    uint64_t getHudRegionsReused() const { return hudRegionsReused.load(); }
+    uint64_t getHudFieldReads() const { return hudFieldReads.load(); }     // Region reads the field engines answered
+
     // Utility functions
+    // Dark text on white. With the profile's @text colours, pixels within tolerance of one
+    // are text; otherwise a blurred adaptive threshold, cleaned up with a morphological close
     cv::Mat preprocessFrame(const cv::Mat& frame);
+    static cv::Mat colorKeyBinarize(const cv::Mat& frame, const std::vector<ProfileDefinition::TextColor>& colors);
     std::vector<cv::Rect> detectTextRegions(const cv::Mat& frame);
 
 private:
@@ -83,26 +177,59 @@ private:
 
     // Windows components (removed for compatibility)
 
+    // Backend loading (see LoadMode)
+    std::mutex backendMutex;
+    std::atomic<bool> backendLoaded;
+    bool backendFailed;
+    double backendLoadTimeMs;
+
     // Tesseract components
     std::unique_ptr<tesseract::TessBaseAPI> tesseractAPI;
+    std::unique_ptr<tesseract::TessBaseAPI> fieldEngines[static_cast<size_t>(FieldType::COUNT)];    // GENERAL unused
+    std::string tessdataPath;
+    ModelSource modelSource;
 
-    // OpenCV components
-    cv::dnn::Net eastNet;
+    // OpenCV components; without the EAST model text regions come from contours
+    std::unique_ptr<cv::dnn::TextDetectionModel_EAST> eastDetector;
+    std::unique_ptr<CrnnRecognizer> crnnRecognizer;
+    CrnnRecognizer::Precision crnnPrecision;
 
     // Caching
     std::vector<TextRegion> cachedResults;
     std::chrono::milliseconds lastProcessTime;
 
     // Game templates
-    std::vector<GameUITemplate> gameTemplates;
+    RcuPointer<TemplateConfig> templateConfig;
+
+    // Incremental HUD reads, indexed like TemplateConfig::hudRegions
+    struct HudRead {
+        cv::Rect area;
+        std::vector<TextRegion> results;
+        int age;                // Frames since the region was last read
+
+        HudRead() : age(0) {}
+    };
+    std::mutex hudMutex;
+    bool incrementalHud;
+    StaticHudMask hudMask;
+    std::vector<HudRead> hudReads;
+    uint64_t hudReadsVersion;
+    std::atomic<uint64_t> hudRegionsRead;
+    std::atomic<uint64_t> hudRegionsReused;
+    std::atomic<uint64_t> hudFieldReads;
 
     // Thread safety
     std::mutex processingMutex;
 
     // Helper functions
+    bool locateTessdata();
+    std::unique_ptr<tesseract::TessBaseAPI> createTesseractEngine(const MappedFile* model, FieldType type);
+    cv::Mat prepareField(const cv::Mat& field);
     void loadGameTemplates(const std::string& gameName);
     void loadDefaultGameTemplates();
-    std::vector<TextRegion> matchGameTemplates(const cv::Mat& frame);
+    std::vector<TextRegion> processWithBackend(const cv::Mat& frame);
+    std::vector<TextRegion> detectGameUILocked(const cv::Mat& frame, const TemplateConfig& config);
+    std::vector<TextRegion> matchGameTemplates(const cv::Mat& frame, const TemplateConfig& config);
     float matchTemplate(const cv::Mat& frame, const GameUITemplate& template_);
     bool isGameUIText(const std::string& text);
     std::string classifyTextType(const std::string& text);
@@ -115,6 +242,33 @@ private:
     // Windows API helpers (removed for compatibility)
 };
 
+// Process-wide cache of memory-mapped traineddata files, shared read-only by every
+// engine using ModelSource::SHARED_MAPPING. Tesseract still copies the buffer it is
+// given and builds its own model from it, so per-engine model memory is unchanged;
+// what is shared is the file itself. Extra engines skip opening and reading it, and
+// its bytes are resident once, as evictable page cache rather than a private heap
+// buffer per load.
+class TraineddataCache {
+public:
+    static TraineddataCache& getInstance();
+
+    // Null if the file cannot be mapped
+    std::shared_ptr<const MappedFile> acquire(const std::string& path);
+    void clear();               // Mappings still held by callers stay valid
+
+    size_t getMappedBytes() const;
+    uint64_t getHitCount() const { return hitCount.load(); }
+    uint64_t getMissCount() const { return missCount.load(); }
+
+private:
+    TraineddataCache() = default;
+
+    mutable std::mutex cacheMutex;
+    std::map<std::string, std::shared_ptr<const MappedFile>> mappings;
+    std::atomic<uint64_t> hitCount{0};
+    std::atomic<uint64_t> missCount{0};
+};
+
 // Frame Cache for OCR Results
 class FrameCache {
 public:
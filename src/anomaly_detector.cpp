@@ -0,0 +1,296 @@
+#include "anomaly_detector.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Scale floor so a perfectly flat signal still reports a finite score on its first jump
+double scaleFloor(double center) {
+    return 1e-3 * std::max(1.0, std::abs(center));
+}
+
+}
+
+const char* AnomalyEvent::detectorName(Detector detector) {
+    switch (detector) {
+        case Detector::ROBUST_ZSCORE: return "RobustZ";
+        case Detector::EWMA_CHART:    return "EWMA";
+        case Detector::CUSUM:         return "CUSUM";
+    }
+    return "Unknown";
+}
+
+// RobustZScoreDetector Implementation
+RobustZScoreDetector::RobustZScoreDetector(size_t window, double threshold)
+    : window(std::max<size_t>(5, window)), threshold(threshold), head(0), currentMedian(0.0) {
+    history.reserve(this->window);
+    sorted.reserve(this->window);
+}
+
+void RobustZScoreDetector::reset() {
+    history.clear();
+    sorted.clear();
+    head = 0;
+    currentMedian = 0.0;
+}
+
+double RobustZScoreDetector::medianAbsoluteDeviation(double center) const {
+    size_t n = sorted.size();
+    if (n == 0) return 0.0;
+
+    // Deviations grow outward from the center on both sides; merge them to the middle
+    size_t right = std::lower_bound(sorted.begin(), sorted.end(), center) - sorted.begin();
+    ptrdiff_t left = static_cast<ptrdiff_t>(right) - 1;
+    size_t target = n / 2;
+    double previous = 0.0, current = 0.0;
+
+    for (size_t k = 0; k <= target; ++k) {
+        double leftDeviation = left >= 0 ? center - sorted[left] : std::numeric_limits<double>::infinity();
+        double rightDeviation = right < n ? sorted[right] - center : std::numeric_limits<double>::infinity();
+
+        previous = current;
+        if (leftDeviation < rightDeviation) {
+            current = leftDeviation;
+            --left;
+        } else {
+            current = rightDeviation;
+            ++right;
+        }
+    }
+
+    return (n % 2 == 1) ? current : 0.5 * (previous + current);
+}
+
+bool RobustZScoreDetector::update(double value, double& score) {
+    score = 0.0;
+    if (!std::isfinite(value)) return false;
+
+    // Score against the window as it was before this sample
+    bool anomaly = false;
+    if (sorted.size() >= std::min<size_t>(8, window)) {
+        double mad = std::max(medianAbsoluteDeviation(currentMedian), scaleFloor(currentMedian));
+        score = 0.6745 * (value - currentMedian) / mad;
+        anomaly = std::abs(score) > threshold;
+    }
+
+    if (history.size() < window) {
+        history.push_back(value);
+    } else {
+        double evicted = history[head];
+        sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), evicted));
+        history[head] = value;
+        head = (head + 1) % window;
+    }
+    sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+
+    size_t n = sorted.size();
+    currentMedian = (n % 2 == 1) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+
+    return anomaly;
+}
+
+// EwmaControlChart Implementation
+EwmaControlChart::EwmaControlChart(double lambda, double limitWidth, double baselineAlpha, size_t warmupSamples)
+    : lambda(std::clamp(lambda, 0.01, 1.0)), limitWidth(limitWidth), baselineAlpha(baselineAlpha),
+      warmupSamples(std::max<size_t>(2, warmupSamples)) {
+    reset();
+}
+
+void EwmaControlChart::reset() {
+    smoothed = 0.0;
+    baselineMean = 0.0;
+    baselineVariance = 0.0;
+    samples = 0;
+}
+
+bool EwmaControlChart::update(double value, double& score) {
+    score = 0.0;
+    if (!std::isfinite(value)) return false;
+
+    samples++;
+    if (samples == 1) {
+        smoothed = value;
+        baselineMean = value;
+        return false;
+    }
+
+    smoothed = lambda * value + (1.0 - lambda) * smoothed;
+
+    bool anomaly = false;
+    if (samples > warmupSamples) {
+        double sigma = std::max(std::sqrt(baselineVariance), scaleFloor(baselineMean));
+        double chartSigma = sigma * std::sqrt(lambda / (2.0 - lambda));
+        score = (smoothed - baselineMean) / chartSigma;
+        anomaly = std::abs(score) > limitWidth;
+    }
+
+    // Running moments during warm-up, then a slow EWMA so the baseline can drift
+    double alpha = samples <= warmupSamples ? 1.0 / samples : baselineAlpha;
+    double delta = value - baselineMean;
+    baselineMean += alpha * delta;
+    baselineVariance = (1.0 - alpha) * (baselineVariance + alpha * delta * delta);
+
+    return anomaly;
+}
+
+// CusumDetector Implementation
+CusumDetector::CusumDetector(double slack, double decisionInterval, double baselineAlpha, size_t warmupSamples)
+    : slack(slack), decisionInterval(decisionInterval), baselineAlpha(baselineAlpha),
+      warmupSamples(std::max<size_t>(2, warmupSamples)) {
+    reset();
+}
+
+void CusumDetector::reset() {
+    upperSum = 0.0;
+    lowerSum = 0.0;
+    baselineMean = 0.0;
+    baselineVariance = 0.0;
+    samples = 0;
+}
+
+bool CusumDetector::update(double value, double& score, int& direction) {
+    score = 0.0;
+    direction = 0;
+    if (!std::isfinite(value)) return false;
+
+    samples++;
+    bool anomaly = false;
+
+    if (samples > warmupSamples) {
+        double sigma = std::max(std::sqrt(baselineVariance), scaleFloor(baselineMean));
+        double z = (value - baselineMean) / sigma;
+
+        upperSum = std::max(0.0, upperSum + z - slack);
+        lowerSum = std::max(0.0, lowerSum - z - slack);
+
+        if (upperSum > decisionInterval || lowerSum > decisionInterval) {
+            anomaly = true;
+            direction = upperSum >= lowerSum ? 1 : -1;
+            score = std::max(upperSum, lowerSum);
+
+            // Change point found: re-learn the baseline from the samples that follow
+            upperSum = 0.0;
+            lowerSum = 0.0;
+            baselineMean = 0.0;
+            baselineVariance = 0.0;
+            samples = 0;
+            return anomaly;
+        }
+    }
+
+    double alpha = samples <= warmupSamples ? 1.0 / samples : baselineAlpha;
+    double delta = value - baselineMean;
+    baselineMean += alpha * delta;
+    baselineVariance = (1.0 - alpha) * (baselineVariance + alpha * delta * delta);
+
+    return anomaly;
+}
+
+// SeriesAnomalyMonitor Implementation
+SeriesAnomalyMonitor::SeriesAnomalyMonitor(const std::string& name)
+    : name(name), ewmaOutOfControl(false) {
+}
+
+void SeriesAnomalyMonitor::reset() {
+    robustZScore.reset();
+    ewmaChart.reset();
+    cusum.reset();
+    ewmaOutOfControl = false;
+}
+
+void SeriesAnomalyMonitor::update(double value, int64_t timestamp, std::vector<AnomalyEvent>& events) {
+    auto makeEvent = [&](AnomalyEvent::Detector detector, double score, double baseline, bool upward) {
+        AnomalyEvent event;
+        event.series = name;
+        event.detector = detector;
+        event.value = value;
+        event.score = score;
+        event.baseline = baseline;
+        event.upward = upward;
+        event.timestamp = timestamp;
+        events.push_back(event);
+    };
+
+    double score = 0.0;
+    double median = robustZScore.median();
+    if (robustZScore.update(value, score)) {
+        makeEvent(AnomalyEvent::Detector::ROBUST_ZSCORE, score, median, score > 0);
+    }
+
+    double ewmaBaseline = ewmaChart.baseline();
+    bool outOfControl = ewmaChart.update(value, score);
+    if (outOfControl && !ewmaOutOfControl) {
+        makeEvent(AnomalyEvent::Detector::EWMA_CHART, score, ewmaBaseline, score > 0);
+    }
+    ewmaOutOfControl = outOfControl;
+
+    int direction = 0;
+    double cusumBaseline = cusum.baseline();
+    if (cusum.update(value, score, direction)) {
+        makeEvent(AnomalyEvent::Detector::CUSUM, score, cusumBaseline, direction > 0);
+    }
+}
+
+// AnomalyMonitor Implementation
+AnomalyMonitor::AnomalyMonitor(size_t maxPendingEvents)
+    : maxPendingEvents(std::max<size_t>(1, maxPendingEvents)), totalAnomalies(0), droppedAnomalies(0) {
+}
+
+size_t AnomalyMonitor::registerSeries(const std::string& name) {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+
+    auto it = seriesIds.find(name);
+    if (it != seriesIds.end()) return it->second;
+    size_t id = series.size();
+    seriesIds.emplace(name, id);
+    series.emplace_back(name);
+    return id;
+}
+
+void AnomalyMonitor::observe(const std::string& seriesName, double value, int64_t timestamp) {
+    observe(registerSeries(seriesName), value, timestamp);
+}
+
+void AnomalyMonitor::observe(size_t seriesId, double value, int64_t timestamp) {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+    if (seriesId >= series.size()) return;
+
+    scratch.clear();
+    series[seriesId].update(value, timestamp, scratch);
+
+    for (auto& event : scratch) {
+        totalAnomalies++;
+        if (pendingEvents.size() >= maxPendingEvents) {
+            pendingEvents.pop_front();
+            droppedAnomalies++;
+        }
+        pendingEvents.push_back(std::move(event));
+    }
+}
+
+std::vector<AnomalyEvent> AnomalyMonitor::drainEvents() {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+
+    std::vector<AnomalyEvent> events(pendingEvents.begin(), pendingEvents.end());
+    pendingEvents.clear();
+    return events;
+}
+
+void AnomalyMonitor::reset() {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+    for (auto& monitor : series) monitor.reset();   // IDs stay valid
+    pendingEvents.clear();
+    totalAnomalies = 0;
+    droppedAnomalies = 0;
+}
+
+size_t AnomalyMonitor::getTotalAnomalies() const {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+    return totalAnomalies;
+}
+
+size_t AnomalyMonitor::getDroppedAnomalies() const {
+    std::lock_guard<std::mutex> lock(monitorMutex);
+    return droppedAnomalies;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Anomaly raised by one of the streaming detectors
+struct AnomalyEvent {
+    enum class Detector {
+        ROBUST_ZSCORE,      // Spike relative to rolling median/MAD
+        EWMA_CHART,         // Smoothed level outside control limits
+        CUSUM               // Sustained shift in mean (change point)
+    };
+
+    std::string series;
+    Detector detector;
+    double value;
+    double score;           // Detector statistic, in units of its own threshold scale
+    double baseline;        // Expected value when the anomaly fired
+    bool upward;
+    int64_t timestamp;
+
+    AnomalyEvent() : detector(Detector::ROBUST_ZSCORE), value(0.0), score(0.0),
+                     baseline(0.0), upward(true), timestamp(0) {}
+
+    static const char* detectorName(Detector detector);
+};
+
+// Modified z-score against a rolling median and MAD (fixed window, O(window) per sample)
+class RobustZScoreDetector {
+public:
+    explicit RobustZScoreDetector(size_t window = 31, double threshold = 3.5);
+
+    bool update(double value, double& score);
+    double median() const { return currentMedian; }
+    void reset();
+
+private:
+    size_t window;
+    double threshold;
+    std::vector<double> history;    // Ring of raw samples (arrival order)
+    std::vector<double> sorted;     // Same samples, kept sorted
+    size_t head;
+    double currentMedian;
+
+    double medianAbsoluteDeviation(double center) const;
+};
+
+// EWMA control chart with self-estimated in-control mean/variance
+class EwmaControlChart {
+public:
+    EwmaControlChart(double lambda = 0.2, double limitWidth = 3.0, double baselineAlpha = 0.01,
+                     size_t warmupSamples = 30);
+
+    bool update(double value, double& score);
+    double baseline() const { return baselineMean; }
+    void reset();
+
+private:
+    double lambda;
+    double limitWidth;
+    double baselineAlpha;
+    size_t warmupSamples;
+
+    double smoothed;
+    double baselineMean;
+    double baselineVariance;
+    size_t samples;
+};
+
+// Two-sided tabular CUSUM on standardised samples
+class CusumDetector {
+public:
+    CusumDetector(double slack = 0.5, double decisionInterval = 5.0, double baselineAlpha = 0.02,
+                  size_t warmupSamples = 30);
+
+    // direction is +1 for an upward shift, -1 for a downward shift
+    bool update(double value, double& score, int& direction);
+    double baseline() const { return baselineMean; }
+    void reset();
+
+private:
+    double slack;
+    double decisionInterval;
+    double baselineAlpha;
+    size_t warmupSamples;
+
+    double upperSum;
+    double lowerSum;
+    double baselineMean;
+    double baselineVariance;
+    size_t samples;
+};
+
+// The three detectors applied to a single series
+class SeriesAnomalyMonitor {
+public:
+    explicit SeriesAnomalyMonitor(const std::string& name = "");
+
+    // Appends any anomalies raised by this sample to events
+    void update(double value, int64_t timestamp, std::vector<AnomalyEvent>& events);
+    void reset();
+
+    const std::string& getName() const { return name; }
+
+private:
+    std::string name;
+    RobustZScoreDetector robustZScore;
+    EwmaControlChart ewmaChart;
+    CusumDetector cusum;
+    bool ewmaOutOfControl;      // Alarm only on entering the out-of-control state
+};
+
+// Thread-safe collection of per-series monitors with a bounded pending-event queue
+class AnomalyMonitor {
+public:
+    explicit AnomalyMonitor(size_t maxPendingEvents = 256);
+
+    // Dense ID for a series, the same one if it is already registered. Register at
+    // setup so per-sample observe calls index an array instead of looking up a name
+    size_t registerSeries(const std::string& name);
+    void observe(size_t seriesId, double value, int64_t timestamp);     // Unknown IDs are ignored
+    void observe(const std::string& series, double value, int64_t timestamp);   // Registers on first use
+    std::vector<AnomalyEvent> drainEvents();
+    void reset();
+
+    size_t getTotalAnomalies() const;
+    size_t getDroppedAnomalies() const;
+
+private:
+    mutable std::mutex monitorMutex;
+    std::map<std::string, size_t> seriesIds;    // Registration and reporting only
+    std::vector<SeriesAnomalyMonitor> series;   // Indexed by series ID
+    std::deque<AnomalyEvent> pendingEvents;
+    std::vector<AnomalyEvent> scratch;
+    size_t maxPendingEvents;
+    size_t totalAnomalies;
+    size_t droppedAnomalies;
+};
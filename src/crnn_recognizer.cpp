@@ -0,0 +1,206 @@
+#include "crnn_recognizer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+// CrnnRecognizer Implementation
+CrnnRecognizer::Options::Options()
+    : precision(Precision::FP32), inputSize(100, 32), grayscale(false), maxBatch(32) {}
+
+CrnnRecognizer::CrnnRecognizer() : loaded(false), lastInferenceMs(0.0) {}
+
+bool CrnnRecognizer::load(const Options& newOptions) {
+    options = newOptions;
+    loaded = false;
+    if (options.maxBatch == 0) options.maxBatch = 1;
+    if (!loadVocabulary(options.vocabularyPath)) {
+        std::cerr << "CRNN vocabulary not found: " << options.vocabularyPath << std::endl;
+        return false;
+    }
+
+    try {
+        std::error_code error;
+        bool quantisedFile = options.precision == Precision::INT8 && !options.int8ModelPath.empty() &&
+                             std::filesystem::exists(options.int8ModelPath, error);
+        net = cv::dnn::readNetFromONNX(quantisedFile ? options.int8ModelPath : options.modelPath);
+        if (net.empty()) return false;
+        net.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+        net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+        if (options.precision == Precision::INT8 && !quantisedFile) {
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 6)
+            // Activation ranges come from rendered HUD-like strings
+            net = net.quantize(std::vector<cv::Mat>{calibrationBatch()}, CV_32F, CV_32F);
+#else
+            std::cerr << "This OpenCV cannot quantise networks; CRNN runs in FP32" << std::endl;
+#endif
+        }
+        if (options.precision == Precision::FP16) {
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 8)
+            net.setPreferableTarget(cv::dnn::DNN_TARGET_CPU_FP16);
+#else
+            std::cerr << "This OpenCV has no FP16 CPU target; CRNN runs in FP32" << std::endl;
+#endif
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "CRNN model could not be loaded: " << e.what() << std::endl;
+        return false;
+    }
+
+    loaded = true;
+    return true;
+}
+
+std::vector<CrnnRecognizer::Result> CrnnRecognizer::recognize(const cv::Mat& frame, const std::vector<cv::Rect>& boxes,
+                                                              const std::vector<std::string>& allowed) {
+    std::vector<Result> results(boxes.size());
+    if (!loaded || frame.empty() || boxes.empty()) return results;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Crops share the frame's pixels; blobFromImages does the resize and scaling
+    cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    std::vector<cv::Mat> crops;
+    std::vector<size_t> indices;
+    crops.reserve(boxes.size());
+    indices.reserve(boxes.size());
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        cv::Rect area = boxes[i] & frameRect;
+        if (area.empty()) continue;
+
+        cv::Mat crop = frame(area);
+        if (options.grayscale && crop.channels() > 1) {
+            cv::cvtColor(crop, crop, crop.channels() == 4 ? cv::COLOR_BGRA2GRAY : cv::COLOR_BGR2GRAY);
+        } else if (!options.grayscale && crop.channels() != 3) {
+            cv::cvtColor(crop, crop, crop.channels() == 4 ? cv::COLOR_BGRA2BGR : cv::COLOR_GRAY2BGR);
+        }
+        crops.push_back(crop);
+        indices.push_back(i);
+    }
+
+    // Boxes asking for the same characters share one class mask
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> masks;
+    auto maskFor = [&](size_t box) -> const std::vector<uint8_t>& {
+        static const std::vector<uint8_t> everything;
+        if (box >= allowed.size() || allowed[box].empty()) return everything;
+        for (const auto& mask : masks) {
+            if (mask.first == allowed[box]) return mask.second;
+        }
+        masks.emplace_back(allowed[box], classMask(allowed[box]));
+        return masks.back().second;
+    };
+
+    try {
+        for (size_t first = 0; first < crops.size(); first += options.maxBatch) {
+            size_t count = std::min(options.maxBatch, crops.size() - first);
+            std::vector<cv::Mat> batch(crops.begin() + first, crops.begin() + first + count);
+            cv::Mat blob = cv::dnn::blobFromImages(batch, 1.0 / 127.5, options.inputSize, cv::Scalar::all(127.5));
+            net.setInput(blob);
+            cv::Mat output = net.forward();
+
+            if (output.dims != 3 || output.size[1] != static_cast<int>(count) || output.type() != CV_32F) {
+                std::cerr << "CRNN output is not [steps, batch, classes]" << std::endl;
+                break;
+            }
+            int steps = output.size[0];
+            int classes = output.size[2];
+            const float* scores = output.ptr<float>();
+            for (size_t b = 0; b < count; ++b) {
+                size_t box = indices[first + b];
+                results[box] = decodeGreedy(scores + b * classes, steps, count * classes, classes, vocabulary, maskFor(box));
+            }
+        }
+    } catch (const cv::Exception& e) {
+        std::cerr << "CRNN inference error: " << e.what() << std::endl;
+    }
+
+    lastInferenceMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return results;
+}
+
+CrnnRecognizer::Result CrnnRecognizer::decodeGreedy(const float* scores, int steps, size_t stepStride, int classes,
+                                                    const std::vector<std::string>& vocabulary,
+                                                    const std::vector<uint8_t>& allowedClasses) {
+    Result result;
+    float probabilitySum = 0.0f;
+    int emitted = 0;
+    int previous = 0;
+
+    for (int step = 0; step < steps; ++step) {
+        const float* row = scores + step * stepStride;
+
+        float top = -std::numeric_limits<float>::infinity();
+        int best = 0;
+        float bestScore = row[0];
+        for (int c = 0; c < classes; ++c) {
+            top = std::max(top, row[c]);
+            bool permitted = c == 0 || allowedClasses.empty() || (c < static_cast<int>(allowedClasses.size()) && allowedClasses[c]);
+            if (permitted && row[c] > bestScore) {
+                bestScore = row[c];
+                best = c;
+            }
+        }
+
+        if (best != 0 && best != previous && best <= static_cast<int>(vocabulary.size())) {
+            // Softmax over every class, so a masked-out favourite lowers the confidence
+            float sum = 0.0f;
+            for (int c = 0; c < classes; ++c) sum += std::exp(row[c] - top);
+            probabilitySum += std::exp(bestScore - top) / sum;
+            ++emitted;
+            result.text += vocabulary[best - 1];
+        }
+        previous = best;
+    }
+
+    result.confidence = emitted ? probabilitySum / emitted : 0.0f;
+    return result;
+}
+
+bool CrnnRecognizer::loadVocabulary(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    vocabulary.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        vocabulary.push_back(line);
+    }
+    return !vocabulary.empty();
+}
+
+std::vector<uint8_t> CrnnRecognizer::classMask(const std::string& allowed) const {
+    std::vector<uint8_t> mask(vocabulary.size() + 1, 0);
+    mask[0] = 1;
+    for (size_t i = 0; i < vocabulary.size(); ++i) {
+        if (vocabulary[i].size() != 1) continue;
+        unsigned char character = static_cast<unsigned char>(vocabulary[i][0]);
+        for (char permitted : allowed) {
+            if (std::tolower(static_cast<unsigned char>(permitted)) == std::tolower(character)) {
+                mask[i + 1] = 1;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+cv::Mat CrnnRecognizer::calibrationBatch() const {
+    static const char* const samples[] = {
+        "100", "1250", "02:45", "30/120", "LV 3", "ELIMINATED", "87", "59:59", "7/90", "SCORE 4410"
+    };
+    std::vector<cv::Mat> images;
+    for (const char* sample : samples) {
+        cv::Mat image(options.inputSize, CV_8UC3, cv::Scalar(20, 20, 20));
+        cv::putText(image, sample, cv::Point(2, options.inputSize.height - 8), cv::FONT_HERSHEY_SIMPLEX,
+                    0.6, cv::Scalar(255, 255, 255), 1, cv::LINE_AA);
+        if (options.grayscale) cv::cvtColor(image, image, cv::COLOR_BGR2GRAY);
+        images.push_back(image);
+    }
+    return cv::dnn::blobFromImages(images, 1.0 / 127.5, options.inputSize, cv::Scalar::all(127.5));
+}
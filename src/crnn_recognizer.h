@@ -0,0 +1,69 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <opencv2/dnn.hpp>
+#include <string>
+#include <vector>
+
+// Small convolutional-recurrent text recogniser (CRNN, CTC output) run through
+// cv::dnn on the CPU. Recognition only: each box holds one line of text, typically
+// a HUD field, and all boxes of a call go through the network as one batch. Output
+// is decoded greedily, optionally restricted per box to the characters it can hold.
+class CrnnRecognizer {
+public:
+    enum class Precision {
+        FP32,
+        FP16,       // Half-precision CPU target where this OpenCV build has one
+        INT8        // The quantised model file, or the FP32 model quantised at load
+    };
+
+    struct Options {
+        std::string modelPath;          // ONNX, output [steps, batch, classes], class 0 = CTC blank
+        std::string int8ModelPath;      // Optional pre-quantised (QDQ) model
+        std::string vocabularyPath;     // One character per line, in class order from 1
+        Precision precision;
+        cv::Size inputSize;
+        bool grayscale;                 // One input channel instead of three
+        size_t maxBatch;                // Boxes per forward pass
+
+        Options();
+    };
+
+    struct Result {
+        std::string text;
+        float confidence;               // Mean probability of the characters emitted
+
+        Result() : confidence(0.0f) {}
+    };
+
+    CrnnRecognizer();
+
+    bool load(const Options& options);
+    bool isLoaded() const { return loaded; }
+    const Options& getOptions() const { return options; }
+    const std::vector<std::string>& getVocabulary() const { return vocabulary; }
+
+    // One result per box. allowed[i], when present and non-empty, limits box i to
+    // those characters (matched case-insensitively against the vocabulary)
+    std::vector<Result> recognize(const cv::Mat& frame, const std::vector<cv::Rect>& boxes,
+                                  const std::vector<std::string>& allowed = {});
+
+    double getLastInferenceMs() const { return lastInferenceMs; }
+
+    // Best class per step, repeats merged, blanks dropped; classes outside allowedClasses
+    // (indexed by class, empty = all) are never chosen. Scores may be logits or log-probabilities.
+    static Result decodeGreedy(const float* scores, int steps, size_t stepStride, int classes,
+                               const std::vector<std::string>& vocabulary,
+                               const std::vector<uint8_t>& allowedClasses = {});
+
+private:
+    Options options;
+    cv::dnn::Net net;
+    std::vector<std::string> vocabulary;
+    bool loaded;
+    double lastInferenceMs;
+
+    bool loadVocabulary(const std::string& path);
+    std::vector<uint8_t> classMask(const std::string& allowed) const;
+    cv::Mat calibrationBatch() const;
+};
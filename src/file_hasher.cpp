@@ -0,0 +1,438 @@
+#include "file_hasher.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t PRIME64_1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME64_2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME64_3 = 1609587929392839161ULL;
+constexpr uint64_t PRIME64_4 = 9650029242287828579ULL;
+constexpr uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t read64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t xxhRound(uint64_t accumulator, uint64_t input) {
+    accumulator += input * PRIME64_2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * PRIME64_1;
+}
+
+inline uint64_t xxhMergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= xxhRound(0, accumulator);
+    return hash * PRIME64_1 + PRIME64_4;
+}
+
+const char CACHE_HEADER[] = "GAHC1";
+
+} // namespace
+
+// XxHash64 Implementation
+XxHash64::XxHash64(uint64_t seed) {
+    reset(seed);
+}
+
+void XxHash64::reset(uint64_t seed) {
+    this->seed = seed;
+    accumulators[0] = seed + PRIME64_1 + PRIME64_2;
+    accumulators[1] = seed + PRIME64_2;
+    accumulators[2] = seed;
+    accumulators[3] = seed - PRIME64_1;
+    bufferSize = 0;
+    totalLength = 0;
+}
+
+void XxHash64::update(const void* data, size_t length) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    totalLength += length;
+
+    // Complete a partially filled stripe first
+    if (bufferSize > 0) {
+        size_t fill = std::min(length, sizeof(buffer) - bufferSize);
+        std::memcpy(buffer + bufferSize, input, fill);
+        bufferSize += fill;
+        input += fill;
+        length -= fill;
+        if (bufferSize < sizeof(buffer)) return;
+
+        for (int lane = 0; lane < 4; ++lane) {
+            accumulators[lane] = xxhRound(accumulators[lane], read64(buffer + lane * 8));
+        }
+        bufferSize = 0;
+    }
+
+    // Whole stripes straight from the caller's buffer
+    uint64_t v0 = accumulators[0], v1 = accumulators[1], v2 = accumulators[2], v3 = accumulators[3];
+    while (length >= 32) {
+        v0 = xxhRound(v0, read64(input));
+        v1 = xxhRound(v1, read64(input + 8));
+        v2 = xxhRound(v2, read64(input + 16));
+        v3 = xxhRound(v3, read64(input + 24));
+        input += 32;
+        length -= 32;
+    }
+    accumulators[0] = v0; accumulators[1] = v1; accumulators[2] = v2; accumulators[3] = v3;
+
+    std::memcpy(buffer, input, length);
+    bufferSize = length;
+}
+
+uint64_t XxHash64::digest() const {
+    uint64_t hash;
+    if (totalLength >= 32) {
+        hash = rotateLeft(accumulators[0], 1) + rotateLeft(accumulators[1], 7) +
+               rotateLeft(accumulators[2], 12) + rotateLeft(accumulators[3], 18);
+        for (int lane = 0; lane < 4; ++lane) {
+            hash = xxhMergeRound(hash, accumulators[lane]);
+        }
+    } else {
+        hash = seed + PRIME64_5;
+    }
+    hash += totalLength;
+
+    const uint8_t* tail = buffer;
+    size_t remaining = bufferSize;
+    while (remaining >= 8) {
+        hash ^= xxhRound(0, read64(tail));
+        hash = rotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+        tail += 8;
+        remaining -= 8;
+    }
+    if (remaining >= 4) {
+        hash ^= static_cast<uint64_t>(read32(tail)) * PRIME64_1;
+        hash = rotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+        tail += 4;
+        remaining -= 4;
+    }
+    while (remaining > 0) {
+        hash ^= (*tail) * PRIME64_5;
+        hash = rotateLeft(hash, 11) * PRIME64_1;
+        tail++;
+        remaining--;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t XxHash64::hash(const void* data, size_t length, uint64_t seed) {
+    XxHash64 hasher(seed);
+    hasher.update(data, length);
+    return hasher.digest();
+}
+
+// Md5 Implementation
+Md5::Md5() {
+    reset();
+}
+
+void Md5::reset() {
+    state[0] = 0x67452301;
+    state[1] = 0xefcdab89;
+    state[2] = 0x98badcfe;
+    state[3] = 0x10325476;
+    bufferSize = 0;
+    totalLength = 0;
+}
+
+void Md5::update(const void* data, size_t length) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    totalLength += length;
+
+    if (bufferSize > 0) {
+        size_t fill = std::min(length, sizeof(buffer) - bufferSize);
+        std::memcpy(buffer + bufferSize, input, fill);
+        bufferSize += fill;
+        input += fill;
+        length -= fill;
+        if (bufferSize < sizeof(buffer)) return;
+        transform(buffer);
+        bufferSize = 0;
+    }
+
+    while (length >= 64) {
+        transform(input);
+        input += 64;
+        length -= 64;
+    }
+
+    std::memcpy(buffer, input, length);
+    bufferSize = length;
+}
+
+std::string Md5::hexDigest() {
+    uint64_t bitLength = totalLength * 8;
+
+    // 0x80, zero pad to 56 mod 64, then the little-endian bit length
+    uint8_t padding[72] = {0x80};
+    size_t padLength = bufferSize < 56 ? 56 - bufferSize : 120 - bufferSize;
+    update(padding, padLength);
+
+    uint8_t lengthBytes[8];
+    for (int i = 0; i < 8; ++i) {
+        lengthBytes[i] = static_cast<uint8_t>(bitLength >> (8 * i));
+    }
+    update(lengthBytes, 8);
+
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(32);
+    for (uint32_t word : state) {
+        for (int i = 0; i < 4; ++i) {
+            uint8_t byte = static_cast<uint8_t>(word >> (8 * i));
+            hex += digits[byte >> 4];
+            hex += digits[byte & 15];
+        }
+    }
+    return hex;
+}
+
+void Md5::transform(const uint8_t block[64]) {
+    static const uint32_t sines[64] = {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+    };
+    static const int shifts[64] = {
+        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+        5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+    };
+
+    uint32_t words[16];
+    for (int i = 0; i < 16; ++i) {
+        words[i] = read32(block + i * 4);
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t f;
+        int g;
+        if (i < 16) {
+            f = (b & c) | (~b & d);
+            g = i;
+        } else if (i < 32) {
+            f = (d & b) | (~d & c);
+            g = (5 * i + 1) & 15;
+        } else if (i < 48) {
+            f = b ^ c ^ d;
+            g = (3 * i + 5) & 15;
+        } else {
+            f = c ^ (b | ~d);
+            g = (7 * i) & 15;
+        }
+
+        uint32_t rotated = a + f + sines[i] + words[g];
+        a = d;
+        d = c;
+        c = b;
+        b += (rotated << shifts[i]) | (rotated >> (32 - shifts[i]));
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+// FileHashCache Implementation
+FileHashCache::FileHashCache(const std::string& cacheFile)
+    : cacheFile(cacheFile), loaded(false), cacheHits(0), cacheMisses(0) {
+}
+
+bool FileHashCache::statFile(const std::string& path, uint64_t& size, int64_t& modifiedTime) {
+    std::error_code error;
+    size = std::filesystem::file_size(path, error);
+    if (error) return false;
+
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    if (error) return false;
+    modifiedTime = static_cast<int64_t>(writeTime.time_since_epoch().count());
+    return true;
+}
+
+bool FileHashCache::hashFile(const std::string& path, bool includeMd5, FileDigest& digest) {
+    if (!statFile(path, digest.size, digest.modifiedTime)) return false;
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    // Unbuffered stdio: each fread is one large sequential read at a chunk-aligned offset
+    setvbuf(file, nullptr, _IONBF, 0);
+    std::unique_ptr<uint8_t[]> chunk(new uint8_t[READ_CHUNK_SIZE]);
+
+    XxHash64 xxh;
+    Md5 md5;
+    size_t bytesRead;
+    while ((bytesRead = fread(chunk.get(), 1, READ_CHUNK_SIZE, file)) > 0) {
+        xxh.update(chunk.get(), bytesRead);
+        if (includeMd5) {
+            md5.update(chunk.get(), bytesRead);
+        }
+    }
+
+    bool readError = ferror(file) != 0;
+    fclose(file);
+    if (readError) return false;
+
+    digest.xxh64 = toHex(xxh.digest());
+    digest.md5 = includeMd5 ? md5.hexDigest() : std::string();
+    return true;
+}
+
+bool FileHashCache::getDigest(const std::string& path, bool includeMd5, FileDigest& digest) {
+    uint64_t size;
+    int64_t modifiedTime;
+    if (!statFile(path, size, modifiedTime)) return false;
+
+    // First use reads the persisted cache; a racing lookup just hashes once more
+    bool needsLoad;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        needsLoad = !loaded;
+        loaded = true;
+    }
+    if (needsLoad) load();
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        auto it = entries.find(path);
+        if (it != entries.end() && it->second.size == size && it->second.modifiedTime == modifiedTime &&
+            (!includeMd5 || !it->second.md5.empty())) {
+            digest = it->second;
+            cacheHits++;
+            return true;
+        }
+        cacheMisses++;
+    }
+
+    // Hash outside the lock; large binaries take a while
+    FileDigest computed;
+    if (!hashFile(path, includeMd5, computed)) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        entries[path] = computed;
+    }
+    save();
+
+    digest = computed;
+    return true;
+}
+
+bool FileHashCache::load() {
+    FILE* file = fopen(cacheFile.c_str(), "r");
+    if (!file) return false;
+
+    std::map<std::string, FileDigest> loadedEntries;
+    char line[4096];
+    bool valid = fgets(line, sizeof(line), file) && std::strncmp(line, CACHE_HEADER, sizeof(CACHE_HEADER) - 1) == 0;
+
+    // path \t size \t mtime \t xxh64 \t md5 (or "-")
+    while (valid && fgets(line, sizeof(line), file)) {
+        std::string text(line);
+        while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.pop_back();
+
+        std::vector<std::string> fields;
+        size_t start = 0;
+        for (size_t tab = text.find('\t'); tab != std::string::npos; tab = text.find('\t', start)) {
+            fields.push_back(text.substr(start, tab - start));
+            start = tab + 1;
+        }
+        fields.push_back(text.substr(start));
+        if (fields.size() != 5) continue;
+
+        FileDigest digest;
+        digest.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+        digest.modifiedTime = std::strtoll(fields[2].c_str(), nullptr, 10);
+        digest.xxh64 = fields[3];
+        digest.md5 = fields[4] == "-" ? std::string() : fields[4];
+        loadedEntries[fields[0]] = digest;
+    }
+    fclose(file);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    loaded = true;
+    for (auto& entry : loadedEntries) {
+        entries.insert(entry);      // Entries hashed in this session take precedence
+    }
+    return valid;
+}
+
+bool FileHashCache::save() {
+    std::map<std::string, FileDigest> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        snapshot = entries;
+    }
+
+    // Write beside the cache and swap in, so a crash never leaves a truncated cache
+    std::string temporaryFile = cacheFile + ".tmp";
+    FILE* file = fopen(temporaryFile.c_str(), "w");
+    if (!file) return false;
+
+    fprintf(file, "%s\n", CACHE_HEADER);
+    for (const auto& entry : snapshot) {
+        const FileDigest& digest = entry.second;
+        fprintf(file, "%s\t%llu\t%lld\t%s\t%s\n", entry.first.c_str(),
+                static_cast<unsigned long long>(digest.size), static_cast<long long>(digest.modifiedTime),
+                digest.xxh64.c_str(), digest.md5.empty() ? "-" : digest.md5.c_str());
+    }
+    bool written = fclose(file) == 0;
+
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temporaryFile, cacheFile, error);
+        if (error) {
+            std::filesystem::remove(cacheFile, error);
+            std::filesystem::rename(temporaryFile, cacheFile, error);
+        }
+    }
+    return written && !error;
+}
+
+void FileHashCache::clear() {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    entries.clear();
+    cacheHits = 0;
+    cacheMisses = 0;
+}
+
+size_t FileHashCache::size() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return entries.size();
+}
+
+std::string FileHashCache::toHex(uint64_t value) {
+    char text[17];
+    snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+    return text;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Streaming XXH64 (the 64-bit xxHash), used as the primary executable fingerprint.
+// Non-cryptographic but runs at memory bandwidth, so hashing is I/O bound.
+class XxHash64 {
+public:
+    explicit XxHash64(uint64_t seed = 0);
+
+    void reset(uint64_t seed = 0);
+    void update(const void* data, size_t length);
+    uint64_t digest() const;
+
+    static uint64_t hash(const void* data, size_t length, uint64_t seed = 0);
+
+private:
+    uint64_t accumulators[4];
+    uint8_t buffer[32];         // Tail that has not yet filled a 32-byte stripe
+    size_t bufferSize;
+    uint64_t totalLength;
+    uint64_t seed;
+};
+
+// Streaming MD5 (RFC 1321), only computed when a caller asks for it
+class Md5 {
+public:
+    Md5();
+
+    void reset();
+    void update(const void* data, size_t length);
+    std::string hexDigest();        // Finalises; call reset() before reuse
+
+private:
+    uint32_t state[4];
+    uint8_t buffer[64];
+    size_t bufferSize;
+    uint64_t totalLength;
+
+    void transform(const uint8_t block[64]);
+};
+
+struct FileDigest {
+    uint64_t size;
+    int64_t modifiedTime;       // Filesystem clock ticks; only compared for equality
+    std::string xxh64;          // 16 hex digits
+    std::string md5;            // 32 hex digits, empty unless requested
+
+    FileDigest() : size(0), modifiedTime(0) {}
+};
+
+// File hashes cached persistently by (path, size, modification time).
+// Unchanged files are answered from the cache without reading them; anything
+// else is streamed once in large sequential chunks and the cache file rewritten.
+class FileHashCache {
+public:
+    static constexpr size_t READ_CHUNK_SIZE = 1 << 20;
+
+    explicit FileHashCache(const std::string& cacheFile = "hash_cache.dat");
+
+    // Returns false if the file cannot be read
+    bool getDigest(const std::string& path, bool includeMd5, FileDigest& digest);
+
+    // Hash without consulting or updating the cache
+    static bool hashFile(const std::string& path, bool includeMd5, FileDigest& digest);
+
+    bool load();
+    bool save();
+    void clear();
+
+    size_t size() const;
+    size_t getCacheHits() const { return cacheHits; }
+    size_t getCacheMisses() const { return cacheMisses; }
+
+    static std::string toHex(uint64_t value);
+
+private:
+    std::string cacheFile;
+    std::map<std::string, FileDigest> entries;
+    mutable std::mutex cacheMutex;
+    bool loaded;
+    size_t cacheHits;
+    size_t cacheMisses;
+
+    static bool statFile(const std::string& path, uint64_t& size, int64_t& modifiedTime);
+};
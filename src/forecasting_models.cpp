@@ -0,0 +1,298 @@
+#include "forecasting_models.h"
+#include "stats_kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// ForecastErrorStats Implementation
+void ForecastErrorStats::update(double predicted, double actual, double alpha) {
+    double error = actual - predicted;
+    if (!std::isfinite(error)) return;
+
+    if (samples == 0) {
+        meanAbsoluteError = std::abs(error);
+        meanSquaredError = error * error;
+    } else {
+        meanAbsoluteError += alpha * (std::abs(error) - meanAbsoluteError);
+        meanSquaredError += alpha * (error * error - meanSquaredError);
+    }
+    samples++;
+}
+
+// HoltWintersModel Implementation
+HoltWintersModel::HoltWintersModel(double alpha, double beta, double gamma, int seasonLength)
+    : alpha(alpha), beta(beta), gamma(gamma), seasonLength(std::max(1, seasonLength)),
+      initialized(false), level(0.0), trend(0.0), sampleCount(0) {
+    // A single-slot season degenerates to Holt's linear method
+    if (this->seasonLength == 1) {
+        this->gamma = 0.0;
+    }
+    seasonal.assign(this->seasonLength, 0.0);
+    warmup.reserve(this->seasonLength);
+}
+
+void HoltWintersModel::update(double value) {
+    if (!std::isfinite(value)) return;
+
+    if (!initialized) {
+        warmup.push_back(value);
+        sampleCount++;
+
+        if (static_cast<int>(warmup.size()) >= seasonLength) {
+            // Seed level with the first season's mean and the season with its offsets
+            level = std::accumulate(warmup.begin(), warmup.end(), 0.0) / warmup.size();
+            trend = 0.0;
+            for (int i = 0; i < seasonLength; ++i) {
+                seasonal[i] = (seasonLength > 1) ? warmup[i] - level : 0.0;
+            }
+            warmup.clear();
+            initialized = true;
+        }
+        return;
+    }
+
+    errorStats.update(predict(1), value);
+
+    size_t slot = sampleCount % seasonLength;
+    double previousLevel = level;
+
+    level = alpha * (value - seasonal[slot]) + (1.0 - alpha) * (level + trend);
+    trend = beta * (level - previousLevel) + (1.0 - beta) * trend;
+    seasonal[slot] = gamma * (value - level) + (1.0 - gamma) * seasonal[slot];
+
+    sampleCount++;
+}
+
+double HoltWintersModel::predict(int horizon) const {
+    if (!initialized) {
+        return warmup.empty() ? 0.0 : warmup.back();
+    }
+
+    horizon = std::max(1, horizon);
+    size_t slot = (sampleCount + horizon - 1) % seasonLength;
+    return level + horizon * trend + seasonal[slot];
+}
+
+std::vector<double> HoltWintersModel::forecast(int periods) const {
+    std::vector<double> result;
+    result.reserve(std::max(0, periods));
+
+    for (int i = 1; i <= periods; ++i) {
+        result.push_back(predict(i));
+    }
+
+    return result;
+}
+
+void HoltWintersModel::reset() {
+    initialized = false;
+    level = 0.0;
+    trend = 0.0;
+    std::fill(seasonal.begin(), seasonal.end(), 0.0);
+    warmup.clear();
+    sampleCount = 0;
+    errorStats.reset();
+}
+
+// OnlineARModel Implementation
+OnlineARModel::OnlineARModel(int order, double forgettingFactor, double initialCovariance)
+    : order(std::max(1, order)), lambda(std::clamp(forgettingFactor, 0.9, 1.0)),
+      initialCovariance(initialCovariance), lagCount(0), sampleCount(0) {
+    int dimension = this->order + 1;
+    weights.assign(dimension, 0.0);
+    covariance.assign(dimension * dimension, 0.0);
+    lags.assign(this->order, 0.0);
+    regressor.assign(dimension, 0.0);
+    gain.assign(dimension, 0.0);
+    pPhi.assign(dimension, 0.0);
+    reset();
+}
+
+void OnlineARModel::resetCovariance() {
+    int dimension = order + 1;
+    std::fill(covariance.begin(), covariance.end(), 0.0);
+    for (int i = 0; i < dimension; ++i) {
+        covariance[i * dimension + i] = initialCovariance;
+    }
+}
+
+void OnlineARModel::reset() {
+    std::fill(weights.begin(), weights.end(), 0.0);
+    // Start from a random walk (x(t) = x(t-1)) until the data says otherwise
+    weights[1] = 1.0;
+    resetCovariance();
+    std::fill(lags.begin(), lags.end(), 0.0);
+    lagCount = 0;
+    sampleCount = 0;
+    errorStats.reset();
+}
+
+double OnlineARModel::dot(const std::vector<double>& lagValues) const {
+    double value = weights[0];
+    for (int i = 0; i < order; ++i) {
+        value += weights[i + 1] * lagValues[i];
+    }
+    return value;
+}
+
+void OnlineARModel::update(double value) {
+    if (!std::isfinite(value)) return;
+
+    if (lagCount >= order) {
+        int dimension = order + 1;
+
+        regressor[0] = 1.0;
+        for (int i = 0; i < order; ++i) {
+            regressor[i + 1] = lags[i];
+        }
+
+        double predicted = dot(lags);
+        if (isReady()) {
+            errorStats.update(predicted, value);
+        }
+        double error = value - predicted;
+
+        // pPhi = P * phi, denominator = lambda + phi' * P * phi
+        double denominator = lambda;
+        for (int r = 0; r < dimension; ++r) {
+            double sum = 0.0;
+            for (int c = 0; c < dimension; ++c) {
+                sum += covariance[r * dimension + c] * regressor[c];
+            }
+            pPhi[r] = sum;
+            denominator += regressor[r] * sum;
+        }
+
+        if (std::isfinite(denominator) && denominator > 1e-12) {
+            double trace = 0.0;
+            for (int r = 0; r < dimension; ++r) {
+                gain[r] = pPhi[r] / denominator;
+                weights[r] += gain[r] * error;
+            }
+
+            // P = (P - k * (P * phi)') / lambda; P stays symmetric
+            for (int r = 0; r < dimension; ++r) {
+                for (int c = 0; c < dimension; ++c) {
+                    covariance[r * dimension + c] = (covariance[r * dimension + c] - gain[r] * pPhi[c]) / lambda;
+                }
+                trace += covariance[r * dimension + r];
+            }
+
+            // Covariance wind-up under forgetting on flat signals
+            if (!std::isfinite(trace) || trace > 1e12) {
+                resetCovariance();
+            }
+        } else {
+            resetCovariance();
+        }
+    }
+
+    for (int i = order - 1; i > 0; --i) {
+        lags[i] = lags[i - 1];
+    }
+    lags[0] = value;
+    lagCount = std::min(lagCount + 1, order);
+    sampleCount++;
+}
+
+double OnlineARModel::predict(int horizon) const {
+    if (lagCount == 0) return 0.0;
+    if (lagCount < order) return lags[0];
+
+    std::vector<double> window(lags);
+    double next = lags[0];
+
+    for (int step = 0; step < std::max(1, horizon); ++step) {
+        next = dot(window);
+        for (int i = order - 1; i > 0; --i) {
+            window[i] = window[i - 1];
+        }
+        window[0] = next;
+    }
+
+    return next;
+}
+
+std::vector<double> OnlineARModel::forecast(int periods) const {
+    std::vector<double> result;
+    if (periods <= 0) return result;
+    result.reserve(periods);
+
+    if (lagCount < order) {
+        result.assign(periods, lagCount > 0 ? lags[0] : 0.0);
+        return result;
+    }
+
+    std::vector<double> window(lags);
+    for (int step = 0; step < periods; ++step) {
+        double next = dot(window);
+        for (int i = order - 1; i > 0; --i) {
+            window[i] = window[i - 1];
+        }
+        window[0] = next;
+        result.push_back(next);
+    }
+
+    return result;
+}
+
+// PredictionTracker Implementation
+PredictionTracker::PredictionTracker(size_t capacity)
+    : predictions(std::max<size_t>(1, capacity)),
+      actuals(std::max<size_t>(1, capacity)) {
+}
+
+void PredictionTracker::record(double predicted, double actual) {
+    if (!std::isfinite(predicted) || !std::isfinite(actual)) return;
+
+    predictions.push_back(predicted);
+    actuals.push_back(actual);
+}
+
+void PredictionTracker::clear() {
+    predictions.clear();
+    actuals.clear();
+}
+
+double PredictionTracker::predictedAt(size_t index) const {
+    return index < predictions.size() ? predictions[index] : 0.0;
+}
+
+double PredictionTracker::actualAt(size_t index) const {
+    return index < actuals.size() ? actuals[index] : 0.0;
+}
+
+double PredictionTracker::meanAbsoluteError() const {
+    if (predictions.empty()) return 0.0;
+
+    double total = 0.0;
+    for (size_t i = 0; i < predictions.size(); ++i) {
+        total += std::abs(predictions[i] - actuals[i]);
+    }
+    return total / predictions.size();
+}
+
+double PredictionTracker::rootMeanSquaredError() const {
+    if (predictions.empty()) return 0.0;
+
+    double total = 0.0;
+    for (size_t i = 0; i < predictions.size(); ++i) {
+        double error = predictions[i] - actuals[i];
+        total += error * error;
+    }
+    return std::sqrt(total / predictions.size());
+}
+
+double PredictionTracker::actualStandardDeviation() const {
+    return StatsKernels::standardDeviation(actuals);
+}
+
+double PredictionTracker::actualMeanAbsolute() const {
+    if (actuals.empty()) return 0.0;
+
+    double total = 0.0;
+    for (double value : actuals) {
+        total += std::abs(value);
+    }
+    return total / actuals.size();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "ring_buffer.h"
+
+// Live one-step-ahead error of a forecasting model (EWMA of |e| and e^2)
+struct ForecastErrorStats {
+    double meanAbsoluteError;
+    double meanSquaredError;
+    size_t samples;
+
+    ForecastErrorStats() : meanAbsoluteError(0.0), meanSquaredError(0.0), samples(0) {}
+
+    void update(double predicted, double actual, double alpha = 0.1);
+    void reset() { *this = ForecastErrorStats(); }
+};
+
+// Holt-Winters additive model (level/trend/season), O(1) per sample
+class HoltWintersModel {
+public:
+    HoltWintersModel(double alpha = 0.3, double beta = 0.1, double gamma = 0.1, int seasonLength = 8);
+
+    void update(double value);
+    double predict(int horizon = 1) const;
+    std::vector<double> forecast(int periods) const;
+    void reset();
+
+    bool isReady() const { return initialized; }
+    const ForecastErrorStats& getErrorStats() const { return errorStats; }
+
+private:
+    double alpha;
+    double beta;
+    double gamma;
+    int seasonLength;
+
+    bool initialized;
+    double level;
+    double trend;
+    std::vector<double> seasonal;
+    std::vector<double> warmup;     // First season, used to seed level/season
+    size_t sampleCount;
+
+    ForecastErrorStats errorStats;
+};
+
+// Autoregressive AR(p) model with intercept, fitted online by recursive least squares
+class OnlineARModel {
+public:
+    OnlineARModel(int order = 3, double forgettingFactor = 0.98, double initialCovariance = 1000.0);
+
+    void update(double value);
+    double predict(int horizon = 1) const;
+    std::vector<double> forecast(int periods) const;
+    void reset();
+
+    bool isReady() const { return lagCount >= order && sampleCount > static_cast<size_t>(2 * order); }
+    const ForecastErrorStats& getErrorStats() const { return errorStats; }
+    const std::vector<double>& getCoefficients() const { return weights; }
+
+private:
+    int order;
+    double lambda;
+    double initialCovariance;
+
+    std::vector<double> weights;    // [intercept, a1..ap]
+    std::vector<double> covariance; // (p+1)x(p+1), row-major
+    std::vector<double> lags;       // lags[0] = x(t-1)
+    int lagCount;
+    size_t sampleCount;
+
+    // Scratch space so update() never allocates
+    std::vector<double> regressor;
+    std::vector<double> gain;
+    std::vector<double> pPhi;
+
+    ForecastErrorStats errorStats;
+
+    double dot(const std::vector<double>& lagValues) const;
+    void resetCovariance();
+};
+
+// Bounded ring of (prediction, actual) pairs for scoring live forecasts
+class PredictionTracker {
+public:
+    explicit PredictionTracker(size_t capacity = 256);
+
+    void record(double predicted, double actual);
+    void clear();
+
+    size_t size() const { return predictions.size(); }
+    size_t capacity() const { return predictions.capacity(); }
+
+    // Oldest-first access
+    double predictedAt(size_t index) const;
+    double actualAt(size_t index) const;
+
+    double meanAbsoluteError() const;
+    double rootMeanSquaredError() const;
+    double actualStandardDeviation() const;
+    double actualMeanAbsolute() const;
+
+private:
+    RingBuffer<double> predictions;
+    RingBuffer<double> actuals;
+};
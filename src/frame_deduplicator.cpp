@@ -0,0 +1,169 @@
+#include "frame_deduplicator.h"
+#include "file_hasher.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr uint64_t PRIME64_1 = 11400714785074694791ULL;
+constexpr uint64_t PRIME64_2 = 14029467366897019727ULL;
+constexpr uint64_t PRIME64_3 = 1609587929392839161ULL;
+
+// Per-lane key, varied per block by the block's index
+alignas(32) const uint64_t BLOCK_KEY[4] = {
+    0xbe4ba423396cfeb8ULL, 0x1cad21f72c81017cULL, 0xdb979083e96dd4deULL, 0x1f67b3b7a4a44072ULL
+};
+
+uint64_t avalanche(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t shapeOf(const cv::Mat& frame) {
+    return (static_cast<uint64_t>(frame.rows) << 32) ^ (static_cast<uint64_t>(frame.cols) << 8) ^
+           static_cast<uint64_t>(frame.type());
+}
+
+// One 32-byte block into four 64-bit lanes, XXH3-style: each lane adds the product of
+// the halves of (data ^ key) and its neighbouring lane's data. Lanes pair up within
+// each 16 bytes, so AVX2, SSE2 and the scalar version compute the same thing.
+#if defined(__AVX2__)
+struct Accumulator {
+    __m256i lanes = _mm256_load_si256(reinterpret_cast<const __m256i*>(BLOCK_KEY));
+
+    void add(const uint8_t* block, uint64_t index) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        __m256i key = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(BLOCK_KEY)),
+                                       _mm256_set1_epi64x(static_cast<long long>(index * PRIME64_1)));
+        __m256i keyed = _mm256_xor_si256(data, key);
+        __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        lanes = _mm256_add_epi64(lanes, _mm256_add_epi64(product, swapped));
+    }
+
+    void store(uint64_t out[4]) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lanes); }
+};
+#elif defined(__SSE2__) || defined(_M_X64)
+struct Accumulator {
+    __m128i lanes[2] = {_mm_load_si128(reinterpret_cast<const __m128i*>(BLOCK_KEY)),
+                        _mm_load_si128(reinterpret_cast<const __m128i*>(BLOCK_KEY + 2))};
+
+    void add(const uint8_t* block, uint64_t index) {
+        __m128i offset = _mm_set1_epi64x(static_cast<long long>(index * PRIME64_1));
+        for (int half = 0; half < 2; ++half) {
+            __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * half));
+            __m128i key = _mm_xor_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(BLOCK_KEY + 2 * half)), offset);
+            __m128i keyed = _mm_xor_si128(data, key);
+            __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+            lanes[half] = _mm_add_epi64(lanes[half], _mm_add_epi64(product, swapped));
+        }
+    }
+
+    void store(uint64_t out[4]) const {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lanes[0]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2), lanes[1]);
+    }
+};
+#else
+struct Accumulator {
+    uint64_t lanes[4] = {BLOCK_KEY[0], BLOCK_KEY[1], BLOCK_KEY[2], BLOCK_KEY[3]};
+
+    void add(const uint8_t* block, uint64_t index) {
+        uint64_t data[4];
+        std::memcpy(data, block, sizeof(data));
+        for (int lane = 0; lane < 4; ++lane) {
+            uint64_t keyed = data[lane] ^ BLOCK_KEY[lane] ^ (index * PRIME64_1);
+            lanes[lane] += (keyed & 0xffffffffULL) * (keyed >> 32) + data[lane ^ 1];
+        }
+    }
+
+    void store(uint64_t out[4]) const { std::copy(lanes, lanes + 4, out); }
+};
+#endif
+
+} // namespace
+
+// FrameDeduplicator Implementation
+FrameDeduplicator::FrameDeduplicator() {
+    reset();
+}
+
+void FrameDeduplicator::reset() {
+    hasReference = false;
+    referenceSample = 0;
+    referenceFull = 0;
+    referenceFullKnown = false;
+    framesSeen = 0;
+    duplicateFrames = 0;
+    fullHashes = 0;
+}
+
+bool FrameDeduplicator::isDuplicate(const cv::Mat& frame) {
+    ++framesSeen;
+    uint64_t sample = sampleHash(frame);
+    if (!hasReference || sample != referenceSample) {
+        hasReference = true;
+        referenceSample = sample;
+        referenceFullKnown = false;
+        return false;
+    }
+
+    // The sample can miss a small change (a HUD digit between sampled rows)
+    uint64_t full = fullHash(frame);
+    ++fullHashes;
+    if (referenceFullKnown && full == referenceFull) {
+        ++duplicateFrames;
+        return true;
+    }
+    referenceFull = full;
+    referenceFullKnown = true;
+    return false;
+}
+
+uint64_t FrameDeduplicator::sampleHash(const cv::Mat& frame) {
+    size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
+    if (frame.empty() || rowBytes < BLOCK_BYTES) return fullHash(frame);
+
+    int rows = std::min(frame.rows, SAMPLE_ROWS);
+    size_t blocks = std::min<size_t>(SAMPLE_BLOCKS, rowBytes / BLOCK_BYTES);
+    size_t spacing = blocks > 1 ? (rowBytes - BLOCK_BYTES) / (blocks - 1) : 0;
+
+    Accumulator accumulator;
+    uint64_t index = 0;
+    for (int i = 0; i < rows; ++i) {
+        const uint8_t* row = frame.ptr<uint8_t>(static_cast<int>((2LL * i + 1) * frame.rows / (2 * rows)));
+        for (size_t block = 0; block < blocks; ++block) {
+            accumulator.add(row + block * spacing, index++);
+        }
+    }
+
+    uint64_t lanes[4];
+    accumulator.store(lanes);
+    uint64_t hash = shapeOf(frame) * PRIME64_1;
+    for (uint64_t lane : lanes) {
+        hash = (hash ^ avalanche(lane)) * PRIME64_1 + PRIME64_3;
+    }
+    return avalanche(hash);
+}
+
+uint64_t FrameDeduplicator::fullHash(const cv::Mat& frame) {
+    XxHash64 hasher(shapeOf(frame));
+    size_t rowBytes = static_cast<size_t>(frame.cols) * frame.elemSize();
+    if (frame.isContinuous()) {
+        hasher.update(frame.data, rowBytes * frame.rows);
+    } else {
+        for (int y = 0; y < frame.rows; ++y) {
+            hasher.update(frame.ptr<uint8_t>(y), rowBytes);
+        }
+    }
+    return hasher.digest();
+}
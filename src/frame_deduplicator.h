@@ -0,0 +1,48 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Recognises frames identical to the one before (menus, pauses, a game rendering
+// slower than it is captured) so they can skip detection and OCR. Every frame gets
+// a cheap hash of a fixed sparse sample of its pixels; only when that matches the
+// previous frame's is the whole frame hashed (XXH64) to confirm. The first repeat
+// of a frame is therefore still processed, since it is what gives the reference a
+// full hash; from the second on, repeats are reported as duplicates.
+// Not thread-safe: one instance per frame stream.
+class FrameDeduplicator {
+public:
+    static constexpr int SAMPLE_ROWS = 64;          // Evenly spaced rows sampled per frame
+    static constexpr int SAMPLE_BLOCKS = 16;        // Blocks sampled per row
+    static constexpr size_t BLOCK_BYTES = 32;
+
+    FrameDeduplicator();
+
+    void reset();
+
+    // True if frame has the same size, type and pixels as the previous one
+    bool isDuplicate(const cv::Mat& frame);
+
+    uint64_t getFramesSeen() const { return framesSeen; }
+    uint64_t getDuplicateFrames() const { return duplicateFrames; }
+    uint64_t getFullHashes() const { return fullHashes; }
+    double getDuplicateRatio() const { return framesSeen ? static_cast<double>(duplicateFrames) / framesSeen : 0.0; }
+
+    // Hash of SAMPLE_ROWS x SAMPLE_BLOCKS blocks of BLOCK_BYTES (fewer for small frames),
+    // mixed with the frame's size and type. SIMD where available; the same value either way
+    static uint64_t sampleHash(const cv::Mat& frame);
+
+    // XXH64 of every pixel, row by row, mixed with the frame's size and type
+    static uint64_t fullHash(const cv::Mat& frame);
+
+private:
+    bool hasReference;
+    uint64_t referenceSample;
+    uint64_t referenceFull;
+    bool referenceFullKnown;
+
+    uint64_t framesSeen;
+    uint64_t duplicateFrames;
+    uint64_t fullHashes;
+};
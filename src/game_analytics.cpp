@@ -1,18 +1,124 @@
 #include "game_analytics.h"
 #include "cuda_support.h"
 #include "performance_monitor.h"
+#include "stats_kernels.h"
+#include "text_serializer.h"
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <chrono>
 #include <thread>
+#include <limits>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/objdetect.hpp>
 #include <opencv2/dnn.hpp>
 #include <numeric>
 #include <cmath>
 
+namespace {
+
+using EventType = GameEventDetector::EventType;
+using CueSource = GameEventDetector::CueSource;
+
+// How often each cue shows within one fusion window: with the event, and without it.
+// Estimates from the simulator and common HUD conventions; a pair missing here adds nothing
+struct CueEvidence {
+    EventType type;
+    CueSource source;
+    float hitRate;
+    float falseAlarmRate;
+};
+
+const CueEvidence CUE_EVIDENCE[] = {
+    {EventType::DEATH, CueSource::RED_FLASH, 0.90f, 0.010f},
+    {EventType::DEATH, CueSource::HEALTH_ZERO, 0.95f, 0.001f},
+    {EventType::DEATH, CueSource::HEALTH_DROP, 0.90f, 0.100f},
+    {EventType::DEATH, CueSource::SCREEN_SHAKE, 0.30f, 0.100f},
+    {EventType::DEATH, CueSource::OCR_TEXT, 0.70f, 0.005f},
+    {EventType::DEATH, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::LEVEL_UP, CueSource::GOLDEN_FLASH, 0.85f, 0.010f},
+    {EventType::LEVEL_UP, CueSource::OCR_TEXT, 0.70f, 0.005f},
+    {EventType::LEVEL_UP, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::DAMAGE_TAKEN, CueSource::HEALTH_DROP, 0.95f, 0.010f},
+    {EventType::DAMAGE_TAKEN, CueSource::SCREEN_SHAKE, 0.60f, 0.050f},
+    {EventType::DAMAGE_TAKEN, CueSource::RED_INDICATOR, 0.50f, 0.050f},
+    {EventType::DAMAGE_TAKEN, CueSource::RED_FLASH, 0.10f, 0.020f},
+    {EventType::DAMAGE_TAKEN, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::DAMAGE_DEALT, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::KILL, CueSource::OCR_TEXT, 0.70f, 0.005f},
+    {EventType::KILL, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::ITEM_PICKUP, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::ACHIEVEMENT, CueSource::OCR_TEXT, 0.70f, 0.005f},
+    {EventType::ACHIEVEMENT, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::SCORE_CHANGE, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::HEALTH_CHANGE, CueSource::HEALTH_DROP, 0.90f, 0.010f},
+    {EventType::HEALTH_CHANGE, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::AMMO_CHANGE, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::TIME_CHANGE, CueSource::PROFILE_CUE, 0.90f, 0.005f},
+    {EventType::UNKNOWN, CueSource::COLOR_FLASH, 0.60f, 0.400f}
+};
+
+// Chance of each event within one window; anything unlisted is 0.05
+const std::pair<EventType, float> EVENT_BASE_RATES[] = {
+    {EventType::DEATH, 0.02f},
+    {EventType::LEVEL_UP, 0.02f},
+    {EventType::ACHIEVEMENT, 0.01f},
+    {EventType::DAMAGE_TAKEN, 0.10f},
+    {EventType::ANOMALY, 0.0001f},      // Raised by the analytics engine, not from cues
+    {EventType::UNKNOWN, 0.50f}
+};
+
+struct LogOddsTable {
+    float prior[GameEventDetector::EVENT_TYPE_COUNT];
+    float cue[GameEventDetector::EVENT_TYPE_COUNT][GameEventDetector::CUE_SOURCE_COUNT];
+
+    LogOddsTable() : cue() {
+        for (float& value : prior) value = std::log(0.05f / 0.95f);
+        for (const auto& rate : EVENT_BASE_RATES) {
+            prior[static_cast<int>(rate.first)] = std::log(rate.second / (1.0f - rate.second));
+        }
+        for (const auto& evidence : CUE_EVIDENCE) {
+            cue[static_cast<int>(evidence.type)][static_cast<int>(evidence.source)] =
+                std::log(evidence.hitRate / evidence.falseAlarmRate);
+        }
+    }
+};
+
+const LogOddsTable& logOddsTable() {
+    static const LogOddsTable table;
+    return table;
+}
+
+// On-screen text that names an event, matched as whole words; the first match wins
+const std::pair<const char*, EventType> TEXT_CUES[] = {
+    {"LEVEL UP", EventType::LEVEL_UP},
+    {"ACHIEVEMENT", EventType::ACHIEVEMENT},
+    {"KILLED BY", EventType::DEATH},
+    {"YOU DIED", EventType::DEATH},
+    {"GAME OVER", EventType::DEATH},
+    {"WASTED", EventType::DEATH},
+    {"DEFEATED", EventType::DEATH},
+    {"ELIMINATED", EventType::KILL},
+    {"KILL", EventType::KILL}
+};
+
+// "KILL" in "DOUBLE KILL", not in "SKILL", "KILLS: 3" or "KILLSTREAK"
+bool containsWords(const std::string& text, const char* words) {
+    size_t length = std::strlen(words);
+    for (size_t at = text.find(words); at != std::string::npos; at = text.find(words, at + 1)) {
+        bool startsWord = at == 0 || !std::isalnum(static_cast<unsigned char>(text[at - 1]));
+        bool endsWord = at + length == text.size() || !std::isalnum(static_cast<unsigned char>(text[at + length]));
+        if (startsWord && endsWord) return true;
+    }
+    return false;
+}
+
+} // namespace
+
 // GameEventDetector Implementation
 GameEventDetector::GameEventDetector() 
-    : totalEventsDetected(0), falsePositives(0), averageDetectionTime(0.0), isDetecting(false) {
+    : totalEventsDetected(0), falsePositives(0), averageDetectionTime(0.0), fusedReported(),
+      fusionWindowMs(DEFAULT_FUSION_WINDOW_MS), fusionThreshold(DEFAULT_FUSION_THRESHOLD), isDetecting(false) {
     
     // Initialize CUDA support
     useCuda = CudaSupport::isAvailable();
@@ -26,12 +132,25 @@ GameEventDetector::GameEventDetector()
     }
     
     // Initialize game colors
-    gameColors["red"] = cv::Scalar(0, 0, 255);
-    gameColors["green"] = cv::Scalar(0, 255, 0);
-    gameColors["blue"] = cv::Scalar(255, 0, 0);
-    gameColors["yellow"] = cv::Scalar(0, 255, 255);
-    gameColors["white"] = cv::Scalar(255, 255, 255);
-    gameColors["black"] = cv::Scalar(0, 0, 0);
+    detectionConfig.update([](DetectionConfig& config) {
+        config.redColorId = config.addGameColor("red", cv::Scalar(0, 0, 255));
+        config.addGameColor("green", cv::Scalar(0, 255, 0));
+        config.addGameColor("blue", cv::Scalar(255, 0, 0));
+        config.addGameColor("yellow", cv::Scalar(0, 255, 255));
+        config.addGameColor("white", cv::Scalar(255, 255, 255));
+        config.addGameColor("black", cv::Scalar(0, 0, 0));
+    });
+}
+
+int GameEventDetector::DetectionConfig::addGameColor(const std::string& name, const cv::Scalar& color) {
+    for (size_t id = 0; id < gameColors.size(); ++id) {
+        if (gameColors[id].name == name) {
+            gameColors[id].color = color;
+            return static_cast<int>(id);
+        }
+    }
+    gameColors.push_back(GameColor{name, color, name + " flash"});
+    return static_cast<int>(gameColors.size() - 1);
 }
 
 GameEventDetector::~GameEventDetector() {
@@ -61,36 +180,233 @@ std::vector<GameEventDetector::GameEvent> GameEventDetector::detectEvents(const
     auto startTime = std::chrono::high_resolution_clock::now();
     std::vector<GameEvent> events;
     
-    // Detect different types of events
-    auto deathEvents = detectDeaths(frame);
-    auto levelUpEvents = detectLevelUps(frame);
-    auto damageEvents = detectDamage(frame);
-    auto shakeEvents = detectScreenShake(frame);
-    auto colorEvents = detectColorChanges(frame);
-    
-    // Combine all events
-    events.insert(events.end(), deathEvents.begin(), deathEvents.end());
-    events.insert(events.end(), levelUpEvents.begin(), levelUpEvents.end());
-    events.insert(events.end(), damageEvents.begin(), damageEvents.end());
-    events.insert(events.end(), shakeEvents.begin(), shakeEvents.end());
-    events.insert(events.end(), colorEvents.begin(), colorEvents.end());
+    int64_t now = steadyClockMs();
+    std::vector<Cue> frameCues;
+    collectFrameCues(frame, now, frameCues);
+    
+    {
+        std::lock_guard<std::mutex> cueLock(cueMutex);
+        cues.insert(cues.end(), frameCues.begin(), frameCues.end());
+        int64_t horizon = now - fusionWindowMs;
+        cues.erase(std::remove_if(cues.begin(), cues.end(), [horizon](const Cue& cue) {
+            return cue.timestampMs < horizon;
+        }), cues.end());
+        for (auto it = textLastSeenMs.begin(); it != textLastSeenMs.end();) {
+            it = it->second < horizon ? textLastSeenMs.erase(it) : std::next(it);
+        }
+        
+        // One candidate per event type; most have no cues and drop out straight away
+        for (int type = 0; type < EVENT_TYPE_COUNT; ++type) {
+            GameEvent event(static_cast<EventType>(type), eventTypeName(static_cast<EventType>(type)), 0.0f);
+            updateEventConfidence(event, frame);
+            if (event.parameters.empty()) {
+                fusedReported[type] = false;
+                continue;
+            }
+            if (!validateEvent(event, frame)) continue;
+            fusedReported[type] = true;
+            events.push_back(std::move(event));
+        }
+    }
     
     // Update statistics
     auto endTime = std::chrono::high_resolution_clock::now();
     double detectionTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
     
     totalEventsDetected += events.size();
-    averageDetectionTime = (averageDetectionTime * (totalEventsDetected - events.size()) + detectionTime) / totalEventsDetected;
+    if (totalEventsDetected > 0) {
+        averageDetectionTime = (averageDetectionTime * (totalEventsDetected - events.size()) + detectionTime) / totalEventsDetected;
+    }
     
     return events;
 }
 
+void GameEventDetector::collectFrameCues(const cv::Mat& frame, int64_t timestampMs, std::vector<Cue>& frameCues) {
+    if (frame.empty()) return;
+    auto cue = [&](CueSource source, EventType type, const std::string& label, const cv::Rect& region) {
+        frameCues.push_back(Cue{source, type, timestampMs, label, region});
+    };
+    
+    if (detectRedScreenFlash(frame)) cue(CueSource::RED_FLASH, EventType::UNKNOWN, "red flash", cv::Rect());
+    if (detectGoldenEffects(frame)) cue(CueSource::GOLDEN_FLASH, EventType::UNKNOWN, "golden flash", cv::Rect());
+    if (!detectScreenShake(frame).empty()) cue(CueSource::SCREEN_SHAKE, EventType::UNKNOWN, "screen shake", cv::Rect());
+    
+    auto config = detectionConfig.read();
+    if (config->redColorId >= 0 && detectColorFlash(frame, config->gameColors[config->redColorId].color, 0.3f)) {
+        cue(CueSource::RED_INDICATOR, EventType::UNKNOWN, "damage indicator", cv::Rect());
+    }
+    for (const auto& gameColor : config->gameColors) {
+        if (detectColorFlash(frame, gameColor.color, 0.2f)) {
+            cue(CueSource::COLOR_FLASH, EventType::UNKNOWN, gameColor.flashLabel, cv::Rect());
+        }
+    }
+    for (const auto& profileCue : config->profileCues) {
+        cv::Rect area = profileCueArea(profileCue.second, frame);
+        if (area.empty() || !detectColorFlash(frame(area), profileCue.second.color, profileCue.second.threshold)) continue;
+        // A cue whose name maps to no event is just a coloured flash; as a typeless
+        // PROFILE_CUE it would count towards every event
+        if (profileCue.first == EventType::UNKNOWN) {
+            cue(CueSource::COLOR_FLASH, EventType::UNKNOWN, profileCue.second.name, area);
+        } else {
+            cue(CueSource::PROFILE_CUE, profileCue.first, profileCue.second.name, area);
+        }
+    }
+}
+
+int GameEventDetector::registerMemoryValue(const std::string& name) {
+    std::lock_guard<std::mutex> lock(cueMutex);
+    auto it = memoryValueIds.find(name);
+    if (it != memoryValueIds.end()) return it->second;
+    
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+    int id = -1;
+    if (lower.find("health") != std::string::npos || lower == "hp") {
+        id = static_cast<int>(healthValues.size());
+        healthValues.push_back(HealthValue{name + " drop", name + " zero", 0.0, false});
+    }
+    memoryValueIds.emplace(name, id);
+    return id;
+}
+
+void GameEventDetector::observeMemoryValue(const std::string& name, double value, int64_t timestampMs) {
+    observeMemoryValue(registerMemoryValue(name), value, timestampMs);
+}
+
+void GameEventDetector::observeMemoryValue(int valueId, double value, int64_t timestampMs) {
+    if (valueId < 0) return;
+    if (timestampMs == 0) timestampMs = steadyClockMs();
+    
+    std::lock_guard<std::mutex> lock(cueMutex);
+    if (valueId >= static_cast<int>(healthValues.size())) return;
+    HealthValue& health = healthValues[valueId];
+    if (health.seen && value < health.last) {
+        cues.push_back(Cue{CueSource::HEALTH_DROP, EventType::UNKNOWN, timestampMs, health.dropLabel, cv::Rect()});
+        if (value <= 0 && health.last > 0) {
+            cues.push_back(Cue{CueSource::HEALTH_ZERO, EventType::UNKNOWN, timestampMs, health.zeroLabel, cv::Rect()});
+        }
+    }
+    health.last = value;
+    health.seen = true;
+}
+
+void GameEventDetector::observeText(const std::string& text, int64_t timestampMs) {
+    std::string upper = text;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+    for (const auto& textCue : TEXT_CUES) {
+        if (!containsWords(upper, textCue.first)) continue;
+        if (timestampMs == 0) timestampMs = steadyClockMs();
+        {
+            // Text held on screen is one cue, from when it appeared; seeing it again only keeps
+            // it held, so a banner that never goes away cannot keep its event latched
+            std::lock_guard<std::mutex> lock(cueMutex);
+            auto seen = textLastSeenMs.find(upper);
+            bool held = seen != textLastSeenMs.end() && timestampMs - seen->second <= fusionWindowMs;
+            textLastSeenMs[upper] = timestampMs;
+            if (held) return;
+        }
+        addCue(CueSource::OCR_TEXT, textCue.second, "\"" + text + "\"", timestampMs);
+        return;
+    }
+}
+
+void GameEventDetector::addCue(CueSource source, EventType type, const std::string& label, int64_t timestampMs) {
+    if (timestampMs == 0) timestampMs = steadyClockMs();
+    std::lock_guard<std::mutex> lock(cueMutex);
+    cues.push_back(Cue{source, type, timestampMs, label, cv::Rect()});
+}
+
+void GameEventDetector::setFusionWindowMs(int64_t windowMs) {
+    std::lock_guard<std::mutex> lock(cueMutex);
+    fusionWindowMs = std::max<int64_t>(1, windowMs);
+}
+
+void GameEventDetector::setFusionThreshold(float confidence) {
+    std::lock_guard<std::mutex> lock(cueMutex);
+    fusionThreshold = confidence;
+}
+
+float GameEventDetector::cueLogOdds(EventType type, CueSource source) {
+    return logOddsTable().cue[static_cast<int>(type)][static_cast<int>(source)];
+}
+
+float GameEventDetector::priorLogOdds(EventType type) {
+    return logOddsTable().prior[static_cast<int>(type)];
+}
+
+float GameEventDetector::cueConfidence(EventType type, CueSource source) {
+    return 1.0f / (1.0f + std::exp(-(priorLogOdds(type) + cueLogOdds(type, source))));
+}
+
+const char* GameEventDetector::cueSourceName(CueSource source) {
+    switch (source) {
+        case CueSource::RED_FLASH: return "red_flash";
+        case CueSource::GOLDEN_FLASH: return "golden_flash";
+        case CueSource::SCREEN_SHAKE: return "screen_shake";
+        case CueSource::RED_INDICATOR: return "red_indicator";
+        case CueSource::COLOR_FLASH: return "color_flash";
+        case CueSource::PROFILE_CUE: return "profile_cue";
+        case CueSource::HEALTH_DROP: return "health_drop";
+        case CueSource::HEALTH_ZERO: return "health_zero";
+        case CueSource::OCR_TEXT: return "ocr_text";
+        case CueSource::COUNT: break;
+    }
+    return "unknown";
+}
+
+void GameEventDetector::updateEventConfidence(GameEvent& event, const cv::Mat& frame) {
+    // Naive Bayes: cues are taken as independent given the event, so their log-odds add.
+    // Repeats of one kind (a flash over several frames) are not independent and count once
+    bool counted[CUE_SOURCE_COUNT] = {};
+    float logOdds = priorLogOdds(event.type);
+    int64_t firstCueMs = 0;
+    std::string labels;
+    cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    
+    for (const auto& cue : cues) {
+        if (cue.type != EventType::UNKNOWN && cue.type != event.type) continue;
+        int source = static_cast<int>(cue.source);
+        float weight = cueLogOdds(event.type, cue.source);
+        if (weight == 0.0f || counted[source]) continue;
+        counted[source] = true;
+        
+        logOdds += weight;
+        event.parameters[cueSourceName(cue.source)] = weight;
+        if (firstCueMs == 0 || cue.timestampMs < firstCueMs) firstCueMs = cue.timestampMs;
+        if (event.region.empty()) event.region = cue.region & frameRect;
+        labels += labels.empty() ? cue.label : " + " + cue.label;
+    }
+    if (labels.empty()) return;
+    
+    event.confidence = 1.0f / (1.0f + std::exp(-logOdds));
+    event.timestamp = firstCueMs;
+    event.description = std::string(eventTypeName(event.type)) + ": " + labels;
+}
+
+bool GameEventDetector::validateEvent(const GameEvent& event, const cv::Mat& frame) {
+    if (event.confidence < fusionThreshold) return false;
+    if (!event.region.empty() && (event.region & cv::Rect(0, 0, frame.cols, frame.rows)) != event.region) return false;
+    return !fusedReported[static_cast<int>(event.type)];
+}
+
+cv::Rect GameEventDetector::profileCueArea(const VisualCue& cue, const cv::Mat& frame) {
+    cv::Rect frameRect(0, 0, frame.cols, frame.rows);
+    return cv::Rect(cvRound(cue.relativeRegion.x * frame.cols), cvRound(cue.relativeRegion.y * frame.rows),
+                    cvRound(cue.relativeRegion.width * frame.cols),
+                    cvRound(cue.relativeRegion.height * frame.rows)) & frameRect;
+}
+
+int64_t GameEventDetector::steadyClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 std::vector<GameEventDetector::GameEvent> GameEventDetector::detectDeaths(const cv::Mat& frame) {
     std::vector<GameEvent> events;
     
     // Detect red screen flash (common death indicator)
     if (detectRedScreenFlash(frame)) {
-        GameEvent event(EventType::DEATH, "Player death detected", 0.8f);
+        GameEvent event(EventType::DEATH, "Player death detected", cueConfidence(EventType::DEATH, CueSource::RED_FLASH));
         events.push_back(event);
     }
     
@@ -105,7 +421,7 @@ std::vector<GameEventDetector::GameEvent> GameEventDetector::detectLevelUps(cons
     
     // Detect golden effects (common level up indicator)
     if (detectGoldenEffects(frame)) {
-        GameEvent event(EventType::LEVEL_UP, "Level up detected", 0.7f);
+        GameEvent event(EventType::LEVEL_UP, "Level up detected", cueConfidence(EventType::LEVEL_UP, CueSource::GOLDEN_FLASH));
         events.push_back(event);
     }
     
@@ -124,8 +440,10 @@ std::vector<GameEventDetector::GameEvent> GameEventDetector::detectDamage(const
     }
     
     // Detect red damage indicators
-    if (detectColorFlash(frame, gameColors["red"], 0.3f)) {
-        GameEvent event(EventType::DAMAGE_TAKEN, "Damage indicator detected", 0.6f);
+    auto config = detectionConfig.read();
+    if (config->redColorId >= 0 && detectColorFlash(frame, config->gameColors[config->redColorId].color, 0.3f)) {
+        GameEvent event(EventType::DAMAGE_TAKEN, "Damage indicator detected",
+                        cueConfidence(EventType::DAMAGE_TAKEN, CueSource::RED_INDICATOR));
         events.push_back(event);
     }
     
@@ -162,10 +480,27 @@ std::vector<GameEventDetector::GameEvent> GameEventDetector::detectScreenShake(c
 std::vector<GameEventDetector::GameEvent> GameEventDetector::detectColorChanges(const cv::Mat& frame) {
     std::vector<GameEvent> events;
     
+    auto config = detectionConfig.read();
+    
     // Detect various color flashes that might indicate game events
-    for (const auto& colorPair : gameColors) {
-        if (detectColorFlash(frame, colorPair.second, 0.2f)) {
-            GameEvent event(EventType::UNKNOWN, "Color flash detected: " + colorPair.first, 0.5f);
+    for (const auto& gameColor : config->gameColors) {
+        if (detectColorFlash(frame, gameColor.color, 0.2f)) {
+            GameEvent event(EventType::UNKNOWN, "Color flash detected: " + gameColor.name,
+                            cueConfidence(EventType::UNKNOWN, CueSource::COLOR_FLASH));
+            events.push_back(event);
+        }
+    }
+    
+    // Profile cues only look at their own HUD area
+    for (const auto& profileCue : config->profileCues) {
+        const VisualCue& cue = profileCue.second;
+        cv::Rect area = profileCueArea(cue, frame);
+        if (area.empty()) continue;
+        
+        if (detectColorFlash(frame(area), cue.color, cue.threshold)) {
+            GameEvent event(profileCue.first, "Profile cue detected: " + cue.name,
+                            cueConfidence(profileCue.first, CueSource::PROFILE_CUE));
+            event.region = area;
             events.push_back(event);
         }
     }
@@ -283,8 +618,45 @@ void GameEventDetector::loadDefaultVisualCues() {
 }
 
 void GameEventDetector::addVisualCue(const VisualCue& cue, EventType eventType) {
-    visualCues.push_back(cue);
-    eventCues[eventType].push_back(cue);
+    detectionConfig.update([&](DetectionConfig& config) {
+        config.visualCues.push_back(cue);
+        config.eventCues[eventType].push_back(cue);
+    });
+}
+
+void GameEventDetector::applyProfile(const ProfileDefinition& profile) {
+    std::vector<std::pair<EventType, VisualCue>> profileCues;
+    for (const auto& source : profile.cues) {
+        VisualCue cue;
+        cue.name = source.name;
+        cue.color = cv::Scalar(source.blue, source.green, source.red);
+        cue.relativeRegion = cv::Rect2f(source.x, source.y, source.width, source.height);
+        cue.threshold = source.threshold;
+        cue.duration = source.durationMs;
+        profileCues.emplace_back(eventTypeForCue(source.name), cue);
+    }
+    
+    // Built off to the side; readers switch over on their next frame
+    detectionConfig.update([&](DetectionConfig& config) {
+        config.profileCues.swap(profileCues);
+        config.profileName = profile.name;
+    });
+}
+
+GameEventDetector::EventType GameEventDetector::eventTypeForCue(const std::string& cueName) {
+    std::string name = cueName;
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+    
+    if (name.find("death") != std::string::npos || name.find("dead") != std::string::npos) return EventType::DEATH;
+    if (name.find("level") != std::string::npos) return EventType::LEVEL_UP;
+    if (name.find("damage") != std::string::npos || name.find("hit") != std::string::npos) return EventType::DAMAGE_TAKEN;
+    if (name.find("kill") != std::string::npos) return EventType::KILL;
+    if (name.find("pickup") != std::string::npos || name.find("item") != std::string::npos) return EventType::ITEM_PICKUP;
+    if (name.find("achievement") != std::string::npos) return EventType::ACHIEVEMENT;
+    if (name.find("score") != std::string::npos) return EventType::SCORE_CHANGE;
+    if (name.find("health") != std::string::npos) return EventType::HEALTH_CHANGE;
+    if (name.find("ammo") != std::string::npos) return EventType::AMMO_CHANGE;
+    return EventType::UNKNOWN;
 }
 
 double GameEventDetector::getDetectionAccuracy() const {
@@ -313,36 +685,67 @@ void GameFingerprinting::cleanup() {
     templateMatcher.release();
 }
 
+#ifdef _WIN32
 GameFingerprinting::FingerprintMatch GameFingerprinting::identifyGame(HWND hwnd) {
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    std::string processName = getProcessNameFromHWND(hwnd);
+    std::string processPath = getProcessPathFromHWND(hwnd);
+    size_t lastSlash = processPath.find_last_of("\\/");
+    std::string processName = (lastSlash != std::string::npos) ? processPath.substr(lastSlash + 1) : processPath;
     std::string windowTitle = getWindowTitleFromHWND(hwnd);
     
+    // Hashing is only worth it when some profile carries a hash; repeats come from the cache
+    std::string executableHash;
+    if (!hashMap.empty() && !processPath.empty()) {
+        executableHash = calculateExecutableHash(processPath);
+    }
+    
     // Try different identification methods
+    float hashMatch = executableHash.empty() ? 0.0f : matchByExecutableHash(executableHash);
     float processMatch = matchByProcessName(processName);
     float titleMatch = matchByWindowTitle(windowTitle);
     
     FingerprintMatch bestMatch;
     
-    if (processMatch > 0.8f) {
+    if (hashMatch > 0.0f) {
+        bestMatch = FingerprintMatch(hashMap[executableHash], hashMatch, "Executable Hash");
+    } else if (processMatch > 0.8f) {
         bestMatch = FingerprintMatch(getProfileByProcessName(processName), processMatch, "Process Name");
     } else if (titleMatch > 0.7f) {
         bestMatch = FingerprintMatch(getProfileByWindowTitle(windowTitle), titleMatch, "Window Title");
     }
     
-    // Update statistics
     auto endTime = std::chrono::high_resolution_clock::now();
-    double fingerprintTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    recordFingerprint(std::chrono::duration<double, std::milli>(endTime - startTime).count(), bestMatch);
+    
+    return bestMatch;
+}
+#endif
+
+GameFingerprinting::FingerprintMatch GameFingerprinting::identifyGame(const cv::Mat& uiScreenshot) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    FingerprintMatch bestMatch;
+    VisualDescriptorIndex::Match match = visualIndex.nearest(VisualDescriptor::compute(uiScreenshot),
+                                                             VISUAL_MATCH_DISTANCE);
+    if (match.found() && match.id < gameDatabase.size()) {
+        float confidence = 1.0f - static_cast<float>(match.distance) / VISUAL_MATCH_DISTANCE;
+        bestMatch = FingerprintMatch(gameDatabase[match.id], confidence, "Visual Descriptor");
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    recordFingerprint(std::chrono::duration<double, std::milli>(endTime - startTime).count(), bestMatch);
     
+    return bestMatch;
+}
+
+void GameFingerprinting::recordFingerprint(double fingerprintTime, const FingerprintMatch& match) {
     totalFingerprints++;
-    if (bestMatch.confidence > 0.5f) {
+    if (match.confidence > 0.5f) {
         successfulMatches++;
     }
     
     averageFingerprintTime = (averageFingerprintTime * (totalFingerprints - 1) + fingerprintTime) / totalFingerprints;
-    
-    return bestMatch;
 }
 
 void GameFingerprinting::loadGameDatabase() {
@@ -368,13 +771,102 @@ void GameFingerprinting::loadTop50GamesDatabase() {
         GameProfile profile(gameName);
         profile.executableName = gameName + ".exe";
         profile.windowTitle = gameName;
-        
-        // Add to maps
-        processNameMap[profile.executableName] = profile;
-        windowTitleMap[profile.windowTitle] = profile;
-        
-        gameDatabase.push_back(profile);
+        addGameProfile(profile);
+    }
+}
+
+void GameFingerprinting::addGameProfile(const GameProfile& profile) {
+    processNameMap[profile.executableName] = profile;
+    windowTitleMap[profile.windowTitle] = profile;
+    if (!profile.executableHash.empty()) {
+        hashMap[profile.executableHash] = profile;
+    }
+    
+    // Both indexes get every profile so their ids stay aligned with gameDatabase
+    processNameIndex.add(profile.executableName);
+    windowTitleIndex.add(profile.windowTitle);
+    if (!profile.uiTemplate.empty()) {
+        visualIndex.add(VisualDescriptor::compute(profile.uiTemplate), gameDatabase.size());
+    }
+    for (const auto& descriptor : profile.visualDescriptors) {
+        visualIndex.add(descriptor, gameDatabase.size());
+    }
+    gameDatabase.push_back(profile);
+}
+
+size_t GameFingerprinting::loadProfileDatabase(const ProfileDatabase& database) {
+    static_assert(ProfileDefinition::VISUAL_DESCRIPTOR_BYTES == VisualDescriptor::SERIALIZED_BYTES,
+                  "@visual records hold one serialized VisualDescriptor");
+    for (size_t i = 0; i < database.size(); ++i) {
+        ProfileDatabase::ProfileView view = database.profile(i);
+        if (!view.valid()) continue;
+        GameProfile profile(view.name());
+        profile.executableName = view.executable();
+        profile.windowTitle = view.windowTitle()[0] ? view.windowTitle() : view.name();
+        profile.executableHash = view.executableHash();
+        for (size_t visual = 0; visual < view.visualCount(); ++visual) {
+            profile.visualDescriptors.push_back(VisualDescriptor::deserialize(view.visual(visual).descriptor));
+        }
+        addGameProfile(profile);
+    }
+    return database.size();
+}
+
+bool GameFingerprinting::addVisualDescriptor(const std::string& gameName, const VisualDescriptor& descriptor) {
+    // Latest profile of that name, matching what the name maps resolve to
+    for (size_t i = gameDatabase.size(); i-- > 0;) {
+        if (gameDatabase[i].name == gameName) {
+            visualIndex.add(descriptor, i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<cv::Scalar> GameFingerprinting::extractColorPalette(const cv::Mat& screenshot) {
+    return VisualDescriptor::compute(screenshot).dominantColors();
+}
+
+float GameFingerprinting::matchByUITemplate(const cv::Mat& template_) {
+    VisualDescriptorIndex::Match match = visualIndex.nearest(VisualDescriptor::compute(template_),
+                                                             VISUAL_MATCH_DISTANCE);
+    return match.found() ? 1.0f - static_cast<float>(match.distance) / VISUAL_MATCH_DISTANCE : 0.0f;
+}
+
+float GameFingerprinting::matchByColorPalette(const std::vector<cv::Scalar>& palette) {
+    float bestSimilarity = 0.0f;
+    for (const auto& profile : gameDatabase) {
+        if (profile.colorPalette.empty()) continue;
+        bestSimilarity = std::max(bestSimilarity, calculateColorPaletteSimilarity(palette, profile.colorPalette));
     }
+    return bestSimilarity;
+}
+
+float GameFingerprinting::calculateTemplateSimilarity(const cv::Mat& template1, const cv::Mat& template2) {
+    int distance = VisualDescriptor::distance(VisualDescriptor::compute(template1), VisualDescriptor::compute(template2));
+    return 1.0f - static_cast<float>(distance) / VisualDescriptor::MAX_DISTANCE;
+}
+
+float GameFingerprinting::calculateColorPaletteSimilarity(const std::vector<cv::Scalar>& palette1,
+                                                          const std::vector<cv::Scalar>& palette2) {
+    if (palette1.empty() || palette2.empty()) return 0.0f;
+    
+    // Mean distance from each colour to its closest counterpart, in both directions
+    auto meanNearest = [](const std::vector<cv::Scalar>& from, const std::vector<cv::Scalar>& to) {
+        double total = 0.0;
+        for (const auto& color : from) {
+            double closest = std::numeric_limits<double>::max();
+            for (const auto& candidate : to) {
+                closest = std::min(closest, cv::norm(color - candidate));
+            }
+            total += closest;
+        }
+        return total / from.size();
+    };
+    
+    const double maxColorDistance = std::sqrt(3.0) * 255.0;
+    double meanDistance = 0.5 * (meanNearest(palette1, palette2) + meanNearest(palette2, palette1));
+    return static_cast<float>(std::max(0.0, 1.0 - meanDistance / maxColorDistance));
 }
 
 float GameFingerprinting::matchByProcessName(const std::string& processName) {
@@ -383,15 +875,8 @@ float GameFingerprinting::matchByProcessName(const std::string& processName) {
         return 1.0f; // Exact match
     }
     
-    // Fuzzy matching
-    for (const auto& pair : processNameMap) {
-        if (pair.first.find(processName) != std::string::npos ||
-            processName.find(pair.first) != std::string::npos) {
-            return 0.8f;
-        }
-    }
-    
-    return 0.0f;
+    // Fuzzy matching over the trigram index
+    return processNameIndex.bestMatch(processName, FUZZY_MIN_SCORE).score;
 }
 
 float GameFingerprinting::matchByWindowTitle(const std::string& windowTitle) {
@@ -400,15 +885,8 @@ float GameFingerprinting::matchByWindowTitle(const std::string& windowTitle) {
         return 1.0f; // Exact match
     }
     
-    // Fuzzy matching
-    for (const auto& pair : windowTitleMap) {
-        if (pair.first.find(windowTitle) != std::string::npos ||
-            windowTitle.find(pair.first) != std::string::npos) {
-            return 0.7f;
-        }
-    }
-    
-    return 0.0f;
+    // Fuzzy matching; normalisation strips version strings and FPS counters
+    return windowTitleIndex.bestMatch(windowTitle, FUZZY_MIN_SCORE).score;
 }
 
 GameFingerprinting::GameProfile GameFingerprinting::getProfileByProcessName(const std::string& processName) {
@@ -416,7 +894,7 @@ GameFingerprinting::GameProfile GameFingerprinting::getProfileByProcessName(cons
     if (it != processNameMap.end()) {
         return it->second;
     }
-    return GameProfile("Unknown");
+    return getProfileByIndex(processNameIndex, processName);
 }
 
 GameFingerprinting::GameProfile GameFingerprinting::getProfileByWindowTitle(const std::string& windowTitle) {
@@ -424,10 +902,42 @@ GameFingerprinting::GameProfile GameFingerprinting::getProfileByWindowTitle(cons
     if (it != windowTitleMap.end()) {
         return it->second;
     }
+    return getProfileByIndex(windowTitleIndex, windowTitle);
+}
+
+GameFingerprinting::GameProfile GameFingerprinting::getProfileByIndex(const TrigramIndex& index,
+                                                                      const std::string& query) {
+    TrigramIndex::Candidate candidate = index.bestMatch(query, FUZZY_MIN_SCORE);
+    if (candidate.score > 0.0f && candidate.id < gameDatabase.size()) {
+        return gameDatabase[candidate.id];
+    }
     return GameProfile("Unknown");
 }
 
-std::string GameFingerprinting::getProcessNameFromHWND(HWND hwnd) {
+std::string GameFingerprinting::calculateExecutableHash(const std::string& executablePath) {
+    return calculateFileHash(executablePath);
+}
+
+std::string GameFingerprinting::calculateFileHash(const std::string& filePath) {
+    FileDigest digest;
+    if (!hashCache.getDigest(filePath, false, digest)) {
+        return "";
+    }
+    return digest.xxh64;
+}
+
+std::string GameFingerprinting::calculateMD5Hash(const std::string& data) {
+    Md5 md5;
+    md5.update(data.data(), data.size());
+    return md5.hexDigest();
+}
+
+float GameFingerprinting::matchByExecutableHash(const std::string& hash) {
+    return hashMap.find(hash) != hashMap.end() ? 1.0f : 0.0f;
+}
+
+#ifdef _WIN32
+std::string GameFingerprinting::getProcessPathFromHWND(HWND hwnd) {
     DWORD processId;
     GetWindowThreadProcessId(hwnd, &processId);
     
@@ -439,20 +949,25 @@ std::string GameFingerprinting::getProcessNameFromHWND(HWND hwnd) {
     
     if (QueryFullProcessImageNameA(hProcess, 0, processName, &size)) {
         CloseHandle(hProcess);
-        std::string fullPath(processName);
-        size_t lastSlash = fullPath.find_last_of("\\/");
-        return (lastSlash != std::string::npos) ? fullPath.substr(lastSlash + 1) : fullPath;
+        return std::string(processName);
     }
     
     CloseHandle(hProcess);
     return "";
 }
 
+std::string GameFingerprinting::getProcessNameFromHWND(HWND hwnd) {
+    std::string fullPath = getProcessPathFromHWND(hwnd);
+    size_t lastSlash = fullPath.find_last_of("\\/");
+    return (lastSlash != std::string::npos) ? fullPath.substr(lastSlash + 1) : fullPath;
+}
+
 std::string GameFingerprinting::getWindowTitleFromHWND(HWND hwnd) {
     char title[256];
     GetWindowTextA(hwnd, title, sizeof(title));
     return std::string(title);
 }
+#endif
 
 double GameFingerprinting::getMatchAccuracy() const {
     if (totalFingerprints == 0) return 0.0;
@@ -461,8 +976,14 @@ double GameFingerprinting::getMatchAccuracy() const {
 
 // BloombergAnalyticsEngine Implementation
 BloombergAnalyticsEngine::BloombergAnalyticsEngine() 
-    : lookbackPeriod(20), smoothingFactor(0.1), volatilityThreshold(0.2),
+    : performanceHistory(20 * HISTORY_LOOKBACK_MULTIPLE), timeSeries(20 * HISTORY_LOOKBACK_MULTIPLE),
+      eventHistory(EVENT_HISTORY_CAPACITY), rsiHistory(20 * HISTORY_LOOKBACK_MULTIPLE),
+      macdHistory(20 * HISTORY_LOOKBACK_MULTIPLE), volatilityHistory(20 * HISTORY_LOOKBACK_MULTIPLE),
+      pendingPrediction(0.0), hasPendingPrediction(false),
+      performanceSeriesId(anomalyMonitor.registerSeries("performance")),
+      lookbackPeriod(20), smoothingFactor(0.1), volatilityThreshold(0.2),
       totalCalculations(0), averageCalculationTime(0.0) {
+    compileSignalRules();
 }
 
 BloombergAnalyticsEngine::~BloombergAnalyticsEngine() {
@@ -472,6 +993,22 @@ BloombergAnalyticsEngine::~BloombergAnalyticsEngine() {
 bool BloombergAnalyticsEngine::initialize(int lookback, double smoothing) {
     lookbackPeriod = lookback;
     smoothingFactor = smoothing;
+    
+    // History windows follow the lookback; existing samples are kept newest first
+    size_t historyCapacity = static_cast<size_t>(std::max(1, lookback * HISTORY_LOOKBACK_MULTIPLE));
+    performanceHistory.setCapacity(historyCapacity);
+    timeSeries.setCapacity(historyCapacity);
+    rsiHistory.setCapacity(historyCapacity);
+    macdHistory.setCapacity(historyCapacity);
+    volatilityHistory.setCapacity(historyCapacity);
+    
+    indicators = StreamingIndicators(14, 12, 26, smoothing, historyCapacity);
+    
+    // Season length tracks the lookback so a full cycle fits in the history window
+    holtWinters = HoltWintersModel(0.3, 0.1, 0.1, std::max(2, lookback / 2));
+    arModel = OnlineARModel(3, 0.98);
+    predictionTracker.clear();
+    hasPendingPrediction = false;
     return true;
 }
 
@@ -480,14 +1017,64 @@ void BloombergAnalyticsEngine::cleanup() {
 }
 
 void BloombergAnalyticsEngine::addPerformanceData(double performance, int64_t timestamp) {
+    // Score the forecast made before this sample arrived
+    if (hasPendingPrediction) {
+        predictionTracker.record(pendingPrediction, performance);
+    }
+    
+    // Ring buffers drop the oldest sample once the lookback window is full
     performanceHistory.push_back(performance);
-    timeSeries.push_back(timestamp);
+    timeSeries.push_back(static_cast<double>(timestamp));
+    
+    // O(1) model updates; each model tracks its own live one-step error
+    holtWinters.update(performance);
+    arModel.update(performance);
+    anomalyMonitor.observe(performanceSeriesId, performance, timestamp);
+    indicators.update(performance);
+    
+    pendingPrediction = predictNextPerformance();
+    hasPendingPrediction = true;
+}
+
+void BloombergAnalyticsEngine::observeSeries(size_t seriesId, double value, int64_t timestamp) {
+    anomalyMonitor.observe(seriesId, value, timestamp);
+}
+
+void BloombergAnalyticsEngine::observeSeries(const std::string& series, double value, int64_t timestamp) {
+    anomalyMonitor.observe(series, value, timestamp);
+}
+
+std::vector<GameEventDetector::GameEvent> BloombergAnalyticsEngine::drainAnomalyEvents() {
+    std::vector<GameEventDetector::GameEvent> events;
+    
+    // Analytics series first, then pipeline timings from the PerformanceMonitor
+    for (const auto& anomaly : anomalyMonitor.drainEvents()) {
+        events.push_back(toGameEvent(anomaly));
+    }
+    for (const auto& anomaly : PerformanceMonitor::getInstance().drainAnomalies()) {
+        events.push_back(toGameEvent(anomaly));
+    }
     
-    // Keep only recent data
-    if (performanceHistory.size() > lookbackPeriod * 2) {
-        performanceHistory.erase(performanceHistory.begin());
-        timeSeries.erase(timeSeries.begin());
+    for (const auto& event : events) {
+        eventHistory.push_back(event);
     }
+    return events;
+}
+
+GameEventDetector::GameEvent BloombergAnalyticsEngine::toGameEvent(const AnomalyEvent& anomaly) {
+    std::string description = std::string(AnomalyEvent::detectorName(anomaly.detector)) + " anomaly on " +
+                              anomaly.series + (anomaly.upward ? " (up)" : " (down)");
+    
+    // Map the detector statistic onto (0, 1] so stronger deviations read as more confident
+    float confidence = static_cast<float>(1.0 - 1.0 / (1.0 + std::abs(anomaly.score) / 3.0));
+    
+    GameEventDetector::GameEvent event(GameEventDetector::EventType::ANOMALY, description, confidence);
+    event.timestamp = anomaly.timestamp;
+    event.parameters["value"] = static_cast<float>(anomaly.value);
+    event.parameters["baseline"] = static_cast<float>(anomaly.baseline);
+    event.parameters["score"] = static_cast<float>(anomaly.score);
+    event.parameters["detector"] = static_cast<float>(anomaly.detector);
+    return event;
 }
 
 BloombergAnalyticsEngine::PerformanceMetrics BloombergAnalyticsEngine::calculateMetrics() {
@@ -505,6 +1092,10 @@ BloombergAnalyticsEngine::PerformanceMetrics BloombergAnalyticsEngine::calculate
     metrics.volatility = calculateVolatility();
     metrics.sharpeRatio = calculateSharpeRatio();
     
+    rsiHistory.push_back(metrics.rsi);
+    macdHistory.push_back(metrics.macd);
+    volatilityHistory.push_back(metrics.volatility);
+    
     // Calculate performance indices
     metrics.consistencyIndex = calculateConsistencyIndex();
     metrics.improvementIndex = calculateImprovementIndex();
@@ -534,6 +1125,8 @@ double BloombergAnalyticsEngine::calculateRSI(int period) {
     if (performanceHistory.size() < period + 1) return 50.0;
     
     std::vector<double> gains, losses;
+    gains.reserve(performanceHistory.size());
+    losses.reserve(performanceHistory.size());
     
     for (size_t i = 1; i < performanceHistory.size(); ++i) {
         double change = performanceHistory[i] - performanceHistory[i-1];
@@ -546,8 +1139,8 @@ double BloombergAnalyticsEngine::calculateRSI(int period) {
         }
     }
     
-    double avgGain = calculateEMA(gains, period, smoothingFactor);
-    double avgLoss = calculateEMA(losses, period, smoothingFactor);
+    double avgGain = calculateEMA(SpanView<const double>(gains), period, smoothingFactor);
+    double avgLoss = calculateEMA(SpanView<const double>(losses), period, smoothingFactor);
     
     if (avgLoss == 0) return 100.0;
     
@@ -567,8 +1160,7 @@ double BloombergAnalyticsEngine::calculateMACD(int fastPeriod, int slowPeriod, i
 double BloombergAnalyticsEngine::calculateVolatility(int period) {
     if (performanceHistory.size() < period) return 0.0;
     
-    std::vector<double> recentData = getRecentData(period);
-    return calculateStandardDeviation(recentData);
+    return StatsKernels::standardDeviation(performanceHistory.segments().last(period));
 }
 
 double BloombergAnalyticsEngine::calculateSharpeRatio(double riskFreeRate) {
@@ -585,15 +1177,8 @@ double BloombergAnalyticsEngine::calculateSharpeRatio(double riskFreeRate) {
 double BloombergAnalyticsEngine::calculateConsistencyIndex() {
     if (performanceHistory.size() < 2) return 0.0;
     
-    double mean = calculateSimpleAverage(performanceHistory);
-    double variance = 0.0;
-    
-    for (double value : performanceHistory) {
-        variance += (value - mean) * (value - mean);
-    }
-    variance /= performanceHistory.size();
-    
-    double standardDeviation = std::sqrt(variance);
+    double mean = StatsKernels::mean(performanceHistory);
+    double standardDeviation = StatsKernels::standardDeviation(performanceHistory, false);
     
     // Consistency is inverse of coefficient of variation
     return mean > 0 ? 1.0 / (1.0 + standardDeviation / mean) : 0.0;
@@ -633,200 +1218,291 @@ std::vector<double> BloombergAnalyticsEngine::detectPerformanceCycles() {
 double BloombergAnalyticsEngine::calculateTrendDirection() {
     if (performanceHistory.size() < 2) return 0.0;
     
-    // Simple linear regression
-    double n = performanceHistory.size();
-    double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
-    
-    for (size_t i = 0; i < performanceHistory.size(); ++i) {
-        double x = static_cast<double>(i);
-        double y = performanceHistory[i];
-        
-        sumX += x;
-        sumY += y;
-        sumXY += x * y;
-        sumXX += x * x;
-    }
-    
-    double slope = (n * sumXY - sumX * sumY) / (n * sumXX - sumX * sumX);
-    return slope;
+    // Least-squares slope against sample index
+    return StatsKernels::linearTrend(performanceHistory).slope;
 }
 
 double BloombergAnalyticsEngine::predictNextPerformance() {
     if (performanceHistory.empty()) return 0.0;
     
-    // Use exponential smoothing for prediction
-    return exponentialSmoothing(performanceHistory, smoothingFactor);
+    // Fall back to exponential smoothing until a model has warmed up
+    if (!holtWinters.isReady() && !arModel.isReady()) {
+        return exponentialSmoothing(performanceHistory, smoothingFactor);
+    }
+    
+    return blendModelForecast(holtWinters.predict(1), arModel.predict(1));
 }
 
 std::vector<double> BloombergAnalyticsEngine::generateForecast(int periods) {
     std::vector<double> forecast;
     
-    if (performanceHistory.empty()) return forecast;
+    if (performanceHistory.empty() || periods <= 0) return forecast;
     
-    double currentValue = performanceHistory.back();
-    double trend = calculateTrendDirection();
+    if (!holtWinters.isReady() && !arModel.isReady()) {
+        forecast.assign(periods, exponentialSmoothing(performanceHistory, smoothingFactor));
+        return forecast;
+    }
+    
+    std::vector<double> seasonalForecast = holtWinters.forecast(periods);
+    std::vector<double> autoregressiveForecast = arModel.forecast(periods);
     
-    for (int i = 1; i <= periods; ++i) {
-        double predictedValue = currentValue + (trend * i);
-        forecast.push_back(predictedValue);
+    forecast.reserve(periods);
+    for (int i = 0; i < periods; ++i) {
+        forecast.push_back(blendModelForecast(seasonalForecast[i], autoregressiveForecast[i]));
     }
     
     return forecast;
 }
 
+double BloombergAnalyticsEngine::blendModelForecast(double holtWintersValue, double autoregressiveValue) const {
+    bool seasonalReady = holtWinters.isReady() && holtWinters.getErrorStats().samples > 0;
+    bool autoregressiveReady = arModel.isReady() && arModel.getErrorStats().samples > 0;
+    
+    if (seasonalReady && !autoregressiveReady) return holtWintersValue;
+    if (autoregressiveReady && !seasonalReady) return autoregressiveValue;
+    if (!seasonalReady && !autoregressiveReady) {
+        return holtWinters.isReady() ? holtWintersValue : autoregressiveValue;
+    }
+    
+    // Inverse-MSE weighting so the model that is currently right dominates
+    const double epsilon = 1e-9;
+    double seasonalWeight = 1.0 / (holtWinters.getErrorStats().meanSquaredError + epsilon);
+    double autoregressiveWeight = 1.0 / (arModel.getErrorStats().meanSquaredError + epsilon);
+    
+    return (seasonalWeight * holtWintersValue + autoregressiveWeight * autoregressiveValue) /
+           (seasonalWeight + autoregressiveWeight);
+}
+
 double BloombergAnalyticsEngine::calculatePredictionConfidence() {
-    if (predictionHistory.empty() || actualHistory.empty()) return 0.0;
+    if (predictionTracker.size() < 2) return 0.0;
+    
+    // Skill relative to the spread of the actuals: 1 = perfect, 0 = no better than the mean
+    double rmse = predictionTracker.rootMeanSquaredError();
+    double spread = predictionTracker.actualStandardDeviation();
     
-    // Calculate correlation between predictions and actual values
-    return calculateCorrelation(predictionHistory, actualHistory);
+    if (spread <= 0.0) {
+        return rmse <= 1e-9 ? 1.0 : 0.0;
+    }
+    
+    return std::clamp(1.0 - rmse / spread, 0.0, 1.0);
 }
 
-BloombergAnalyticsEngine::TradingSignal BloombergAnalyticsEngine::generateTradingSignal() {
-    auto metrics = calculateMetrics();
+void BloombergAnalyticsEngine::compileSignalRules() {
+    using Condition = SignalDecisionTable::Condition;
+    
+    auto action = [](TradingSignal::SignalType type, double strength, const char* reasoning) {
+        TradingSignal signal;
+        signal.type = type;
+        signal.strength = strength;
+        signal.reasoning = reasoning;
+        return signal;
+    };
     
-    TradingSignal signal;
-    signal.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+    // First match wins; the improvement index is the trend slope
+    signalTable.compile({
+        {{SignalFeatures::RSI, false, 30.0}, {SignalFeatures::TREND, true, 0.0}},
+        {{SignalFeatures::RSI, true, 70.0}, {SignalFeatures::TREND, false, 0.0}},
+        {{SignalFeatures::MACD, true, 0.0}, {SignalFeatures::TREND, true, 0.1}},
+        {{SignalFeatures::MACD, false, 0.0}, {SignalFeatures::TREND, false, -0.1}}
+    });
+    
+    signalActions = {
+        action(TradingSignal::SignalType::BUY, 0.8, "Oversold with positive trend"),
+        action(TradingSignal::SignalType::SELL, 0.8, "Overbought with negative trend"),
+        action(TradingSignal::SignalType::BUY, 0.6, "Positive MACD with improvement"),
+        action(TradingSignal::SignalType::SELL, 0.6, "Negative MACD with decline"),
+        action(TradingSignal::SignalType::HOLD, 0.5, "No clear signal")
+    };
+}
+
+BloombergAnalyticsEngine::TradingSignal BloombergAnalyticsEngine::signalFromFeatures(const SignalFeatures& features,
+                                                                                     int64_t timestamp) const {
+    size_t rule = std::min(signalTable.evaluate(features), signalActions.size() - 1);
+    
+    TradingSignal signal = signalActions[rule];
+    signal.timestamp = timestamp;
+    return signal;
+}
+
+BloombergAnalyticsEngine::TradingSignal BloombergAnalyticsEngine::generateTradingSignal() {
+    // Indicators are already current; no need to recompute the full metrics
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::steady_clock::now().time_since_epoch()).count();
+    return signalFromFeatures(indicators.features(), now);
+}
+
+std::vector<BloombergAnalyticsEngine::TradingSignal> BloombergAnalyticsEngine::generateSignalHistory(int periods) {
+    std::vector<TradingSignal> history;
+    if (periods <= 0 || performanceHistory.empty()) return history;
     
-    // Determine signal based on technical indicators
-    if (metrics.rsi < 30 && metrics.trendDirection > 0) {
-        signal.type = TradingSignal::SignalType::BUY;
-        signal.strength = 0.8;
-        signal.reasoning = "Oversold with positive trend";
-    } else if (metrics.rsi > 70 && metrics.trendDirection < 0) {
-        signal.type = TradingSignal::SignalType::SELL;
-        signal.strength = 0.8;
-        signal.reasoning = "Overbought with negative trend";
-    } else if (metrics.macd > 0 && metrics.improvementIndex > 0.1) {
-        signal.type = TradingSignal::SignalType::BUY;
-        signal.strength = 0.6;
-        signal.reasoning = "Positive MACD with improvement";
-    } else if (metrics.macd < 0 && metrics.improvementIndex < -0.1) {
-        signal.type = TradingSignal::SignalType::SELL;
-        signal.strength = 0.6;
-        signal.reasoning = "Negative MACD with decline";
-    } else {
-        signal.type = TradingSignal::SignalType::HOLD;
-        signal.strength = 0.5;
-        signal.reasoning = "No clear signal";
+    // One forward pass over the retained window, emitting the last `periods` signals
+    StreamingIndicators replay(14, 12, 26, smoothingFactor, performanceHistory.capacity());
+    size_t first = performanceHistory.size() > static_cast<size_t>(periods)
+                       ? performanceHistory.size() - periods : 0;
+    history.reserve(performanceHistory.size() - first);
+    
+    for (size_t i = 0; i < performanceHistory.size(); ++i) {
+        replay.update(performanceHistory[i]);
+        if (i >= first) {
+            history.push_back(signalFromFeatures(replay.features(), static_cast<int64_t>(timeSeries[i])));
+        }
     }
     
-    return signal;
+    return history;
+}
+
+BloombergAnalyticsEngine::TradingSignal BloombergAnalyticsEngine::generateSignalFromMetrics(const PerformanceMetrics& metrics) {
+    SignalFeatures features;
+    features[SignalFeatures::RSI] = metrics.rsi;
+    features[SignalFeatures::MACD] = metrics.macd;
+    features[SignalFeatures::TREND] = metrics.trendDirection;
+    
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return signalFromFeatures(features, now);
+}
+
+std::string BloombergAnalyticsEngine::generateSignalReasoning(const PerformanceMetrics& metrics) {
+    return generateSignalFromMetrics(metrics).reasoning;
 }
 
 std::string BloombergAnalyticsEngine::exportToCSV() {
-    std::stringstream csv;
-    csv << "Timestamp,Performance,RSI,MACD,Volatility,SharpeRatio\n";
+    // Indicators describe the whole window, so compute them once rather than per row
+    double rsi = calculateRSI();
+    double macd = calculateMACD();
+    double volatility = calculateVolatility();
+    double sharpeRatio = calculateSharpeRatio();
+    
+    TextSerializer csv;
+    csv.text("Timestamp,Performance,RSI,MACD,Volatility,SharpeRatio").newline();
     
     for (size_t i = 0; i < performanceHistory.size(); ++i) {
-        csv << timeSeries[i] << "," << performanceHistory[i] << ",";
+        csv.general(timeSeries[i]).character(',').general(performanceHistory[i]).character(',');
         
         if (i >= 13) { // RSI needs at least 14 periods
-            csv << calculateRSI() << ",";
+            csv.general(rsi).character(',');
         } else {
-            csv << "0,";
+            csv.text("0,");
         }
         
         if (i >= 25) { // MACD needs at least 26 periods
-            csv << calculateMACD() << ",";
+            csv.general(macd).character(',');
         } else {
-            csv << "0,";
+            csv.text("0,");
         }
         
-        csv << calculateVolatility() << "," << calculateSharpeRatio() << "\n";
+        csv.general(volatility).character(',').general(sharpeRatio).newline();
     }
     
     return csv.str();
 }
 
+std::string BloombergAnalyticsEngine::exportAnalyticsReport() {
+    static const char* SIGNAL_NAMES[] = {"BUY", "SELL", "HOLD", "STRONG_BUY", "STRONG_SELL"};
+    
+    TradingSignal signal = generateTradingSignal();
+    std::vector<double> forecast = generateForecast();
+    
+    TextSerializer json;
+    json.text("{\n  \"samples\": ").unsignedInteger(performanceHistory.size());
+    json.text(",\n  \"indicators\": {\"rsi\": ").jsonNumber(calculateRSI())
+        .text(", \"macd\": ").jsonNumber(calculateMACD())
+        .text(", \"volatility\": ").jsonNumber(calculateVolatility())
+        .text(", \"sharpeRatio\": ").jsonNumber(calculateSharpeRatio()).character('}');
+    json.text(",\n  \"trendDirection\": ").jsonNumber(calculateTrendDirection());
+    json.text(",\n  \"predictedPerformance\": ").jsonNumber(predictNextPerformance());
+    json.text(",\n  \"predictionAccuracy\": ").jsonNumber(getPredictionAccuracy());
+    
+    json.text(",\n  \"forecast\": [");
+    for (size_t i = 0; i < forecast.size(); ++i) {
+        if (i > 0) json.text(", ");
+        json.jsonNumber(forecast[i]);
+    }
+    json.character(']');
+    
+    json.text(",\n  \"signal\": {\"type\": ").jsonString(SIGNAL_NAMES[static_cast<int>(signal.type)])
+        .text(", \"strength\": ").jsonNumber(signal.strength)
+        .text(", \"reasoning\": ").jsonString(signal.reasoning).character('}');
+    json.text("\n}").newline();
+    
+    return json.str();
+}
+
+std::string BloombergAnalyticsEngine::exportBloombergFormat() {
+    // Terminal-style pipe-delimited rows: a header, then one row per retained sample
+    TextSerializer out;
+    out.text("GAME-ANALYZER|SAMPLES|").unsignedInteger(performanceHistory.size())
+       .text("|RSI|").fixed(calculateRSI(), 2)
+       .text("|MACD|").fixed(calculateMACD(), 4)
+       .text("|VOL|").fixed(calculateVolatility(), 4)
+       .text("|SHARPE|").fixed(calculateSharpeRatio(), 4).newline();
+    
+    for (size_t i = 0; i < performanceHistory.size(); ++i) {
+        out.text("PX|").fixed(timeSeries[i], 0).character('|').fixed(performanceHistory[i], 4).newline();
+    }
+    
+    return out.str();
+}
+
 double BloombergAnalyticsEngine::getPredictionAccuracy() const {
-    if (predictionHistory.empty() || actualHistory.empty()) return 0.0;
+    if (predictionTracker.size() == 0) return 0.0;
     
-    double totalError = 0.0;
-    for (size_t i = 0; i < predictionHistory.size(); ++i) {
-        totalError += std::abs(predictionHistory[i] - actualHistory[i]);
+    // 1 - relative mean absolute error over the tracked window
+    double scale = predictionTracker.actualMeanAbsolute();
+    if (scale <= 0.0) {
+        return predictionTracker.meanAbsoluteError() <= 1e-9 ? 1.0 : 0.0;
     }
     
-    return 1.0 - (totalError / predictionHistory.size());
+    return std::clamp(1.0 - predictionTracker.meanAbsoluteError() / scale, 0.0, 1.0);
 }
 
 // Helper functions
-double BloombergAnalyticsEngine::calculateEMA(const std::vector<double>& data, int period, double smoothing) {
+double BloombergAnalyticsEngine::calculateEMA(SegmentedSpan<const double> data, int period, double smoothing) {
     if (data.empty()) return 0.0;
-    if (data.size() < period) return calculateSimpleAverage(data);
+    if (data.size() < static_cast<size_t>(period)) return StatsKernels::mean(data);
     
-    double ema = calculateSimpleAverage(std::vector<double>(data.begin(), data.begin() + period));
+    // Seed with the SMA of the first period, then smooth the rest in place
+    double seed = StatsKernels::mean(data.first(period));
     double multiplier = smoothing > 0 ? smoothing : (2.0 / (period + 1.0));
     
-    for (size_t i = period; i < data.size(); ++i) {
-        ema = (data[i] - ema) * multiplier + ema;
-    }
-    
-    return ema;
+    return StatsKernels::exponentialMovingAverage(data.subspan(period), multiplier, seed);
 }
 
-double BloombergAnalyticsEngine::calculateSimpleAverage(const std::vector<double>& data) {
-    if (data.empty()) return 0.0;
-    return std::accumulate(data.begin(), data.end(), 0.0) / data.size();
+double BloombergAnalyticsEngine::calculateSMA(SegmentedSpan<const double> data, int period) {
+    if (data.empty() || period <= 0) return 0.0;
+    return StatsKernels::mean(data.last(period));
 }
 
-double BloombergAnalyticsEngine::calculateStandardDeviation(const std::vector<double>& data) {
-    if (data.size() < 2) return 0.0;
-    
-    double mean = calculateSimpleAverage(data);
-    double variance = 0.0;
-    
-    for (double value : data) {
-        variance += (value - mean) * (value - mean);
-    }
-    variance /= (data.size() - 1);
-    
-    return std::sqrt(variance);
+double BloombergAnalyticsEngine::calculateSimpleAverage(SegmentedSpan<const double> data) {
+    return StatsKernels::mean(data);
+}
+
+double BloombergAnalyticsEngine::calculateStandardDeviation(SegmentedSpan<const double> data) {
+    return StatsKernels::standardDeviation(data);
 }
 
 std::vector<double> BloombergAnalyticsEngine::getRecentData(int count) {
-    if (performanceHistory.size() <= count) {
-        return performanceHistory;
-    }
+    SegmentedSpan<const double> recent = performanceHistory.segments().last(std::max(0, count));
     
-    return std::vector<double>(
-        performanceHistory.end() - count,
-        performanceHistory.end()
-    );
+    std::vector<double> result;
+    result.reserve(recent.size());
+    for (size_t i = 0; i < recent.size(); ++i) {
+        result.push_back(recent[i]);
+    }
+    return result;
 }
 
-double BloombergAnalyticsEngine::exponentialSmoothing(const std::vector<double>& data, double alpha) {
+double BloombergAnalyticsEngine::exponentialSmoothing(SegmentedSpan<const double> data, double alpha) {
     if (data.empty()) return 0.0;
-    if (data.size() == 1) return data[0];
-    
-    double forecast = data[0];
-    for (size_t i = 1; i < data.size(); ++i) {
-        forecast = alpha * data[i] + (1 - alpha) * forecast;
-    }
     
-    return forecast;
+    return StatsKernels::exponentialMovingAverage(data.subspan(1), alpha, data[0]);
+}
+
+double BloombergAnalyticsEngine::linearRegression(const std::vector<double>& x, const std::vector<double>& y) {
+    return StatsKernels::linearFit(x, y).slope;
 }
 
 // Static helper function
 double BloombergAnalyticsEngine::calculateCorrelation(const std::vector<double>& x, const std::vector<double>& y) {
-    if (x.size() != y.size() || x.empty()) return 0.0;
-    
-    double meanX = std::accumulate(x.begin(), x.end(), 0.0) / x.size();
-    double meanY = std::accumulate(y.begin(), y.end(), 0.0) / y.size();
-    
-    double covariance = 0.0;
-    double varX = 0.0;
-    double varY = 0.0;
-    
-    for (size_t i = 0; i < x.size(); ++i) {
-        double dx = x[i] - meanX;
-        double dy = y[i] - meanY;
-        covariance += dx * dy;
-        varX += dx * dx;
-        varY += dy * dy;
-    }
-    
-    if (varX == 0 || varY == 0) return 0.0;
-    
-    return covariance / (std::sqrt(varX) * std::sqrt(varY));
+    return StatsKernels::correlation(x, y);
 }
\ No newline at end of file
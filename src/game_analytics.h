@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <opencv2/opencv.hpp>
 // CUDA support disabled for compatibility
 #include <string>
@@ -14,6 +16,15 @@
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include "forecasting_models.h"
+#include "anomaly_detector.h"
+#include "ring_buffer.h"
+#include "signal_rules.h"
+#include "trigram_index.h"
+#include "visual_fingerprint.h"
+#include "file_hasher.h"
+#include "profile_database.h"
+#include "rcu_pointer.h"
 
 // Game Event Detection System
 class GameEventDetector {
@@ -30,8 +41,27 @@ public:
         HEALTH_CHANGE,      // Health changed
         AMMO_CHANGE,        // Ammo changed
         TIME_CHANGE,        // Time changed
+        ANOMALY,            // Statistical anomaly in a monitored series
         UNKNOWN             // Unknown event
     };
+    static constexpr int EVENT_TYPE_COUNT = static_cast<int>(EventType::UNKNOWN) + 1;
+
+    // Evidence the fusion stage combines; each kind counts once per event
+    enum class CueSource {
+        RED_FLASH,          // Most of the screen red
+        GOLDEN_FLASH,       // Much of the screen gold
+        SCREEN_SHAKE,       // Whole-frame motion
+        RED_INDICATOR,      // Damage-red pixels
+        COLOR_FLASH,        // One of the game colours over much of the screen
+        PROFILE_CUE,        // A profile @cue in its HUD area
+        HEALTH_DROP,        // Health read from memory went down
+        HEALTH_ZERO,        // ... to zero or below
+        OCR_TEXT,           // A keyword read on screen ("ELIMINATED", "YOU DIED", ...)
+        COUNT
+    };
+    static constexpr int CUE_SOURCE_COUNT = static_cast<int>(CueSource::COUNT);
+    static constexpr int64_t DEFAULT_FUSION_WINDOW_MS = 500;
+    static constexpr float DEFAULT_FUSION_THRESHOLD = 0.5f;
 
     struct GameEvent {
         EventType type;
@@ -39,7 +69,7 @@ public:
         int64_t timestamp;
         float confidence;
         cv::Rect region;
-        std::map<std::string, float> parameters;
+        std::map<std::string, float> parameters;    // Fused events: log-odds added by each cue
         
         GameEvent() : type(EventType::UNKNOWN), timestamp(0), confidence(0.0f) {}
         GameEvent(EventType t, const std::string& desc, float conf = 1.0f)
@@ -53,6 +83,7 @@ public:
         std::string name;
         cv::Scalar color;
         cv::Rect region;
+        cv::Rect2f relativeRegion;  // Fractions of the frame (profile cues); empty for full-frame cues
         float threshold;
         int duration;       // Expected duration in ms
         bool isActive;
@@ -60,11 +91,31 @@ public:
         VisualCue() : threshold(0.8f), duration(1000), isActive(false) {}
     };
 
+    // A colour watched for full-screen flashes; its index in gameColors is its ID
+    struct GameColor {
+        std::string name;
+        cv::Scalar color;
+        std::string flashLabel;     // Cue label, built once at registration
+    };
+
+    // Everything detection reads per frame; replaced as a whole, never edited in place
+    struct DetectionConfig {
+        std::vector<VisualCue> visualCues;
+        std::map<EventType, std::vector<VisualCue>> eventCues;
+        std::vector<GameColor> gameColors;
+        int redColorId;             // Damage indicator colour; -1 if none is registered
+        std::vector<std::pair<EventType, VisualCue>> profileCues;  // @cue lines of the active profile
+        std::string profileName;
+
+        DetectionConfig() : redColorId(-1) {}
+        // Replaces a colour of the same name, keeping its ID
+        int addGameColor(const std::string& name, const cv::Scalar& color);
+    };
+
 private:
-    // Event detection components
-    std::vector<VisualCue> visualCues;
+    // Event detection components (read lock-free on the frame path)
+    RcuPointer<DetectionConfig> detectionConfig;
     std::vector<GameEvent> detectedEvents;
-    std::map<EventType, std::vector<VisualCue>> eventCues;
     
     // CUDA support
     bool useCuda;
@@ -75,14 +126,34 @@ private:
     cv::Mat flow;
     cv::Ptr<cv::FarnebackOpticalFlow> opticalFlow;
     
-    // Color detection for UI elements
-    std::map<std::string, cv::Scalar> gameColors;
-    
     // Performance tracking
     std::atomic<int> totalEventsDetected;
     std::atomic<int> falsePositives;
     double averageDetectionTime;
     
+    // Event fusion: cues from frames, memory and OCR within the last fusionWindowMs
+    struct Cue {
+        CueSource source;
+        EventType type;         // UNKNOWN: evidence for whichever events the log-odds table lists
+        int64_t timestampMs;    // Steady clock
+        std::string label;
+        cv::Rect region;
+    };
+    std::mutex cueMutex;
+    std::vector<Cue> cues;
+    std::map<std::string, int64_t> textLastSeenMs;  // Upper-cased cue text still on screen
+    struct HealthValue {
+        std::string dropLabel;
+        std::string zeroLabel;
+        double last;
+        bool seen;
+    };
+    std::map<std::string, int> memoryValueIds;  // Registration only
+    std::vector<HealthValue> healthValues;      // Indexed by memory value ID
+    bool fusedReported[EVENT_TYPE_COUNT];   // Until that event's cues lapse
+    int64_t fusionWindowMs;
+    float fusionThreshold;
+    
     // Threading
     std::mutex detectionMutex;
     std::thread detectionThread;
@@ -96,11 +167,12 @@ public:
     bool initialize();
     void cleanup();
     
-    // Event detection
+    // Event detection: this frame's cues fused with those of the last fusion window;
+    // an event is reported once per run of cues, not once per frame
     std::vector<GameEvent> detectEvents(const cv::Mat& frame);
     std::vector<GameEvent> detectEventsGPU(const cv::cuda::GpuMat& gpuFrame);
     
-    // Specific event detection
+    // Specific event detection, one frame on its own
     std::vector<GameEvent> detectDeaths(const cv::Mat& frame);
     std::vector<GameEvent> detectLevelUps(const cv::Mat& frame);
     std::vector<GameEvent> detectDamage(const cv::Mat& frame);
@@ -116,6 +188,30 @@ public:
     void loadGameProfile(const std::string& gameName);
     void saveGameProfile(const std::string& gameName);
     
+    // Swaps in the profile's cues; frames in flight finish on the previous config
+    void applyProfile(const ProfileDefinition& profile);
+    uint64_t getConfigVersion() const { return detectionConfig.version(); }
+    static EventType eventTypeForCue(const std::string& cueName);
+    static const char* eventTypeName(EventType type);      // "death", "level_up", ...
+    
+    // Cues from outside the frame, fused on the next detectEvents. Thread-safe;
+    // timestampMs is steady-clock milliseconds, 0 for now
+    // Memory values are registered once; only health-like names ("health", "hp") get an
+    // ID, -1 otherwise, and observing by ID does no string work
+    int registerMemoryValue(const std::string& name);
+    void observeMemoryValue(int valueId, double value, int64_t timestampMs = 0);
+    void observeMemoryValue(const std::string& name, double value, int64_t timestampMs = 0);  // Registers on first use
+    void observeText(const std::string& text, int64_t timestampMs = 0);
+    void addCue(CueSource source, EventType type, const std::string& label, int64_t timestampMs = 0);  // type UNKNOWN: any event
+    void setFusionWindowMs(int64_t windowMs);
+    void setFusionThreshold(float confidence);
+    
+    // Precomputed from per-cue hit and false-alarm rates: log(P(cue | event) / P(cue | no event)),
+    // 0 where the cue says nothing about the event; priorLogOdds is the event's base rate
+    static float cueLogOdds(EventType type, CueSource source);
+    static float priorLogOdds(EventType type);
+    static const char* cueSourceName(CueSource source);
+    
     // Statistics
     int getTotalEventsDetected() const { return totalEventsDetected.load(); }
     int getFalsePositives() const { return falsePositives.load(); }
@@ -137,14 +233,38 @@ private:
     cv::Scalar detectDominantColor(const cv::Mat& frame, const cv::Rect& region);
     bool isColorSimilar(const cv::Scalar& color1, const cv::Scalar& color2, float threshold);
     
-    // Event validation
+    // Event fusion (cueMutex held): confidence from the prior plus each kind of cue in
+    // the window, then whether that is enough and not already reported
     bool validateEvent(const GameEvent& event, const cv::Mat& frame);
     void updateEventConfidence(GameEvent& event, const cv::Mat& frame);
     
     // Helper functions
     void loadDefaultVisualCues();
+    void collectFrameCues(const cv::Mat& frame, int64_t timestampMs, std::vector<Cue>& frameCues);
+    static cv::Rect profileCueArea(const VisualCue& cue, const cv::Mat& frame);
+    static float cueConfidence(EventType type, CueSource source);   // That cue alone
+    static int64_t steadyClockMs();
 };
 
+inline const char* GameEventDetector::eventTypeName(EventType type) {
+    switch (type) {
+        case EventType::DEATH: return "death";
+        case EventType::LEVEL_UP: return "level_up";
+        case EventType::DAMAGE_TAKEN: return "damage_taken";
+        case EventType::DAMAGE_DEALT: return "damage_dealt";
+        case EventType::KILL: return "kill";
+        case EventType::ITEM_PICKUP: return "item_pickup";
+        case EventType::ACHIEVEMENT: return "achievement";
+        case EventType::SCORE_CHANGE: return "score_change";
+        case EventType::HEALTH_CHANGE: return "health_change";
+        case EventType::AMMO_CHANGE: return "ammo_change";
+        case EventType::TIME_CHANGE: return "time_change";
+        case EventType::ANOMALY: return "anomaly";
+        case EventType::UNKNOWN: break;
+    }
+    return "unknown";
+}
+
 // Game Fingerprinting System
 class GameFingerprinting {
 public:
@@ -154,6 +274,7 @@ public:
         std::string windowTitle;
         std::string executableHash;
         cv::Mat uiTemplate;
+        std::vector<VisualDescriptor> visualDescriptors;    // Precomputed, e.g. from "@visual" profile lines
         std::vector<cv::Scalar> colorPalette;
         std::vector<cv::Rect> uiRegions;
         std::map<std::string, std::string> metadata;
@@ -179,6 +300,18 @@ private:
     std::map<std::string, GameProfile> windowTitleMap;
     std::map<std::string, GameProfile> hashMap;
     
+    // Fuzzy lookup; entry ids are gameDatabase indices
+    TrigramIndex processNameIndex;
+    TrigramIndex windowTitleIndex;
+    static constexpr float FUZZY_MIN_SCORE = 0.5f;
+    
+    // Screenshot descriptors; match ids are gameDatabase indices
+    VisualDescriptorIndex visualIndex;
+    static constexpr int VISUAL_MATCH_DISTANCE = 64;
+    
+    // Executable hashes, cached on disk by (path, size, mtime)
+    FileHashCache hashCache;
+    
     // Template matching (CPU fallback)
     cv::Mat templateMatcher;
     
@@ -199,7 +332,9 @@ public:
     void cleanup();
     
     // Game identification
+#ifdef _WIN32
     FingerprintMatch identifyGame(HWND hwnd);
+#endif
     FingerprintMatch identifyGame(const std::string& processName);
     FingerprintMatch identifyGame(const cv::Mat& uiScreenshot);
     
@@ -209,6 +344,8 @@ public:
     void addGameProfile(const GameProfile& profile);
     void removeGameProfile(const std::string& gameName);
     void updateGameProfile(const std::string& gameName, const GameProfile& profile);
+    bool addVisualDescriptor(const std::string& gameName, const VisualDescriptor& descriptor);
+    size_t loadProfileDatabase(const ProfileDatabase& database);   // Every compiled profile, with its descriptors
     
     // Fingerprinting methods
     std::string calculateExecutableHash(const std::string& executablePath);
@@ -251,8 +388,13 @@ private:
     // Helper functions
     GameProfile getProfileByProcessName(const std::string& processName);
     GameProfile getProfileByWindowTitle(const std::string& windowTitle);
+    GameProfile getProfileByIndex(const TrigramIndex& index, const std::string& query);
+#ifdef _WIN32
+    std::string getProcessPathFromHWND(HWND hwnd);
     std::string getProcessNameFromHWND(HWND hwnd);
     std::string getWindowTitleFromHWND(HWND hwnd);
+#endif
+    void recordFingerprint(double fingerprintTime, const FingerprintMatch& match);
 };
 
 // Bloomberg-Style Analytics Engine
@@ -303,23 +445,35 @@ public:
     };
 
 private:
-    // Data storage
-    std::vector<double> performanceHistory;
-    std::vector<double> timeSeries;
-    std::vector<GameEventDetector::GameEvent> eventHistory;
+    // Data storage (fixed capacity; oldest samples are overwritten)
+    RingBuffer<double> performanceHistory;
+    RingBuffer<double> timeSeries;
+    RingBuffer<GameEventDetector::GameEvent> eventHistory;
     
-    // Technical indicators
-    std::vector<double> rsiHistory;
-    std::vector<double> macdHistory;
-    std::vector<double> volatilityHistory;
+    // Technical indicators (one entry per calculateMetrics call)
+    RingBuffer<double> rsiHistory;
+    RingBuffer<double> macdHistory;
+    RingBuffer<double> volatilityHistory;
     
     // Pattern detection
     std::vector<std::vector<int>> deathPatterns;
     std::vector<std::vector<double>> performancePatterns;
     
-    // Predictive models
-    std::vector<double> predictionHistory;
-    std::vector<double> actualHistory;
+    // Predictive models (updated incrementally in addPerformanceData)
+    HoltWintersModel holtWinters;
+    OnlineARModel arModel;
+    PredictionTracker predictionTracker;
+    double pendingPrediction;
+    bool hasPendingPrediction;
+    
+    // Streaming anomaly detection on analytics series
+    AnomalyMonitor anomalyMonitor;
+    size_t performanceSeriesId;
+    
+    // Signal generation: indicators updated per sample, rules compiled once
+    StreamingIndicators indicators;
+    SignalDecisionTable signalTable;
+    std::vector<TradingSignal> signalActions;   // One per rule, plus the no-match fallback
     
     // Configuration
     int lookbackPeriod;         // Period for technical analysis
@@ -331,6 +485,10 @@ private:
     double averageCalculationTime;
     
 public:
+    // History capacities
+    static constexpr size_t EVENT_HISTORY_CAPACITY = 1024;
+    static constexpr int HISTORY_LOOKBACK_MULTIPLE = 2;     // Samples kept per lookback period
+    
     BloombergAnalyticsEngine();
     ~BloombergAnalyticsEngine();
     
@@ -343,6 +501,13 @@ public:
     void addEventData(const GameEventDetector::GameEvent& event);
     void addTimeSeriesData(const std::vector<double>& data);
     
+    // Anomaly detection (performance series and pipeline metrics)
+    size_t registerSeries(const std::string& series) { return anomalyMonitor.registerSeries(series); }
+    void observeSeries(size_t seriesId, double value, int64_t timestamp);
+    void observeSeries(const std::string& series, double value, int64_t timestamp);
+    std::vector<GameEventDetector::GameEvent> drainAnomalyEvents();
+    size_t getTotalAnomalies() const { return anomalyMonitor.getTotalAnomalies(); }
+    
     // Technical analysis
     PerformanceMetrics calculateMetrics();
     double calculateRSI(int period = 14);
@@ -373,12 +538,14 @@ public:
     int getTotalCalculations() const { return totalCalculations.load(); }
     double getAverageCalculationTime() const { return averageCalculationTime; }
     double getPredictionAccuracy() const;
+    const ForecastErrorStats& getHoltWintersError() const { return holtWinters.getErrorStats(); }
+    const ForecastErrorStats& getAutoregressiveError() const { return arModel.getErrorStats(); }
     
 private:
     // Technical indicator calculations
-    double calculateEMA(const std::vector<double>& data, int period, double smoothing);
-    double calculateSMA(const std::vector<double>& data, int period);
-    double calculateStandardDeviation(const std::vector<double>& data);
+    double calculateEMA(SegmentedSpan<const double> data, int period, double smoothing);
+    double calculateSMA(SegmentedSpan<const double> data, int period);
+    double calculateStandardDeviation(SegmentedSpan<const double> data);
     
     // Pattern analysis
     std::vector<int> findClusters(const std::vector<int>& data, int minClusterSize = 3);
@@ -386,11 +553,17 @@ private:
     
     // Predictive algorithms
     double linearRegression(const std::vector<double>& x, const std::vector<double>& y);
-    double exponentialSmoothing(const std::vector<double>& data, double alpha);
+    double exponentialSmoothing(SegmentedSpan<const double> data, double alpha);
+    double blendModelForecast(double holtWintersValue, double autoregressiveValue) const;
+    
+    // Anomaly events
+    static GameEventDetector::GameEvent toGameEvent(const AnomalyEvent& anomaly);
     
     // Signal generation
     TradingSignal generateSignalFromMetrics(const PerformanceMetrics& metrics);
     std::string generateSignalReasoning(const PerformanceMetrics& metrics);
+    void compileSignalRules();
+    TradingSignal signalFromFeatures(const SignalFeatures& features, int64_t timestamp) const;
     
     // Utility functions
     std::vector<double> getRecentData(int count);
@@ -400,6 +573,6 @@ private:
     double calculateConsistencyIndex();
     double calculateImprovementIndex();
     double calculateStabilityIndex();
-    double calculateSimpleAverage(const std::vector<double>& data);
+    double calculateSimpleAverage(SegmentedSpan<const double> data);
     double calculateCorrelation(const std::vector<double>& x, const std::vector<double>& y);
 };
@@ -0,0 +1,395 @@
+#include "game_simulator.h"
+#include "text_serializer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <opencv2/imgproc.hpp>
+
+namespace {
+
+// Fixed HUD layout (fractions of the frame); the banner only shows after kills and level ups
+struct HudSlot {
+    const char* name;
+    float x, y, width, height;
+};
+
+const HudSlot HUD_SLOTS[] = {
+    {"health", 0.03f, 0.88f, 0.18f, 0.09f},
+    {"ammo",   0.76f, 0.88f, 0.21f, 0.09f},
+    {"score",  0.76f, 0.03f, 0.21f, 0.09f},
+    {"time",   0.42f, 0.03f, 0.16f, 0.09f},
+    {"level",  0.03f, 0.03f, 0.16f, 0.09f},
+    {"banner", 0.30f, 0.42f, 0.40f, 0.14f}
+};
+
+constexpr size_t BANNER_SLOT = 5;
+constexpr size_t MEMORY_BLOCK_SIZE = 4096;
+constexpr size_t FIXED_LAYOUT_BASE = 0x100;     // Unrandomised: a packed struct at this offset
+
+} // namespace
+
+// SimulatorConfig Implementation
+SimulatorConfig::SimulatorConfig()
+    : seed(1), width(640), height(360), frameIntervalMs(33),
+      fontFace(cv::FONT_HERSHEY_SIMPLEX), fontScale(1.0), fontThickness(2), textColor(255, 255, 255),
+      randomizeLayout(false), colorFlashes(true), screenShake(true), shakeAmplitude(12), movingBackground(true),
+      damageRate(0.8), killRate(0.3), pickupRate(0.1), shotRate(4.0) {
+}
+
+// GameSimulator Implementation
+const char* GameSimulator::fieldName(Field field) {
+    switch (field) {
+        case FIELD_HEALTH: return "Health";
+        case FIELD_AMMO: return "Ammo";
+        case FIELD_RESERVE_AMMO: return "Reserve_Ammo";
+        case FIELD_SCORE: return "Score";
+        case FIELD_KILLS: return "Kills";
+        case FIELD_LEVEL: return "Level";
+        case FIELD_TIME_SECONDS: return "Time_Seconds";
+        case FIELD_COUNT: break;
+    }
+    return "Unknown";
+}
+
+GameSimulator::GameSimulator(const SimulatorConfig& config)
+    : config(config), random(config.seed), memoryBlock(MEMORY_BLOCK_SIZE), fieldOffsets{},
+      frameIndex(0), gameTimeMs(0), redFlashFrames(0), goldFlashFrames(0), shakeFrames(0), bannerFrames(0),
+      truthLog(nullptr) {
+    buildLayout();
+    buildBackground();
+    resetState();
+}
+
+GameSimulator::~GameSimulator() {
+    closeGroundTruthLog();
+}
+
+void GameSimulator::buildLayout() {
+    // Decoy bytes around the fields so a memory scan has something to reject
+    for (auto& byte : memoryBlock) {
+        byte = static_cast<uint8_t>(random());
+    }
+
+    if (!config.randomizeLayout) {
+        for (int field = 0; field < FIELD_COUNT; ++field) {
+            fieldOffsets[field] = FIXED_LAYOUT_BASE + field * sizeof(int32_t);
+        }
+    } else {
+        // Shuffled order with 0-15 ints of padding between fields, all 4-byte aligned
+        int order[FIELD_COUNT];
+        std::iota(order, order + FIELD_COUNT, 0);
+        std::shuffle(order, order + FIELD_COUNT, random);
+
+        size_t offset = 16 * (1 + random() % 64);
+        for (int i = 0; i < FIELD_COUNT; ++i) {
+            fieldOffsets[order[i]] = offset;
+            offset += sizeof(int32_t) * (1 + random() % 16);
+        }
+    }
+
+    hudRegions.clear();
+    for (const auto& slot : HUD_SLOTS) {
+        hudRegions.push_back(ProfileDefinition::HudRegion{slot.name, slot.x, slot.y, slot.width, slot.height});
+    }
+}
+
+void GameSimulator::buildBackground() {
+    // Cool-coloured scenery (blues and greens), so it never trips the red or gold detectors
+    int margin = config.shakeAmplitude + 1;
+    background.create(config.height + 2 * margin, config.width * 2 + 2 * margin, CV_8UC3);
+    for (int y = 0; y < background.rows; ++y) {
+        cv::Vec3b* row = background.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < background.cols; ++x) {
+            row[x] = cv::Vec3b(static_cast<uint8_t>(90 + 60 * y / background.rows),
+                               static_cast<uint8_t>(60 + 40 * x / background.cols), 30);
+        }
+    }
+
+    for (int i = 0; i < 40; ++i) {
+        cv::Point corner(static_cast<int>(random() % background.cols), static_cast<int>(random() % background.rows));
+        cv::Size size(20 + static_cast<int>(random() % 120), 20 + static_cast<int>(random() % 80));
+        cv::Scalar color(120 + random() % 120, 80 + random() % 100, random() % 40);
+        cv::rectangle(background, cv::Rect(corner, size), color, cv::FILLED);
+    }
+}
+
+void GameSimulator::resetState() {
+    writeField(FIELD_HEALTH, MAX_HEALTH);
+    writeField(FIELD_AMMO, MAGAZINE_SIZE);
+    writeField(FIELD_RESERVE_AMMO, 4 * MAGAZINE_SIZE);
+    writeField(FIELD_SCORE, 0);
+    writeField(FIELD_KILLS, 0);
+    writeField(FIELD_LEVEL, 1);
+    writeField(FIELD_TIME_SECONDS, 0);
+}
+
+int32_t GameSimulator::readField(Field field) const {
+    int32_t value;
+    std::memcpy(&value, memoryBlock.data() + fieldOffsets[field], sizeof(value));
+    return value;
+}
+
+void GameSimulator::writeField(Field field, int32_t value) {
+    std::memcpy(memoryBlock.data() + fieldOffsets[field], &value, sizeof(value));
+}
+
+uint64_t GameSimulator::getFieldAddress(Field field) const {
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(memoryBlock.data() + fieldOffsets[field]));
+}
+
+bool GameSimulator::chance(double ratePerSecond) {
+    double probability = ratePerSecond * config.frameIntervalMs / 1000.0;
+    return std::uniform_real_distribution<double>(0.0, 1.0)(random) < probability;
+}
+
+void GameSimulator::step(cv::Mat* frame, FrameTruth* truth) {
+    FrameTruth localTruth;
+    FrameTruth& current = truth ? *truth : localTruth;
+
+    ++frameIndex;
+    gameTimeMs += config.frameIntervalMs;
+    redFlashFrames = std::max(0, redFlashFrames - 1);
+    goldFlashFrames = std::max(0, goldFlashFrames - 1);
+    shakeFrames = std::max(0, shakeFrames - 1);
+    bannerFrames = std::max(0, bannerFrames - 1);
+
+    current.events.clear();
+    current.hudFields.clear();
+    applyEvents(current.events);
+    writeField(FIELD_TIME_SECONDS, static_cast<int32_t>(gameTimeMs / 1000));
+
+    current.frameIndex = frameIndex;
+    current.timestampMs = gameTimeMs;
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        current.values[field] = readField(static_cast<Field>(field));
+    }
+    current.redFlash = redFlashFrames > 0;
+    current.goldFlash = goldFlashFrames > 0;
+    current.shakeOffset = cv::Point(0, 0);
+    if (shakeFrames > 0) {
+        std::uniform_int_distribution<int> offset(-config.shakeAmplitude, config.shakeAmplitude);
+        current.shakeOffset = cv::Point(offset(random), offset(random));
+    }
+
+    if (frame) render(*frame, current);
+    if (truthWriter) logTruth(current);
+}
+
+void GameSimulator::applyEvents(std::vector<GameEventDetector::EventType>& events) {
+    using EventType = GameEventDetector::EventType;
+
+    if (chance(config.shotRate)) {
+        int32_t ammo = readField(FIELD_AMMO);
+        int32_t reserve = readField(FIELD_RESERVE_AMMO);
+        if (ammo > 0) {
+            writeField(FIELD_AMMO, ammo - 1);
+            events.push_back(EventType::AMMO_CHANGE);
+        } else if (reserve > 0) {
+            int32_t loaded = std::min<int32_t>(MAGAZINE_SIZE, reserve);
+            writeField(FIELD_AMMO, loaded);
+            writeField(FIELD_RESERVE_AMMO, reserve - loaded);
+            events.push_back(EventType::AMMO_CHANGE);
+        }
+    }
+
+    if (chance(config.damageRate)) {
+        int32_t damage = 5 + static_cast<int32_t>(random() % 21);
+        int32_t health = readField(FIELD_HEALTH) - damage;
+        events.push_back(EventType::DAMAGE_TAKEN);
+        events.push_back(EventType::HEALTH_CHANGE);
+        if (config.screenShake) shakeFrames = SHAKE_FRAMES;
+
+        if (health <= 0) {
+            // Respawn with a fresh magazine; score, kills and level carry over
+            events.push_back(EventType::DEATH);
+            if (config.colorFlashes) redFlashFrames = FLASH_FRAMES;
+            health = MAX_HEALTH;
+            writeField(FIELD_AMMO, MAGAZINE_SIZE);
+        }
+        writeField(FIELD_HEALTH, health);
+    }
+
+    if (chance(config.killRate)) {
+        int32_t kills = readField(FIELD_KILLS) + 1;
+        writeField(FIELD_KILLS, kills);
+        writeField(FIELD_SCORE, readField(FIELD_SCORE) + 100);
+        events.push_back(EventType::KILL);
+        events.push_back(EventType::SCORE_CHANGE);
+        bannerText = "ELIMINATED";
+        bannerFrames = BANNER_FRAMES;
+
+        if (kills % 5 == 0) {
+            writeField(FIELD_LEVEL, readField(FIELD_LEVEL) + 1);
+            events.push_back(EventType::LEVEL_UP);
+            if (config.colorFlashes) goldFlashFrames = FLASH_FRAMES;
+            bannerText = "LEVEL UP";
+        }
+    }
+
+    if (chance(config.pickupRate)) {
+        writeField(FIELD_RESERVE_AMMO, std::min<int32_t>(8 * MAGAZINE_SIZE, readField(FIELD_RESERVE_AMMO) + MAGAZINE_SIZE));
+        events.push_back(EventType::ITEM_PICKUP);
+    }
+}
+
+std::string GameSimulator::fieldText(size_t hudIndex) const {
+    char text[32];
+    switch (hudIndex) {
+        case 0:
+            snprintf(text, sizeof(text), "%d", readField(FIELD_HEALTH));
+            break;
+        case 1:
+            snprintf(text, sizeof(text), "%d/%d", readField(FIELD_AMMO), readField(FIELD_RESERVE_AMMO));
+            break;
+        case 2:
+            snprintf(text, sizeof(text), "%d", readField(FIELD_SCORE));
+            break;
+        case 3: {
+            int32_t seconds = readField(FIELD_TIME_SECONDS);
+            snprintf(text, sizeof(text), "%02d:%02d", (seconds / 60) % 100, seconds % 60);
+            break;
+        }
+        case 4:
+            snprintf(text, sizeof(text), "LV %d", readField(FIELD_LEVEL));
+            break;
+        default:
+            return bannerText;
+    }
+    return text;
+}
+
+void GameSimulator::render(cv::Mat& frame, FrameTruth& truth) {
+    // World: a window onto the wider background, panning right and shifted by any shake
+    int margin = config.shakeAmplitude + 1;
+    int pan = config.movingBackground ? static_cast<int>((frameIndex * 4) % config.width) : 0;
+    cv::Rect view(margin + pan - truth.shakeOffset.x, margin - truth.shakeOffset.y, config.width, config.height);
+    background(view).copyTo(frame);
+
+    // Flashes tint the whole screen, well past the detectors' coverage thresholds
+    if (truth.redFlash) {
+        cv::addWeighted(frame, 0.35, cv::Mat(frame.size(), frame.type(), cv::Scalar(0, 0, 255)), 0.65, 0.0, frame);
+    } else if (truth.goldFlash) {
+        cv::addWeighted(frame, 0.35, cv::Mat(frame.size(), frame.type(), cv::Scalar(0, 215, 255)), 0.65, 0.0, frame);
+    }
+
+    // HUD: fixed on screen, but shaken along with everything else
+    for (size_t i = 0; i < hudRegions.size(); ++i) {
+        if (i == BANNER_SLOT && bannerFrames == 0) continue;
+
+        const auto& region = hudRegions[i];
+        cv::Rect slot(cvRound(region.x * frame.cols), cvRound(region.y * frame.rows),
+                      cvRound(region.width * frame.cols), cvRound(region.height * frame.rows));
+        std::string text = fieldText(i);
+
+        int baseline = 0;
+        double scale = i == BANNER_SLOT ? config.fontScale * 1.5 : config.fontScale;
+        cv::Size textSize = cv::getTextSize(text, config.fontFace, scale, config.fontThickness, &baseline);
+        cv::Point origin(slot.x + 4 + truth.shakeOffset.x,
+                         slot.y + (slot.height + textSize.height) / 2 + truth.shakeOffset.y);
+
+        if (i == BANNER_SLOT) {
+            cv::rectangle(frame, slot + truth.shakeOffset, cv::Scalar(40, 40, 40), cv::FILLED);
+            origin.x = slot.x + (slot.width - textSize.width) / 2 + truth.shakeOffset.x;
+        }
+        cv::putText(frame, text, origin, config.fontFace, scale, config.textColor, config.fontThickness, cv::LINE_AA);
+
+        HudField field;
+        field.name = region.name;
+        field.text = text;
+        field.box = cv::Rect(origin.x, origin.y - textSize.height, textSize.width, textSize.height + baseline) &
+                    cv::Rect(0, 0, frame.cols, frame.rows);
+        truth.hudFields.push_back(field);
+    }
+}
+
+ProfileDefinition GameSimulator::buildProfile(const std::string& name) const {
+    ProfileDefinition profile;
+    profile.name = name;
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        profile.addresses.push_back(ProfileDefinition::Address{
+            fieldName(static_cast<Field>(field)), getFieldAddress(static_cast<Field>(field))});
+    }
+    profile.hudRegions = hudRegions;
+    profile.textColors.push_back(ProfileDefinition::TextColor{
+        static_cast<uint8_t>(config.textColor[2]), static_cast<uint8_t>(config.textColor[1]),
+        static_cast<uint8_t>(config.textColor[0]), TEXT_COLOR_TOLERANCE});
+    return profile;
+}
+
+bool GameSimulator::writeProfile(const std::string& path, const std::string& name) const {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    ProfileDefinition profile = buildProfile(name);
+    bool written;
+    {
+        TextSerializer out(TextSerializer::fileSink(file));
+        out.text("# Game: ").text(profile.name).newline();
+        out.text("# Description: Synthetic game simulator; addresses are valid for this run only").newline();
+        out.newline();
+        for (const auto& address : profile.addresses) {
+            out.text("0x").hex(address.address).character(' ').text(address.name).newline();
+        }
+        out.newline();
+        for (const auto& region : profile.hudRegions) {
+            out.text("@hud ").text(region.name).character(' ').general(region.x).character(' ').general(region.y)
+               .character(' ').general(region.width).character(' ').general(region.height).newline();
+        }
+        for (const auto& color : profile.textColors) {
+            out.text("@text ").integer(color.red).character(' ').integer(color.green).character(' ')
+               .integer(color.blue).character(' ').integer(color.tolerance).newline();
+        }
+        written = out.flush() && out.good();
+    }
+    return (fclose(file) == 0) && written;
+}
+
+bool GameSimulator::openGroundTruthLog(const std::string& path) {
+    closeGroundTruthLog();
+    truthLog = fopen(path.c_str(), "wb");
+    if (!truthLog) return false;
+
+    truthWriter.reset(new TextSerializer(TextSerializer::fileSink(truthLog)));
+    TextSerializer& out = *truthWriter;
+    out.text("frame,time_ms");
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        out.character(',').text(fieldName(static_cast<Field>(field)));
+    }
+    out.text(",red_flash,gold_flash,shake_x,shake_y,events,hud").newline();
+    return true;
+}
+
+void GameSimulator::closeGroundTruthLog() {
+    truthWriter.reset();    // Flushes
+    if (truthLog) {
+        fclose(truthLog);
+        truthLog = nullptr;
+    }
+}
+
+void GameSimulator::logTruth(const FrameTruth& truth) {
+    TextSerializer& out = *truthWriter;
+    out.integer(truth.frameIndex).character(',').integer(truth.timestampMs);
+    for (int field = 0; field < FIELD_COUNT; ++field) {
+        out.character(',').integer(truth.values[field]);
+    }
+    out.character(',').integer(truth.redFlash ? 1 : 0).character(',').integer(truth.goldFlash ? 1 : 0)
+       .character(',').integer(truth.shakeOffset.x).character(',').integer(truth.shakeOffset.y).character(',');
+
+    // events: name;name   hud: name=text@x:y:w:h;...
+    std::string events;
+    for (auto type : truth.events) {
+        if (!events.empty()) events += ';';
+        events += GameEventDetector::eventTypeName(type);
+    }
+    out.csvField(events).character(',');
+
+    std::string hud;
+    for (const auto& field : truth.hudFields) {
+        if (!hud.empty()) hud += ';';
+        hud += field.name + "=" + field.text + "@" + std::to_string(field.box.x) + ":" + std::to_string(field.box.y) +
+               ":" + std::to_string(field.box.width) + ":" + std::to_string(field.box.height);
+    }
+    out.csvField(hud).newline();
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "game_analytics.h"
+#include "profile_database.h"
+
+class TextSerializer;
+
+// Settings for a simulated game. Everything random is drawn from one seed, so a
+// seed reproduces the same layout, events and frames.
+struct SimulatorConfig {
+    uint64_t seed;
+    int width;
+    int height;
+    int frameIntervalMs;        // Game time per step
+
+    // HUD text
+    int fontFace;               // cv::HersheyFonts
+    double fontScale;
+    int fontThickness;
+    cv::Scalar textColor;       // BGR
+
+    // Memory layout: shuffled field order and random padding, as between game builds
+    bool randomizeLayout;
+
+    // Effects
+    bool colorFlashes;          // Red flash on death, gold on level up
+    bool screenShake;           // Frame offset while taking damage
+    int shakeAmplitude;         // Pixels
+    bool movingBackground;      // Camera pan under a fixed HUD
+
+    // Mean events per second of game time
+    double damageRate;
+    double killRate;
+    double pickupRate;
+    double shotRate;
+
+    SimulatorConfig();
+};
+
+// A stand-in game for end-to-end tests and benchmarks on any OS. It keeps health,
+// ammo, score and friends as int32 values in a block of its own memory (readable
+// through ProcessMemory like a real game), advances them with random events, and
+// renders HUD frames that match: the values as text in fixed HUD regions, plus the
+// colour flashes, screen shake and banners the detectors look for. Each step can
+// be logged as ground truth (values, HUD text and boxes, events).
+class GameSimulator {
+public:
+    enum Field {
+        FIELD_HEALTH,
+        FIELD_AMMO,
+        FIELD_RESERVE_AMMO,
+        FIELD_SCORE,
+        FIELD_KILLS,
+        FIELD_LEVEL,
+        FIELD_TIME_SECONDS,
+        FIELD_COUNT
+    };
+
+    static constexpr int MAX_HEALTH = 100;
+    static constexpr int MAGAZINE_SIZE = 30;
+    static constexpr int FLASH_FRAMES = 3;
+    static constexpr int SHAKE_FRAMES = 4;
+    static constexpr int BANNER_FRAMES = 15;
+    static constexpr int TEXT_COLOR_TOLERANCE = 60;     // Per channel; also takes in the brighter anti-aliased edge pixels
+
+    // One HUD field as drawn this frame
+    struct HudField {
+        std::string name;
+        std::string text;
+        cv::Rect box;           // Where the text was drawn (after shake)
+    };
+
+    struct FrameTruth {
+        int64_t frameIndex;
+        int64_t timestampMs;    // Game time
+        int32_t values[FIELD_COUNT];
+        std::vector<GameEventDetector::EventType> events;   // Started this frame
+        std::vector<HudField> hudFields;
+        bool redFlash;
+        bool goldFlash;
+        cv::Point shakeOffset;
+    };
+
+    static const char* fieldName(Field field);
+
+    explicit GameSimulator(const SimulatorConfig& config = SimulatorConfig());
+    ~GameSimulator();
+
+    GameSimulator(const GameSimulator&) = delete;
+    GameSimulator& operator=(const GameSimulator&) = delete;
+
+    // Advances one frame interval; frame may be null to update memory only
+    void step(cv::Mat* frame, FrameTruth* truth = nullptr);
+
+    int32_t getValue(Field field) const { return readField(field); }
+    uint64_t getFieldAddress(Field field) const;    // In this process
+    size_t getFieldOffset(Field field) const { return fieldOffsets[field]; }
+    const uint8_t* getMemoryBlock() const { return memoryBlock.data(); }
+    size_t getMemoryBlockSize() const { return memoryBlock.size(); }
+    int64_t getFrameIndex() const { return frameIndex; }
+
+    // HUD field boxes as fractions of the frame (before shake)
+    const std::vector<ProfileDefinition::HudRegion>& getHudRegions() const { return hudRegions; }
+
+    // Field addresses and HUD regions, in the game_profiles text format
+    ProfileDefinition buildProfile(const std::string& name = "Synthetic Game") const;
+    bool writeProfile(const std::string& path, const std::string& name = "Synthetic Game") const;
+
+    // CSV: frame,time_ms,<field values>,red_flash,gold_flash,shake_x,shake_y,events,hud
+    bool openGroundTruthLog(const std::string& path);
+    void closeGroundTruthLog();
+
+private:
+    SimulatorConfig config;
+    std::mt19937_64 random;
+
+    std::vector<uint8_t> memoryBlock;       // Game state lives here, among decoy bytes
+    size_t fieldOffsets[FIELD_COUNT];
+    std::vector<ProfileDefinition::HudRegion> hudRegions;
+
+    int64_t frameIndex;
+    int64_t gameTimeMs;
+    int redFlashFrames;
+    int goldFlashFrames;
+    int shakeFrames;
+    int bannerFrames;
+    std::string bannerText;
+
+    cv::Mat background;                     // Wider and taller than the frame; panned over
+    FILE* truthLog;
+    std::unique_ptr<TextSerializer> truthWriter;
+
+    void buildLayout();
+    void buildBackground();
+    void resetState();
+
+    int32_t readField(Field field) const;
+    void writeField(Field field, int32_t value);
+
+    bool chance(double ratePerSecond);
+    void applyEvents(std::vector<GameEventDetector::EventType>& events);
+    void render(cv::Mat& frame, FrameTruth& truth);
+    std::string fieldText(size_t hudIndex) const;
+    void logTruth(const FrameTruth& truth);
+};
@@ -0,0 +1,131 @@
+#include "headless_pipeline.h"
+#include "visual_fingerprint.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Command-line entry point: runs the analysis pipeline with no UI until the frame
+// source ends, --frames/--duration is reached, or SIGINT/SIGTERM arrives.
+
+namespace {
+
+std::atomic<bool> stopSignalled(false);
+
+void handleStopSignal(int) {
+    stopSignalled = true;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl
+              << "  --config FILE        Load settings (key = value per line)" << std::endl
+              << "  --set KEY=VALUE      Override one setting (repeatable)" << std::endl
+              << "  --frames N           Stop after N frames (same as --set max_frames=N)" << std::endl
+              << "  --duration SECONDS   Stop after this long" << std::endl
+              << "  --metrics FILE       Write Prometheus metrics here every metrics_interval_ms" << std::endl
+              << "  --describe IMAGE     Print the @visual profile line that identifies a screenshot, then exit" << std::endl
+              << "  --help               Show this message" << std::endl
+              << std::endl
+              << "Settings: frames, max_fps, max_frames, process_id, memory_interval_ms, profile," << std::endl
+              << "  profile_directory, profile_database, address, frame_dedup, ocr, ocr_backend, events, analytics," << std::endl
+              << "  session_file, session_format, metrics_file, metrics_interval_ms, highlight_directory, highlight_events," << std::endl
+              << "  highlight_pre_ms, highlight_post_ms, highlight_buffer_mb" << std::endl
+              << "Frame sources: video:<file>, camera:<index>, images:<directory>, synthetic:<seed>, screen (Windows), none" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    PipelineConfig config;
+    double durationSeconds = 0.0;
+    std::string error;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--help" || argument == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argument == "--config" && hasValue) {
+            if (!config.load(argv[++i], error)) {
+                std::cerr << error << std::endl;
+                return 2;
+            }
+        } else if (argument == "--set" && hasValue) {
+            std::string setting = argv[++i];
+            size_t equals = setting.find('=');
+            if (equals == std::string::npos) {
+                std::cerr << "--set expects KEY=VALUE, got: " << setting << std::endl;
+                return 2;
+            }
+            if (!config.set(setting.substr(0, equals), setting.substr(equals + 1), error)) {
+                std::cerr << error << std::endl;
+                return 2;
+            }
+        } else if (argument == "--frames" && hasValue) {
+            if (!config.set("max_frames", argv[++i], error)) {
+                std::cerr << error << std::endl;
+                return 2;
+            }
+        } else if (argument == "--duration" && hasValue) {
+            durationSeconds = std::atof(argv[++i]);
+            if (durationSeconds <= 0.0) {
+                std::cerr << "--duration expects a positive number of seconds" << std::endl;
+                return 2;
+            }
+        } else if (argument == "--metrics" && hasValue) {
+            config.metricsFile = argv[++i];
+        } else if (argument == "--describe" && hasValue) {
+            cv::Mat screenshot = cv::imread(argv[++i]);
+            if (screenshot.empty()) {
+                std::cerr << "Cannot read image: " << argv[i] << std::endl;
+                return 2;
+            }
+            std::cout << "@visual " << VisualDescriptor::compute(screenshot).toHex() << std::endl;
+            return 0;
+        } else {
+            std::cerr << "Unknown or incomplete option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    HeadlessPipeline pipeline(config);
+    if (!pipeline.start(error)) {
+        std::cerr << "Failed to start: " << error << std::endl;
+        return 1;
+    }
+    std::cerr << "Pipeline running (frames: " << config.frameSource << ")" << std::endl;
+
+    auto started = std::chrono::steady_clock::now();
+    auto nextMetrics = started + std::chrono::milliseconds(config.metricsIntervalMs);
+
+    while (!stopSignalled && pipeline.isRunning()) {
+        auto now = std::chrono::steady_clock::now();
+        if (durationSeconds > 0.0 && std::chrono::duration<double>(now - started).count() >= durationSeconds) break;
+
+        if (!config.metricsFile.empty() && now >= nextMetrics) {
+            if (!pipeline.writeMetricsFile(config.metricsFile)) {
+                std::cerr << "Cannot write metrics to " << config.metricsFile << std::endl;
+            }
+            nextMetrics = now + std::chrono::milliseconds(config.metricsIntervalMs);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    pipeline.stop();
+
+    if (!config.metricsFile.empty()) {
+        pipeline.writeMetricsFile(config.metricsFile);
+    }
+    std::cout << pipeline.formatMetrics();
+    return 0;
+}
@@ -0,0 +1,922 @@
+#include "headless_pipeline.h"
+#include "game_simulator.h"
+#include "text_serializer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#include "optimized_screen_capture.h"
+#else
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool parseBool(const std::string& value, bool& result) {
+    std::string lower = toLower(value);
+    if (lower == "true" || lower == "1" || lower == "yes" || lower == "on") {
+        result = true;
+        return true;
+    }
+    if (lower == "false" || lower == "0" || lower == "no" || lower == "off") {
+        result = false;
+        return true;
+    }
+    return false;
+}
+
+bool parseInteger(const std::string& value, int64_t minimum, int64_t& result) {
+    try {
+        size_t consumed = 0;
+        long long parsed = std::stoll(value, &consumed, 0);
+        if (consumed != value.size() || parsed < minimum) return false;
+        result = parsed;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// Comma-separated event type names, as GameEventDetector::eventTypeName spells them
+bool parseEventTypes(const std::string& value, std::vector<GameEventDetector::EventType>& result) {
+    std::vector<GameEventDetector::EventType> types;
+    std::istringstream stream(value);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        name = toLower(trim(name));
+        if (name.empty()) continue;
+        bool known = false;
+        for (int type = 0; type < static_cast<int>(GameEventDetector::EventType::UNKNOWN); ++type) {
+            auto eventType = static_cast<GameEventDetector::EventType>(type);
+            if (name == GameEventDetector::eventTypeName(eventType)) {
+                types.push_back(eventType);
+                known = true;
+                break;
+            }
+        }
+        if (!known) return false;
+    }
+    if (types.empty()) return false;
+    result.swap(types);
+    return true;
+}
+
+bool hasPrefix(const std::string& text, const std::string& prefix) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+// Video file or camera:<index>
+class VideoFrameSource : public FrameSource {
+public:
+    explicit VideoFrameSource(const std::string& spec) : spec(spec) {}
+
+    bool open() override {
+        if (hasPrefix(spec, "camera:")) {
+            int64_t index = 0;
+            if (!parseInteger(spec.substr(7), 0, index)) return false;
+            return capture.open(static_cast<int>(index));
+        }
+        return capture.open(spec.substr(6));
+    }
+
+    bool read(cv::Mat& frame) override {
+        return capture.read(frame) && !frame.empty();
+    }
+
+    std::string describe() const override { return spec; }
+
+private:
+    std::string spec;
+    cv::VideoCapture capture;
+};
+
+// Every image in a directory, in file name order
+class ImageDirectorySource : public FrameSource {
+public:
+    explicit ImageDirectorySource(const std::string& directory) : directory(directory), next(0) {}
+
+    bool open() override {
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error)) return false;
+
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+            if (!entry.is_regular_file()) continue;
+            std::string extension = toLower(entry.path().extension().string());
+            if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+                files.push_back(entry.path().string());
+            }
+        }
+        std::sort(files.begin(), files.end());
+        return !files.empty();
+    }
+
+    bool read(cv::Mat& frame) override {
+        // Unreadable files are skipped rather than ending the run
+        while (next < files.size()) {
+            frame = cv::imread(files[next++], cv::IMREAD_COLOR);
+            if (!frame.empty()) return true;
+        }
+        return false;
+    }
+
+    std::string describe() const override { return "images:" + directory; }
+
+private:
+    std::string directory;
+    std::vector<std::string> files;
+    size_t next;
+};
+
+// In-process GameSimulator frames: synthetic:<seed>, runs until max_frames
+class SyntheticFrameSource : public FrameSource {
+public:
+    explicit SyntheticFrameSource(uint64_t seed) : seed(seed) {}
+
+    bool open() override {
+        SimulatorConfig config;
+        config.seed = seed;
+        simulator.reset(new GameSimulator(config));
+        return true;
+    }
+
+    bool read(cv::Mat& frame) override {
+        simulator->step(&frame);
+        return true;
+    }
+
+    std::string describe() const override { return "synthetic:" + std::to_string(seed); }
+
+private:
+    uint64_t seed;
+    std::unique_ptr<GameSimulator> simulator;
+};
+
+#ifdef _WIN32
+// Desktop capture; an empty frame means none was ready yet
+class ScreenFrameSource : public FrameSource {
+public:
+    bool open() override {
+        if (!capture.initialize(false, false)) return false;
+        capture.setCaptureMode(OptimizedScreenCapture::CaptureMode::FULL_DESKTOP);
+        capture.setFrameDeduplication(false);   // The frame_dedup stage hashes each frame once
+        return true;
+    }
+
+    bool read(cv::Mat& frame) override {
+        OptimizedScreenCapture::FrameData frameData;
+        frame.release();
+        if (!capture.captureFrame(frameData)) return true;
+        if (frameData.isGPU) {
+            frameData.gpuFrame.download(frame);
+        } else {
+            frame = frameData.frame;
+        }
+        // Steady-clock milliseconds, stamped when the desktop was copied
+        captured = std::chrono::steady_clock::time_point(std::chrono::milliseconds(frameData.timestamp));
+        return true;
+    }
+
+    std::string describe() const override { return "screen"; }
+    std::chrono::steady_clock::time_point captureTime() const override { return captured; }
+
+private:
+    OptimizedScreenCapture capture;
+    std::chrono::steady_clock::time_point captured;
+};
+#endif
+
+} // namespace
+
+// PipelineConfig Implementation
+PipelineConfig::PipelineConfig()
+    : frameSource("none"), maxFps(0), maxFrames(0), processId(0), memoryIntervalMs(1000),
+      profileDirectory("game_profiles"), profileDatabase("game_profiles.db"),
+      frameDedup(true), enableOcr(true), ocrBackend(AdvancedOCR::OCRBackend::TESSERACT), crnnPrecision(CrnnRecognizer::Precision::FP32),
+      enableEvents(true), enableAnalytics(true),
+      sessionFormat(SessionExporter::Format::BINARY), metricsIntervalMs(5000) {
+}
+
+bool PipelineConfig::set(const std::string& rawKey, const std::string& rawValue, std::string& error) {
+    std::string key = toLower(trim(rawKey));
+    std::string value = trim(rawValue);
+    int64_t number = 0;
+
+    auto invalid = [&](const char* expected) {
+        error = "Invalid value for " + key + ": '" + value + "' (expected " + expected + ")";
+        return false;
+    };
+
+    if (key == "frames") {
+        if (value.empty()) return invalid("a frame source");
+        frameSource = value;
+    } else if (key == "max_fps") {
+        if (!parseInteger(value, 0, number) || number > 1000) return invalid("0-1000");
+        maxFps = static_cast<int>(number);
+    } else if (key == "max_frames") {
+        if (!parseInteger(value, 0, number)) return invalid("a non-negative integer");
+        maxFrames = number;
+    } else if (key == "process_id") {
+        if (!parseInteger(value, 0, number) || number > INT32_MAX) return invalid("a process id");
+        processId = static_cast<int>(number);
+    } else if (key == "memory_interval_ms") {
+        if (!parseInteger(value, 1, number) || number > INT32_MAX) return invalid("a positive integer");
+        memoryIntervalMs = static_cast<int>(number);
+    } else if (key == "profile") {
+        profile = value;
+    } else if (key == "profile_directory") {
+        profileDirectory = value;
+    } else if (key == "profile_database") {
+        profileDatabase = value;
+    } else if (key == "address") {
+        // Same form as the profile files: "0xADDRESS Name"
+        std::istringstream stream(value);
+        std::string addressText, name;
+        stream >> addressText;
+        std::getline(stream, name);
+        name = trim(name);
+        if (!parseInteger(addressText, 0, number) || name.empty()) return invalid("0x<address> <name>");
+        addresses.push_back(ProfileDefinition::Address{name, static_cast<uint64_t>(number)});
+    } else if (key == "ocr") {
+        if (!parseBool(value, enableOcr)) return invalid("true or false");
+    } else if (key == "ocr_backend") {
+        std::string lower = toLower(value);
+        if (lower == "tesseract") {
+            ocrBackend = AdvancedOCR::OCRBackend::TESSERACT;
+        } else if (lower == "crnn" || lower == "crnn-fp16" || lower == "crnn-int8") {
+            ocrBackend = AdvancedOCR::OCRBackend::CRNN;
+            crnnPrecision = lower == "crnn-fp16" ? CrnnRecognizer::Precision::FP16
+                          : lower == "crnn-int8" ? CrnnRecognizer::Precision::INT8 : CrnnRecognizer::Precision::FP32;
+        } else {
+            return invalid("tesseract, crnn, crnn-fp16 or crnn-int8");
+        }
+    } else if (key == "frame_dedup") {
+        if (!parseBool(value, frameDedup)) return invalid("true or false");
+    } else if (key == "events") {
+        if (!parseBool(value, enableEvents)) return invalid("true or false");
+    } else if (key == "analytics") {
+        if (!parseBool(value, enableAnalytics)) return invalid("true or false");
+    } else if (key == "session_file") {
+        sessionFile = value;
+    } else if (key == "session_format") {
+        std::string lower = toLower(value);
+        if (lower == "binary") {
+            sessionFormat = SessionExporter::Format::BINARY;
+        } else if (lower == "columnar") {
+            sessionFormat = SessionExporter::Format::COLUMNAR;
+        } else {
+            return invalid("binary or columnar");
+        }
+    } else if (key == "metrics_file") {
+        metricsFile = value;
+    } else if (key == "metrics_interval_ms") {
+        if (!parseInteger(value, 1, number) || number > INT32_MAX) return invalid("a positive integer");
+        metricsIntervalMs = static_cast<int>(number);
+    } else if (key == "highlight_directory") {
+        highlights.directory = value;
+    } else if (key == "highlight_events") {
+        if (!parseEventTypes(value, highlights.triggers)) return invalid("event names, e.g. death,kill,achievement");
+    } else if (key == "highlight_pre_ms") {
+        if (!parseInteger(value, 0, number) || number > 600000) return invalid("0-600000");
+        highlights.preRollMs = number;
+    } else if (key == "highlight_post_ms") {
+        if (!parseInteger(value, 0, number) || number > 600000) return invalid("0-600000");
+        highlights.postRollMs = number;
+    } else if (key == "highlight_buffer_mb") {
+        if (!parseInteger(value, 1, number) || number > 4096) return invalid("1-4096");
+        highlights.maxBufferBytes = static_cast<size_t>(number) << 20;
+    } else {
+        error = "Unknown setting: " + key;
+        return false;
+    }
+    return true;
+}
+
+bool PipelineConfig::load(const std::string& path, std::string& error) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        error = "Cannot open config file: " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        if (trim(line).empty()) continue;
+
+        size_t equals = line.find('=');
+        std::string lineError;
+        if (equals == std::string::npos) {
+            lineError = "expected key = value";
+        } else if (set(line.substr(0, equals), line.substr(equals + 1), lineError)) {
+            continue;
+        }
+        error = path + ":" + std::to_string(lineNumber) + ": " + lineError;
+        return false;
+    }
+    return true;
+}
+
+// FrameSource Implementation
+std::unique_ptr<FrameSource> FrameSource::create(const std::string& spec) {
+    if (hasPrefix(spec, "video:") || hasPrefix(spec, "camera:")) {
+        return std::unique_ptr<FrameSource>(new VideoFrameSource(spec));
+    }
+    if (hasPrefix(spec, "images:")) {
+        return std::unique_ptr<FrameSource>(new ImageDirectorySource(spec.substr(7)));
+    }
+    if (hasPrefix(spec, "synthetic:")) {
+        int64_t seed = 0;
+        if (!parseInteger(spec.substr(10), 0, seed)) return nullptr;
+        return std::unique_ptr<FrameSource>(new SyntheticFrameSource(static_cast<uint64_t>(seed)));
+    }
+#ifdef _WIN32
+    if (spec == "screen") {
+        return std::unique_ptr<FrameSource>(new ScreenFrameSource());
+    }
+#endif
+    return nullptr;
+}
+
+// ProcessMemory Implementation
+bool ProcessMemory::read(int processId, uint64_t address, void* buffer, size_t size) {
+    if (processId <= 0 || !buffer || size == 0) return false;
+
+#ifdef _WIN32
+    HANDLE process = OpenProcess(PROCESS_VM_READ, FALSE, static_cast<DWORD>(processId));
+    if (!process) return false;
+    SIZE_T bytesRead = 0;
+    BOOL ok = ReadProcessMemory(process, reinterpret_cast<LPCVOID>(static_cast<uintptr_t>(address)),
+                                buffer, size, &bytesRead);
+    CloseHandle(process);
+    return ok && bytesRead == size;
+#else
+    // One syscall, no ptrace attach; needs the same user (and ptrace_scope permitting)
+    struct iovec local = {buffer, size};
+    struct iovec remote = {reinterpret_cast<void*>(static_cast<uintptr_t>(address)), size};
+    ssize_t bytesRead = process_vm_readv(static_cast<pid_t>(processId), &local, 1, &remote, 1, 0);
+    return bytesRead == static_cast<ssize_t>(size);
+#endif
+}
+
+int ProcessMemory::currentProcessId() {
+#ifdef _WIN32
+    return static_cast<int>(GetCurrentProcessId());
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+// HeadlessPipeline Implementation
+const double HeadlessPipeline::LatencyHistogram::BUCKET_BOUNDS_MS[BUCKET_COUNT] = {
+    0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000
+};
+
+HeadlessPipeline::LatencyHistogram::LatencyHistogram() : buckets(), count(0), totalMs(0.0) {}
+
+void HeadlessPipeline::LatencyHistogram::record(double ms) {
+    int bucket = static_cast<int>(std::lower_bound(BUCKET_BOUNDS_MS, BUCKET_BOUNDS_MS + BUCKET_COUNT, ms) - BUCKET_BOUNDS_MS);
+    ++buckets[bucket];
+    ++count;
+    totalMs += ms;
+}
+
+double HeadlessPipeline::LatencyHistogram::quantileMs(double quantile) const {
+    if (count == 0) return 0.0;
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::min(1.0, std::max(0.0, quantile)) * count));
+    uint64_t seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+        seen += buckets[bucket];
+        if (seen >= rank && seen > 0) return BUCKET_BOUNDS_MS[bucket];
+    }
+    return std::numeric_limits<double>::infinity();
+}
+
+const char* HeadlessPipeline::stageName(Stage stage) {
+    switch (stage) {
+        case STAGE_CAPTURE: return "capture";
+        case STAGE_DEDUP: return "dedup";
+        case STAGE_OCR: return "ocr";
+        case STAGE_EVENTS: return "events";
+        case STAGE_ANALYTICS: return "analytics";
+        case STAGE_MEMORY: return "memory";
+        case STAGE_COUNT: break;
+    }
+    return "unknown";
+}
+
+HeadlessPipeline::HeadlessPipeline(const PipelineConfig& config)
+    : config(config),
+      sessionExporter([this](std::function<void()> task) { return threadManager.submitIOTask(std::move(task)); }),
+      highlightRecorder([this](std::function<void()> task) { return threadManager.submitIOTask(std::move(task)); }),
+      stopRequested(false), frameLoopRunning(false), memoryLoopRunning(false), metrics() {
+}
+
+HeadlessPipeline::~HeadlessPipeline() {
+    stop();
+}
+
+bool HeadlessPipeline::start(std::string& error) {
+    if (frameThread.joinable() || memoryThread.joinable()) {
+        error = "Pipeline is already running";
+        return false;
+    }
+
+    if (config.frameSource != "none") {
+        frameSource = FrameSource::create(config.frameSource);
+        if (!frameSource) {
+            error = "Unsupported frame source: " + config.frameSource;
+            return false;
+        }
+    }
+
+    if (!threadManager.initialize()) {
+        error = "Failed to start worker threads";
+        return false;
+    }
+
+    if (frameSource && config.enableOcr) {
+        // Cached results would make repeated frames look free; measure real OCR work
+        ocr.setModelSource(AdvancedOCR::ModelSource::SHARED_MAPPING);
+        ocr.setCrnnPrecision(config.crnnPrecision);
+        if (!ocr.initialize(config.ocrBackend, AdvancedOCR::LoadMode::EAGER)) {
+            error = config.ocrBackend == AdvancedOCR::OCRBackend::CRNN
+                ? "Failed to initialize OCR (is the CRNN model in models/? set ocr = false to skip)"
+                : "Failed to initialize OCR (is tessdata installed? set ocr = false to skip)";
+            return false;
+        }
+        ocr.enableCaching(false);
+    }
+
+    if (frameSource && config.enableEvents && !eventDetector.initialize()) {
+        error = "Failed to initialize event detection";
+        return false;
+    }
+    if (frameSource && config.enableEvents && config.processId > 0) {
+        // A health drop read from memory must still be in the window when its flash is seen
+        eventDetector.setFusionWindowMs(std::max<int64_t>(GameEventDetector::DEFAULT_FUSION_WINDOW_MS, config.memoryIntervalMs));
+    }
+
+    if (config.enableAnalytics && !analytics.initialize(20, 0.1)) {
+        error = "Failed to initialize analytics";
+        return false;
+    }
+
+    if (!loadProfile(error)) return false;
+
+    if (frameSource && !frameSource->open()) {
+        error = "Cannot open frame source: " + frameSource->describe();
+        return false;
+    }
+
+    if (!config.sessionFile.empty() && !sessionExporter.open(config.sessionFile, config.sessionFormat)) {
+        error = "Cannot open session file: " + config.sessionFile;
+        return false;
+    }
+
+    if (frameSource && !config.highlights.directory.empty()) {
+        if (!config.enableEvents) {
+            error = "highlight_directory needs events = true";
+            sessionExporter.close();
+            return false;
+        }
+        if (!highlightRecorder.start(config.highlights)) {
+            error = "Cannot create highlight directory: " + config.highlights.directory;
+            sessionExporter.close();
+            return false;
+        }
+    }
+
+    stopRequested = false;
+    startTime = std::chrono::steady_clock::now();
+
+    if (frameSource) {
+        frameLoopRunning = true;
+        frameThread = std::thread(&HeadlessPipeline::frameLoop, this);
+    }
+    if (config.processId > 0 && !addresses.empty()) {
+        memoryLoopRunning = true;
+        memoryThread = std::thread(&HeadlessPipeline::memoryLoop, this);
+    }
+
+    if (!frameThread.joinable() && !memoryThread.joinable()) {
+        error = "Nothing to do: set frames, or process_id with at least one address";
+        sessionExporter.close();
+        return false;
+    }
+    return true;
+}
+
+void HeadlessPipeline::stop() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopRequested = true;
+    }
+    stopCondition.notify_all();
+
+    bool wasRunning = frameThread.joinable() || memoryThread.joinable();
+    if (frameThread.joinable()) frameThread.join();
+    if (memoryThread.joinable()) memoryThread.join();
+    if (wasRunning) {
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        metrics.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    if (sessionExporter.isOpen()) {
+        sessionExporter.close();
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        metrics.sessionBytes = sessionExporter.getBytesWritten();
+    }
+    if (highlightRecorder.isActive()) {
+        // Clips still collecting post-roll are written with what was captured
+        highlightRecorder.stop();
+        std::lock_guard<std::mutex> lock(metricsMutex);
+        metrics.highlightClips = highlightRecorder.getClipsWritten();
+        metrics.highlightBufferBytes = 0;
+    }
+    threadManager.shutdown();
+}
+
+bool HeadlessPipeline::isRunning() const {
+    if (frameThread.joinable()) return frameLoopRunning;
+    return memoryLoopRunning;
+}
+
+HeadlessPipeline::Metrics HeadlessPipeline::getMetrics() const {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    Metrics snapshot = metrics;
+    // Frozen by stop(); live until then
+    if (frameThread.joinable() || memoryThread.joinable()) {
+        snapshot.uptimeSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+    if (sessionExporter.isOpen()) {
+        snapshot.sessionBytes = sessionExporter.getBytesWritten();
+    }
+    if (highlightRecorder.isActive()) {
+        snapshot.highlightClips = highlightRecorder.getClipsWritten();
+        snapshot.highlightBufferBytes = highlightRecorder.getBufferedBytes();
+    }
+    return snapshot;
+}
+
+std::string HeadlessPipeline::formatMetrics() const {
+    Metrics snapshot = getMetrics();
+    TextSerializer out;
+
+    auto counter = [&out](const char* name, const char* help, uint64_t value) {
+        out.text("# HELP game_analyzer_").text(name).character(' ').text(help).newline();
+        out.text("# TYPE game_analyzer_").text(name).text(" counter").newline();
+        out.text("game_analyzer_").text(name).character(' ').unsignedInteger(value).newline();
+    };
+    auto gauge = [&out](const char* name, const char* help, double value) {
+        out.text("# HELP game_analyzer_").text(name).character(' ').text(help).newline();
+        out.text("# TYPE game_analyzer_").text(name).text(" gauge").newline();
+        out.text("game_analyzer_").text(name).character(' ').shortest(value).newline();
+    };
+
+    gauge("uptime_seconds", "Seconds since the pipeline started.", snapshot.uptimeSeconds);
+    counter("frames_processed_total", "Frames taken through every enabled stage.", snapshot.framesProcessed);
+    gauge("frames_per_second", "Average frame throughput since start.", snapshot.framesPerSecond());
+    counter("duplicate_frames_total", "Frames identical to the previous one, skipped after capture.", snapshot.duplicateFrames);
+    gauge("duplicate_frame_ratio", "Share of captured frames skipped as duplicates.", snapshot.duplicateRatio());
+    gauge("last_frame_timestamp_seconds", "Wall-clock time of the latest frame, duplicates included.",
+          snapshot.lastFrameTimeMs / 1000.0);
+    counter("text_regions_total", "Text regions recognised by OCR.", snapshot.textRegions);
+    counter("events_detected_total", "Game events detected in frames.", snapshot.eventsDetected);
+    counter("memory_samples_total", "Process memory values read.", snapshot.memorySamples);
+    counter("memory_read_failures_total", "Process memory reads that failed.", snapshot.memoryReadFailures);
+    counter("anomalies_total", "Anomalies raised by the analytics engine.", snapshot.anomalies);
+    counter("session_bytes_total", "Bytes written to the session file.", snapshot.sessionBytes);
+    counter("highlight_clips_total", "Event clips written to the highlight directory.", snapshot.highlightClips);
+    gauge("highlight_buffer_bytes", "Encoded frames held for highlight pre-roll.",
+          static_cast<double>(snapshot.highlightBufferBytes));
+
+    static const struct {
+        const char* suffix;
+        const char* type;
+        const char* help;
+    } stageSeries[] = {
+        {"sum", "counter", "Total time spent in each stage."},
+        {"count", "counter", "Times each stage ran."},
+        {"max", "gauge", "Slowest single run of each stage."}
+    };
+
+    // Time from capture, so a slow stage shows up in every stage after it
+    auto histogram = [&out](const LatencyHistogram& latency, const char* name, const char* stage) {
+        auto labels = [&](const char* suffix) -> TextSerializer& {
+            out.text("game_analyzer_").text(name).text(suffix);
+            if (stage) out.text("{stage=\"").text(stage).character('"');
+            return out;
+        };
+        uint64_t cumulative = 0;
+        for (int bucket = 0; bucket <= LatencyHistogram::BUCKET_COUNT; ++bucket) {
+            cumulative += latency.buckets[bucket];
+            labels("_bucket").text(stage ? "," : "{").text("le=\"");
+            if (bucket < LatencyHistogram::BUCKET_COUNT) {
+                out.shortest(LatencyHistogram::BUCKET_BOUNDS_MS[bucket]);
+            } else {
+                out.text("+Inf");
+            }
+            out.text("\"} ").unsignedInteger(cumulative).newline();
+        }
+        labels("_sum").text(stage ? "} " : " ").shortest(latency.totalMs).newline();
+        labels("_count").text(stage ? "} " : " ").unsignedInteger(latency.count).newline();
+    };
+    out.text("# HELP game_analyzer_capture_to_stage_ms Time from frame capture to the end of each stage.").newline();
+    out.text("# TYPE game_analyzer_capture_to_stage_ms histogram").newline();
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        if (stage == STAGE_MEMORY) continue;
+        histogram(snapshot.captureToStage[stage], "capture_to_stage_ms", stageName(static_cast<Stage>(stage)));
+    }
+    out.text("# HELP game_analyzer_capture_to_event_ms Time from frame capture to its events being recorded.").newline();
+    out.text("# TYPE game_analyzer_capture_to_event_ms histogram").newline();
+    histogram(snapshot.captureToEvent, "capture_to_event_ms", nullptr);
+
+    for (size_t series = 0; series < 3; ++series) {
+        out.text("# HELP game_analyzer_stage_latency_ms_").text(stageSeries[series].suffix)
+           .character(' ').text(stageSeries[series].help).newline();
+        out.text("# TYPE game_analyzer_stage_latency_ms_").text(stageSeries[series].suffix)
+           .character(' ').text(stageSeries[series].type).newline();
+        for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+            const StageMetrics& stageMetrics = snapshot.stages[stage];
+            out.text("game_analyzer_stage_latency_ms_").text(stageSeries[series].suffix)
+               .text("{stage=\"").text(stageName(static_cast<Stage>(stage))).text("\"} ");
+            if (series == 0) {
+                out.shortest(stageMetrics.totalMs);
+            } else if (series == 1) {
+                out.unsignedInteger(stageMetrics.count);
+            } else {
+                out.shortest(stageMetrics.maxMs);
+            }
+            out.newline();
+        }
+    }
+
+    return out.str();
+}
+
+bool HeadlessPipeline::writeMetricsFile(const std::string& path) const {
+    // Scrapers never see a half-written file: write alongside, then rename over
+    std::string temporaryPath = path + ".tmp";
+    FILE* file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) return false;
+
+    TextSerializer out(TextSerializer::fileSink(file));
+    out.text(formatMetrics());
+    bool written = out.flush() && out.good();
+    written = (fclose(file) == 0) && written;
+    if (!written) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+    return !error;
+}
+
+bool HeadlessPipeline::loadProfile(std::string& error) {
+    addresses.clear();
+
+    if (!config.profile.empty()) {
+        ProfileDatabase database;
+        if (!database.openOrBuild(config.profileDirectory, config.profileDatabase)) {
+            error = "Cannot open profile database " + config.profileDatabase + " (sources: " + config.profileDirectory + ")";
+            return false;
+        }
+
+        ProfileDatabase::ProfileView view = database.findByName(config.profile);
+        if (!view.valid()) view = database.findProfile(config.profile);
+        if (!view.valid()) {
+            error = "Profile not found: " + config.profile;
+            return false;
+        }
+
+        ProfileDefinition profile = view.definition();
+        if (frameSource && config.enableEvents) eventDetector.applyProfile(profile);
+        if (frameSource && config.enableOcr) ocr.applyProfile(profile);
+        addresses = profile.addresses;
+    }
+
+    addresses.insert(addresses.end(), config.addresses.begin(), config.addresses.end());
+
+    // Names are resolved here so the memory loop only indexes
+    addressValueIds.clear();
+    addressSeriesIds.clear();
+    for (const auto& address : addresses) {
+        addressValueIds.push_back(eventDetector.registerMemoryValue(address.name));
+        addressSeriesIds.push_back(analytics.registerSeries(address.name));
+    }
+    return true;
+}
+
+void HeadlessPipeline::frameLoop() {
+    auto frameInterval = config.maxFps > 0
+        ? std::chrono::microseconds(1000000 / config.maxFps)
+        : std::chrono::microseconds(0);
+    auto nextFrame = std::chrono::steady_clock::now();
+    int64_t framesRead = 0;
+    cv::Mat frame;
+
+    while (!stopRequested) {
+        if (config.maxFrames > 0 && framesRead >= config.maxFrames) break;
+
+        auto captureBegin = std::chrono::steady_clock::now();
+        if (!frameSource->read(frame)) break;
+        if (frame.empty()) {
+            // Live source with nothing new yet
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        FrameTrace trace;
+        trace.captured = frameSource->captureTime();
+        if (trace.captured == std::chrono::steady_clock::time_point()) trace.captured = std::chrono::steady_clock::now();
+        trace.wallClockMs = wallClockMs();
+        recordStage(STAGE_CAPTURE, captureBegin, &trace);
+        ++framesRead;
+
+        // A repeated frame has nothing new for OCR or the detectors, but still counts as seen
+        bool duplicate = false;
+        if (config.frameDedup) {
+            auto dedupBegin = std::chrono::steady_clock::now();
+            duplicate = deduplicator.isDuplicate(frame);
+            recordStage(STAGE_DEDUP, dedupBegin, &trace);
+        }
+        {
+            std::lock_guard<std::mutex> lock(metricsMutex);
+            metrics.lastFrameTimeMs = trace.wallClockMs;
+        }
+        // Duplicates too, so clips keep real time; an unchanged frame encodes to a byte
+        if (highlightRecorder.isActive()) highlightRecorder.addFrame(frame, trace.wallClockMs);
+
+        if (duplicate) {
+            addCount(&Metrics::duplicateFrames, 1);
+        } else {
+            processFrame(frame, trace);
+            addCount(&Metrics::framesProcessed, 1);
+        }
+
+        if (frameInterval.count() > 0) {
+            nextFrame += frameInterval;
+            auto now = std::chrono::steady_clock::now();
+            if (nextFrame > now) {
+                std::this_thread::sleep_until(nextFrame);
+            } else {
+                nextFrame = now;    // Behind schedule: do not burst to catch up
+            }
+        }
+    }
+
+    frameLoopRunning = false;
+}
+
+void HeadlessPipeline::memoryLoop() {
+    auto interval = std::chrono::milliseconds(config.memoryIntervalMs);
+
+    while (!stopRequested) {
+        auto roundBegin = std::chrono::steady_clock::now();
+        int64_t wallClock = wallClockMs();
+        uint64_t samples = 0;
+        uint64_t failures = 0;
+
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            const auto& address = addresses[i];
+            int32_t value = 0;
+            if (!ProcessMemory::read(config.processId, address.address, &value, sizeof(value))) {
+                ++failures;
+                continue;
+            }
+            ++samples;
+
+            if (frameSource && config.enableEvents) {
+                eventDetector.observeMemoryValue(addressValueIds[i], value);
+            }
+            if (config.enableAnalytics) {
+                std::lock_guard<std::mutex> lock(analyticsMutex);
+                analytics.observeSeries(addressSeriesIds[i], value, wallClock);
+            }
+            if (sessionExporter.isOpen()) {
+                sessionExporter.addSample(wallClock, address.address, address.name, value);
+            }
+        }
+        recordStage(STAGE_MEMORY, roundBegin);
+        addCount(&Metrics::memorySamples, samples);
+        addCount(&Metrics::memoryReadFailures, failures);
+
+        if (config.enableAnalytics) {
+            std::vector<GameEventDetector::GameEvent> anomalies;
+            {
+                std::lock_guard<std::mutex> lock(analyticsMutex);
+                anomalies = analytics.drainAnomalyEvents();
+            }
+            if (sessionExporter.isOpen()) {
+                for (const auto& anomaly : anomalies) {
+                    sessionExporter.addEvent(wallClock, static_cast<int32_t>(anomaly.type),
+                                             anomaly.confidence, anomaly.description);
+                }
+            }
+            addCount(&Metrics::anomalies, anomalies.size());
+        }
+
+        std::unique_lock<std::mutex> lock(stopMutex);
+        stopCondition.wait_until(lock, roundBegin + interval, [this]() { return stopRequested.load(); });
+    }
+
+    memoryLoopRunning = false;
+}
+
+void HeadlessPipeline::processFrame(const cv::Mat& frame, const FrameTrace& trace) {
+    if (config.enableOcr) {
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<AdvancedOCR::TextRegion> regions = ocr.detectText(frame);
+        recordStage(STAGE_OCR, begin, &trace);
+        addCount(&Metrics::textRegions, regions.size());
+        if (config.enableEvents) {
+            for (const auto& region : regions) {
+                eventDetector.observeText(region.text);
+            }
+        }
+    }
+
+    if (config.enableEvents) {
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<GameEventDetector::GameEvent> events = eventDetector.detectEvents(frame);
+        recordStage(STAGE_EVENTS, begin, &trace);
+        if (highlightRecorder.isActive()) highlightRecorder.onEvents(events, trace.wallClockMs);
+        recordEvents(events, trace);
+    }
+}
+
+void HeadlessPipeline::recordEvents(const std::vector<GameEventDetector::GameEvent>& events, const FrameTrace& trace) {
+    if (events.empty()) return;
+    addCount(&Metrics::eventsDetected, events.size());
+
+    if (config.enableAnalytics) {
+        auto begin = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(analyticsMutex);
+            for (const auto& event : events) {
+                analytics.addEventData(event);
+            }
+        }
+        recordStage(STAGE_ANALYTICS, begin, &trace);
+    }
+
+    if (sessionExporter.isOpen()) {
+        for (const auto& event : events) {
+            sessionExporter.addEvent(trace.wallClockMs, static_cast<int32_t>(event.type), event.confidence, event.description);
+        }
+    }
+
+    double sinceCaptureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - trace.captured).count();
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    metrics.captureToEvent.record(sinceCaptureMs);
+}
+
+void HeadlessPipeline::recordStage(Stage stage, std::chrono::steady_clock::time_point begin, const FrameTrace* trace) {
+    auto now = std::chrono::steady_clock::now();
+    double elapsedMs = std::chrono::duration<double, std::milli>(now - begin).count();
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    StageMetrics& stageMetrics = metrics.stages[stage];
+    ++stageMetrics.count;
+    stageMetrics.totalMs += elapsedMs;
+    stageMetrics.maxMs = std::max(stageMetrics.maxMs, elapsedMs);
+    if (trace) {
+        metrics.captureToStage[stage].record(std::chrono::duration<double, std::milli>(now - trace->captured).count());
+    }
+}
+
+void HeadlessPipeline::addCount(uint64_t Metrics::*counter, uint64_t amount) {
+    if (amount == 0) return;
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    metrics.*counter += amount;
+}
+
+int64_t HeadlessPipeline::wallClockMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "advanced_ocr.h"
+#include "frame_deduplicator.h"
+#include "game_analytics.h"
+#include "highlight_recorder.h"
+#include "profile_database.h"
+#include "session_exporter.h"
+#include "thread_manager.h"
+
+// Settings for a headless run, read from a "key = value" file ('#' starts a comment).
+// The same keys can be overridden on the command line with --set key=value.
+//
+//   frames = video:<file> | camera:<index> | images:<directory> | synthetic:<seed> | screen | none
+//   max_fps = 0                 (0 = as fast as the source delivers)
+//   max_frames = 0              (0 = until the source ends)
+//   process_id = 0              (memory source; 0 = none)
+//   memory_interval_ms = 1000
+//   profile = <name>            (addresses, cues and HUD regions from game_profiles.db)
+//   profile_directory = game_profiles
+//   profile_database = game_profiles.db
+//   address = 0x<address> <name>   (repeatable; added to the profile's addresses)
+//   frame_dedup = true          (a frame identical to the previous one skips OCR and detectors)
+//   ocr = true | events = true | analytics = true
+//   ocr_backend = tesseract | crnn | crnn-fp16 | crnn-int8
+//   session_file = <path>       (samples and events; empty = none)
+//   session_format = binary | columnar
+//   metrics_file = <path>       (Prometheus text format; empty = none)
+//   metrics_interval_ms = 5000
+//   highlight_directory = <dir>    (clips around chosen events; empty = none)
+//   highlight_events = death,kill,achievement
+//   highlight_pre_ms = 5000 | highlight_post_ms = 3000
+//   highlight_buffer_mb = 64
+struct PipelineConfig {
+    std::string frameSource;
+    int maxFps;
+    int64_t maxFrames;
+    int processId;
+    int memoryIntervalMs;
+    std::string profile;
+    std::string profileDirectory;
+    std::string profileDatabase;
+    std::vector<ProfileDefinition::Address> addresses;
+    bool frameDedup;
+    bool enableOcr;
+    AdvancedOCR::OCRBackend ocrBackend;
+    CrnnRecognizer::Precision crnnPrecision;
+    bool enableEvents;
+    bool enableAnalytics;
+    std::string sessionFile;
+    SessionExporter::Format sessionFormat;
+    std::string metricsFile;
+    int metricsIntervalMs;
+    HighlightRecorder::Options highlights;  // Off while highlights.directory is empty
+
+    PipelineConfig();
+
+    // Unknown keys and malformed values are errors, so typos do not pass silently
+    bool set(const std::string& key, const std::string& value, std::string& error);
+    bool load(const std::string& path, std::string& error);
+};
+
+// Where frames come from. read() returns false once the source is exhausted.
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual bool open() = 0;
+    virtual bool read(cv::Mat& frame) = 0;
+    virtual std::string describe() const = 0;
+
+    // When the last frame read was captured, for sources that stamp their own frames;
+    // otherwise the epoch, and the frame counts as captured when read() returns
+    virtual std::chrono::steady_clock::time_point captureTime() const { return {}; }
+
+    // From a PipelineConfig::frameSource spec; null if the spec is not recognised
+    static std::unique_ptr<FrameSource> create(const std::string& spec);
+};
+
+// Reads another process's memory: ReadProcessMemory on Windows, process_vm_readv on Linux
+class ProcessMemory {
+public:
+    static bool read(int processId, uint64_t address, void* buffer, size_t size);
+    static int currentProcessId();
+};
+
+// Frames, memory, detectors, OCR, analytics and exporters wired together with no UI.
+// Frames are processed in order on one thread (event detection keeps per-frame
+// state) and memory is sampled on another; both feed the same analytics engine
+// and session file. Metrics are cumulative and safe to read while running.
+class HeadlessPipeline {
+public:
+    enum Stage {
+        STAGE_CAPTURE,
+        STAGE_DEDUP,
+        STAGE_OCR,
+        STAGE_EVENTS,
+        STAGE_ANALYTICS,
+        STAGE_MEMORY,
+        STAGE_COUNT
+    };
+
+    struct StageMetrics {
+        uint64_t count;
+        double totalMs;
+        double maxMs;
+
+        StageMetrics() : count(0), totalMs(0.0), maxMs(0.0) {}
+        double averageMs() const { return count ? totalMs / count : 0.0; }
+    };
+
+    // Fixed buckets, so snapshots copy and exposition needs no sorting
+    struct LatencyHistogram {
+        static constexpr int BUCKET_COUNT = 13;
+        static const double BUCKET_BOUNDS_MS[BUCKET_COUNT];   // Upper bounds; one more bucket above
+
+        uint64_t buckets[BUCKET_COUNT + 1];     // Per bucket, not cumulative
+        uint64_t count;
+        double totalMs;
+
+        LatencyHistogram();
+        void record(double ms);
+        double quantileMs(double quantile) const;   // Upper bound of the bucket it falls in
+    };
+
+    // Carried with one frame from capture through dedup, OCR, detectors and analytics
+    struct FrameTrace {
+        std::chrono::steady_clock::time_point captured;
+        int64_t wallClockMs;
+    };
+
+    struct Metrics {
+        double uptimeSeconds;
+        uint64_t framesProcessed;
+        uint64_t duplicateFrames;       // Captured but not processed
+        int64_t lastFrameTimeMs;        // Wall clock of the latest frame, duplicate or not
+        uint64_t textRegions;
+        uint64_t eventsDetected;
+        uint64_t memorySamples;
+        uint64_t memoryReadFailures;
+        uint64_t anomalies;
+        uint64_t sessionBytes;
+        uint64_t highlightClips;
+        uint64_t highlightBufferBytes;
+        StageMetrics stages[STAGE_COUNT];
+        LatencyHistogram captureToStage[STAGE_COUNT];   // Capture to the end of each frame stage
+        LatencyHistogram captureToEvent;                // Capture to events recorded, per frame with events
+
+        double framesPerSecond() const { return uptimeSeconds > 0 ? framesProcessed / uptimeSeconds : 0.0; }
+        double duplicateRatio() const {
+            uint64_t captured = framesProcessed + duplicateFrames;
+            return captured ? static_cast<double>(duplicateFrames) / captured : 0.0;
+        }
+    };
+
+    static const char* stageName(Stage stage);
+
+    explicit HeadlessPipeline(const PipelineConfig& config);
+    ~HeadlessPipeline();
+
+    HeadlessPipeline(const HeadlessPipeline&) = delete;
+    HeadlessPipeline& operator=(const HeadlessPipeline&) = delete;
+
+    bool start(std::string& error);
+    void stop();                // Stops both loops and closes the session file
+
+    // True while the frame loop runs, or the memory loop if there are no frames
+    bool isRunning() const;
+
+    Metrics getMetrics() const;
+    std::string formatMetrics() const;          // Prometheus text exposition format
+    bool writeMetricsFile(const std::string& path) const;   // Atomic replace
+
+private:
+    PipelineConfig config;
+    std::unique_ptr<FrameSource> frameSource;
+    std::vector<ProfileDefinition::Address> addresses;
+    std::vector<int> addressValueIds;       // Per address: its eventDetector memory value ID
+    std::vector<size_t> addressSeriesIds;   // Per address: its analytics series ID
+    FrameDeduplicator deduplicator;         // Frame thread only
+
+    ThreadManager threadManager;
+    AdvancedOCR ocr;
+    GameEventDetector eventDetector;
+    BloombergAnalyticsEngine analytics;
+    std::mutex analyticsMutex;              // The engine is not thread-safe
+    SessionExporter sessionExporter;
+    HighlightRecorder highlightRecorder;    // Frame thread only
+
+    std::thread frameThread;
+    std::thread memoryThread;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> frameLoopRunning;
+    std::atomic<bool> memoryLoopRunning;
+    std::mutex stopMutex;
+    std::condition_variable stopCondition;  // Wakes the memory loop early on stop()
+    std::chrono::steady_clock::time_point startTime;
+
+    mutable std::mutex metricsMutex;
+    Metrics metrics;
+
+    bool loadProfile(std::string& error);
+    void frameLoop();
+    void memoryLoop();
+    void processFrame(const cv::Mat& frame, const FrameTrace& trace);
+    void recordEvents(const std::vector<GameEventDetector::GameEvent>& events, const FrameTrace& trace);
+    void recordStage(Stage stage, std::chrono::steady_clock::time_point begin, const FrameTrace* trace = nullptr);
+    void addCount(uint64_t Metrics::*counter, uint64_t amount);
+
+    static int64_t wallClockMs();
+};
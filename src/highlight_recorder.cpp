@@ -0,0 +1,351 @@
+#include "highlight_recorder.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+// Zero runs shorter than this stay inside a literal; each pair costs at least two bytes
+constexpr size_t MIN_ZERO_RUN = 4;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool getVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+void appendRuns(const std::vector<uint8_t>& delta, std::vector<uint8_t>& out) {
+    size_t size = delta.size();
+    size_t i = 0;
+    while (i < size) {
+        size_t zeros = i;
+        while (zeros < size && delta[zeros] == 0) ++zeros;
+        size_t literal = zeros;
+        size_t end = literal;
+        while (end < size) {
+            if (delta[end] != 0) {
+                ++end;
+                continue;
+            }
+            size_t run = end;
+            while (run < size && run - end < MIN_ZERO_RUN && delta[run] == 0) ++run;
+            if (run - end >= MIN_ZERO_RUN || run == size) break;
+            end = run;
+        }
+        putVarint(out, zeros - i);
+        putVarint(out, end - literal);
+        out.insert(out.end(), delta.begin() + literal, delta.begin() + end);
+        i = end;
+    }
+}
+
+cv::Rect tileRect(int index, int tilesX, int tileSize, const cv::Size& size) {
+    int x = (index % tilesX) * tileSize;
+    int y = (index / tilesX) * tileSize;
+    return cv::Rect(x, y, std::min(tileSize, size.width - x), std::min(tileSize, size.height - y));
+}
+
+} // namespace
+
+// HighlightRecorder Implementation
+HighlightRecorder::Options::Options()
+    : preRollMs(5000), postRollMs(3000), maxBufferBytes(64u << 20), scale(0.5), tileSize(32),
+      keyframeIntervalMs(1000),
+      triggers{GameEventDetector::EventType::DEATH, GameEventDetector::EventType::KILL,
+               GameEventDetector::EventType::ACHIEVEMENT} {}
+
+HighlightRecorder::HighlightRecorder(TaskExecutor executor)
+    : executor(std::move(executor)), active(false), lastKeyframeMs(0), forceKeyframe(true), bufferBytes(0),
+      bufferedFrames(0), bufferedBytes(0), clipsWritten(0), clipsFailed(0) {}
+
+HighlightRecorder::~HighlightRecorder() {
+    stop();
+}
+
+bool HighlightRecorder::start(const Options& newOptions) {
+    stop();
+    options = newOptions;
+    options.scale = std::min(1.0, std::max(0.05, options.scale));
+    options.tileSize = std::max(8, options.tileSize);
+
+    std::error_code error;
+    if (options.directory.empty()) return false;
+    std::filesystem::create_directories(options.directory, error);
+    if (!std::filesystem::is_directory(options.directory, error)) return false;
+
+    clearBuffer();
+    active = true;
+    return true;
+}
+
+void HighlightRecorder::stop() {
+    if (active) {
+        flushClips(0, true);
+        active = false;
+    }
+    for (auto& write : writes) {
+        if (write.valid()) write.wait();
+    }
+    writes.clear();
+    clearBuffer();
+}
+
+void HighlightRecorder::addFrame(const cv::Mat& frame, int64_t timestampMs) {
+    if (!active || frame.empty() || frame.depth() != CV_8U) return;
+
+    // Stored as 8-bit BGR, which is what the clip writer takes
+    cv::Mat color;
+    if (frame.channels() == 4) {
+        cv::cvtColor(frame, color, cv::COLOR_BGRA2BGR);
+    } else if (frame.channels() == 1) {
+        cv::cvtColor(frame, color, cv::COLOR_GRAY2BGR);
+    } else {
+        color = frame;
+    }
+    cv::Mat scaled;
+    if (options.scale < 1.0) {
+        cv::Size size(std::max(1, static_cast<int>(color.cols * options.scale)),
+                      std::max(1, static_cast<int>(color.rows * options.scale)));
+        cv::resize(color, scaled, size, 0, 0, cv::INTER_AREA);
+    } else {
+        scaled = color.clone();     // The source may reuse its buffer
+    }
+
+    // A resolution change starts over; clips waiting on post-roll get what there is
+    if (!buffer.empty() && scaled.size() != buffer.back()->size) {
+        flushClips(0, true);
+        clearBuffer();
+    }
+
+    auto encoded = std::make_shared<EncodedFrame>();
+    encoded->timestampMs = timestampMs;
+    encoded->keyframe = buffer.empty() || forceKeyframe || timestampMs - lastKeyframeMs >= options.keyframeIntervalMs;
+    encoded->size = scaled.size();
+    encodeDelta(scaled, reference, encoded->keyframe, options.tileSize, encoded->data);
+    if (encoded->keyframe) {
+        lastKeyframeMs = timestampMs;
+        forceKeyframe = false;
+    }
+    reference = scaled;
+
+    bufferBytes += encoded->data.size();
+    buffer.push_back(std::move(encoded));
+
+    flushClips(timestampMs, false);
+    evict(timestampMs);
+    bufferedFrames = buffer.size();
+    bufferedBytes = bufferBytes;
+
+    // Forget finished writes so the list does not grow over a long session
+    writes.erase(std::remove_if(writes.begin(), writes.end(), [](std::future<void>& write) {
+        return !write.valid() || write.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }), writes.end());
+}
+
+void HighlightRecorder::onEvents(const std::vector<GameEventDetector::GameEvent>& events, int64_t timestampMs) {
+    if (!active) return;
+    for (const auto& event : events) {
+        if (std::find(options.triggers.begin(), options.triggers.end(), event.type) != options.triggers.end()) {
+            trigger(event.type, timestampMs);
+        }
+    }
+}
+
+void HighlightRecorder::trigger(GameEventDetector::EventType type, int64_t timestampMs) {
+    if (!active) return;
+    int64_t startMs = timestampMs - options.preRollMs;
+    int64_t endMs = timestampMs + options.postRollMs;
+    if (!pending.empty() && startMs <= pending.back().endMs) {
+        pending.back().endMs = std::max(pending.back().endMs, endMs);
+        return;
+    }
+    pending.push_back(Clip{type, timestampMs, startMs, endMs});
+}
+
+std::vector<std::string> HighlightRecorder::getClipPaths() const {
+    std::lock_guard<std::mutex> lock(pathsMutex);
+    return clipPaths;
+}
+
+void HighlightRecorder::evict(int64_t newestMs) {
+    // Kept back to the pre-roll, or further for a clip still collecting its post-roll
+    int64_t keepFromMs = newestMs - options.preRollMs;
+    if (!pending.empty()) keepFromMs = std::min(keepFromMs, pending.front().startMs);
+
+    // Only whole groups go: the frames after a keyframe need it to decode
+    while (true) {
+        size_t next = 1;
+        while (next < buffer.size() && !buffer[next]->keyframe) ++next;
+        if (next >= buffer.size()) break;
+        bool expired = buffer[next]->timestampMs <= keepFromMs;
+        if (!expired && bufferBytes <= options.maxBufferBytes) break;
+        for (size_t i = 0; i < next; ++i) {
+            bufferBytes -= buffer.front()->data.size();
+            buffer.pop_front();
+        }
+    }
+    // One group over budget: start another so the next call can drop this one
+    if (bufferBytes > options.maxBufferBytes) forceKeyframe = true;
+}
+
+void HighlightRecorder::flushClips(int64_t newestMs, bool all) {
+    while (!pending.empty() && (all || pending.front().endMs <= newestMs)) {
+        Clip clip = pending.front();
+        pending.pop_front();
+
+        // The buffer always starts at a keyframe; decode from the last one at or before the clip
+        size_t first = 0;
+        for (size_t i = 0; i < buffer.size() && buffer[i]->timestampMs <= clip.startMs; ++i) {
+            if (buffer[i]->keyframe) first = i;
+        }
+        std::vector<FramePtr> frames;
+        for (size_t i = first; i < buffer.size() && buffer[i]->timestampMs <= clip.endMs; ++i) {
+            frames.push_back(buffer[i]);
+        }
+        if (frames.empty()) continue;
+
+        std::string path = (std::filesystem::path(options.directory) /
+            (std::string(GameEventDetector::eventTypeName(clip.type)) + "_" + std::to_string(clip.eventMs) + ".avi")).string();
+        int64_t startMs = clip.startMs;
+        std::function<void()> task = [this, path, frames = std::move(frames), startMs]() {
+            writeClip(path, frames, startMs);
+        };
+        writes.push_back(executor ? executor(std::move(task)) : std::async(std::launch::async, std::move(task)));
+    }
+}
+
+void HighlightRecorder::writeClip(const std::string& path, const std::vector<FramePtr>& frames, int64_t startMs) {
+    // Frame rate from the timestamps, since captures rarely arrive at a fixed rate
+    int64_t firstMs = -1;
+    int64_t lastMs = -1;
+    size_t written = 0;
+    for (const auto& frame : frames) {
+        if (frame->timestampMs < startMs) continue;
+        if (firstMs < 0) firstMs = frame->timestampMs;
+        lastMs = frame->timestampMs;
+        ++written;
+    }
+    double fps = written > 1 && lastMs > firstMs ? (written - 1) * 1000.0 / (lastMs - firstMs) : 30.0;
+    fps = std::min(120.0, std::max(1.0, fps));
+
+    cv::VideoWriter writer(path, cv::VideoWriter::fourcc('M', 'J', 'P', 'G'), fps, frames.front()->size);
+    bool ok = writer.isOpened();
+    cv::Mat canvas(frames.front()->size, CV_8UC3, cv::Scalar::all(0));
+    for (size_t i = 0; ok && i < frames.size(); ++i) {
+        const EncodedFrame& frame = *frames[i];
+        ok = applyDelta(frame.data.data(), frame.data.size(), canvas, options.tileSize);
+        if (ok && frame.timestampMs >= startMs) writer.write(canvas);
+    }
+    writer.release();
+
+    if (!ok) {
+        ++clipsFailed;
+        return;
+    }
+    ++clipsWritten;
+    std::lock_guard<std::mutex> lock(pathsMutex);
+    clipPaths.push_back(path);
+}
+
+void HighlightRecorder::clearBuffer() {
+    buffer.clear();
+    pending.clear();
+    reference.release();
+    bufferBytes = 0;
+    forceKeyframe = true;
+    bufferedFrames = 0;
+    bufferedBytes = 0;
+}
+
+void HighlightRecorder::encodeDelta(const cv::Mat& frame, const cv::Mat& reference, bool keyframe,
+                                    int tileSize, std::vector<uint8_t>& out) {
+    bool useReference = !keyframe && reference.size() == frame.size() && reference.type() == frame.type();
+    out.clear();
+    out.push_back(useReference ? 0 : 1);
+
+    const size_t pixelBytes = frame.elemSize();
+    const int tilesX = (frame.cols + tileSize - 1) / tileSize;
+    const int tilesY = (frame.rows + tileSize - 1) / tileSize;
+    std::vector<uint8_t> delta;
+
+    for (int index = 0; index < tilesX * tilesY; ++index) {
+        cv::Rect tile = tileRect(index, tilesX, tileSize, frame.size());
+        size_t rowBytes = tile.width * pixelBytes;
+        size_t offset = tile.x * pixelBytes;
+
+        if (useReference) {
+            bool same = true;
+            for (int y = tile.y; same && y < tile.y + tile.height; ++y) {
+                same = std::memcmp(frame.ptr<uint8_t>(y) + offset, reference.ptr<uint8_t>(y) + offset, rowBytes) == 0;
+            }
+            if (same) continue;
+        }
+
+        delta.resize(rowBytes * tile.height);
+        uint8_t* target = delta.data();
+        for (int y = tile.y; y < tile.y + tile.height; ++y, target += rowBytes) {
+            const uint8_t* current = frame.ptr<uint8_t>(y) + offset;
+            if (useReference) {
+                const uint8_t* previous = reference.ptr<uint8_t>(y) + offset;
+                for (size_t i = 0; i < rowBytes; ++i) target[i] = current[i] ^ previous[i];
+            } else {
+                std::memcpy(target, current, rowBytes);
+            }
+        }
+        putVarint(out, static_cast<uint64_t>(index));
+        appendRuns(delta, out);
+    }
+}
+
+bool HighlightRecorder::applyDelta(const uint8_t* data, size_t size, cv::Mat& canvas, int tileSize) {
+    if (!data || size == 0 || canvas.empty() || canvas.depth() != CV_8U) return false;
+    const uint8_t* in = data;
+    const uint8_t* end = data + size;
+    if (*in++) canvas.setTo(cv::Scalar::all(0));
+
+    const size_t pixelBytes = canvas.elemSize();
+    const int tilesX = (canvas.cols + tileSize - 1) / tileSize;
+    const int tilesY = (canvas.rows + tileSize - 1) / tileSize;
+    std::vector<uint8_t> delta;
+
+    while (in < end) {
+        uint64_t index = 0;
+        if (!getVarint(in, end, index) || index >= static_cast<uint64_t>(tilesX) * tilesY) return false;
+        cv::Rect tile = tileRect(static_cast<int>(index), tilesX, tileSize, canvas.size());
+        size_t rowBytes = tile.width * pixelBytes;
+        size_t offset = tile.x * pixelBytes;
+
+        delta.assign(rowBytes * tile.height, 0);
+        size_t position = 0;
+        while (position < delta.size()) {
+            uint64_t zeros = 0;
+            uint64_t literal = 0;
+            if (!getVarint(in, end, zeros) || !getVarint(in, end, literal)) return false;
+            if (zeros + literal > delta.size() - position || literal > static_cast<uint64_t>(end - in)) return false;
+            if (zeros + literal == 0) return false;
+            position += zeros;
+            std::memcpy(delta.data() + position, in, literal);
+            position += literal;
+            in += literal;
+        }
+
+        const uint8_t* source = delta.data();
+        for (int y = tile.y; y < tile.y + tile.height; ++y, source += rowBytes) {
+            uint8_t* target = canvas.ptr<uint8_t>(y) + offset;
+            for (size_t i = 0; i < rowBytes; ++i) target[i] ^= source[i];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "game_analytics.h"
+#include "session_exporter.h"
+
+// Keeps the last few seconds of frames in memory and writes a clip around chosen
+// events (deaths, kills, achievements): the pre-roll before the event and the
+// post-roll after it. Frames are downscaled and stored as tiles XORed against the
+// previous frame and run-length coded, with a keyframe every keyframeIntervalMs, so
+// a mostly static screen costs little and the buffer is bounded in bytes as well as
+// time. Clips are decoded and written (MJPG .avi) by the executor, off the frame
+// thread. addFrame, onEvents and trigger must be called from one thread.
+class HighlightRecorder {
+public:
+    using TaskExecutor = AsyncFileWriter::TaskExecutor;
+
+    struct Options {
+        std::string directory;
+        int64_t preRollMs;
+        int64_t postRollMs;
+        size_t maxBufferBytes;      // Oldest frames go first when over, pre-roll or not
+        double scale;               // Applied before encoding; 1.0 keeps full size
+        int tileSize;
+        int64_t keyframeIntervalMs;
+        std::vector<GameEventDetector::EventType> triggers;
+
+        Options();
+    };
+
+    struct EncodedFrame {
+        int64_t timestampMs;
+        bool keyframe;
+        cv::Size size;
+        std::vector<uint8_t> data;  // See encodeDelta
+    };
+
+    explicit HighlightRecorder(TaskExecutor executor = TaskExecutor());
+    ~HighlightRecorder();
+
+    HighlightRecorder(const HighlightRecorder&) = delete;
+    HighlightRecorder& operator=(const HighlightRecorder&) = delete;
+
+    bool start(const Options& options);     // False if the directory cannot be created
+    void stop();                            // Writes pending clips with what is buffered, then waits
+    bool isActive() const { return active; }
+
+    void addFrame(const cv::Mat& frame, int64_t timestampMs);
+    void onEvents(const std::vector<GameEventDetector::GameEvent>& events, int64_t timestampMs);
+    // A clip overlapping the previous pending one extends it instead
+    void trigger(GameEventDetector::EventType type, int64_t timestampMs);
+
+    size_t getBufferedFrames() const { return bufferedFrames.load(); }
+    size_t getBufferedBytes() const { return bufferedBytes.load(); }
+    uint64_t getClipsWritten() const { return clipsWritten.load(); }
+    uint64_t getClipsFailed() const { return clipsFailed.load(); }
+    std::vector<std::string> getClipPaths() const;
+
+    // One byte keyframe flag, then for each tile that differs from reference: its index
+    // (varint) and its bytes XOR reference as (zero run, literal length, literal bytes)
+    // pairs. A keyframe, or a reference of another size or type, XORs against zero
+    // and writes every tile. frame must be 8-bit
+    static void encodeDelta(const cv::Mat& frame, const cv::Mat& reference, bool keyframe,
+                            int tileSize, std::vector<uint8_t>& out);
+    // Applies an encodeDelta result to canvas, which must already have the frame's size
+    // and type. False on malformed data
+    static bool applyDelta(const uint8_t* data, size_t size, cv::Mat& canvas, int tileSize);
+
+private:
+    struct Clip {
+        GameEventDetector::EventType type;
+        int64_t eventMs;
+        int64_t startMs;
+        int64_t endMs;
+    };
+
+    using FramePtr = std::shared_ptr<const EncodedFrame>;
+
+    TaskExecutor executor;
+    Options options;
+    bool active;
+
+    std::deque<FramePtr> buffer;
+    cv::Mat reference;                      // Last frame added, as encoded
+    int64_t lastKeyframeMs;
+    bool forceKeyframe;
+    size_t bufferBytes;
+    std::deque<Clip> pending;
+    std::vector<std::future<void>> writes;
+
+    std::atomic<size_t> bufferedFrames;
+    std::atomic<size_t> bufferedBytes;
+    std::atomic<uint64_t> clipsWritten;
+    std::atomic<uint64_t> clipsFailed;
+    mutable std::mutex pathsMutex;
+    std::vector<std::string> clipPaths;
+
+    void evict(int64_t newestMs);
+    void flushClips(int64_t newestMs, bool all);
+    void writeClip(const std::string& path, const std::vector<FramePtr>& frames, int64_t startMs);
+    void clearBuffer();
+};
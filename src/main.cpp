@@ -27,6 +27,13 @@
 #include "game_analytics.h"
 #include "thread_manager.h"
 #include "performance_monitor.h"
+#include "stats_kernels.h"
+#include "ring_buffer.h"
+#include "profile_database.h"
+#include "profile_watcher.h"
+#include "session_exporter.h"
+#include "text_serializer.h"
+#include "startup_graph.h"
 
 
 // Real process information structure
@@ -667,6 +674,7 @@ private:
     std::atomic<bool> monitoring;
     std::atomic<bool> scanning;
     std::atomic<bool> visionAnalyzing;
+    std::atomic<bool> lastFrameAnalyzed;    // OCR and detectors have run on lastFrameData
     ProcessInfo* selectedProcess;
     bool showSystemProcesses;
     
@@ -680,21 +688,36 @@ private:
     GameEventDetector gameEventDetector;
     GameFingerprinting gameFingerprinting;
     BloombergAnalyticsEngine bloombergAnalytics;
+    ProfileDatabase profileDatabase;        // game_profiles/ compiled to game_profiles.db
     
     // Thread management
     ThreadManager threadManager;
+    ProfileWatcher profileWatcher;          // Declared after its consumers so it stops first
+    std::mutex activeProfileMutex;
+    std::string activeProfileFile;          // Source file of the loaded profile, reloaded on change
+    uint64_t activeProfileGeneration = 0;   // Bumped per load; a reload for an older one is dropped
+    
+    // Every monitored sample and anomaly, streamed to session_<time>.gasx on the IO pool.
+    // sessionMutex orders the monitoring loop's writes against close; a loop whose
+    // generation is stale drops its samples instead of writing them into the next session
+    std::mutex sessionMutex;
+    std::atomic<uint32_t> sessionGeneration{0};
+    SessionExporter sessionRecorder{[this](std::function<void()> task) { return threadManager.submitIOTask(std::move(task)); }};
     SmartDialogManager dialogManager;
+    StartupGraph startupGraph;              // Last, so background warm-ups finish before teardown
     
     // Legacy compatibility
     std::vector<uint8_t> lastFrameData;
-    int frameWidth, frameHeight;
+    std::atomic<int> frameWidth, frameHeight;   // Written on capture, read by profile reloads on the IO pool
     std::vector<std::string> detectedTexts;
     
     // Analytics engine
     struct PerformanceMetrics {
-        std::vector<float> memoryValues;
-        std::vector<float> visionConfidence;
-        std::vector<int64_t> timestamps;
+        static constexpr size_t HISTORY_CAPACITY = 4096;    // Samples kept per series
+        
+        RingBuffer<float> memoryValues{HISTORY_CAPACITY};
+        RingBuffer<float> visionConfidence{HISTORY_CAPACITY};
+        RingBuffer<int64_t> timestamps{HISTORY_CAPACITY};
         float averageMemoryStability;
         float averageVisionAccuracy;
         int totalAnalysisRuns;
@@ -703,7 +726,7 @@ private:
     } analytics;
     
 public:
-    RealGameAnalyzerGUI() : hwnd(nullptr), monitoring(false), scanning(false), visionAnalyzing(false), selectedProcess(nullptr), showSystemProcesses(false), frameWidth(0), frameHeight(0), hBackgroundBrush(nullptr), hPanelBrush(nullptr), hCardBrush(nullptr), hModernFont(nullptr), hBoldFont(nullptr), hHeaderFont(nullptr), hTooltipWindow(nullptr), hButtonHoverBrush(nullptr), hButtonPressedBrush(nullptr), hBorderBrush(nullptr) {
+    RealGameAnalyzerGUI() : hwnd(nullptr), monitoring(false), scanning(false), visionAnalyzing(false), lastFrameAnalyzed(false), selectedProcess(nullptr), showSystemProcesses(false), frameWidth(0), frameHeight(0), hBackgroundBrush(nullptr), hPanelBrush(nullptr), hCardBrush(nullptr), hModernFont(nullptr), hBoldFont(nullptr), hHeaderFont(nullptr), hTooltipWindow(nullptr), hButtonHoverBrush(nullptr), hButtonPressedBrush(nullptr), hBorderBrush(nullptr) {
         refreshProcesses();
         initializeModernUI();
     }
@@ -1376,63 +1399,119 @@ public:
     }
     
     void initializeAdvancedComponents() {
-        // Initialize thread manager
-        threadManager.initialize(8, 32);
+        // Components start as soon as their dependencies are up, independent ones in
+        // parallel. Nothing here may touch the window: the UI thread is blocked in run()
+        // until the blocking components finish, so a cross-thread SetWindowText would deadlock.
+        using Mode = StartupGraph::Mode;
+        
+        startupGraph.addComponent("ThreadManager", {}, [this]() {
+            threadManager.initialize(8, 32);
+            return true;
+        });
         
         // Initialize advanced screen capture with GPU acceleration
-        optimizedScreenCapture.initialize(true, true);
-        optimizedScreenCapture.setCaptureMode(OptimizedScreenCapture::CaptureMode::GAME_WINDOW);
-        optimizedScreenCapture.setMaxFPS(60);
+        startupGraph.addComponent("ScreenCapture", {}, [this]() {
+            bool captureReady = optimizedScreenCapture.initialize(true, true);
+            optimizedScreenCapture.setCaptureMode(OptimizedScreenCapture::CaptureMode::GAME_WINDOW);
+            optimizedScreenCapture.setMaxFPS(60);
+            return captureReady;
+        });
+        
+        // Tesseract only locates its traineddata here; loading it is a background warm-up,
+        // and the first detectText() loads it if that has not finished yet
+        startupGraph.addComponent("OCR", {}, [this]() {
+            advancedOCR.enableCaching(true);
+            advancedOCR.setModelSource(AdvancedOCR::ModelSource::SHARED_MAPPING);
+            return advancedOCR.initialize(AdvancedOCR::OCRBackend::TESSERACT, AdvancedOCR::LoadMode::LAZY);
+        });
+        startupGraph.addComponent("OCRWarmup", {"OCR"}, [this]() {
+            return advancedOCR.warmUp();
+        }, Mode::BACKGROUND);
+        
+        startupGraph.addComponent("FrameCache", {}, [this]() {
+            frameCache.~FrameCache();
+            new(&frameCache) FrameCache(100, 5000); // 100 frames, 5 second timeout
+            return true;
+        });
         
-        // Initialize advanced OCR with Windows.Media.Ocr (fallback to Tesseract)
-        if (!advancedOCR.initialize(AdvancedOCR::OCRBackend::TESSERACT)) {
-            // Fallback to basic initialization
-        }
-        advancedOCR.enableCaching(true);
+        // Initialize intelligent region processor
+        startupGraph.addComponent("RegionProcessor", {}, [this]() {
+            regionProcessor.clearRegions();
+            
+            // Add default processing regions for common game UI elements
+            IntelligentRegionProcessor::ProcessingRegion hudRegion;
+            hudRegion.name = "HUD";
+            hudRegion.rect = cv::Rect(0, 0, 1920, 200); // Top HUD area
+            hudRegion.fps = 30;
+            hudRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
+            regionProcessor.addRegion(hudRegion);
+            
+            IntelligentRegionProcessor::ProcessingRegion healthRegion;
+            healthRegion.name = "Health";
+            healthRegion.rect = cv::Rect(50, 50, 200, 100); // Health bar area
+            healthRegion.fps = 10;
+            healthRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
+            regionProcessor.addRegion(healthRegion);
+            
+            IntelligentRegionProcessor::ProcessingRegion scoreRegion;
+            scoreRegion.name = "Score";
+            scoreRegion.rect = cv::Rect(1600, 50, 300, 100); // Score area
+            scoreRegion.fps = 10;
+            scoreRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
+            regionProcessor.addRegion(scoreRegion);
+            return true;
+        });
         
-        // Initialize frame cache
-        frameCache.~FrameCache();
-        new(&frameCache) FrameCache(100, 5000); // 100 frames, 5 second timeout
+        startupGraph.addComponent("EventDetector", {}, [this]() {
+            return gameEventDetector.initialize();
+        });
         
-        // Initialize intelligent region processor
-        regionProcessor = IntelligentRegionProcessor();
-        
-        // Add default processing regions for common game UI elements
-        IntelligentRegionProcessor::ProcessingRegion hudRegion;
-        hudRegion.name = "HUD";
-        hudRegion.rect = cv::Rect(0, 0, 1920, 200); // Top HUD area
-        hudRegion.fps = 30;
-        hudRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
-        regionProcessor.addRegion(hudRegion);
-        
-        IntelligentRegionProcessor::ProcessingRegion healthRegion;
-        healthRegion.name = "Health";
-        healthRegion.rect = cv::Rect(50, 50, 200, 100); // Health bar area
-        healthRegion.fps = 10;
-        healthRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
-        regionProcessor.addRegion(healthRegion);
-        
-        IntelligentRegionProcessor::ProcessingRegion scoreRegion;
-        scoreRegion.name = "Score";
-        scoreRegion.rect = cv::Rect(1600, 50, 300, 100); // Score area
-        scoreRegion.fps = 10;
-        scoreRegion.requiredState = IntelligentRegionProcessor::GameState::GAMEPLAY;
-        regionProcessor.addRegion(scoreRegion);
-        
-        // Initialize game event detector
-        gameEventDetector.initialize();
-        
-        // Initialize game fingerprinting
-        gameFingerprinting.initialize();
+        startupGraph.addComponent("Fingerprinting", {}, [this]() {
+            return gameFingerprinting.initialize();
+        });
+        
+        // Compiled profile database (rebuilt only if game_profiles/ changed) also feeds fingerprinting
+        startupGraph.addComponent("ProfileDatabase", {"Fingerprinting"}, [this]() {
+            if (!profileDatabase.openOrBuild("game_profiles", "game_profiles.db")) return false;
+            gameFingerprinting.loadProfileDatabase(profileDatabase);
+            return true;
+        });
+        
+        // Edits to the loaded profile apply to the running pipeline without a restart; reloads
+        // run on the IO pool. OCR is not a dependency: its profile state is an RCU snapshot,
+        // and a missing tessdata must not stop hot reload for the other components
+        startupGraph.addComponent("ProfileWatcher", {"ThreadManager", "EventDetector", "RegionProcessor"}, [this]() {
+            return profileWatcher.start("game_profiles", [this](const std::vector<std::string>& changedFiles) {
+                onProfilesChanged(changedFiles);
+            });
+        });
         
         // Initialize Bloomberg analytics engine
-        bloombergAnalytics.initialize(20, 0.1); // 20 period lookback, 0.1 smoothing
+        startupGraph.addComponent("Analytics", {}, [this]() {
+            bloombergAnalytics.initialize(20, 0.1); // 20 period lookback, 0.1 smoothing
+            return true;
+        });
         
         // Initialize dialog manager
-        dialogManager.~SmartDialogManager();
-        new(&dialogManager) SmartDialogManager();
+        startupGraph.addComponent("DialogManager", {}, [this]() {
+            dialogManager.~SmartDialogManager();
+            new(&dialogManager) SmartDialogManager();
+            return true;
+        }, Mode::CALLER);
         
-        setStatus("Advanced components initialized - Ready for professional gaming analytics");
+        // The full timeline, warm-ups included, is written once everything has finished
+        startupGraph.setCompletionCallback([this]() {
+            FILE* file = fopen("startup_timeline.txt", "w");
+            if (file) {
+                std::string timeline = startupGraph.formatTimeline();
+                fwrite(timeline.data(), 1, timeline.size(), file);
+                fclose(file);
+            }
+        });
+        
+        bool allReady = startupGraph.run();
+        setStatus("Advanced components initialized in %.0f ms%s - Ready for professional gaming analytics",
+                  startupGraph.getElapsedMs(), allReady ? "" : " (some failed, see startup_timeline.txt)");
     }
     
     bool isUserApplication(const std::string& processName) {
@@ -1693,6 +1772,11 @@ public:
         
         if (monitoring) {
             monitoring = false;
+            {
+                std::lock_guard<std::mutex> lock(sessionMutex);
+                ++sessionGeneration;
+                sessionRecorder.close();
+            }
             SetWindowText(hStartButton, "Start Monitoring");
             SetWindowText(hStatusLabel, "Monitoring stopped.");
         } else {
@@ -1700,15 +1784,31 @@ public:
             SetWindowText(hStartButton, "Stop Monitoring");
             SetWindowText(hStatusLabel, "Monitoring started...");
             
+            time_t started = time(0);
+            char sessionFile[64];
+            strftime(sessionFile, sizeof(sessionFile), "session_%Y%m%d_%H%M%S.gasx", localtime(&started));
+            uint32_t session;
+            {
+                std::lock_guard<std::mutex> lock(sessionMutex);
+                session = ++sessionGeneration;
+                sessionRecorder.open(sessionFile);
+            }
+            
             // Start monitoring thread
-            std::thread([this]() {
+            std::thread([this, session]() {
                 int sample = 0;
-                while (monitoring && selectedProcess) {
+                while (monitoring && selectedProcess && session == sessionGeneration) {
                     char status[200];
                     sprintf(status, "Monitoring %s... Sample %d", selectedProcess->name.c_str(), sample);
                     SetWindowText(hStatusLabel, status);
                     
+                    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+                    int64_t wallClock = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::system_clock::now().time_since_epoch()).count();
+                    
                     // Try to read memory from selected process
+                    std::vector<std::pair<std::pair<std::string, uintptr_t>, int32_t>> reads;
                     for (const auto& memAddr : memoryAddresses) {
                         int32_t value;
                         if (MemoryReader::readMemory(selectedProcess->pid, memAddr.second, &value, sizeof(value))) {
@@ -1716,9 +1816,31 @@ public:
                             char memStatus[300];
                             sprintf(memStatus, "%s: %s = %d", status, memAddr.first.c_str(), value);
                             SetWindowText(hStatusLabel, memStatus);
+                            bloombergAnalytics.observeSeries(memAddr.first, value, now);
+                            reads.emplace_back(memAddr, value);
                         }
                     }
                     
+                    // Surface the latest value or pipeline anomaly
+                    auto anomalies = bloombergAnalytics.drainAnomalyEvents();
+                    {
+                        // Not held across SetWindowText, which waits on the UI thread
+                        std::lock_guard<std::mutex> lock(sessionMutex);
+                        if (session != sessionGeneration) break;
+                        for (const auto& read : reads) {
+                            sessionRecorder.addSample(wallClock, read.first.second, read.first.first, read.second);
+                        }
+                        for (const auto& anomaly : anomalies) {
+                            sessionRecorder.addEvent(wallClock, static_cast<int32_t>(anomaly.type), anomaly.confidence,
+                                                     anomaly.description);
+                        }
+                    }
+                    if (!anomalies.empty()) {
+                        char anomalyStatus[300];
+                        sprintf(anomalyStatus, "%s | %s", status, anomalies.back().description.c_str());
+                        SetWindowText(hStatusLabel, anomalyStatus);
+                    }
+                    
                     sample++;
                     std::this_thread::sleep_for(std::chrono::seconds(1));
                 }
@@ -1729,35 +1851,49 @@ public:
     void exportData() {
         SetWindowText(hStatusLabel, "Exporting data to game_analysis.csv...");
         
-        FILE* file = fopen("game_analysis.csv", "w");
-        if (file) {
-            fprintf(file, "Timestamp,Process,Address,Name,Value\n");
+        // Memory reads and file writes happen on the IO pool; the UI and monitoring keep running
+        DWORD pid = selectedProcess ? selectedProcess->pid : 0;
+        std::string processName = selectedProcess ? selectedProcess->name : "";
+        std::vector<std::pair<std::string, uintptr_t>> addresses;
+        if (selectedProcess) addresses = memoryAddresses;
+        
+        threadManager.submitIOTask([this, pid, processName, addresses]() {
+            FILE* file = fopen("game_analysis.csv", "w");
+            if (!file) {
+                SetWindowText(hStatusLabel, "Error: Could not create export file!");
+                return;
+            }
+            TextSerializer csv(TextSerializer::fileSink(file));
+            csv.text("Timestamp,Process,Address,Name,Value").newline();
             
             time_t now = time(0);
             char timestamp[100];
             strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", localtime(&now));
+            int64_t wallClock = static_cast<int64_t>(now) * 1000;
             
-            if (selectedProcess) {
-                for (const auto& memAddr : memoryAddresses) {
-                    int32_t value = 0;
-                    if (MemoryReader::readMemory(selectedProcess->pid, memAddr.second, &value, sizeof(value))) {
-                        fprintf(file, "%s,%s,0x%llX,%s,%d\n", 
-                               timestamp, selectedProcess->name.c_str(), 
-                               (unsigned long long)memAddr.second, memAddr.first.c_str(), value);
-                    }
+            // Same snapshot in the binary session format for tooling
+            SessionExporter snapshot;
+            snapshot.open("game_analysis.gasx");
+            
+            for (const auto& memAddr : addresses) {
+                int32_t value = 0;
+                if (MemoryReader::readMemory(pid, memAddr.second, &value, sizeof(value))) {
+                    csv.text(timestamp).character(',').text(processName).text(",0x").hex(memAddr.second)
+                       .character(',').text(memAddr.first).character(',').integer(value).newline();
+                    snapshot.addSample(wallClock, memAddr.second, memAddr.first, value);
                 }
             }
             
+            csv.flush();
             fclose(file);
+            snapshot.close();
             
-            char status[200];
+            char status[300];
             char cwd[256];
             getcwd(cwd, sizeof(cwd));
             sprintf(status, "Data exported to: %s/game_analysis.csv", cwd);
             SetWindowText(hStatusLabel, status);
-        } else {
-            SetWindowText(hStatusLabel, "Error: Could not create export file!");
-        }
+        });
     }
     
     void scanProcessMemory() {
@@ -2064,20 +2200,56 @@ public:
         
         setStatus("Loading game profile for %s...", selectedProcess->name.c_str());
         
-        // Try to load from game_profiles directory first
-        std::string gameProfilesPath = "game_profiles/" + selectedProcess->name + ".txt";
-        FILE* file = fopen(gameProfilesPath.c_str(), "r");
-        
-        // If not found in game_profiles, try local profile
-        if (!file) {
-            std::string localProfile = selectedProcess->name + "_profile.txt";
-            file = fopen(localProfile.c_str(), "r");
+        // Try the compiled game_profiles database first (recompiled if a source file changed)
+        profileDatabase.openOrBuild("game_profiles", "game_profiles.db");
+        ProfileDatabase::ProfileView compiledProfile = profileDatabase.findProfile(selectedProcess->name);
+        if (compiledProfile.valid()) {
+            {
+                // Applied under the lock so a reload in flight cannot land after it
+                std::lock_guard<std::mutex> lock(activeProfileMutex);
+                ++activeProfileGeneration;
+                activeProfileFile = compiledProfile.sourceFile();
+                applyProfileToPipeline(compiledProfile.definition());
+            }
+            
+            int loadedCount = 0;
+            for (size_t i = 0; i < compiledProfile.addressCount(); ++i) {
+                const ProfileDatabase::AddressRecord& entry = compiledProfile.address(i);
+                uintptr_t address = static_cast<uintptr_t>(entry.address);
+                
+                bool exists = false;
+                for (const auto& memAddr : memoryAddresses) {
+                    if (memAddr.second == address) {
+                        exists = true;
+                        break;
+                    }
+                }
+                
+                if (!exists) {
+                    addMemoryAddress(MemoryScanner::addressToString(address), profileDatabase.text(entry.name));
+                    loadedCount++;
+                }
+            }
+            
+            if (loadedCount > 0) {
+                char infoMsg[200];
+                sprintf(infoMsg, "Successfully loaded %d addresses from %s profile. You can now start monitoring!", loadedCount, compiledProfile.name());
+                showInfo("Profile Loaded", infoMsg);
+                setStatus("Loaded %d addresses from game_profiles profile", loadedCount);
+            } else {
+                showWarning("No New Addresses", "Profile loaded but no new addresses were added. All addresses may already be in your monitoring list.");
+            }
+            return;
         }
         
+        // Otherwise fall back to a local profile saved by the user
+        std::string localProfile = selectedProcess->name + "_profile.txt";
+        FILE* file = fopen(localProfile.c_str(), "r");
+        
         if (file) {
             char line[256];
             int loadedCount = 0;
-            std::string profileSource = (file == fopen(gameProfilesPath.c_str(), "r")) ? "game_profiles" : "local";
+            std::string profileSource = "local";
             
             while (fgets(line, sizeof(line), file)) {
                 // Skip comments and empty lines
@@ -2126,8 +2298,8 @@ public:
                 showWarning("No New Addresses", "Profile loaded but no new addresses were added. All addresses may already be in your monitoring list.");
             }
         } else {
-            // Check if game_profiles directory exists
-            if (fopen("game_profiles", "r")) {
+            // Check if the game_profiles database is available
+            if (profileDatabase.isOpen()) {
                 char warningMsg[200];
                 sprintf(warningMsg, "No profile found for '%s'. Available profiles are in the 'game_profiles' folder. Save a profile first or use memory scanning.", selectedProcess->name.c_str());
                 showWarning("No Profile Found", warningMsg);
@@ -2139,34 +2311,54 @@ public:
         }
     }
     
+    // HUD regions and cues of a profile go to OCR, region scheduling and event detection;
+    // each swaps its config atomically, so capture keeps running on the old one meanwhile
+    void applyProfileToPipeline(const ProfileDefinition& profile) {
+        int width = frameWidth.load(), height = frameHeight.load();
+        cv::Size frameSize = width > 0 && height > 0 ? cv::Size(width, height) : cv::Size(1920, 1080);
+        gameEventDetector.applyProfile(profile);
+        advancedOCR.applyProfile(profile);
+        regionProcessor.applyProfile(profile, frameSize);
+    }
+    
+    // Watcher thread: only the active profile matters, and it is reparsed on the IO pool
+    void onProfilesChanged(const std::vector<std::string>& changedFiles) {
+        profileDatabase.markSourcesChanged();       // Next openOrBuild rechecks the sources
+        
+        std::string sourceFile;
+        uint64_t generation;
+        {
+            std::lock_guard<std::mutex> lock(activeProfileMutex);
+            sourceFile = activeProfileFile;
+            generation = activeProfileGeneration;
+        }
+        if (sourceFile.empty() || std::find(changedFiles.begin(), changedFiles.end(), sourceFile) == changedFiles.end()) {
+            return;
+        }
+        
+        threadManager.submitIOTask([this, sourceFile, generation]() {
+            ProfileDefinition profile;
+            if (!ProfileDatabase::parseProfile("game_profiles/" + sourceFile, profile)) return;
+            
+            // Another profile loaded while this one was parsed: it stays
+            std::lock_guard<std::mutex> lock(activeProfileMutex);
+            if (generation == activeProfileGeneration) applyProfileToPipeline(profile);
+        });
+    }
+    
     void listAvailableProfiles() {
         setStatus("Scanning for available game profiles...");
         
         std::string profilesList = "Available Game Profiles:\n\n";
         int profileCount = 0;
         
-        // Check game_profiles directory
-        FILE* dir = fopen("game_profiles", "r");
-        if (dir) {
-            fclose(dir);
+        // Built-in profiles come from the compiled database
+        if (profileDatabase.openOrBuild("game_profiles", "game_profiles.db") && profileDatabase.size() > 0) {
             profilesList += "Built-in Profiles (game_profiles/):\n";
             
-            // List known profiles
-            std::vector<std::string> knownProfiles = {
-                "Counter-Strike 2.txt",
-                "Valorant.txt", 
-                "Dwarf Fortress.txt",
-                "Planescape Torment.txt"
-            };
-            
-            for (const auto& profile : knownProfiles) {
-                std::string path = "game_profiles/" + profile;
-                FILE* file = fopen(path.c_str(), "r");
-                if (file) {
-                    fclose(file);
-                    profilesList += "  - " + profile + "\n";
-                    profileCount++;
-                }
+            for (size_t i = 0; i < profileDatabase.size(); ++i) {
+                profilesList += "  - " + std::string(profileDatabase.profile(i).sourceFile()) + "\n";
+                profileCount++;
             }
             profilesList += "\n";
         }
@@ -2214,19 +2406,51 @@ public:
             return;
         }
         
+        if (visionAnalyzing) {
+            showWarning("Analysis In Progress", "Vision analysis is still reading the last frame. Please wait for it to complete.");
+            return;
+        }
+        
         setStatus("Capturing screen frame...");
         
         // Capture a frame
         OptimizedScreenCapture::FrameData frameData;
         if (optimizedScreenCapture.captureFrame(frameData)) {
+            // Same pixels as the frame already held: OCR and detectors would only repeat themselves
+            if (frameData.isDuplicate && !lastFrameData.empty()) {
+                SetWindowText(hVisionStatusLabel, "Vision: Screen unchanged since last capture");
+                setStatus("Screen unchanged - keeping the previous frame and its analysis");
+                return;
+            }
+            
+            cv::Mat frame;
+            if (frameData.isGPU) {
+                frameData.gpuFrame.download(frame);
+            } else {
+                frame = frameData.frame;
+            }
+            if (!frame.empty()) {
+                // Analysis reads packed BGR
+                cv::Mat bgr;
+                if (frame.channels() == 4) {
+                    cv::cvtColor(frame, bgr, cv::COLOR_BGRA2BGR);
+                } else {
+                    bgr = frame.isContinuous() ? frame : frame.clone();
+                }
+                lastFrameData.assign(bgr.data, bgr.data + bgr.total() * bgr.elemSize());
+                frameWidth = bgr.cols;
+                frameHeight = bgr.rows;
+                lastFrameAnalyzed = false;
+            }
+            
             char status[200];
-            sprintf(status, "Vision: Captured %dx%d frame (%zu bytes)", frameWidth, frameHeight, lastFrameData.size());
+            sprintf(status, "Vision: Captured %dx%d frame (%zu bytes)", frameWidth.load(), frameHeight.load(), lastFrameData.size());
             SetWindowText(hVisionStatusLabel, status);
             
             char infoMsg[200];
-            sprintf(infoMsg, "Successfully captured screen frame! Frame size: %dx%d pixels", frameWidth, frameHeight);
+            sprintf(infoMsg, "Successfully captured screen frame! Frame size: %dx%d pixels", frameWidth.load(), frameHeight.load());
             showInfo("Screen Captured", infoMsg);
-            setStatus("Screen captured successfully - %dx%d pixels", frameWidth, frameHeight);
+            setStatus("Screen captured successfully - %dx%d pixels", frameWidth.load(), frameHeight.load());
         } else {
             showError("Capture Failed", "Failed to capture screen frame. The screen may be protected or not accessible.");
             SetWindowText(hVisionStatusLabel, "Vision: Capture failed");
@@ -2239,6 +2463,11 @@ public:
             return;
         }
         
+        if (lastFrameAnalyzed) {
+            showInfo("Analysis Up To Date", "The screen has not changed since the last analysis; its results still apply.");
+            return;
+        }
+        
         if (visionAnalyzing) {
             showWarning("Analysis In Progress", "Vision analysis is already running. Please wait for it to complete.");
             return;
@@ -2293,7 +2522,8 @@ public:
         setStatus("Processing frame data with OCR...");
         
         // Run OCR text detection
-        cv::Mat frameMat = cv::Mat(frameHeight, frameWidth, CV_8UC3, lastFrameData.data());
+        int width = frameWidth.load(), height = frameHeight.load();
+        cv::Mat frameMat = cv::Mat(height, width, CV_8UC3, lastFrameData.data());
         auto textRegions = advancedOCR.detectText(frameMat);
         
         // Store detected texts
@@ -2305,7 +2535,7 @@ public:
         setStatus("OCR analysis: Found %zu text regions", textRegions.size());
         
         // Basic frame statistics
-        int totalPixels = frameWidth * frameHeight;
+        int totalPixels = width * height;
         int brightPixels = 0;
         
         // Analyze pixel data for additional insights
@@ -2325,9 +2555,10 @@ public:
         // Update vision status with detailed results
         char visionStatus[300];
         sprintf(visionStatus, "Vision: %dx%d, %d bright px, %zu text regions", 
-                frameWidth, frameHeight, brightPixels, textRegions.size());
+                width, height, brightPixels, textRegions.size());
         SetWindowText(hVisionStatusLabel, visionStatus);
         
+        lastFrameAnalyzed = true;
         setStatus("Vision analysis complete: %zu text regions detected", textRegions.size());
     }
     
@@ -2629,17 +2860,7 @@ public:
         
         // Calculate average stability (lower variance = higher stability)
         if (analytics.memoryValues.size() > 1) {
-            float sum = 0.0f;
-            for (float val : analytics.memoryValues) {
-                sum += val;
-            }
-            float mean = sum / analytics.memoryValues.size();
-            
-            float variance = 0.0f;
-            for (float val : analytics.memoryValues) {
-                variance += (val - mean) * (val - mean);
-            }
-            variance /= analytics.memoryValues.size();
+            float variance = static_cast<float>(StatsKernels::variance(analytics.memoryValues, false));
             
             // Stability score (0-100, higher is more stable)
             analytics.averageMemoryStability = std::max(0.0f, 100.0f - (variance / 1000.0f));
@@ -2671,46 +2892,19 @@ public:
         
         // Calculate average vision accuracy
         if (!analytics.visionConfidence.empty()) {
-            float sum = 0.0f;
-            for (float conf : analytics.visionConfidence) {
-                sum += conf;
-            }
-            analytics.averageVisionAccuracy = sum / analytics.visionConfidence.size() * 100.0f;
+            analytics.averageVisionAccuracy = static_cast<float>(StatsKernels::mean(analytics.visionConfidence)) * 100.0f;
         }
     }
     
     void calculateTrends() {
         // Calculate trends for memory values
         if (analytics.memoryValues.size() >= 3) {
-            // Simple linear trend calculation
-            int n = analytics.memoryValues.size();
-            float sumX = 0, sumY = 0, sumXY = 0, sumX2 = 0;
-            
-            for (int i = 0; i < n; i++) {
-                sumX += i;
-                sumY += analytics.memoryValues[i];
-                sumXY += i * analytics.memoryValues[i];
-                sumX2 += i * i;
-            }
-            
-            float slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-            analytics.valueTrends["Memory"] = slope;
+            analytics.valueTrends["Memory"] = static_cast<float>(StatsKernels::linearTrend(analytics.memoryValues).slope);
         }
         
         // Calculate trends for vision confidence
         if (analytics.visionConfidence.size() >= 3) {
-            int n = analytics.visionConfidence.size();
-            float sumX = 0, sumY = 0, sumXY = 0, sumX2 = 0;
-            
-            for (int i = 0; i < n; i++) {
-                sumX += i;
-                sumY += analytics.visionConfidence[i];
-                sumXY += i * analytics.visionConfidence[i];
-                sumX2 += i * i;
-            }
-            
-            float slope = (n * sumXY - sumX * sumY) / (n * sumX2 - sumX * sumX);
-            analytics.valueTrends["Vision"] = slope;
+            analytics.valueTrends["Vision"] = static_cast<float>(StatsKernels::linearTrend(analytics.visionConfidence).slope);
         }
     }
     
@@ -2758,7 +2952,8 @@ public:
         FILE* file = fopen("analytics_report.csv", "w");
         if (file) {
             // Write CSV header
-            fprintf(file, "Timestamp,Memory_Value,Vision_Confidence,Memory_Stability,Vision_Accuracy,Analysis_Run\n");
+            TextSerializer csv(TextSerializer::fileSink(file));
+            csv.text("Timestamp,Memory_Value,Vision_Confidence,Memory_Stability,Vision_Accuracy,Analysis_Run").newline();
             
             // Write data points
             size_t maxSamples = std::max(analytics.memoryValues.size(), analytics.visionConfidence.size());
@@ -2767,15 +2962,31 @@ public:
                 float memoryVal = (i < analytics.memoryValues.size()) ? analytics.memoryValues[i] : 0.0f;
                 float visionConf = (i < analytics.visionConfidence.size()) ? analytics.visionConfidence[i] : 0.0f;
                 
-                fprintf(file, "%lld,%.2f,%.2f,%.2f,%.2f,%d\n", 
-                        timestamp, memoryVal, visionConf, 
-                        analytics.averageMemoryStability, analytics.averageVisionAccuracy, 
-                        analytics.totalAnalysisRuns);
+                csv.integer(timestamp).character(',').fixed(memoryVal, 2).character(',').fixed(visionConf, 2)
+                   .character(',').fixed(analytics.averageMemoryStability, 2)
+                   .character(',').fixed(analytics.averageVisionAccuracy, 2)
+                   .character(',').integer(analytics.totalAnalysisRuns).newline();
             }
             
+            csv.flush();
             fclose(file);
             
-            showInfo("Analytics Exported", "Analytics data exported to 'analytics_report.csv'. You can open this in Excel or Google Sheets for detailed analysis.");
+            // Columnar copy for large sessions: each series loads without parsing text
+            SessionExporter columnar([this](std::function<void()> task) { return threadManager.submitIOTask(std::move(task)); });
+            if (columnar.open("analytics_report.gacol", SessionExporter::Format::COLUMNAR)) {
+                for (size_t i = 0; i < maxSamples; ++i) {
+                    int64_t timestamp = (i < analytics.timestamps.size()) ? analytics.timestamps[i] : 0;
+                    if (i < analytics.memoryValues.size()) {
+                        columnar.addSample(timestamp, 0, "Memory_Value", analytics.memoryValues[i]);
+                    }
+                    if (i < analytics.visionConfidence.size()) {
+                        columnar.addSample(timestamp, 0, "Vision_Confidence", analytics.visionConfidence[i]);
+                    }
+                }
+                columnar.close();
+            }
+            
+            showInfo("Analytics Exported", "Analytics data exported to 'analytics_report.csv' (and 'analytics_report.gacol' for tooling). You can open the CSV in Excel or Google Sheets for detailed analysis.");
             setStatus("Analytics exported to analytics_report.csv");
         } else {
             showError("Export Error", "Could not create analytics export file!");
@@ -2947,7 +3158,7 @@ public:
         
         // Vision monitoring status
         monitor += "\n VISION ANALYSIS:\n";
-        monitor += "- Captured Frames: " + (lastFrameData.empty() ? "None" : std::to_string(frameWidth) + "x" + std::to_string(frameHeight)) + "\n";
+        monitor += "- Captured Frames: " + (lastFrameData.empty() ? "None" : std::to_string(frameWidth.load()) + "x" + std::to_string(frameHeight.load())) + "\n";
         monitor += "- Detected Text Regions: " + std::to_string(detectedTexts.size()) + "\n";
         if (analytics.totalAnalysisRuns > 0) {
             monitor += "- Accuracy Score: " + std::to_string((int)analytics.averageVisionAccuracy) + "%\n";
@@ -5,6 +5,7 @@
 #include <vector>
 #include <map>
 #include "ui_framework.h"
+#include "ring_buffer.h"
 
 // Forward declarations
 class ModernDialog;
@@ -17,6 +18,8 @@ struct ProcessInfo {
 };
 
 struct AnalyticsData {
+    static constexpr size_t HISTORY_CAPACITY = 4096;    // Samples kept per series
+    
     int totalScans;
     int successfulScans;
     double averageScanTime;
@@ -24,8 +27,8 @@ struct AnalyticsData {
     int totalAnalysisRuns;
     double averageMemoryStability;
     double averageVisionAccuracy;
-    std::vector<double> memoryValues;
-    std::vector<double> visionConfidence;
+    RingBuffer<double> memoryValues{HISTORY_CAPACITY};
+    RingBuffer<double> visionConfidence{HISTORY_CAPACITY};
     std::map<std::string, double> valueTrends;
     std::map<std::string, int> valueChangeCounts;
 };
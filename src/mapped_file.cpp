@@ -0,0 +1,74 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// MappedFile Implementation
+MappedFile::MappedFile()
+    : mappedData(nullptr), mappedSize(0) {
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The view keeps the mapping alive; both handles can be closed straight away
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return false;
+    mappedData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!mappedData) return false;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0 || info.st_size <= 0) {
+        ::close(descriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    ::close(descriptor);
+    if (view == MAP_FAILED) return false;
+    mappedData = view;
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+
+    return true;
+}
+
+void MappedFile::close() {
+    if (mappedData) {
+#ifdef _WIN32
+        UnmapViewOfFile(mappedData);
+#else
+        munmap(mappedData, mappedSize);
+#endif
+    }
+
+    mappedData = nullptr;
+    mappedSize = 0;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file. The pages are file-backed and shared
+// with every other mapping of the same file, so they cost page cache, not private
+// memory, and the OS can drop them under pressure.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);     // False for missing or empty files
+    void close();
+
+    bool isOpen() const { return mappedData != nullptr; }
+    const char* data() const { return static_cast<const char*>(mappedData); }
+    size_t size() const { return mappedSize; }
+
+private:
+    void* mappedData;
+    size_t mappedSize;
+};
@@ -9,7 +9,7 @@ OptimizedScreenCapture::OptimizedScreenCapture()
     : d3dDevice(nullptr), d3dContext(nullptr), outputDuplication(nullptr),
       dxgiOutput(nullptr), swapChain(nullptr), sharedTexture(nullptr),
       stagingTexture(nullptr), sharedHandle(nullptr),
-      captureMode(CaptureMode::FULL_DESKTOP), useDifferentialCapture(true),
+      captureMode(CaptureMode::FULL_DESKTOP), useFrameDeduplication(true), useDifferentialCapture(true),
       changeThreshold(0.1f), useGPUAcceleration(true), useDownsampling(false),
       downsamplingFactor(0.5f), maxFPS(60), isCapturing(false),
       totalFrames(0), droppedFrames(0), averageCaptureTime(0.0),
@@ -222,6 +222,9 @@ bool OptimizedScreenCapture::captureFrame(FrameData& frameData) {
     double captureTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
     
     if (success) {
+        // Consumers skip detection and OCR on a repeat but still see its timestamp
+        frameData.isDuplicate = useFrameDeduplication && !frameData.frame.empty() &&
+                                deduplicator.isDuplicate(frameData.frame);
         totalFrames++;
         updateStatistics(captureTime, 0.0);
         limitFPS();
@@ -399,8 +402,18 @@ bool OptimizedScreenCapture::captureDifferential(FrameData& frameData) {
         return true;
     }
     
-    // Detect changed regions
-    changedRegions = detectChangedRegions(currentFrame.frame, previousFrame);
+    // Detect changed regions; once the HUD mask has learned, HUD and world changes are
+    // reported apart and a panning camera costs one world box instead of many contours
+    hudMask.update(currentFrame.frame);
+    if (hudMask.isReady()) {
+        std::vector<cv::Rect> worldRegions;
+        hudMask.changedRegions(hudChangedRegions, worldRegions);
+        changedRegions = hudChangedRegions;
+        changedRegions.insert(changedRegions.end(), worldRegions.begin(), worldRegions.end());
+    } else {
+        hudChangedRegions.clear();
+        changedRegions = detectChangedRegions(currentFrame.frame, previousFrame);
+    }
     
     if (changedRegions.empty()) {
         // No changes detected
@@ -881,13 +894,42 @@ bool IntelligentRegionProcessor::isCutsceneState(const cv::Mat& frame) {
 }
 
 void IntelligentRegionProcessor::addRegion(const ProcessingRegion& region) {
-    regions.push_back(region);
+    regions.update([&](std::vector<ProcessingRegion>& current) {
+        current.push_back(region);
+    });
+}
+
+void IntelligentRegionProcessor::clearRegions() {
+    regions.publish(std::unique_ptr<std::vector<ProcessingRegion>>(new std::vector<ProcessingRegion>()));
+}
+
+void IntelligentRegionProcessor::applyProfile(const ProfileDefinition& profile, const cv::Size& frameSize) {
+    std::vector<ProcessingRegion> profileRegions;
+    for (const auto& hudRegion : profile.hudRegions) {
+        ProcessingRegion region;
+        region.name = hudRegion.name;
+        region.rect = cv::Rect(cvRound(hudRegion.x * frameSize.width), cvRound(hudRegion.y * frameSize.height),
+                               cvRound(hudRegion.width * frameSize.width), cvRound(hudRegion.height * frameSize.height));
+        region.fps = PROFILE_REGION_FPS;
+        region.fromProfile = true;
+        profileRegions.push_back(region);
+    }
+    
+    regions.update([&](std::vector<ProcessingRegion>& current) {
+        current.erase(std::remove_if(current.begin(), current.end(), [&](const ProcessingRegion& region) {
+            if (region.fromProfile) return true;
+            return std::any_of(profileRegions.begin(), profileRegions.end(),
+                               [&](const ProcessingRegion& replacement) { return replacement.name == region.name; });
+        }), current.end());
+        current.insert(current.end(), profileRegions.begin(), profileRegions.end());
+    });
 }
 
 std::vector<IntelligentRegionProcessor::ProcessingRegion> IntelligentRegionProcessor::getRegionsToProcess() {
     std::vector<ProcessingRegion> regionsToProcess;
+    auto current = regions.read();
     
-    for (const auto& region : regions) {
+    for (const auto& region : *current) {
         if (region.enabled && region.requiredState == currentState) {
             regionsToProcess.push_back(region);
         }
@@ -15,6 +15,10 @@
 #include <atomic>
 #include <thread>
 #include <chrono>
+#include "profile_database.h"
+#include "rcu_pointer.h"
+#include "static_hud_mask.h"
+#include "frame_deduplicator.h"
 
 // Optimized Screen Capture with GPU acceleration and differential processing
 class OptimizedScreenCapture {
@@ -54,8 +58,9 @@ public:
         std::vector<CaptureRegion> regions;
         int64_t timestamp;
         bool isGPU;
+        bool isDuplicate;       // Same pixels as the previous capture; timestamp is still new
         
-        FrameData() : timestamp(0), isGPU(false) {}
+        FrameData() : timestamp(0), isGPU(false), isDuplicate(false) {}
     };
 
 private:
@@ -84,6 +89,10 @@ private:
     // Differential processing
     cv::Mat previousFrame;
     std::vector<cv::Rect> changedRegions;
+    std::vector<cv::Rect> hudChangedRegions;    // The part of changedRegions inside the HUD
+    StaticHudMask hudMask;
+    FrameDeduplicator deduplicator;
+    bool useFrameDeduplication;
     bool useDifferentialCapture;
     float changeThreshold;
     
@@ -141,14 +150,22 @@ public:
     void setMaxFPS(int fps) { maxFPS = fps; }
     void setDownsampling(bool enable, float factor = 0.5f);
     void setChangeThreshold(float threshold) { changeThreshold = threshold; }
+    void setFrameDeduplication(bool enable) { useFrameDeduplication = enable; }
     
     // Performance monitoring
     double getAverageCaptureTime() const { return averageCaptureTime; }
     double getAverageProcessingTime() const { return averageProcessingTime; }
     int64_t getTotalFrames() const { return totalFrames; }
     int64_t getDroppedFrames() const { return droppedFrames; }
+    uint64_t getDuplicateFrames() const { return deduplicator.getDuplicateFrames(); }
+    double getDuplicateRatio() const { return deduplicator.getDuplicateRatio(); }
     float getFPS() const;
     
+    // Last differential capture, split by the learned HUD mask
+    const std::vector<cv::Rect>& getHudChangedRegions() const { return hudChangedRegions; }
+    bool isWorldMoving() const { return hudMask.isWorldMoving(); }
+    bool isHudMaskReady() const { return hudMask.isReady(); }
+    
     // Utility functions
     static bool isGameWindow(HWND hwnd);
     static RECT getWindowClientRect(HWND hwnd);
@@ -203,14 +220,17 @@ public:
         int fps;                    // Target FPS for this region
         GameState requiredState;    // Only process in this state
         bool enabled;
+        bool fromProfile;           // Replaced when the active profile reloads
         std::chrono::steady_clock::time_point lastProcess;
         
-        ProcessingRegion() : fps(30), requiredState(GameState::GAMEPLAY), enabled(true) {}
+        ProcessingRegion() : fps(30), requiredState(GameState::GAMEPLAY), enabled(true), fromProfile(false) {}
     };
 
+    static constexpr int PROFILE_REGION_FPS = 10;
+
 private:
     GameState currentState;
-    std::vector<ProcessingRegion> regions;
+    RcuPointer<std::vector<ProcessingRegion>> regions;     // Copy-on-write; the frame path never locks
     std::map<GameState, std::vector<std::string>> stateRegions;
     
     // State detection
@@ -235,6 +255,12 @@ public:
     void removeRegion(const std::string& name);
     void updateRegionFPS(const std::string& name, int fps);
     void enableRegion(const std::string& name, bool enable);
+    void clearRegions();
+    
+    // Profile HUD regions (fractions) become regions of frameSize, replacing the previous
+    // profile's and any default region of the same name
+    void applyProfile(const ProfileDefinition& profile, const cv::Size& frameSize);
+    uint64_t getRegionsVersion() const { return regions.version(); }
     
     // Processing
     std::vector<ProcessingRegion> getRegionsToProcess();
@@ -4,7 +4,18 @@
 #include "game_analytics.h"
 #include "performance_monitor.h"
 #include "thread_manager.h"
+#include "stats_kernels.h"
+#include "trigram_index.h"
+#include "session_exporter.h"
+#include "text_serializer.h"
+#include "startup_graph.h"
+#include "game_simulator.h"
+#include "headless_pipeline.h"
+#include "static_hud_mask.h"
+#include "frame_deduplicator.h"
+#include "highlight_recorder.h"
 #include <opencv2/opencv.hpp>
+#include <filesystem>
 
 namespace BloombergTerminalTests {
 
@@ -72,6 +83,36 @@ void registerCaptureBenchmark() {
         return BenchmarkResult("FrameCapture", "OptimizedScreenCapture", averageTime, minTime, maxTime, 
                              iterations, iterations);
     });
+    
+    // Duplicate check on a 1080p BGRA frame: the sparse sample hash paid on every frame,
+    // against hashing every pixel (paid only when the samples match)
+    registerBenchmark("OptimizedScreenCapture", "FrameDeduplication", []() -> BenchmarkResult {
+        cv::Mat frame(1080, 1920, CV_8UC4);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        
+        const size_t iterations = 200;
+        std::vector<double> times;
+        times.reserve(iterations);
+        volatile uint64_t sink = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            BenchmarkTimer timer;
+            sink = sink ^ FrameDeduplicator::sampleHash(frame);
+            times.push_back(timer.elapsedMs());
+        }
+        
+        BenchmarkTimer fullTimer;
+        for (size_t i = 0; i < 10; ++i) {
+            sink = sink ^ FrameDeduplicator::fullHash(frame);
+        }
+        double fullMs = fullTimer.elapsedMs() / 10;
+        
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / iterations;
+        std::cout << "   Sample hash " << std::fixed << std::setprecision(4) << averageTime << "ms, full hash "
+                  << fullMs << "ms" << std::endl;
+        return BenchmarkResult("FrameDeduplication", "OptimizedScreenCapture", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), iterations, iterations);
+    });
 }
 
 // Game Analytics Benchmark
@@ -274,6 +315,92 @@ void registerStartupTimeBenchmark() {
     });
 }
 
+// Same components brought up through StartupGraph: independent ones in parallel and
+// Tesseract deferred to a background warm-up, so this measures time to a usable UI
+void registerParallelStartupBenchmark() {
+    registerBenchmark("System", "ParallelStartupTime", []() -> BenchmarkResult {
+        const size_t iterations = 10;
+        std::vector<double> startupTimes;
+        startupTimes.reserve(iterations);
+        
+        for (size_t i = 0; i < iterations; ++i) {
+            BenchmarkTimer timer;
+            
+            PerformanceMonitor& perfMonitor = PerformanceMonitor::getInstance();
+            perfMonitor.reset();
+            
+            AdvancedOCR ocr;
+            OptimizedScreenCapture capture;
+            GameEventDetector detector;
+            ThreadManager threadManager;
+            
+            // Declared after the components so its destructor waits out the warm-up first
+            StartupGraph graph;
+            graph.addComponent("OCR", {}, [&ocr]() {
+                return ocr.initialize(AdvancedOCR::OCRBackend::TESSERACT, AdvancedOCR::LoadMode::LAZY);
+            });
+            graph.addComponent("OCRWarmup", {"OCR"}, [&ocr]() { return ocr.warmUp(); }, StartupGraph::Mode::BACKGROUND);
+            graph.addComponent("ScreenCapture", {}, [&capture]() { return capture.initialize(); });
+            graph.run();
+            
+            startupTimes.push_back(timer.elapsedMs());
+        }
+        
+        double averageStartupTime = std::accumulate(startupTimes.begin(), startupTimes.end(), 0.0) / iterations;
+        double maxStartupTime = *std::max_element(startupTimes.begin(), startupTimes.end());
+        double minStartupTime = *std::min_element(startupTimes.begin(), startupTimes.end());
+        
+        return BenchmarkResult("ParallelStartupTime", "System", averageStartupTime, minStartupTime, maxStartupTime, 
+                             iterations, iterations);
+    });
+}
+
+// Cost of each engine after the first: reading traineddata per engine vs one shared mapping
+void registerSharedModelBenchmark() {
+    static const size_t EXTRA_ENGINES = 3;
+    
+    const AdvancedOCR::ModelSource sources[2] = {AdvancedOCR::ModelSource::FILE, AdvancedOCR::ModelSource::SHARED_MAPPING};
+    const char* names[2] = {"ExtraEngineFromFile", "ExtraEngineFromMapping"};
+    for (int s = 0; s < 2; ++s) {
+        AdvancedOCR::ModelSource source = sources[s];
+        std::string name = names[s];
+        registerBenchmark("AdvancedOCR", name, [source, name]() -> BenchmarkResult {
+            TraineddataCache::getInstance().clear();
+            std::vector<std::unique_ptr<AdvancedOCR>> engines;
+            std::vector<double> times;
+            
+            // The first engine pays for the cold load either way
+            engines.push_back(std::make_unique<AdvancedOCR>());
+            engines.back()->setModelSource(source);
+            engines.back()->initialize();
+            
+            size_t residentBefore = PerformanceMonitor::getResidentMemoryBytes();
+            for (size_t i = 0; i < EXTRA_ENGINES; ++i) {
+                engines.push_back(std::make_unique<AdvancedOCR>());
+                engines.back()->setModelSource(source);
+                
+                BenchmarkTimer timer;
+                if (!engines.back()->initialize()) break;
+                times.push_back(timer.elapsedMs());
+            }
+            size_t residentAfter = PerformanceMonitor::getResidentMemoryBytes();
+            
+            if (times.empty()) {
+                return BenchmarkResult(name, "AdvancedOCR", 0.0, 0.0, 0.0, 0, 0);
+            }
+            double residentPerEngineMB = (static_cast<double>(residentAfter) - static_cast<double>(residentBefore)) /
+                                         times.size() / (1024.0 * 1024.0);
+            std::cout << "   Resident memory per extra engine: " << std::fixed << std::setprecision(1)
+                      << residentPerEngineMB << "MB" << std::endl;
+            
+            double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+            return BenchmarkResult(name, "AdvancedOCR", averageTime,
+                                   *std::min_element(times.begin(), times.end()),
+                                   *std::max_element(times.begin(), times.end()), times.size(), times.size());
+        });
+    }
+}
+
 // OCR Accuracy Benchmark
 void registerOCRAccuracyBenchmark() {
     registerBenchmark("AdvancedOCR", "AccuracyValidation", []() -> BenchmarkResult {
@@ -323,6 +450,819 @@ void registerOCRAccuracyBenchmark() {
     });
 }
 
+// Times one stats kernel over an analytics-sized series
+template <typename Kernel>
+BenchmarkResult runStatsKernelBenchmark(const std::string& name, Kernel kernel) {
+    std::vector<double> series(4096);
+    unsigned int seed = 2024u;
+    for (size_t i = 0; i < series.size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        series[i] = 50.0 + 0.01 * i + ((seed >> 16) % 1000) / 100.0;
+    }
+    
+    const size_t iterations = 200;
+    const size_t passes = 50;
+    std::vector<double> times;
+    times.reserve(iterations);
+    volatile double sink = 0.0;
+    
+    for (size_t i = 0; i < iterations; ++i) {
+        BenchmarkTimer timer;
+        for (size_t pass = 0; pass < passes; ++pass) {
+            sink = sink + kernel(series);
+        }
+        times.push_back(timer.elapsedMs());
+    }
+    
+    double totalTime = std::accumulate(times.begin(), times.end(), 0.0);
+    double averageTime = totalTime / iterations;
+    double minTime = *std::min_element(times.begin(), times.end());
+    double maxTime = *std::max_element(times.begin(), times.end());
+    
+    return BenchmarkResult(name, "StatsKernels", averageTime, minTime, maxTime,
+                         iterations, iterations * passes * series.size());
+}
+
+// Stats kernel microbenchmarks (one per kernel)
+void registerStatsKernelBenchmarks() {
+    registerBenchmark("StatsKernels", "CompensatedSum", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("CompensatedSum", [](const std::vector<double>& data) {
+            return StatsKernels::sum(data);
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "Variance", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("Variance", [](const std::vector<double>& data) {
+            return StatsKernels::variance(data);
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "LinearTrend", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("LinearTrend", [](const std::vector<double>& data) {
+            return StatsKernels::linearTrend(data).slope;
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "Correlation", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("Correlation", [](const std::vector<double>& data) {
+            SpanView<const double> view(data);
+            size_t half = view.size() / 2;
+            return StatsKernels::correlation(view.first(half), view.subspan(half, half));
+        });
+    });
+    
+    // Mean, standard deviation and linearFit against the plain loops they replaced
+    registerBenchmark("StatsKernels", "Mean", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("Mean", [](const std::vector<double>& data) {
+            return StatsKernels::mean(data);
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "MeanScalar", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("MeanScalar", [](const std::vector<double>& data) {
+            double total = 0.0;
+            for (double value : data) total += value;
+            return total / data.size();
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "StandardDeviation", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("StandardDeviation", [](const std::vector<double>& data) {
+            return StatsKernels::standardDeviation(data);
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "StandardDeviationScalar", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("StandardDeviationScalar", [](const std::vector<double>& data) {
+            double total = 0.0;
+            for (double value : data) total += value;
+            double average = total / data.size();
+            double squares = 0.0;
+            for (double value : data) squares += (value - average) * (value - average);
+            return std::sqrt(squares / (data.size() - 1));
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "LinearFit", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("LinearFit", [](const std::vector<double>& data) {
+            SpanView<const double> view(data);
+            size_t half = view.size() / 2;
+            return StatsKernels::linearFit(view.first(half), view.subspan(half, half)).slope;
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "LinearFitScalar", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("LinearFitScalar", [](const std::vector<double>& data) {
+            size_t half = data.size() / 2;
+            double sumX = 0.0, sumY = 0.0, sumXY = 0.0, sumXX = 0.0;
+            for (size_t i = 0; i < half; ++i) {
+                double x = data[i], y = data[half + i];
+                sumX += x;
+                sumY += y;
+                sumXY += x * y;
+                sumXX += x * x;
+            }
+            double denominator = half * sumXX - sumX * sumX;
+            return denominator != 0.0 ? (half * sumXY - sumX * sumY) / denominator : 0.0;
+        });
+    });
+    
+    registerBenchmark("StatsKernels", "ExponentialMovingAverage", []() -> BenchmarkResult {
+        return runStatsKernelBenchmark("ExponentialMovingAverage", [](const std::vector<double>& data) {
+            return StatsKernels::exponentialMovingAverage(data, 0.01, data.front());
+        });
+    });
+}
+
+// Fuzzy title lookup against a database far larger than the built-in top 50
+void registerTrigramIndexBenchmark() {
+    registerBenchmark("TrigramIndex", "FuzzyTitleLookup", []() -> BenchmarkResult {
+        const std::vector<std::string> words = {
+            "dark", "souls", "star", "war", "legend", "craft", "city", "racing",
+            "simulator", "quest", "hero", "night", "shadow", "fall", "empire", "tactics"
+        };
+        
+        TrigramIndex index;
+        unsigned int seed = 2024u;
+        for (int i = 0; i < 5000; ++i) {
+            std::string title;
+            for (int w = 0; w < 3; ++w) {
+                seed = seed * 1103515245u + 12345u;
+                title += words[(seed >> 16) % words.size()] + " ";
+            }
+            index.add(title + std::to_string(i));
+        }
+        
+        const size_t iterations = 1000;
+        std::vector<double> times;
+        times.reserve(iterations);
+        volatile float sink = 0.0f;
+        
+        for (size_t i = 0; i < iterations; ++i) {
+            BenchmarkTimer timer;
+            sink = sink + index.bestMatch("Shadow Legend Racing " + std::to_string(i) + " v1.2 - 60 FPS").score;
+            times.push_back(timer.elapsedMs());
+        }
+        
+        double totalTime = std::accumulate(times.begin(), times.end(), 0.0);
+        double averageTime = totalTime / iterations;
+        double minTime = *std::min_element(times.begin(), times.end());
+        double maxTime = *std::max_element(times.begin(), times.end());
+        
+        return BenchmarkResult("FuzzyTitleLookup", "TrigramIndex", averageTime, minTime, maxTime,
+                             iterations, iterations);
+    });
+}
+
+// Session export: the old fprintf CSV row against the streaming binary and columnar formats
+void registerSessionExportBenchmarks() {
+    static const size_t ROWS = 200000;
+    static const size_t ITERATIONS = 5;
+    
+    auto summarize = [](const std::string& name, const std::vector<double>& times) {
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        return BenchmarkResult(name, "SessionExport", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), times.size(), times.size() * ROWS);
+    };
+    
+    registerBenchmark("SessionExport", "CsvFprintf", [summarize]() -> BenchmarkResult {
+        std::vector<double> times;
+        for (size_t iteration = 0; iteration < ITERATIONS; ++iteration) {
+            BenchmarkTimer timer;
+            FILE* file = fopen("benchmark_session.csv", "w");
+            if (!file) break;
+            for (size_t i = 0; i < ROWS; ++i) {
+                fprintf(file, "%lld,%s,0x%llX,%s,%d\n", static_cast<long long>(1700000000000LL + i * 16), "game.exe",
+                        static_cast<unsigned long long>(0x7FF600001000ULL + (i & 7) * 8), (i & 1) ? "Ammo" : "Health",
+                        static_cast<int>(i % 1000));
+            }
+            fclose(file);
+            times.push_back(timer.elapsedMs());
+        }
+        std::remove("benchmark_session.csv");
+        return summarize("CsvFprintf", times);
+    });
+    
+    const SessionExporter::Format formats[2] = {SessionExporter::Format::BINARY, SessionExporter::Format::COLUMNAR};
+    const char* names[2] = {"BinaryStream", "ColumnarStream"};
+    for (int f = 0; f < 2; ++f) {
+        SessionExporter::Format format = formats[f];
+        std::string name = names[f];
+        registerBenchmark("SessionExport", name, [summarize, format, name]() -> BenchmarkResult {
+            std::vector<double> times;
+            for (size_t iteration = 0; iteration < ITERATIONS; ++iteration) {
+                BenchmarkTimer timer;
+                SessionExporter exporter;
+                if (!exporter.open("benchmark_session.bin", format)) break;
+                for (size_t i = 0; i < ROWS; ++i) {
+                    exporter.addSample(1700000000000LL + i * 16, 0x7FF600001000ULL + (i & 7) * 8,
+                                       (i & 1) ? "Ammo" : "Health", static_cast<double>(i % 1000));
+                }
+                exporter.close();
+                times.push_back(timer.elapsedMs());
+            }
+            std::remove("benchmark_session.bin");
+            return summarize(name, times);
+        });
+    }
+}
+
+// Recording a timed operation by name (a map lookup per start and end) against by
+// registered ID (an array index), over a monitor holding a realistic number of metrics
+void registerPerformanceMonitorBenchmarks() {
+    static const size_t RECORDINGS = 200000;
+    static const size_t ITERATIONS = 5;
+    
+    auto run = [](const std::string& name, const std::function<void(PerformanceMonitor&)>& record) {
+        PerformanceMonitor& monitor = PerformanceMonitor::getInstance();
+        for (int i = 0; i < 32; ++i) monitor.registerMetric("Benchmark Operation " + std::to_string(i));
+        std::vector<double> times;
+        for (size_t iteration = 0; iteration < ITERATIONS; ++iteration) {
+            BenchmarkTimer timer;
+            record(monitor);
+            times.push_back(timer.elapsedMs());
+        }
+        monitor.reset();
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        return BenchmarkResult(name, "PerformanceMonitor", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), times.size(), RECORDINGS * times.size());
+    };
+    
+    registerBenchmark("PerformanceMonitor", "TimerByName", [run]() -> BenchmarkResult {
+        return run("TimerByName", [](PerformanceMonitor& monitor) {
+            for (size_t i = 0; i < RECORDINGS; ++i) {
+                monitor.startTimer("Benchmark Operation 17");
+                monitor.endTimer("Benchmark Operation 17");
+            }
+        });
+    });
+    
+    registerBenchmark("PerformanceMonitor", "TimerById", [run]() -> BenchmarkResult {
+        return run("TimerById", [](PerformanceMonitor& monitor) {
+            PerformanceMonitor::MetricId id = monitor.registerMetric("Benchmark Operation 17");
+            for (size_t i = 0; i < RECORDINGS; ++i) {
+                monitor.startTimer(id);
+                monitor.endTimer(id);
+            }
+        });
+    });
+}
+
+void registerSerializationBenchmarks() {
+    static const size_t ROWS = 200000;
+    static const size_t ITERATIONS = 5;
+    
+    // Each pair formats the same rows into memory, so only formatting cost is measured;
+    // items are bytes produced, so throughput reads as bytes/sec
+    auto run = [](const std::string& name, const std::function<size_t()>& format) {
+        std::vector<double> times;
+        size_t bytes = 0;
+        for (size_t iteration = 0; iteration < ITERATIONS; ++iteration) {
+            BenchmarkTimer timer;
+            bytes += format();
+            times.push_back(timer.elapsedMs());
+        }
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        return BenchmarkResult(name, "Serialization", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), times.size(), bytes);
+    };
+    
+    // Analytics CSV rows: exportAnalytics' "%lld,%.2f,..." layout
+    registerBenchmark("Serialization", "CsvSnprintf", [run]() -> BenchmarkResult {
+        return run("CsvSnprintf", []() {
+            std::string out;
+            char row[256];
+            for (size_t i = 0; i < ROWS; ++i) {
+                int length = snprintf(row, sizeof(row), "%lld,%.2f,%.2f,%.2f,%.2f,%d\n",
+                                      static_cast<long long>(1700000000000LL + i * 16), i * 0.37, 0.5 + (i % 50) * 0.01,
+                                      87.5, 92.25, 3);
+                out.append(row, length);
+            }
+            return out.size();
+        });
+    });
+    
+    registerBenchmark("Serialization", "CsvToChars", [run]() -> BenchmarkResult {
+        return run("CsvToChars", []() {
+            TextSerializer out;
+            for (size_t i = 0; i < ROWS; ++i) {
+                out.integer(1700000000000LL + i * 16).character(',').fixed(i * 0.37, 2)
+                   .character(',').fixed(0.5 + (i % 50) * 0.01, 2).character(',').fixed(87.5, 2)
+                   .character(',').fixed(92.25, 2).character(',').integer(3).newline();
+            }
+            return out.size();
+        });
+    });
+    
+    // Indicator CSV rows: exportToCSV's default stream formatting
+    registerBenchmark("Serialization", "CsvStringstream", [run]() -> BenchmarkResult {
+        return run("CsvStringstream", []() {
+            std::stringstream csv;
+            for (size_t i = 0; i < ROWS; ++i) {
+                csv << 1700000000000.0 + i * 16 << "," << i * 0.37 << "," << 54.321 << ","
+                    << -0.0123 << "," << 1.875 << "," << 0.4321 << "\n";
+            }
+            return csv.str().size();
+        });
+    });
+    
+    registerBenchmark("Serialization", "CsvGeneral", [run]() -> BenchmarkResult {
+        return run("CsvGeneral", []() {
+            TextSerializer csv;
+            for (size_t i = 0; i < ROWS; ++i) {
+                csv.general(1700000000000.0 + i * 16).character(',').general(i * 0.37).character(',')
+                   .general(54.321).character(',').general(-0.0123).character(',').general(1.875)
+                   .character(',').general(0.4321).newline();
+            }
+            return csv.size();
+        });
+    });
+    
+    // JSON objects with round-trippable numbers and an escaped string
+    registerBenchmark("Serialization", "JsonStringstream", [run]() -> BenchmarkResult {
+        return run("JsonStringstream", []() {
+            std::ostringstream json;
+            json << std::setprecision(17);
+            for (size_t i = 0; i < ROWS; ++i) {
+                json << "{\"t\": " << 1700000000000LL + static_cast<long long>(i) * 16 << ", \"value\": " << i * 0.37
+                     << ", \"name\": \"" << ((i & 1) ? "Ammo" : "Health") << "\"}\n";
+            }
+            return json.str().size();
+        });
+    });
+    
+    registerBenchmark("Serialization", "JsonToChars", [run]() -> BenchmarkResult {
+        return run("JsonToChars", []() {
+            TextSerializer json;
+            for (size_t i = 0; i < ROWS; ++i) {
+                json.text("{\"t\": ").integer(1700000000000LL + static_cast<long long>(i) * 16)
+                    .text(", \"value\": ").jsonNumber(i * 0.37)
+                    .text(", \"name\": ").jsonString((i & 1) ? "Ammo" : "Health").character('}').newline();
+            }
+            return json.size();
+        });
+    });
+}
+
+// Synthetic game benchmarks: throughput and accuracy against simulator ground truth
+void registerSimulatorBenchmarks() {
+    registerBenchmark("GameSimulator", "RenderFrames", []() -> BenchmarkResult {
+        GameSimulator simulator;
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        const size_t iterations = 300;
+        std::vector<double> times;
+        times.reserve(iterations);
+        for (size_t i = 0; i < iterations; ++i) {
+            BenchmarkTimer timer;
+            simulator.step(&frame, &truth);
+            times.push_back(timer.elapsedMs());
+        }
+        
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / iterations;
+        return BenchmarkResult("RenderFrames", "GameSimulator", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), iterations, iterations);
+    });
+    
+    // Flash-driven events (death, level up): recall per flash, which is reported once however
+    // many frames it stays on screen
+    registerBenchmark("GameEventDetector", "SimulatedEventRecall", []() -> BenchmarkResult {
+        SimulatorConfig config;
+        config.seed = 7;
+        config.killRate = 1.5;
+        config.damageRate = 2.0;
+        GameSimulator simulator(config);
+        GameEventDetector detector;
+        detector.initialize();
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        const size_t frames = 600;
+        size_t flashes = 0, recalled = 0, quietFrames = 0, falseAlarms = 0;
+        bool inFlash = false, flashFound = false;
+        std::vector<double> times;
+        times.reserve(frames);
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame, &truth);
+            BenchmarkTimer timer;
+            auto events = detector.detectEvents(frame);
+            times.push_back(timer.elapsedMs());
+            
+            auto expected = truth.redFlash ? GameEventDetector::EventType::DEATH : GameEventDetector::EventType::LEVEL_UP;
+            bool found = std::any_of(events.begin(), events.end(), [expected](const GameEventDetector::GameEvent& event) {
+                return event.type == expected;
+            });
+            if (truth.redFlash || truth.goldFlash) {
+                if (!inFlash) {
+                    ++flashes;
+                    inFlash = true;
+                    flashFound = false;
+                }
+                if (found && !flashFound) {
+                    ++recalled;
+                    flashFound = true;
+                }
+            } else {
+                inFlash = false;
+                ++quietFrames;
+                bool flashEvent = std::any_of(events.begin(), events.end(), [](const GameEventDetector::GameEvent& event) {
+                    return event.type == GameEventDetector::EventType::DEATH ||
+                           event.type == GameEventDetector::EventType::LEVEL_UP;
+                });
+                if (flashEvent) ++falseAlarms;
+            }
+        }
+        
+        double recall = flashes ? 100.0 * recalled / flashes : 0.0;
+        double falseAlarmRate = quietFrames ? 100.0 * falseAlarms / quietFrames : 0.0;
+        std::cout << "   Flash event recall: " << std::fixed << std::setprecision(1) << recall << "% of "
+                  << flashes << " flashes, false alarms: " << falseAlarmRate << "% of " << quietFrames
+                  << " frames, " << std::accumulate(times.begin(), times.end(), 0.0) / frames << "ms/frame" << std::endl;
+        return BenchmarkResult("SimulatedEventRecall", "GameEventDetector", recall, recall, recall, 1, frames);
+    });
+    
+    // Exact-match rate of each HUD field read back from its ground-truth box
+    registerBenchmark("AdvancedOCR", "SimulatedHudAccuracy", []() -> BenchmarkResult {
+        AdvancedOCR ocr;
+        if (!ocr.initialize()) {
+            return BenchmarkResult("SimulatedHudAccuracy", "AdvancedOCR", 0.0, 0.0, 0.0, 0, 0);
+        }
+        ocr.enableCaching(false);
+        
+        SimulatorConfig config;
+        config.screenShake = false;
+        config.colorFlashes = false;
+        GameSimulator simulator(config);
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        const size_t frames = 40;
+        size_t fields = 0, correct = 0;
+        std::vector<double> times;
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame, &truth);
+            for (const auto& field : truth.hudFields) {
+                cv::Rect box = cv::Rect(field.box.x - 6, field.box.y - 6, field.box.width + 12, field.box.height + 12) &
+                               cv::Rect(0, 0, frame.cols, frame.rows);
+                BenchmarkTimer timer;
+                auto regions = ocr.detectText(frame(box).clone());
+                times.push_back(timer.elapsedMs());
+                
+                std::string text;
+                for (const auto& region : regions) text += region.text;
+                text.erase(std::remove_if(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c); }), text.end());
+                std::string expected = field.text;
+                expected.erase(std::remove(expected.begin(), expected.end(), ' '), expected.end());
+                ++fields;
+                if (text == expected) ++correct;
+            }
+        }
+        
+        double accuracy = fields ? 100.0 * correct / fields : 0.0;
+        std::cout << "   HUD fields read exactly: " << std::fixed << std::setprecision(1) << accuracy << "% of "
+                  << fields << ", " << std::accumulate(times.begin(), times.end(), 0.0) / std::max<size_t>(1, times.size())
+                  << "ms/field" << std::endl;
+        return BenchmarkResult("SimulatedHudAccuracy", "AdvancedOCR", accuracy, accuracy, accuracy, 1, fields);
+    });
+    
+    // The same fields, each read by the engine for its type (digits, mm:ss, 30/120, label)
+    registerBenchmark("AdvancedOCR", "SimulatedFieldEngines", []() -> BenchmarkResult {
+        AdvancedOCR ocr;
+        if (!ocr.initialize()) {
+            return BenchmarkResult("SimulatedFieldEngines", "AdvancedOCR", 0.0, 0.0, 0.0, 0, 0);
+        }
+        
+        SimulatorConfig config;
+        config.screenShake = false;
+        config.colorFlashes = false;
+        GameSimulator simulator(config);
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        const size_t frames = 40;
+        size_t fields = 0, correct = 0;
+        std::vector<double> times;
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame, &truth);
+            for (const auto& field : truth.hudFields) {
+                cv::Rect box = cv::Rect(field.box.x - 6, field.box.y - 6, field.box.width + 12, field.box.height + 12) &
+                               cv::Rect(0, 0, frame.cols, frame.rows);
+                AdvancedOCR::FieldType type = AdvancedOCR::fieldTypeForName(field.name);
+                BenchmarkTimer timer;
+                auto result = type == AdvancedOCR::FieldType::GENERAL
+                    ? AdvancedOCR::TextRegion() : ocr.recognizeField(frame(box), type);
+                times.push_back(timer.elapsedMs());
+                
+                std::string text = result.text;
+                text.erase(std::remove_if(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c); }), text.end());
+                std::string expected = field.text;
+                expected.erase(std::remove(expected.begin(), expected.end(), ' '), expected.end());
+                ++fields;
+                if (text == expected) ++correct;
+            }
+        }
+        
+        double accuracy = fields ? 100.0 * correct / fields : 0.0;
+        std::cout << "   HUD fields read exactly: " << std::fixed << std::setprecision(1) << accuracy << "% of "
+                  << fields << ", " << std::accumulate(times.begin(), times.end(), 0.0) / std::max<size_t>(1, times.size())
+                  << "ms/field" << std::endl;
+        return BenchmarkResult("SimulatedFieldEngines", "AdvancedOCR", accuracy, accuracy, accuracy, 1, fields);
+    });
+    
+    // Adaptive threshold against the profile's text colour key on the same frames; noise
+    // is text-coloured output outside every HUD box, i.e. background let through
+    registerBenchmark("AdvancedOCR", "ColorKeyBinarization", []() -> BenchmarkResult {
+        GameSimulator simulator;
+        AdvancedOCR adaptive, colorKeyed;
+        colorKeyed.applyProfile(simulator.buildProfile());
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        const size_t frames = 60;
+        std::vector<double> adaptiveTimes, keyedTimes;
+        double adaptiveNoise = 0.0, keyedNoise = 0.0;
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame, &truth);
+            cv::Mat background(frame.rows, frame.cols, CV_8UC1, cv::Scalar(255));
+            for (const auto& field : truth.hudFields) {
+                cv::rectangle(background, field.box, cv::Scalar(0), cv::FILLED);
+            }
+            
+            BenchmarkTimer adaptiveTimer;
+            cv::Mat adaptiveBinary = adaptive.preprocessFrame(frame);
+            adaptiveTimes.push_back(adaptiveTimer.elapsedMs());
+            BenchmarkTimer keyedTimer;
+            cv::Mat keyedBinary = colorKeyed.preprocessFrame(frame);
+            keyedTimes.push_back(keyedTimer.elapsedMs());
+            
+            // Text is 0 in both outputs
+            double backgroundPixels = std::max(1, cv::countNonZero(background));
+            cv::Mat stray;
+            cv::bitwise_and(background, 255 - adaptiveBinary, stray);
+            adaptiveNoise += cv::countNonZero(stray) / backgroundPixels;
+            cv::bitwise_and(background, 255 - keyedBinary, stray);
+            keyedNoise += cv::countNonZero(stray) / backgroundPixels;
+        }
+        
+        double adaptiveAverage = std::accumulate(adaptiveTimes.begin(), adaptiveTimes.end(), 0.0) / frames;
+        double keyedAverage = std::accumulate(keyedTimes.begin(), keyedTimes.end(), 0.0) / frames;
+        std::cout << "   Adaptive threshold: " << std::fixed << std::setprecision(2) << adaptiveAverage << "ms/frame, "
+                  << std::setprecision(1) << 100.0 * adaptiveNoise / frames << "% background noise" << std::endl;
+        std::cout << "   Colour key: " << std::setprecision(2) << keyedAverage << "ms/frame, "
+                  << std::setprecision(1) << 100.0 * keyedNoise / frames << "% background noise" << std::endl;
+        return BenchmarkResult("ColorKeyBinarization", "AdvancedOCR", keyedAverage,
+                               *std::min_element(keyedTimes.begin(), keyedTimes.end()),
+                               *std::max_element(keyedTimes.begin(), keyedTimes.end()), frames, frames);
+    });
+    
+    // Every HUD field of a frame through recognizeFields on one core: Tesseract field
+    // engines one box at a time against the CRNN backend, one batch per frame
+    registerBenchmark("AdvancedOCR", "HudRecognizerComparison", []() -> BenchmarkResult {
+        struct Candidate {
+            const char* name;
+            AdvancedOCR::OCRBackend backend;
+            CrnnRecognizer::Precision precision;
+        };
+        const Candidate candidates[] = {
+            {"Tesseract field engines", AdvancedOCR::OCRBackend::TESSERACT, CrnnRecognizer::Precision::FP32},
+            {"CRNN fp32", AdvancedOCR::OCRBackend::CRNN, CrnnRecognizer::Precision::FP32},
+            {"CRNN fp16", AdvancedOCR::OCRBackend::CRNN, CrnnRecognizer::Precision::FP16},
+            {"CRNN int8", AdvancedOCR::OCRBackend::CRNN, CrnnRecognizer::Precision::INT8}
+        };
+        
+        int threads = cv::getNumThreads();
+        cv::setNumThreads(1);
+        
+        BenchmarkResult best("HudRecognizerComparison", "AdvancedOCR", 0.0, 0.0, 0.0, 0, 0);
+        double bestFieldsPerMs = 0.0;
+        for (const auto& candidate : candidates) {
+            AdvancedOCR ocr;
+            ocr.setCrnnPrecision(candidate.precision);
+            if (!ocr.initialize(candidate.backend)) {
+                std::cout << "   " << candidate.name << ": not available" << std::endl;
+                continue;
+            }
+            
+            // Same seed, so every candidate reads the same frames
+            SimulatorConfig config;
+            config.screenShake = false;
+            config.colorFlashes = false;
+            GameSimulator simulator(config);
+            GameSimulator::FrameTruth truth;
+            cv::Mat frame;
+            
+            const size_t frames = 40;
+            size_t fields = 0, correct = 0;
+            std::vector<double> times;
+            for (size_t i = 0; i < frames; ++i) {
+                simulator.step(&frame, &truth);
+                std::vector<cv::Rect> boxes;
+                std::vector<AdvancedOCR::FieldType> types;
+                for (const auto& field : truth.hudFields) {
+                    boxes.emplace_back(field.box.x - 6, field.box.y - 6, field.box.width + 12, field.box.height + 12);
+                    types.push_back(AdvancedOCR::fieldTypeForName(field.name));
+                }
+                
+                BenchmarkTimer timer;
+                auto results = ocr.recognizeFields(frame, boxes, types);
+                times.push_back(timer.elapsedMs());
+                
+                for (size_t f = 0; f < truth.hudFields.size(); ++f) {
+                    std::string text = results[f].text, expected = truth.hudFields[f].text;
+                    text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+                    expected.erase(std::remove(expected.begin(), expected.end(), ' '), expected.end());
+                    std::transform(text.begin(), text.end(), text.begin(), ::toupper);
+                    ++fields;
+                    if (text == expected) ++correct;
+                }
+            }
+            
+            double totalMs = std::accumulate(times.begin(), times.end(), 0.0);
+            double fieldsPerMs = totalMs > 0.0 ? fields / totalMs : 0.0;
+            double accuracy = fields ? 100.0 * correct / fields : 0.0;
+            std::cout << "   " << candidate.name << ": " << std::fixed << std::setprecision(1) << accuracy
+                      << "% exact, " << std::setprecision(2) << fieldsPerMs << " fields/ms, "
+                      << totalMs / frames << "ms/frame" << std::endl;
+            
+            if (fieldsPerMs > bestFieldsPerMs) {
+                bestFieldsPerMs = fieldsPerMs;
+                best = BenchmarkResult("HudRecognizerComparison", "AdvancedOCR", totalMs / frames,
+                                       *std::min_element(times.begin(), times.end()),
+                                       *std::max_element(times.begin(), times.end()), frames, fields);
+            }
+        }
+        
+        cv::setNumThreads(threads);
+        return best;
+    });
+    
+    // Static-HUD mask under a panning camera: cost per frame, and HUD regions needing a
+    // read compared with re-reading every region that has any changed pixel
+    registerBenchmark("OptimizedScreenCapture", "StaticHudMask", []() -> BenchmarkResult {
+        SimulatorConfig config;
+        config.screenShake = false;
+        config.colorFlashes = false;
+        GameSimulator simulator(config);
+        std::vector<cv::Rect> boxes;
+        for (const auto& region : simulator.getHudRegions()) {
+            if (region.name == "banner") continue;
+            boxes.emplace_back(cvRound(region.x * config.width), cvRound(region.y * config.height),
+                               cvRound(region.width * config.width), cvRound(region.height * config.height));
+        }
+        
+        StaticHudMask mask;
+        cv::Mat frame, previous, diff;
+        std::vector<cv::Rect> hudRegions, worldRegions;
+        std::vector<double> times;
+        size_t maskReads = 0, naiveReads = 0, worldBoxes = 0;
+        const size_t frames = 600;
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame);
+            BenchmarkTimer timer;
+            mask.update(frame);
+            mask.changedRegions(hudRegions, worldRegions);
+            double elapsed = timer.elapsedMs();
+            
+            if (mask.isReady()) {
+                times.push_back(elapsed);
+                worldBoxes += worldRegions.size();
+                for (const auto& box : boxes) {
+                    maskReads += mask.hudChanged(box);
+                    cv::absdiff(frame(box), previous(box), diff);
+                    cv::cvtColor(diff, diff, cv::COLOR_BGR2GRAY);
+                    naiveReads += cv::countNonZero(diff > 12) > 0;
+                }
+            }
+            previous = frame.clone();
+        }
+        if (times.empty()) {
+            return BenchmarkResult("StaticHudMask", "OptimizedScreenCapture", 0.0, 0.0, 0.0, 0, 0);
+        }
+        
+        size_t checks = times.size() * boxes.size();
+        std::cout << "   HUD regions to read: " << std::fixed << std::setprecision(1) << 100.0 * maskReads / checks
+                  << "% with the mask, " << 100.0 * naiveReads / checks << "% by pixel difference; "
+                  << static_cast<double>(worldBoxes) / times.size() << " world boxes/frame" << std::endl;
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+        return BenchmarkResult("StaticHudMask", "OptimizedScreenCapture", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), times.size(), times.size());
+    });
+    
+    // Highlight pre-roll: encode cost per frame and buffered bytes against raw frames
+    registerBenchmark("HeadlessPipeline", "HighlightBuffer", []() -> BenchmarkResult {
+        GameSimulator simulator;
+        HighlightRecorder recorder;
+        HighlightRecorder::Options options;
+        options.directory = "highlight_benchmark_clips";
+        if (!recorder.start(options)) {
+            return BenchmarkResult("HighlightBuffer", "HeadlessPipeline", 0.0, 0.0, 0.0, 0, 0);
+        }
+        
+        cv::Mat frame;
+        const size_t frames = 600;
+        std::vector<double> times;
+        times.reserve(frames);
+        size_t rawFrameBytes = 0;
+        for (size_t i = 0; i < frames; ++i) {
+            simulator.step(&frame);
+            BenchmarkTimer timer;
+            recorder.addFrame(frame, static_cast<int64_t>(i) * 33);
+            times.push_back(timer.elapsedMs());
+            rawFrameBytes = frame.total() * frame.elemSize();
+        }
+        size_t buffered = recorder.getBufferedFrames();
+        size_t bufferedBytes = recorder.getBufferedBytes();
+        recorder.stop();
+        std::filesystem::remove_all(options.directory);
+        
+        std::cout << "   " << buffered << " frames buffered in " << std::fixed << std::setprecision(1)
+                  << bufferedBytes / 1048576.0 << "MB (" << buffered * rawFrameBytes / 1048576.0 << "MB raw, "
+                  << static_cast<double>(bufferedBytes) / std::max<size_t>(1, buffered) << " bytes/frame)" << std::endl;
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / frames;
+        return BenchmarkResult("HighlightBuffer", "HeadlessPipeline", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), frames, frames);
+    });
+    
+    // End-to-end latency on simulator frames: capture to the end of each stage, and to
+    // events being recorded, as the pipeline's histograms report them
+    registerBenchmark("HeadlessPipeline", "CaptureToEventLatency", []() -> BenchmarkResult {
+        PipelineConfig config;
+        std::string error;
+        config.set("frames", "synthetic:7", error);
+        config.set("max_frames", "300", error);
+        config.set("ocr", "false", error);
+        HeadlessPipeline pipeline(config);
+        if (!pipeline.start(error)) {
+            return BenchmarkResult("CaptureToEventLatency", "HeadlessPipeline", 0.0, 0.0, 0.0, 0, 0);
+        }
+        while (pipeline.isRunning()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pipeline.stop();
+        
+        HeadlessPipeline::Metrics metrics = pipeline.getMetrics();
+        const HeadlessPipeline::Stage stages[] = {HeadlessPipeline::STAGE_DEDUP, HeadlessPipeline::STAGE_EVENTS,
+                                                  HeadlessPipeline::STAGE_ANALYTICS};
+        for (auto stage : stages) {
+            const auto& latency = metrics.captureToStage[stage];
+            std::cout << "   Capture to " << HeadlessPipeline::stageName(stage) << ": p50 <= " << std::fixed
+                      << std::setprecision(1) << latency.quantileMs(0.5) << "ms, p99 <= " << latency.quantileMs(0.99)
+                      << "ms (" << latency.count << " frames)" << std::endl;
+        }
+        const auto& events = metrics.captureToEvent;
+        std::cout << "   Capture to event: p50 <= " << events.quantileMs(0.5) << "ms, p99 <= "
+                  << events.quantileMs(0.99) << "ms (" << events.count << " frames with events)" << std::endl;
+        
+        const auto& detected = metrics.captureToStage[HeadlessPipeline::STAGE_EVENTS];
+        double averageTime = detected.count ? detected.totalMs / detected.count : 0.0;
+        return BenchmarkResult("CaptureToEventLatency", "HeadlessPipeline", averageTime,
+                               detected.quantileMs(0.0), std::min(detected.quantileMs(1.0), 5000.0),
+                               detected.count, metrics.framesProcessed);
+    });
+    
+    // Reads every field through the same path used for real game processes
+    registerBenchmark("ProcessMemory", "SimulatedFieldReads", []() -> BenchmarkResult {
+        SimulatorConfig config;
+        config.randomizeLayout = true;
+        GameSimulator simulator(config);
+        int processId = ProcessMemory::currentProcessId();
+        
+        const size_t iterations = 200;
+        std::vector<double> times;
+        times.reserve(iterations);
+        size_t mismatches = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            simulator.step(nullptr);
+            BenchmarkTimer timer;
+            for (int field = 0; field < GameSimulator::FIELD_COUNT; ++field) {
+                int32_t value = 0;
+                auto id = static_cast<GameSimulator::Field>(field);
+                if (!ProcessMemory::read(processId, simulator.getFieldAddress(id), &value, sizeof(value)) ||
+                    value != simulator.getValue(id)) {
+                    ++mismatches;
+                }
+            }
+            times.push_back(timer.elapsedMs());
+        }
+        
+        if (mismatches) {
+            std::cout << "   Memory reads that failed or disagreed with the simulator: " << mismatches << std::endl;
+        }
+        double averageTime = std::accumulate(times.begin(), times.end(), 0.0) / iterations;
+        return BenchmarkResult("SimulatedFieldReads", "ProcessMemory", averageTime,
+                               *std::min_element(times.begin(), times.end()),
+                               *std::max_element(times.begin(), times.end()), iterations,
+                               iterations * GameSimulator::FIELD_COUNT);
+    });
+}
+
 // Register all benchmarks
 void registerAllBenchmarks() {
     registerOCRBenchmark();
@@ -332,7 +1272,15 @@ void registerAllBenchmarks() {
     registerCPUUsageBenchmark();
     registerThroughputBenchmark();
     registerStartupTimeBenchmark();
+    registerParallelStartupBenchmark();
     registerOCRAccuracyBenchmark();
+    registerSharedModelBenchmark();
+    registerStatsKernelBenchmarks();
+    registerTrigramIndexBenchmark();
+    registerSessionExportBenchmarks();
+    registerPerformanceMonitorBenchmarks();
+    registerSerializationBenchmarks();
+    registerSimulatorBenchmarks();
 }
 
 } // namespace BloombergTerminalTests
@@ -1,33 +1,85 @@
 #include "performance_monitor.h"
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
 
 PerformanceMonitor& PerformanceMonitor::getInstance() {
     static PerformanceMonitor instance;
     return instance;
 }
 
-void PerformanceMonitor::startTimer(const std::string& operation) {
+size_t PerformanceMonitor::getResidentMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.WorkingSetSize;
+#else
+    // Second field of statm is the resident page count
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    unsigned long totalPages = 0, residentPages = 0;
+    int fields = fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    fclose(statm);
+    return fields == 2 ? residentPages * static_cast<size_t>(sysconf(_SC_PAGESIZE)) : 0;
+#endif
+}
+
+PerformanceMonitor::MetricId PerformanceMonitor::registerMetric(const std::string& operation) {
     std::lock_guard<std::mutex> lock(metricsMutex);
-    activeTimers[operation] = std::chrono::high_resolution_clock::now();
+    
+    auto it = metricIds.find(operation);
+    if (it != metricIds.end()) return it->second;
+    
+    MetricId id = metrics.size();
+    metricIds.emplace(operation, id);
+    metrics.emplace_back();
+    metrics.back().name = operation;
+    activeTimers.emplace_back();
+    anomalySeries.push_back(anomalyMonitor.registerSeries(operation));
+    return id;
 }
 
-void PerformanceMonitor::endTimer(const std::string& operation) {
+void PerformanceMonitor::startTimer(MetricId id) {
+    auto now = std::chrono::high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    if (id < activeTimers.size()) activeTimers[id] = now;
+}
+
+void PerformanceMonitor::startTimer(const std::string& operation) {
+    startTimer(registerMetric(operation));
+}
+
+void PerformanceMonitor::endTimer(MetricId id) {
+    auto endTime = std::chrono::high_resolution_clock::now();
     std::lock_guard<std::mutex> lock(metricsMutex);
     
-    auto it = activeTimers.find(operation);
-    if (it != activeTimers.end()) {
-        auto endTime = std::chrono::high_resolution_clock::now();
+    if (id < activeTimers.size() && activeTimers[id] != std::chrono::high_resolution_clock::time_point()) {
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
-            endTime - it->second).count() / 1000.0; // Convert to milliseconds
+            endTime - activeTimers[id]).count() / 1000.0; // Convert to milliseconds
         
-        updateMetric(operation, duration);
-        activeTimers.erase(it);
+        updateMetric(id, duration);
+        activeTimers[id] = std::chrono::high_resolution_clock::time_point();
     }
 }
 
-void PerformanceMonitor::updateMetric(const std::string& operation, double duration) {
-    auto& metric = metrics[operation];
+void PerformanceMonitor::endTimer(const std::string& operation) {
+    endTimer(registerMetric(operation));
+}
+
+void PerformanceMonitor::recordDuration(MetricId id, double durationMs) {
+    std::lock_guard<std::mutex> lock(metricsMutex);
+    if (id < metrics.size()) updateMetric(id, durationMs);
+}
+
+void PerformanceMonitor::updateMetric(MetricId id, double duration) {
+    auto& metric = metrics[id];
     
     metric.totalCalls++;
     metric.totalTime += duration;
@@ -40,24 +92,41 @@ void PerformanceMonitor::updateMetric(const std::string& operation, double durat
         metric.minTime = std::min(metric.minTime, duration);
         metric.maxTime = std::max(metric.maxTime, duration);
     }
+    
+    int64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    anomalyMonitor.observe(anomalySeries[id], duration, timestamp);
 }
 
 PerformanceMonitor::PerformanceMetric PerformanceMonitor::getMetric(const std::string& operation) const {
     std::lock_guard<std::mutex> lock(metricsMutex);
     
-    auto it = metrics.find(operation);
-    return (it != metrics.end()) ? it->second : PerformanceMetric();
+    auto it = metricIds.find(operation);
+    return (it != metricIds.end()) ? metrics[it->second] : PerformanceMetric();
 }
 
 std::map<std::string, PerformanceMonitor::PerformanceMetric> PerformanceMonitor::getAllMetrics() const {
     std::lock_guard<std::mutex> lock(metricsMutex);
-    return metrics;
+    
+    // Registered operations that have not been timed yet are left out
+    std::map<std::string, PerformanceMetric> result;
+    for (const auto& entry : metricIds) {
+        if (metrics[entry.second].totalCalls > 0) result.emplace(entry.first, metrics[entry.second]);
+    }
+    return result;
 }
 
 void PerformanceMonitor::reset() {
     std::lock_guard<std::mutex> lock(metricsMutex);
-    metrics.clear();
-    activeTimers.clear();
+    
+    // Registrations survive so IDs held by callers stay valid
+    for (auto& metric : metrics) {
+        std::string name = std::move(metric.name);
+        metric = PerformanceMetric();
+        metric.name = std::move(name);
+    }
+    std::fill(activeTimers.begin(), activeTimers.end(), std::chrono::high_resolution_clock::time_point());
+    anomalyMonitor.reset();
 }
 
 bool PerformanceMonitor::meetsTarget(const std::string& operation, double targetMs) const {
@@ -66,10 +135,16 @@ bool PerformanceMonitor::meetsTarget(const std::string& operation, double target
 }
 
 // ScopedTimer Implementation
-ScopedTimer::ScopedTimer(const std::string& op) : operation(op) {
-    PerformanceMonitor::getInstance().startTimer(operation);
+ScopedTimer::ScopedTimer(PerformanceMonitor::MetricId metricId)
+    : id(metricId), startTime(std::chrono::high_resolution_clock::now()) {
+}
+
+ScopedTimer::ScopedTimer(const std::string& operation)
+    : ScopedTimer(PerformanceMonitor::getInstance().registerMetric(operation)) {
 }
 
 ScopedTimer::~ScopedTimer() {
-    PerformanceMonitor::getInstance().endTimer(operation);
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::high_resolution_clock::now() - startTime).count() / 1000.0;
+    PerformanceMonitor::getInstance().recordDuration(id, duration);
 }
@@ -6,6 +6,7 @@
 #include <map>
 #include <mutex>
 #include <atomic>
+#include "anomaly_detector.h"
 
 class PerformanceMonitor {
 public:
@@ -20,14 +21,25 @@ public:
         PerformanceMetric() : averageTime(0), minTime(0), maxTime(0), totalCalls(0), totalTime(0) {}
     };
     
+    using MetricId = size_t;
+    
     static PerformanceMonitor& getInstance();
     
+    // Dense ID for an operation, the same one if it is already registered. Timing by
+    // ID is an array index; names are only for setup and reporting
+    MetricId registerMetric(const std::string& operation);
+    
     // Start timing an operation
+    void startTimer(MetricId id);
     void startTimer(const std::string& operation);
     
     // End timing and record the result
+    void endTimer(MetricId id);
     void endTimer(const std::string& operation);
     
+    // Record a duration the caller measured itself
+    void recordDuration(MetricId id, double durationMs);
+    
     // Get performance statistics
     PerformanceMetric getMetric(const std::string& operation) const;
     
@@ -40,6 +52,12 @@ public:
     // Check if operation meets performance target
     bool meetsTarget(const std::string& operation, double targetMs) const;
     
+    // Resident memory of this process (working set on Windows); 0 if unavailable
+    static size_t getResidentMemoryBytes();
+    
+    // Latency anomalies raised since the last call (one series per operation)
+    std::vector<AnomalyEvent> drainAnomalies() { return anomalyMonitor.drainEvents(); }
+    
     // Performance targets (in milliseconds)
     static constexpr double TARGET_CAPTURE_TIME = 16.67; // 60 FPS
     static constexpr double TARGET_OCR_TIME = 50.0;      // <50ms target
@@ -50,22 +68,28 @@ private:
     PerformanceMonitor() = default;
     
     mutable std::mutex metricsMutex;
-    std::map<std::string, PerformanceMetric> metrics;
-    std::map<std::string, std::chrono::high_resolution_clock::time_point> activeTimers;
+    std::map<std::string, MetricId> metricIds;     // Registration and reporting only
+    std::vector<PerformanceMetric> metrics;         // Indexed by metric ID, as are the two below
+    std::vector<std::chrono::high_resolution_clock::time_point> activeTimers;  // Default value: not running
+    std::vector<size_t> anomalySeries;
+    AnomalyMonitor anomalyMonitor;
     
-    void updateMetric(const std::string& operation, double duration);
+    void updateMetric(MetricId id, double duration);
 };
 
 // RAII Timer class for automatic timing
 class ScopedTimer {
 public:
+    explicit ScopedTimer(PerformanceMonitor::MetricId id);
     ScopedTimer(const std::string& operation);
     ~ScopedTimer();
     
 private:
-    std::string operation;
+    PerformanceMonitor::MetricId id;
     std::chrono::high_resolution_clock::time_point startTime;
 };
 
-// Macro for easy timing
-#define TIMED_OPERATION(name) ScopedTimer _timer(name)
+// Macro for easy timing; the name is registered once per call site
+#define TIMED_OPERATION(name) \
+    static const PerformanceMonitor::MetricId _timerId = PerformanceMonitor::getInstance().registerMetric(name); \
+    ScopedTimer _timer(_timerId)
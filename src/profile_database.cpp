@@ -0,0 +1,670 @@
+#include "profile_database.h"
+#include "file_hasher.h"
+#include "trigram_index.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+
+namespace {
+
+const char DATABASE_MAGIC[8] = {'G', 'A', 'P', 'R', 'O', 'F', 'D', 'B'};
+const char* const SOURCE_EXTENSION = ".txt";
+const int DEFAULT_TEXT_COLOR_TOLERANCE = 60;     // Per channel, for @text lines without one
+
+size_t alignTo8(size_t offset) {
+    return (offset + 7) & ~size_t(7);
+}
+
+std::string toLower(const std::string& text) {
+    std::string lowered(text);
+    for (char& c : lowered) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return lowered;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+// "@visual" payload: exactly one descriptor of hex digits
+bool parseHexDescriptor(const std::string& hex, ProfileDefinition::VisualDescriptorBytes& bytes) {
+    if (hex.size() != 2 * bytes.size()) return false;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        int value = 0;
+        for (size_t digit = 2 * i; digit < 2 * i + 2; ++digit) {
+            char c = static_cast<char>(std::tolower(static_cast<unsigned char>(hex[digit])));
+            if (c >= '0' && c <= '9') value = value * 16 + (c - '0');
+            else if (c >= 'a' && c <= 'f') value = value * 16 + (c - 'a' + 10);
+            else return false;
+        }
+        bytes[i] = static_cast<uint8_t>(value);
+    }
+    return true;
+}
+
+std::string sourceStem(const std::string& fileName) {
+    return std::filesystem::path(fileName).stem().string();
+}
+
+struct SourceFile {
+    std::string fileName;
+    std::string path;
+    uint64_t size;
+    int64_t modifiedTime;
+};
+
+// Profile sources in name order, so rebuilds are deterministic
+std::vector<SourceFile> listSourceFiles(const std::string& sourceDirectory) {
+    std::vector<SourceFile> sources;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(sourceDirectory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file(error) || it->path().extension() != SOURCE_EXTENSION) continue;
+
+        SourceFile source;
+        source.fileName = it->path().filename().string();
+        source.path = it->path().string();
+        source.size = it->file_size(error);
+        if (error) continue;
+        source.modifiedTime = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count());
+        if (error) continue;
+        sources.push_back(source);
+    }
+    std::sort(sources.begin(), sources.end(),
+              [](const SourceFile& a, const SourceFile& b) { return a.fileName < b.fileName; });
+    return sources;
+}
+
+// Changes when a source is added, removed or renamed (editors mostly save by rename)
+bool directoryModifiedTime(const std::string& directory, int64_t& time) {
+    std::error_code error;
+    auto modified = std::filesystem::last_write_time(directory, error);
+    if (error) return false;
+    time = static_cast<int64_t>(modified.time_since_epoch().count());
+    return true;
+}
+
+// In-memory image of the database while compiling
+struct DatabaseBuilder {
+    std::vector<ProfileDatabase::ProfileRecord> profiles;
+    std::vector<ProfileDatabase::AddressRecord> addresses;
+    std::vector<ProfileDatabase::HudRegionRecord> hudRegions;
+    std::vector<ProfileDatabase::CueRecord> cues;
+    std::vector<ProfileDatabase::TextColorRecord> textColors;
+    std::vector<ProfileDatabase::VisualRecord> visuals;
+    std::string strings;
+    std::map<std::string, uint32_t> internedStrings;
+
+    DatabaseBuilder() : strings(1, '\0') {
+        internedStrings[""] = 0;
+    }
+
+    uint32_t intern(const std::string& text) {
+        auto it = internedStrings.find(text);
+        if (it != internedStrings.end()) return it->second;
+
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.append(text);
+        strings.push_back('\0');
+        internedStrings[text] = offset;
+        return offset;
+    }
+
+    ProfileDatabase::ProfileRecord& beginProfile(const SourceFile& source) {
+        ProfileDatabase::ProfileRecord record = {};
+        record.sourceFile = intern(source.fileName);
+        record.sourceSize = source.size;
+        record.sourceModifiedTime = source.modifiedTime;
+        record.firstAddress = static_cast<uint32_t>(addresses.size());
+        record.firstHudRegion = static_cast<uint32_t>(hudRegions.size());
+        record.firstCue = static_cast<uint32_t>(cues.size());
+        record.firstTextColor = static_cast<uint32_t>(textColors.size());
+        record.firstVisual = static_cast<uint32_t>(visuals.size());
+        profiles.push_back(record);
+        return profiles.back();
+    }
+};
+
+bool parseSourceFile(const SourceFile& source, DatabaseBuilder& builder) {
+    ProfileDefinition profile;
+    if (!ProfileDatabase::parseProfile(source.path, profile)) return false;
+
+    ProfileDatabase::ProfileRecord& record = builder.beginProfile(source);
+    record.name = builder.intern(profile.name);
+    record.executable = builder.intern(profile.executable);
+    record.windowTitle = builder.intern(profile.windowTitle);
+    record.executableHash = builder.intern(profile.executableHash);
+
+    for (const auto& address : profile.addresses) {
+        ProfileDatabase::AddressRecord entry = {};
+        entry.address = address.address;
+        entry.name = builder.intern(address.name);
+        builder.addresses.push_back(entry);
+    }
+    for (const auto& hudRegion : profile.hudRegions) {
+        ProfileDatabase::HudRegionRecord region = {};
+        region.name = builder.intern(hudRegion.name);
+        region.x = hudRegion.x;
+        region.y = hudRegion.y;
+        region.width = hudRegion.width;
+        region.height = hudRegion.height;
+        builder.hudRegions.push_back(region);
+    }
+    for (const auto& profileCue : profile.cues) {
+        ProfileDatabase::CueRecord cue = {};
+        cue.name = builder.intern(profileCue.name);
+        cue.red = profileCue.red;
+        cue.green = profileCue.green;
+        cue.blue = profileCue.blue;
+        cue.threshold = profileCue.threshold;
+        cue.durationMs = profileCue.durationMs;
+        cue.x = profileCue.x;
+        cue.y = profileCue.y;
+        cue.width = profileCue.width;
+        cue.height = profileCue.height;
+        builder.cues.push_back(cue);
+    }
+    for (const auto& textColor : profile.textColors) {
+        ProfileDatabase::TextColorRecord color = {};
+        color.red = textColor.red;
+        color.green = textColor.green;
+        color.blue = textColor.blue;
+        color.tolerance = static_cast<uint8_t>(std::min(255, std::max(0, textColor.tolerance)));
+        builder.textColors.push_back(color);
+    }
+    for (const auto& descriptor : profile.visualDescriptors) {
+        ProfileDatabase::VisualRecord visual = {};
+        std::copy(descriptor.begin(), descriptor.end(), visual.descriptor);
+        builder.visuals.push_back(visual);
+    }
+
+    record.addressCount = static_cast<uint32_t>(profile.addresses.size());
+    record.hudRegionCount = static_cast<uint32_t>(profile.hudRegions.size());
+    record.cueCount = static_cast<uint32_t>(profile.cues.size());
+    record.textColorCount = static_cast<uint32_t>(profile.textColors.size());
+    record.visualCount = static_cast<uint32_t>(profile.visualDescriptors.size());
+    return true;
+}
+
+void copyProfile(const SourceFile& source, const ProfileDatabase::ProfileView& view, DatabaseBuilder& builder) {
+    ProfileDatabase::ProfileRecord& record = builder.beginProfile(source);
+    record.name = builder.intern(view.name());
+    record.executable = builder.intern(view.executable());
+    record.windowTitle = builder.intern(view.windowTitle());
+    record.executableHash = builder.intern(view.executableHash());
+
+    for (size_t i = 0; i < view.addressCount(); ++i) {
+        ProfileDatabase::AddressRecord entry = view.address(i);
+        entry.name = builder.intern(view.database->text(entry.name));
+        builder.addresses.push_back(entry);
+    }
+    for (size_t i = 0; i < view.hudRegionCount(); ++i) {
+        ProfileDatabase::HudRegionRecord region = view.hudRegion(i);
+        region.name = builder.intern(view.database->text(region.name));
+        builder.hudRegions.push_back(region);
+    }
+    for (size_t i = 0; i < view.cueCount(); ++i) {
+        ProfileDatabase::CueRecord cue = view.cue(i);
+        cue.name = builder.intern(view.database->text(cue.name));
+        builder.cues.push_back(cue);
+    }
+    for (size_t i = 0; i < view.textColorCount(); ++i) {
+        builder.textColors.push_back(view.textColor(i));
+    }
+    for (size_t i = 0; i < view.visualCount(); ++i) {
+        builder.visuals.push_back(view.visual(i));
+    }
+
+    record.addressCount = static_cast<uint32_t>(view.addressCount());
+    record.hudRegionCount = static_cast<uint32_t>(view.hudRegionCount());
+    record.cueCount = static_cast<uint32_t>(view.cueCount());
+    record.textColorCount = static_cast<uint32_t>(view.textColorCount());
+    record.visualCount = static_cast<uint32_t>(view.visualCount());
+}
+
+bool writeSection(FILE* file, size_t& position, size_t offset, const void* data, size_t bytes) {
+    static const char padding[8] = {};
+    if (offset > position && fwrite(padding, 1, offset - position, file) != offset - position) return false;
+    if (bytes > 0 && fwrite(data, 1, bytes, file) != bytes) return false;
+    position = offset + bytes;
+    return true;
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+    std::error_code error;
+    std::filesystem::rename(from, to, error);
+    if (error) {
+        std::filesystem::remove(to, error);
+        std::filesystem::rename(from, to, error);
+    }
+    return !error;
+}
+
+} // namespace
+
+// ProfileDatabase Implementation
+ProfileDatabase::ProfileDatabase() : verifiedDirectoryTime(0), sourcesVerified(false) {
+    close();
+}
+
+ProfileDatabase::~ProfileDatabase() {
+    close();
+}
+
+bool ProfileDatabase::open(const std::string& databasePath) {
+    close();
+
+    if (!mappedFile.open(databasePath) || mappedFile.size() < sizeof(Header)) {
+        mappedFile.close();
+        return false;
+    }
+    size_t mappedSize = mappedFile.size();
+
+    // Header and section bounds are checked once here; lookups trust them afterwards
+    const char* base = mappedFile.data();
+    const Header* header = reinterpret_cast<const Header*>(base);
+    static const size_t recordSizes[SECTION_COUNT] = {
+        sizeof(ProfileRecord), sizeof(AddressRecord), sizeof(HudRegionRecord), sizeof(CueRecord),
+        sizeof(TextColorRecord), sizeof(VisualRecord), sizeof(LookupRecord), sizeof(LookupRecord), sizeof(LookupRecord),
+        sizeof(LookupRecord), 1
+    };
+
+    bool valid = std::memcmp(header->magic, DATABASE_MAGIC, sizeof(DATABASE_MAGIC)) == 0 &&
+                 header->version == FORMAT_VERSION;
+    for (int section = 0; valid && section < SECTION_COUNT; ++section) {
+        uint64_t offset = header->offsets[section];
+        uint64_t count = header->counts[section];
+        valid = offset % 8 == 0 && offset <= mappedSize && count <= (mappedSize - offset) / recordSizes[section];
+    }
+    valid = valid && header->counts[STRINGS] > 0 && base[header->offsets[STRINGS] + header->counts[STRINGS] - 1] == '\0';
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    profiles = reinterpret_cast<const ProfileRecord*>(base + header->offsets[PROFILES]);
+    addresses = reinterpret_cast<const AddressRecord*>(base + header->offsets[ADDRESSES]);
+    hudRegions = reinterpret_cast<const HudRegionRecord*>(base + header->offsets[HUD_REGIONS]);
+    cues = reinterpret_cast<const CueRecord*>(base + header->offsets[CUES]);
+    textColors = reinterpret_cast<const TextColorRecord*>(base + header->offsets[TEXT_COLORS]);
+    visuals = reinterpret_cast<const VisualRecord*>(base + header->offsets[VISUALS]);
+    for (int table = 0; table < 4; ++table) {
+        lookups[table] = reinterpret_cast<const LookupRecord*>(base + header->offsets[NAME_LOOKUP + table]);
+        lookupCounts[table] = static_cast<size_t>(header->counts[NAME_LOOKUP + table]);
+    }
+    strings = base + header->offsets[STRINGS];
+    profileCount = static_cast<size_t>(header->counts[PROFILES]);
+    stringBytes = static_cast<size_t>(header->counts[STRINGS]);
+    for (int section = ADDRESSES; section <= VISUALS; ++section) {
+        sectionCounts[section] = header->counts[section];
+    }
+    return true;
+}
+
+// Checked as each record is handed out, so open stays O(1) in the profile count
+bool ProfileDatabase::recordInBounds(size_t index) const {
+    if (index >= profileCount) return false;
+    const ProfileRecord& record = profiles[index];
+    return record.firstAddress + uint64_t(record.addressCount) <= sectionCounts[ADDRESSES] &&
+           record.firstHudRegion + uint64_t(record.hudRegionCount) <= sectionCounts[HUD_REGIONS] &&
+           record.firstCue + uint64_t(record.cueCount) <= sectionCounts[CUES] &&
+           record.firstTextColor + uint64_t(record.textColorCount) <= sectionCounts[TEXT_COLORS] &&
+           record.firstVisual + uint64_t(record.visualCount) <= sectionCounts[VISUALS];
+}
+
+void ProfileDatabase::close() {
+    mappedFile.close();
+    profiles = nullptr;
+    addresses = nullptr;
+    hudRegions = nullptr;
+    cues = nullptr;
+    textColors = nullptr;
+    visuals = nullptr;
+    for (int table = 0; table < 4; ++table) {
+        lookups[table] = nullptr;
+        lookupCounts[table] = 0;
+    }
+    strings = nullptr;
+    profileCount = 0;
+    stringBytes = 0;
+    for (int section = 0; section < SECTION_COUNT; ++section) sectionCounts[section] = 0;
+    sourcesVerified = false;
+}
+
+bool ProfileDatabase::openOrBuild(const std::string& sourceDirectory, const std::string& databasePath) {
+    // Already checked against this directory and nothing was added, removed or reported changed
+    int64_t directoryTime = 0;
+    bool directoryTimeKnown = directoryModifiedTime(sourceDirectory, directoryTime);
+    if (isOpen() && sourcesVerified && directoryTimeKnown && sourceDirectory == verifiedDirectory &&
+        directoryTime == verifiedDirectoryTime) {
+        return true;
+    }
+
+    if ((isOpen() || open(databasePath)) && !isStale(sourceDirectory)) {
+        if (directoryTimeKnown) markVerified(sourceDirectory, directoryTime);
+        return true;
+    }
+
+    // Build beside the live file, then swap; the old mapping must go first on Windows
+    std::string temporaryPath = databasePath + ".tmp";
+    CompileStats stats;
+    bool compiled = compile(sourceDirectory, temporaryPath, isOpen() ? this : nullptr, &stats);
+    close();
+    if (!compiled || !replaceFile(temporaryPath, databasePath)) {
+        std::remove(temporaryPath.c_str());
+        return open(databasePath);
+    }
+
+    lastCompileStats = stats;
+    if (!open(databasePath)) return false;
+    if (directoryTimeKnown) markVerified(sourceDirectory, directoryTime);
+    return true;
+}
+
+void ProfileDatabase::markVerified(const std::string& sourceDirectory, int64_t directoryTime) {
+    verifiedDirectory = sourceDirectory;
+    verifiedDirectoryTime = directoryTime;
+    sourcesVerified = true;
+}
+
+bool ProfileDatabase::isStale(const std::string& sourceDirectory) const {
+    if (!isOpen()) return true;
+
+    // Both sides are in file-name order. A source without a record is one compile
+    // skipped; it only makes the database stale once it can be read
+    std::vector<SourceFile> sources = listSourceFiles(sourceDirectory);
+    size_t recordIndex = 0;
+    for (const SourceFile& source : sources) {
+        if (recordIndex < profileCount && source.fileName == text(profiles[recordIndex].sourceFile)) {
+            const ProfileRecord& record = profiles[recordIndex++];
+            if (source.size != record.sourceSize || source.modifiedTime != record.sourceModifiedTime) return true;
+            continue;
+        }
+        FILE* file = fopen(source.path.c_str(), "r");
+        if (file) {
+            fclose(file);
+            return true;
+        }
+    }
+    return recordIndex != profileCount;     // Sources removed
+}
+
+bool ProfileDatabase::parseProfile(const std::string& sourcePath, ProfileDefinition& profile) {
+    FILE* file = fopen(sourcePath.c_str(), "r");
+    if (!file) return false;
+
+    profile = ProfileDefinition();
+    profile.sourceFile = std::filesystem::path(sourcePath).filename().string();
+    profile.name = sourceStem(profile.sourceFile);
+
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        std::string text = trim(line);
+        if (text.empty()) continue;
+
+        // "# Key: value" headers; other comments are ignored
+        if (text[0] == '#') {
+            size_t colon = text.find(':');
+            if (colon == std::string::npos) continue;
+            std::string key = toLower(trim(text.substr(1, colon - 1)));
+            std::string value = trim(text.substr(colon + 1));
+            if (key == "game") profile.name = value;
+            else if (key == "executable") profile.executable = value;
+            else if (key == "window") profile.windowTitle = value;
+            else if (key == "hash") profile.executableHash = toLower(value);
+            continue;
+        }
+
+        char entryName[100];
+        if (text.compare(0, 4, "@hud") == 0) {
+            ProfileDefinition::HudRegion region = {};
+            if (sscanf(text.c_str(), "@hud %99s %f %f %f %f", entryName,
+                       &region.x, &region.y, &region.width, &region.height) == 5) {
+                region.name = entryName;
+                profile.hudRegions.push_back(region);
+            }
+            continue;
+        }
+        if (text.compare(0, 4, "@cue") == 0) {
+            ProfileDefinition::Cue cue = {};
+            int red, green, blue;
+            if (sscanf(text.c_str(), "@cue %99s %d %d %d %f %d %f %f %f %f", entryName, &red, &green, &blue,
+                       &cue.threshold, &cue.durationMs, &cue.x, &cue.y, &cue.width, &cue.height) == 10) {
+                cue.name = entryName;
+                cue.red = static_cast<uint8_t>(std::min(255, std::max(0, red)));
+                cue.green = static_cast<uint8_t>(std::min(255, std::max(0, green)));
+                cue.blue = static_cast<uint8_t>(std::min(255, std::max(0, blue)));
+                profile.cues.push_back(cue);
+            }
+            continue;
+        }
+        if (text.compare(0, 5, "@text") == 0) {
+            int red, green, blue, tolerance = DEFAULT_TEXT_COLOR_TOLERANCE;
+            if (sscanf(text.c_str(), "@text %d %d %d %d", &red, &green, &blue, &tolerance) >= 3) {
+                profile.textColors.push_back(ProfileDefinition::TextColor{
+                    static_cast<uint8_t>(std::min(255, std::max(0, red))),
+                    static_cast<uint8_t>(std::min(255, std::max(0, green))),
+                    static_cast<uint8_t>(std::min(255, std::max(0, blue))),
+                    std::min(255, std::max(0, tolerance))});
+            }
+            continue;
+        }
+        if (text.compare(0, 7, "@visual") == 0) {
+            ProfileDefinition::VisualDescriptorBytes descriptor;
+            if (parseHexDescriptor(trim(text.substr(7)), descriptor)) {
+                profile.visualDescriptors.push_back(descriptor);
+            }
+            continue;
+        }
+
+        // Same two address formats loadGameProfile has always accepted
+        unsigned long long address;
+        if (sscanf(text.c_str(), "%99[^=]=0x%llX", entryName, &address) == 2 ||
+            sscanf(text.c_str(), "0x%llX %99s", &address, entryName) == 2) {
+            profile.addresses.push_back(ProfileDefinition::Address{trim(entryName), address});
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+ProfileDefinition ProfileDatabase::ProfileView::definition() const {
+    ProfileDefinition profile;
+    if (!valid()) return profile;
+
+    profile.name = name();
+    profile.executable = executable();
+    profile.windowTitle = windowTitle();
+    profile.executableHash = executableHash();
+    profile.sourceFile = sourceFile();
+    for (size_t i = 0; i < addressCount(); ++i) {
+        profile.addresses.push_back(ProfileDefinition::Address{database->text(address(i).name), address(i).address});
+    }
+    for (size_t i = 0; i < hudRegionCount(); ++i) {
+        const HudRegionRecord& region = hudRegion(i);
+        profile.hudRegions.push_back(ProfileDefinition::HudRegion{
+            database->text(region.name), region.x, region.y, region.width, region.height});
+    }
+    for (size_t i = 0; i < cueCount(); ++i) {
+        const CueRecord& record = cue(i);
+        profile.cues.push_back(ProfileDefinition::Cue{
+            database->text(record.name), record.red, record.green, record.blue, record.threshold,
+            record.durationMs, record.x, record.y, record.width, record.height});
+    }
+    for (size_t i = 0; i < textColorCount(); ++i) {
+        const TextColorRecord& record = textColor(i);
+        profile.textColors.push_back(ProfileDefinition::TextColor{record.red, record.green, record.blue, record.tolerance});
+    }
+    for (size_t i = 0; i < visualCount(); ++i) {
+        ProfileDefinition::VisualDescriptorBytes descriptor;
+        std::copy(visual(i).descriptor, visual(i).descriptor + descriptor.size(), descriptor.begin());
+        profile.visualDescriptors.push_back(descriptor);
+    }
+    return profile;
+}
+
+bool ProfileDatabase::compile(const std::string& sourceDirectory, const std::string& outputPath,
+                              const ProfileDatabase* previous, CompileStats* stats) {
+    std::vector<SourceFile> sources = listSourceFiles(sourceDirectory);
+    DatabaseBuilder builder;
+    CompileStats localStats;
+    localStats.sourceFiles = sources.size();
+
+    // Unchanged sources are copied record-for-record instead of reparsed
+    std::map<std::string, ProfileView> previousProfiles;
+    if (previous && previous->isOpen()) {
+        for (size_t i = 0; i < previous->size(); ++i) {
+            ProfileView view = previous->profile(i);
+            previousProfiles[view.sourceFile()] = view;
+        }
+    }
+
+    for (const auto& source : sources) {
+        auto it = previousProfiles.find(source.fileName);
+        if (it != previousProfiles.end() && it->second.record->sourceSize == source.size &&
+            it->second.record->sourceModifiedTime == source.modifiedTime) {
+            copyProfile(source, it->second, builder);
+            localStats.reusedFiles++;
+        } else if (parseSourceFile(source, builder)) {
+            localStats.parsedFiles++;
+        }
+    }
+
+    // Sorted (key hash, profile) tables; empty fields are not indexed
+    std::vector<LookupRecord> tables[4];
+    static const uint32_t ProfileRecord::* const fields[4] = {
+        &ProfileRecord::name, &ProfileRecord::executable, &ProfileRecord::windowTitle, &ProfileRecord::executableHash
+    };
+    for (uint32_t i = 0; i < builder.profiles.size(); ++i) {
+        for (int table = 0; table < 4; ++table) {
+            std::string key = lookupKey(static_cast<Section>(NAME_LOOKUP + table),
+                                        builder.strings.c_str() + (builder.profiles[i].*fields[table]));
+            if (key.empty()) continue;
+            LookupRecord lookup = {keyHash(key), i, 0};
+            tables[table].push_back(lookup);
+        }
+
+        // The file name stays a name alias, as profiles were always looked up by it
+        std::string stem = lookupKey(NAME_LOOKUP, sourceStem(builder.strings.c_str() + builder.profiles[i].sourceFile));
+        if (stem != lookupKey(NAME_LOOKUP, builder.strings.c_str() + builder.profiles[i].name)) {
+            LookupRecord lookup = {keyHash(stem), i, 0};
+            tables[0].push_back(lookup);
+        }
+    }
+    for (auto& table : tables) {
+        std::sort(table.begin(), table.end(), [](const LookupRecord& a, const LookupRecord& b) {
+            return a.key != b.key ? a.key < b.key : a.profile < b.profile;
+        });
+    }
+
+    Header header = {};
+    std::memcpy(header.magic, DATABASE_MAGIC, sizeof(DATABASE_MAGIC));
+    header.version = FORMAT_VERSION;
+
+    const void* sectionData[SECTION_COUNT] = {
+        builder.profiles.data(), builder.addresses.data(), builder.hudRegions.data(), builder.cues.data(),
+        builder.textColors.data(), builder.visuals.data(), tables[0].data(), tables[1].data(), tables[2].data(), tables[3].data(), builder.strings.data()
+    };
+    const size_t sectionBytes[SECTION_COUNT] = {
+        builder.profiles.size() * sizeof(ProfileRecord), builder.addresses.size() * sizeof(AddressRecord),
+        builder.hudRegions.size() * sizeof(HudRegionRecord), builder.cues.size() * sizeof(CueRecord),
+        builder.textColors.size() * sizeof(TextColorRecord), builder.visuals.size() * sizeof(VisualRecord), tables[0].size() * sizeof(LookupRecord), tables[1].size() * sizeof(LookupRecord),
+        tables[2].size() * sizeof(LookupRecord), tables[3].size() * sizeof(LookupRecord), builder.strings.size()
+    };
+    const size_t sectionCounts[SECTION_COUNT] = {
+        builder.profiles.size(), builder.addresses.size(), builder.hudRegions.size(), builder.cues.size(),
+        builder.textColors.size(), builder.visuals.size(), tables[0].size(), tables[1].size(), tables[2].size(), tables[3].size(), builder.strings.size()
+    };
+
+    size_t offset = sizeof(Header);
+    for (int section = 0; section < SECTION_COUNT; ++section) {
+        offset = alignTo8(offset);
+        header.offsets[section] = offset;
+        header.counts[section] = sectionCounts[section];
+        offset += sectionBytes[section];
+    }
+
+    FILE* file = fopen(outputPath.c_str(), "wb");
+    if (!file) return false;
+
+    size_t position = 0;
+    bool written = writeSection(file, position, 0, &header, sizeof(header));
+    for (int section = 0; written && section < SECTION_COUNT; ++section) {
+        written = writeSection(file, position, header.offsets[section], sectionData[section], sectionBytes[section]);
+    }
+    written = fclose(file) == 0 && written;
+    if (!written) {
+        std::remove(outputPath.c_str());
+        return false;
+    }
+
+    if (stats) *stats = localStats;
+    return true;
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::find(Section table, const std::string& key,
+                                                   uint32_t ProfileRecord::*field) const {
+    std::string normalized = lookupKey(table, key);
+    if (!isOpen() || normalized.empty()) return ProfileView();
+
+    const LookupRecord* entries = lookups[table - NAME_LOOKUP];
+    const LookupRecord* end = entries + lookupCounts[table - NAME_LOOKUP];
+    uint64_t hash = keyHash(normalized);
+    const LookupRecord* it = std::lower_bound(entries, end, hash,
+                                              [](const LookupRecord& entry, uint64_t value) { return entry.key < value; });
+
+    // Confirm against the stored string in case two keys share a hash
+    for (; it != end && it->key == hash; ++it) {
+        if (!recordInBounds(it->profile)) continue;
+        const ProfileRecord& record = profiles[it->profile];
+        if (lookupKey(table, text(record.*field)) == normalized ||
+            (table == NAME_LOOKUP && lookupKey(table, sourceStem(text(record.sourceFile))) == normalized)) {
+            return ProfileView(this, &record);
+        }
+    }
+    return ProfileView();
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::findByName(const std::string& name) const {
+    return find(NAME_LOOKUP, name, &ProfileRecord::name);
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::findByExecutable(const std::string& executable) const {
+    return find(EXECUTABLE_LOOKUP, executable, &ProfileRecord::executable);
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::findByWindowTitle(const std::string& windowTitle) const {
+    return find(TITLE_LOOKUP, windowTitle, &ProfileRecord::windowTitle);
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::findByExecutableHash(const std::string& hash) const {
+    return find(HASH_LOOKUP, hash, &ProfileRecord::executableHash);
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::findProfile(const std::string& processName) const {
+    ProfileView view = findByExecutable(processName);
+    if (!view.valid()) view = findByName(processName);
+    if (!view.valid()) view = findByWindowTitle(processName);
+    return view;
+}
+
+ProfileDatabase::ProfileView ProfileDatabase::profile(size_t index) const {
+    return recordInBounds(index) ? ProfileView(this, &profiles[index]) : ProfileView();
+}
+
+const char* ProfileDatabase::text(uint32_t offset) const {
+    return offset < stringBytes ? strings + offset : "";
+}
+
+uint64_t ProfileDatabase::keyHash(const std::string& key) {
+    return XxHash64::hash(key.data(), key.size());
+}
+
+std::string ProfileDatabase::lookupKey(Section table, const std::string& text) {
+    return table == TITLE_LOOKUP ? TrigramIndex::normalize(text) : toLower(trim(text));
+}
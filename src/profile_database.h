@@ -0,0 +1,260 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+
+// One parsed profile, owning its data; unlike ProfileView it outlives the database.
+// Used to hand a profile to the detection pipeline (see ProfileWatcher).
+struct ProfileDefinition {
+    struct Address {
+        std::string name;
+        uint64_t address;
+    };
+
+    struct HudRegion {
+        std::string name;
+        float x, y, width, height;      // Fractions of the frame
+    };
+
+    struct Cue {
+        std::string name;
+        uint8_t red, green, blue;
+        float threshold;
+        int durationMs;
+        float x, y, width, height;
+    };
+
+    // Colour HUD text is drawn in, and how far (per channel) a pixel may be from it
+    struct TextColor {
+        uint8_t red, green, blue;
+        int tolerance;
+    };
+
+    std::string name;
+    std::string executable;
+    std::string windowTitle;
+    std::string executableHash;
+    std::string sourceFile;
+    std::vector<Address> addresses;
+    std::vector<HudRegion> hudRegions;
+    std::vector<Cue> cues;
+    std::vector<TextColor> textColors;
+
+    // Screenshot descriptors in VisualDescriptor::serialize layout, for identifying the game from pixels
+    static constexpr size_t VISUAL_DESCRIPTOR_BYTES = 80;
+    using VisualDescriptorBytes = std::array<uint8_t, VISUAL_DESCRIPTOR_BYTES>;
+    std::vector<VisualDescriptorBytes> visualDescriptors;
+};
+
+// Game profiles compiled from the game_profiles/ text files into one versioned
+// binary file that is memory-mapped read-only. Records are fixed-size and refer
+// to a shared string pool by offset, so opening is a map plus a header check and
+// lookups by name, executable, window title or executable hash are a binary
+// search over sorted key hashes with no parsing or copying.
+//
+// Source files keep the existing "Name=0xADDRESS" / "0xADDRESS Name" lines and
+// may add:
+//   # Game: <name>            # Executable: <file.exe>
+//   # Window: <title>         # Hash: <executable xxh64>
+//   @hud <name> <x> <y> <w> <h>                           (fractions of the frame)
+//   @cue <name> <r> <g> <b> <threshold> <ms> <x> <y> <w> <h>
+//   @text <r> <g> <b> [<tolerance>]                         (HUD text colour, repeatable)
+//   @visual <160 hex digits>                               (screenshot descriptor, repeatable)
+class ProfileDatabase {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 3;
+
+    // On-disk records (little-endian, 8-byte aligned sections)
+    struct ProfileRecord {
+        uint32_t name;                  // String pool offsets
+        uint32_t executable;
+        uint32_t windowTitle;
+        uint32_t executableHash;
+        uint32_t sourceFile;
+        uint32_t firstAddress;
+        uint32_t addressCount;
+        uint32_t firstHudRegion;
+        uint32_t hudRegionCount;
+        uint32_t firstCue;
+        uint32_t cueCount;
+        uint32_t firstTextColor;
+        uint32_t textColorCount;
+        uint32_t firstVisual;
+        uint32_t visualCount;
+        uint32_t reserved;
+        uint64_t sourceSize;
+        int64_t sourceModifiedTime;
+    };
+
+    struct AddressRecord {
+        uint64_t address;
+        uint32_t name;
+        uint32_t reserved;
+    };
+
+    struct HudRegionRecord {
+        uint32_t name;
+        float x, y, width, height;
+    };
+
+    struct CueRecord {
+        uint32_t name;
+        uint8_t blue, green, red, reserved;
+        float threshold;
+        int32_t durationMs;
+        float x, y, width, height;
+    };
+
+    struct TextColorRecord {
+        uint8_t blue, green, red, tolerance;
+    };
+
+    struct VisualRecord {
+        uint8_t descriptor[ProfileDefinition::VISUAL_DESCRIPTOR_BYTES];
+    };
+
+    // Zero-copy view of one profile; pointers stay valid until the database is reopened
+    struct ProfileView {
+        const ProfileDatabase* database;
+        const ProfileRecord* record;
+
+        ProfileView() : database(nullptr), record(nullptr) {}
+        ProfileView(const ProfileDatabase* db, const ProfileRecord* r) : database(db), record(r) {}
+
+        bool valid() const { return record != nullptr; }
+        const char* name() const { return database->text(record->name); }
+        const char* executable() const { return database->text(record->executable); }
+        const char* windowTitle() const { return database->text(record->windowTitle); }
+        const char* executableHash() const { return database->text(record->executableHash); }
+        const char* sourceFile() const { return database->text(record->sourceFile); }
+
+        size_t addressCount() const { return record->addressCount; }
+        const AddressRecord& address(size_t i) const { return database->addresses[record->firstAddress + i]; }
+        size_t hudRegionCount() const { return record->hudRegionCount; }
+        const HudRegionRecord& hudRegion(size_t i) const { return database->hudRegions[record->firstHudRegion + i]; }
+        size_t cueCount() const { return record->cueCount; }
+        const CueRecord& cue(size_t i) const { return database->cues[record->firstCue + i]; }
+        size_t textColorCount() const { return record->textColorCount; }
+        const TextColorRecord& textColor(size_t i) const { return database->textColors[record->firstTextColor + i]; }
+        size_t visualCount() const { return record->visualCount; }
+        const VisualRecord& visual(size_t i) const { return database->visuals[record->firstVisual + i]; }
+
+        ProfileDefinition definition() const;
+    };
+
+    struct CompileStats {
+        size_t sourceFiles;
+        size_t parsedFiles;         // Reparsed because new or changed
+        size_t reusedFiles;         // Copied from the previous database unchanged
+
+        CompileStats() : sourceFiles(0), parsedFiles(0), reusedFiles(0) {}
+    };
+
+    ProfileDatabase();
+    ~ProfileDatabase();
+
+    ProfileDatabase(const ProfileDatabase&) = delete;
+    ProfileDatabase& operator=(const ProfileDatabase&) = delete;
+
+    // Maps an existing database; false if missing, truncated or another format version.
+    // Only the header and section bounds are checked here; a record pointing outside its
+    // sections is rejected when looked up
+    bool open(const std::string& databasePath);
+    void close();
+    bool isOpen() const { return mappedFile.isOpen(); }
+
+    // Opens databasePath, recompiling it first if any source file was added, removed or changed.
+    // Once checked, later calls only compare the directory's modification time, so in-place
+    // edits are picked up after markSourcesChanged (e.g. from ProfileWatcher)
+    bool openOrBuild(const std::string& sourceDirectory, const std::string& databasePath);
+    void markSourcesChanged() { sourcesVerified = false; }     // Thread-safe
+
+    // True if the open database does not reflect the current source directory. Lists the
+    // directory; sources that could not be read when compiling count only once readable
+    bool isStale(const std::string& sourceDirectory) const;
+
+    // Compiles sourceDirectory to outputPath; unchanged files are copied from previous when given
+    static bool compile(const std::string& sourceDirectory, const std::string& outputPath,
+                        const ProfileDatabase* previous = nullptr, CompileStats* stats = nullptr);
+
+    // Parses a single source file without touching any database
+    static bool parseProfile(const std::string& sourcePath, ProfileDefinition& profile);
+
+    // Lookups (case-insensitive; titles use TrigramIndex normalisation)
+    ProfileView findByName(const std::string& name) const;
+    ProfileView findByExecutable(const std::string& executable) const;
+    ProfileView findByWindowTitle(const std::string& windowTitle) const;
+    ProfileView findByExecutableHash(const std::string& hash) const;
+
+    // Tries executable, then name, then window title
+    ProfileView findProfile(const std::string& processName) const;
+
+    size_t size() const { return profileCount; }
+    ProfileView profile(size_t index) const;
+    const char* text(uint32_t offset) const;
+
+    const CompileStats& getLastCompileStats() const { return lastCompileStats; }
+
+private:
+    struct LookupRecord {
+        uint64_t key;
+        uint32_t profile;
+        uint32_t reserved;
+    };
+
+    enum Section {
+        PROFILES,
+        ADDRESSES,
+        HUD_REGIONS,
+        CUES,
+        TEXT_COLORS,
+        VISUALS,
+        NAME_LOOKUP,
+        EXECUTABLE_LOOKUP,
+        TITLE_LOOKUP,
+        HASH_LOOKUP,
+        STRINGS,
+        SECTION_COUNT
+    };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t counts[SECTION_COUNT];
+        uint64_t offsets[SECTION_COUNT];
+    };
+
+    MappedFile mappedFile;              // Read-only view of the whole file
+
+    const ProfileRecord* profiles;
+    const AddressRecord* addresses;
+    const HudRegionRecord* hudRegions;
+    const CueRecord* cues;
+    const TextColorRecord* textColors;
+    const VisualRecord* visuals;
+    const LookupRecord* lookups[4];     // Indexed by Section - NAME_LOOKUP
+    size_t lookupCounts[4];
+    const char* strings;
+    size_t profileCount;
+    size_t stringBytes;
+    uint64_t sectionCounts[SECTION_COUNT];
+
+    std::string verifiedDirectory;      // Last directory openOrBuild found the database current for
+    int64_t verifiedDirectoryTime;
+    std::atomic<bool> sourcesVerified;
+
+    CompileStats lastCompileStats;
+
+    ProfileView find(Section table, const std::string& key, uint32_t ProfileRecord::*field) const;
+    bool recordInBounds(size_t index) const;
+    void markVerified(const std::string& sourceDirectory, int64_t directoryTime);
+
+    static uint64_t keyHash(const std::string& key);
+    static std::string lookupKey(Section table, const std::string& text);
+};
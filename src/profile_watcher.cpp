@@ -0,0 +1,256 @@
+#include "profile_watcher.h"
+#include <chrono>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char* const SOURCE_EXTENSION = ".txt";
+constexpr size_t EVENT_BUFFER_SIZE = 16384;
+
+} // namespace
+
+// ProfileWatcher Implementation
+ProfileWatcher::ProfileWatcher()
+    : running(false), nativeWatch(false), changeCount(0), startedSignalled(false) {
+}
+
+ProfileWatcher::~ProfileWatcher() {
+    stop();
+}
+
+bool ProfileWatcher::start(const std::string& watchDirectory, ChangeCallback changeCallback) {
+    if (running || !changeCallback) return false;
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(watchDirectory, error)) return false;
+
+    directory = watchDirectory;
+    callback = std::move(changeCallback);
+    startedPromise = std::promise<void>();
+    startedSignalled = false;
+    std::future<void> started = startedPromise.get_future();
+
+    running = true;
+    watchThread = std::thread(&ProfileWatcher::watchLoop, this);
+
+    // Changes made after start() returns are never missed
+    started.wait();
+    return true;
+}
+
+void ProfileWatcher::stop() {
+    running = false;
+    if (watchThread.joinable()) {
+        watchThread.join();
+    }
+}
+
+void ProfileWatcher::watchLoop() {
+    if (!watchNative() && running) {
+        watchPolling();
+    }
+    markStarted();
+}
+
+void ProfileWatcher::markStarted() {
+    if (!startedSignalled) {
+        startedSignalled = true;
+        startedPromise.set_value();
+    }
+}
+
+void ProfileWatcher::dispatch(std::set<std::string>& pending) {
+    std::vector<std::string> changedFiles(pending.begin(), pending.end());
+    pending.clear();
+    changeCount += changedFiles.size();
+    callback(changedFiles);
+}
+
+bool ProfileWatcher::isProfileSource(const std::string& fileName) {
+    return std::filesystem::path(fileName).extension() == SOURCE_EXTENSION;
+}
+
+std::map<std::string, std::pair<uint64_t, int64_t>> ProfileWatcher::snapshotDirectory() const {
+    std::map<std::string, std::pair<uint64_t, int64_t>> files;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        std::string fileName = it->path().filename().string();
+        if (!it->is_regular_file(error) || !isProfileSource(fileName)) continue;
+
+        uint64_t size = it->file_size(error);
+        if (error) continue;
+        int64_t modifiedTime = static_cast<int64_t>(it->last_write_time(error).time_since_epoch().count());
+        if (error) continue;
+        files[fileName] = std::make_pair(size, modifiedTime);
+    }
+    return files;
+}
+
+void ProfileWatcher::watchPolling() {
+    std::map<std::string, std::pair<uint64_t, int64_t>> previous = snapshotDirectory();
+    markStarted();
+
+    std::set<std::string> pending;
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));
+
+        std::map<std::string, std::pair<uint64_t, int64_t>> current = snapshotDirectory();
+        for (const auto& entry : current) {
+            auto it = previous.find(entry.first);
+            if (it == previous.end() || it->second != entry.second) pending.insert(entry.first);
+        }
+        for (const auto& entry : previous) {
+            if (current.find(entry.first) == current.end()) pending.insert(entry.first);
+        }
+        previous.swap(current);
+
+        if (!pending.empty()) dispatch(pending);
+    }
+}
+
+#ifdef _WIN32
+
+bool ProfileWatcher::watchNative() {
+    HANDLE directoryHandle = CreateFileA(directory.c_str(), FILE_LIST_DIRECTORY,
+                                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                         OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directoryHandle == INVALID_HANDLE_VALUE) return false;
+
+    OVERLAPPED overlapped = {};
+    overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!overlapped.hEvent) {
+        CloseHandle(directoryHandle);
+        return false;
+    }
+
+    alignas(DWORD) char buffer[EVENT_BUFFER_SIZE];
+    const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+    std::set<std::string> pending;
+    bool requestActive = false;
+    bool healthy = true;
+
+    while (running) {
+        // The first request is queued before start() returns
+        if (!requestActive) {
+            ResetEvent(overlapped.hEvent);
+            if (!ReadDirectoryChangesW(directoryHandle, buffer, sizeof(buffer), FALSE, filter,
+                                       nullptr, &overlapped, nullptr)) {
+                healthy = false;
+                break;
+            }
+            requestActive = true;
+            nativeWatch = true;
+            markStarted();
+        }
+
+        DWORD wait = WaitForSingleObject(overlapped.hEvent, pending.empty() ? POLL_INTERVAL_MS : DEBOUNCE_MS);
+        if (wait == WAIT_TIMEOUT) {
+            if (!pending.empty()) dispatch(pending);
+            continue;
+        }
+
+        requestActive = false;
+        DWORD bytes = 0;
+        if (wait != WAIT_OBJECT_0 || !GetOverlappedResult(directoryHandle, &overlapped, &bytes, FALSE)) {
+            healthy = false;
+            break;
+        }
+
+        if (bytes == 0) {
+            // Notification buffer overflowed; report every source
+            for (const auto& entry : snapshotDirectory()) pending.insert(entry.first);
+            continue;
+        }
+
+        for (size_t offset = 0;;) {
+            const FILE_NOTIFY_INFORMATION* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(buffer + offset);
+            int wideLength = static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+            int length = WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, nullptr, 0, nullptr, nullptr);
+            std::string fileName(length, '\0');
+            WideCharToMultiByte(CP_UTF8, 0, info->FileName, wideLength, &fileName[0], length, nullptr, nullptr);
+            if (isProfileSource(fileName)) pending.insert(fileName);
+
+            if (info->NextEntryOffset == 0) break;
+            offset += info->NextEntryOffset;
+        }
+    }
+
+    if (requestActive) {
+        CancelIoEx(directoryHandle, &overlapped);
+        DWORD bytes = 0;
+        GetOverlappedResult(directoryHandle, &overlapped, &bytes, TRUE);
+    }
+    CloseHandle(overlapped.hEvent);
+    CloseHandle(directoryHandle);
+    nativeWatch = false;
+    return healthy;
+}
+
+#elif defined(__linux__)
+
+bool ProfileWatcher::watchNative() {
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) return false;
+
+    const uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    if (inotify_add_watch(inotifyFd, directory.c_str(), mask) < 0) {
+        close(inotifyFd);
+        return false;
+    }
+    nativeWatch = true;
+    markStarted();
+
+    alignas(inotify_event) char buffer[EVENT_BUFFER_SIZE];
+    std::set<std::string> pending;
+    bool healthy = true;
+
+    while (running && healthy) {
+        pollfd descriptor = {inotifyFd, POLLIN, 0};
+        int ready = poll(&descriptor, 1, pending.empty() ? POLL_INTERVAL_MS : DEBOUNCE_MS);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            healthy = false;
+            break;
+        }
+        if (ready == 0) {
+            if (!pending.empty()) dispatch(pending);
+            continue;
+        }
+
+        ssize_t bytes;
+        while ((bytes = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (ssize_t offset = 0; offset < bytes;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                if (event->mask & IN_Q_OVERFLOW) {
+                    for (const auto& entry : snapshotDirectory()) pending.insert(entry.first);
+                } else if (event->mask & IN_IGNORED) {
+                    healthy = false;        // Directory removed or unmounted
+                } else if (event->len > 0 && isProfileSource(event->name)) {
+                    pending.insert(event->name);
+                }
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+    }
+
+    close(inotifyFd);
+    nativeWatch = false;
+    return healthy;
+}
+
+#else
+
+bool ProfileWatcher::watchNative() {
+    return false;
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Watches the game_profiles/ directory and reports which profile sources changed,
+// so edits apply without restarting capture. Uses ReadDirectoryChangesW on Windows
+// and inotify on Linux, falling back to polling file sizes and times elsewhere or
+// if the native watch cannot be set up. The burst of events one save produces is
+// coalesced into a single callback on the watcher thread; keep it short and hand
+// real work to a background task.
+class ProfileWatcher {
+public:
+    using ChangeCallback = std::function<void(const std::vector<std::string>& changedFiles)>;
+
+    static constexpr int POLL_INTERVAL_MS = 250;    // Also bounds how long stop() waits
+    static constexpr int DEBOUNCE_MS = 100;         // Quiet time before a burst is reported
+
+    ProfileWatcher();
+    ~ProfileWatcher();
+
+    ProfileWatcher(const ProfileWatcher&) = delete;
+    ProfileWatcher& operator=(const ProfileWatcher&) = delete;
+
+    // Reports file names (not paths) of added, changed or removed .txt sources
+    bool start(const std::string& directory, ChangeCallback callback);
+    void stop();
+
+    bool isRunning() const { return running.load(); }
+    bool isUsingNativeWatch() const { return nativeWatch.load(); }
+    uint64_t getChangeCount() const { return changeCount.load(); }
+
+private:
+    std::string directory;
+    ChangeCallback callback;
+    std::thread watchThread;
+    std::atomic<bool> running;
+    std::atomic<bool> nativeWatch;
+    std::atomic<uint64_t> changeCount;
+    std::promise<void> startedPromise;      // Set by the watcher thread once changes are observed
+    bool startedSignalled;
+
+    void watchLoop();
+    bool watchNative();         // False if the native watch is unavailable or failed
+    void watchPolling();
+    void markStarted();
+    void dispatch(std::set<std::string>& pending);
+
+    static bool isProfileSource(const std::string& fileName);
+    std::map<std::string, std::pair<uint64_t, int64_t>> snapshotDirectory() const;
+};
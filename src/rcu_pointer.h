@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Read-copy-update holder for configuration that is read on every frame and
+// replaced rarely. A reader pins the current snapshot with one atomic increment
+// and never blocks or allocates; publish() swaps in a new immutable snapshot and
+// frees the old one only after every reader that could still see it has left.
+//
+// Readers register in one of two counters chosen by the epoch parity. A publish
+// swaps the pointer, then twice flips the epoch and waits for the parity it left
+// to drain; new readers always land on the other counter, so a steady stream of
+// them cannot starve the writer.
+template <typename T>
+class RcuPointer {
+private:
+    struct Node {
+        std::unique_ptr<const T> value;
+        uint64_t version;
+    };
+
+public:
+    // Pins one snapshot for the guard's lifetime; keep it to one frame
+    class ReadGuard {
+    public:
+        ReadGuard(ReadGuard&& other) noexcept : readers(other.readers), node(other.node) {
+            other.readers = nullptr;
+        }
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        ~ReadGuard() {
+            if (readers) readers->fetch_sub(1, std::memory_order_release);
+        }
+
+        const T& operator*() const { return *node->value; }
+        const T* operator->() const { return node->value.get(); }
+        const T* get() const { return node->value.get(); }
+        uint64_t version() const { return node->version; }
+
+    private:
+        friend class RcuPointer;
+        ReadGuard(std::atomic<int>* r, const Node* n) : readers(r), node(n) {}
+
+        std::atomic<int>* readers;
+        const Node* node;
+    };
+
+    explicit RcuPointer(std::unique_ptr<T> initial = std::unique_ptr<T>(new T()))
+        : current(new Node{std::move(initial), 1}), epoch(0) {
+        readers[0].store(0);
+        readers[1].store(0);
+    }
+
+    ~RcuPointer() {
+        delete current.load();
+    }
+
+    RcuPointer(const RcuPointer&) = delete;
+    RcuPointer& operator=(const RcuPointer&) = delete;
+
+    ReadGuard read() const {
+        std::atomic<int>* counter = &readers[epoch.load(std::memory_order_seq_cst) & 1];
+        counter->fetch_add(1, std::memory_order_seq_cst);
+        return ReadGuard(counter, current.load(std::memory_order_seq_cst));
+    }
+
+    // Replaces the snapshot and returns its version; blocks only other writers
+    uint64_t publish(std::unique_ptr<T> value) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        return publishLocked(std::move(value));
+    }
+
+    // Copies the current snapshot, applies mutate to the copy and publishes it
+    template <typename Mutate>
+    uint64_t update(Mutate&& mutate) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        std::unique_ptr<T> copy(new T(*current.load(std::memory_order_acquire)->value));
+        mutate(*copy);
+        return publishLocked(std::move(copy));
+    }
+
+    uint64_t version() const {
+        return current.load(std::memory_order_acquire)->version;
+    }
+
+private:
+    std::atomic<const Node*> current;
+    std::atomic<uint32_t> epoch;
+    mutable std::atomic<int> readers[2];
+    std::mutex writerMutex;
+
+    uint64_t publishLocked(std::unique_ptr<T> value) {
+        const Node* previous = current.load(std::memory_order_relaxed);
+        const Node* next = new Node{std::move(value), previous->version + 1};
+        current.store(next, std::memory_order_seq_cst);
+
+        // Any reader still holding previous registered before the store above, on either
+        // counter, so once each counter has been seen at zero previous is unreachable
+        for (int phase = 0; phase < 2; ++phase) {
+            uint32_t oldParity = epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+            while (readers[oldParity].load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        delete previous;
+        return next->version;
+    }
+};
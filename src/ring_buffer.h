@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "span_view.h"
+
+// Fixed-capacity FIFO over one preallocated array.
+// push_back is O(1) and overwrites the oldest element once full, so history
+// stays bounded. Elements are indexed oldest first; segments() exposes the
+// storage as at most two contiguous views for the stats kernels.
+template <typename T>
+class RingBuffer {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : ring(nullptr), index(0) {}
+        const_iterator(const RingBuffer* ring, size_t index) : ring(ring), index(index) {}
+
+        reference operator*() const { return (*ring)[index]; }
+        pointer operator->() const { return &(*ring)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator previous = *this; ++index; return previous; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+
+    private:
+        const RingBuffer* ring;
+        size_t index;
+    };
+
+    explicit RingBuffer(size_t capacity = 0) : storage(capacity), start(0), count(0) {}
+
+    size_t size() const { return count; }
+    size_t capacity() const { return storage.size(); }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == storage.size(); }
+
+    void push_back(const T& value) {
+        if (storage.empty()) return;
+        slotForAppend() = value;
+    }
+
+    void push_back(T&& value) {
+        if (storage.empty()) return;
+        slotForAppend() = std::move(value);
+    }
+
+    void pop_front() {
+        if (count == 0) return;
+        start = wrap(start + 1);
+        --count;
+    }
+
+    void clear() {
+        start = 0;
+        count = 0;
+    }
+
+    // Reallocates, keeping the newest min(size, capacity) elements
+    void setCapacity(size_t newCapacity) {
+        if (newCapacity == storage.size()) return;
+
+        size_t keep = count < newCapacity ? count : newCapacity;
+        std::vector<T> resized(newCapacity);
+        for (size_t i = 0; i < keep; ++i) {
+            resized[i] = std::move((*this)[count - keep + i]);
+        }
+
+        storage.swap(resized);
+        start = 0;
+        count = keep;
+    }
+
+    T& operator[](size_t index) { return storage[wrap(start + index)]; }
+    const T& operator[](size_t index) const { return storage[wrap(start + index)]; }
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[count - 1]; }
+    const T& back() const { return (*this)[count - 1]; }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+
+    SegmentedSpan<T> segments() {
+        size_t firstLength = count < storage.size() - start ? count : storage.size() - start;
+        return SegmentedSpan<T>(SpanView<T>(storage.data() + start, firstLength),
+                                SpanView<T>(storage.data(), count - firstLength));
+    }
+
+    SegmentedSpan<const T> segments() const {
+        size_t firstLength = count < storage.size() - start ? count : storage.size() - start;
+        return SegmentedSpan<const T>(SpanView<const T>(storage.data() + start, firstLength),
+                                      SpanView<const T>(storage.data(), count - firstLength));
+    }
+
+    operator SegmentedSpan<const T>() const { return segments(); }
+
+    std::vector<T> toVector() const {
+        return std::vector<T>(begin(), end());
+    }
+
+private:
+    std::vector<T> storage;
+    size_t start;           // Physical slot of the oldest element
+    size_t count;
+
+    size_t wrap(size_t slot) const { return slot >= storage.size() ? slot - storage.size() : slot; }
+
+    T& slotForAppend() {
+        if (count < storage.size()) {
+            return storage[wrap(start + count++)];
+        }
+        T& oldest = storage[start];
+        start = wrap(start + 1);
+        return oldest;
+    }
+};
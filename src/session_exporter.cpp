@@ -0,0 +1,466 @@
+#include "session_exporter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char BINARY_MAGIC[8] = {'G', 'A', 'S', 'E', 'S', 'S', 'B', '\0'};
+const char COLUMNAR_MAGIC[8] = {'G', 'A', 'S', 'E', 'S', 'S', 'C', '\0'};
+
+enum RecordTag : uint8_t {
+    TAG_STRING = 1,
+    TAG_SAMPLE = 2,
+    TAG_EVENT = 3
+};
+
+template <typename T>
+void put(std::vector<uint8_t>& out, const T& value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(&out[at], &value, sizeof(T));
+}
+
+template <typename T>
+T take(const uint8_t*& in) {
+    T value;
+    std::memcpy(&value, in, sizeof(T));
+    in += sizeof(T);
+    return value;
+}
+
+// Timestamps are stored as zigzag varint deltas, usually one or two bytes
+void putVarint(std::vector<uint8_t>& out, int64_t value) {
+    uint64_t encoded = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    while (encoded >= 0x80) {
+        out.push_back(static_cast<uint8_t>(encoded | 0x80));
+        encoded >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(encoded));
+}
+
+bool takeVarint(const uint8_t*& in, const uint8_t* end, int64_t& value) {
+    uint64_t encoded = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        encoded |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool readExact(FILE* file, void* data, size_t length) {
+    return fread(data, 1, length, file) == length;
+}
+
+bool seekTo(FILE* file, int64_t offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif
+}
+
+// Column chunk: byte length, then payload
+bool readColumn(FILE* file, std::vector<uint8_t>& column) {
+    uint32_t length;
+    if (!readExact(file, &length, sizeof(length))) return false;
+    column.resize(length);
+    return length == 0 || readExact(file, column.data(), length);
+}
+
+} // namespace
+
+// AsyncFileWriter Implementation
+AsyncFileWriter::AsyncFileWriter(TaskExecutor taskExecutor, size_t bufferSize)
+    : executor(std::move(taskExecutor)), file(nullptr), activeBuffer(0), activeSize(0),
+      failed(false), bytesWritten(0), stallCount(0) {
+    buffers[0].resize(std::max<size_t>(bufferSize, 1));
+    buffers[1].resize(std::max<size_t>(bufferSize, 1));
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    close();
+}
+
+bool AsyncFileWriter::open(const std::string& path) {
+    close();
+
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    // Writes are already a buffer at a time
+    setvbuf(file, nullptr, _IONBF, 0);
+    activeBuffer = 0;
+    activeSize = 0;
+    failed = false;
+    bytesWritten = 0;
+    stallCount = 0;
+    return true;
+}
+
+bool AsyncFileWriter::write(const void* data, size_t length) {
+    if (!file) return false;
+
+    const char* bytes = static_cast<const char*>(data);
+    size_t capacity = buffers[activeBuffer].size();
+    bytesWritten += length;
+    while (length > 0) {
+        size_t chunk = std::min(length, capacity - activeSize);
+        std::memcpy(buffers[activeBuffer].data() + activeSize, bytes, chunk);
+        activeSize += chunk;
+        bytes += chunk;
+        length -= chunk;
+        if (activeSize == capacity) flushActive();
+    }
+    return !failed;
+}
+
+bool AsyncFileWriter::close() {
+    if (!file) return false;
+
+    flushActive();
+    waitForFlush();
+    bool written = !failed;
+    written = fclose(file) == 0 && written;
+    file = nullptr;
+    return written;
+}
+
+void AsyncFileWriter::flushActive() {
+    if (activeSize == 0) return;
+
+    // The other buffer must be on disk before it can be refilled
+    waitForFlush();
+
+    FILE* target = file;
+    const char* data = buffers[activeBuffer].data();
+    size_t size = activeSize;
+    std::function<void()> task = [this, target, data, size]() {
+        if (fwrite(data, 1, size, target) != size) failed = true;
+    };
+    pendingFlush = executor ? executor(std::move(task)) : std::async(std::launch::async, std::move(task));
+
+    activeBuffer ^= 1;
+    activeSize = 0;
+}
+
+void AsyncFileWriter::waitForFlush() {
+    if (!pendingFlush.valid()) return;
+    if (pendingFlush.wait_for(std::chrono::seconds(0)) != std::future_status::ready) stallCount++;
+    try {
+        pendingFlush.get();
+    } catch (...) {
+        failed = true;      // Executor could not run the write (e.g. pool shutting down)
+    }
+}
+
+// SessionExporter Implementation
+SessionExporter::SessionExporter(AsyncFileWriter::TaskExecutor executor)
+    : writer(std::move(executor)), format(Format::BINARY), sampleCount(0), eventCount(0) {
+}
+
+SessionExporter::~SessionExporter() {
+    close();
+}
+
+bool SessionExporter::open(const std::string& path, Format outputFormat) {
+    close();
+
+    std::lock_guard<std::mutex> lock(exportMutex);
+    if (!writer.open(path)) return false;
+
+    format = outputFormat;
+    stringIds.clear();
+    strings.clear();
+    rowGroupOffsets.clear();
+    pendingSamples.clear();
+    pendingEvents.clear();
+    sampleCount = 0;
+    eventCount = 0;
+    if (format == Format::COLUMNAR) {
+        pendingSamples.reserve(ROW_GROUP_SIZE);
+    }
+
+    encodeBuffer.clear();
+    const char* magic = format == Format::BINARY ? BINARY_MAGIC : COLUMNAR_MAGIC;
+    encodeBuffer.insert(encodeBuffer.end(), magic, magic + sizeof(BINARY_MAGIC));
+    put(encodeBuffer, FORMAT_VERSION);
+    put(encodeBuffer, uint32_t(0));
+    return writer.write(encodeBuffer.data(), encodeBuffer.size());
+}
+
+bool SessionExporter::isOpen() const {
+    std::lock_guard<std::mutex> lock(exportMutex);
+    return writer.isOpen();
+}
+
+uint32_t SessionExporter::intern(const std::string& text) {
+    auto it = stringIds.find(text);
+    if (it != stringIds.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(strings.size());
+    stringIds.emplace(text, id);
+    strings.push_back(text);
+
+    if (format == Format::BINARY) {
+        encodeBuffer.clear();
+        put(encodeBuffer, uint8_t(TAG_STRING));
+        put(encodeBuffer, id);
+        put(encodeBuffer, static_cast<uint32_t>(text.size()));
+        encodeBuffer.insert(encodeBuffer.end(), text.begin(), text.end());
+        writer.write(encodeBuffer.data(), encodeBuffer.size());
+    }
+    return id;
+}
+
+void SessionExporter::addSample(int64_t timestamp, uint64_t address, const std::string& name, double value) {
+    std::lock_guard<std::mutex> lock(exportMutex);
+    if (!writer.isOpen()) return;
+
+    Sample sample = {timestamp, address, value, intern(name)};
+    sampleCount++;
+
+    if (format == Format::COLUMNAR) {
+        pendingSamples.push_back(sample);
+        if (pendingSamples.size() >= ROW_GROUP_SIZE) writeRowGroup();
+        return;
+    }
+
+    encodeBuffer.clear();
+    put(encodeBuffer, uint8_t(TAG_SAMPLE));
+    put(encodeBuffer, sample.timestamp);
+    put(encodeBuffer, sample.address);
+    put(encodeBuffer, sample.value);
+    put(encodeBuffer, sample.nameId);
+    writer.write(encodeBuffer.data(), encodeBuffer.size());
+}
+
+void SessionExporter::addEvent(int64_t timestamp, int32_t type, float confidence, const std::string& description) {
+    std::lock_guard<std::mutex> lock(exportMutex);
+    if (!writer.isOpen()) return;
+
+    Event event = {timestamp, type, confidence, intern(description)};
+    eventCount++;
+
+    if (format == Format::COLUMNAR) {
+        pendingEvents.push_back(event);
+        if (pendingEvents.size() >= ROW_GROUP_SIZE) writeRowGroup();
+        return;
+    }
+
+    encodeBuffer.clear();
+    put(encodeBuffer, uint8_t(TAG_EVENT));
+    put(encodeBuffer, event.timestamp);
+    put(encodeBuffer, event.type);
+    put(encodeBuffer, event.confidence);
+    put(encodeBuffer, event.descriptionId);
+    writer.write(encodeBuffer.data(), encodeBuffer.size());
+}
+
+void SessionExporter::writeRowGroup() {
+    if (pendingSamples.empty() && pendingEvents.empty()) return;
+
+    rowGroupOffsets.push_back(writer.getBytesWritten());
+    encodeBuffer.clear();
+    put(encodeBuffer, static_cast<uint32_t>(pendingSamples.size()));
+    put(encodeBuffer, static_cast<uint32_t>(pendingEvents.size()));
+
+    // Each column is length-prefixed so a reader can skip the ones it does not need
+    auto writeColumn = [this](auto&& encode) {
+        size_t lengthAt = encodeBuffer.size();
+        put(encodeBuffer, uint32_t(0));
+        encode();
+        uint32_t length = static_cast<uint32_t>(encodeBuffer.size() - lengthAt - sizeof(uint32_t));
+        std::memcpy(&encodeBuffer[lengthAt], &length, sizeof(length));
+    };
+
+    writeColumn([this]() {
+        int64_t previous = 0;
+        for (const auto& sample : pendingSamples) {
+            putVarint(encodeBuffer, sample.timestamp - previous);
+            previous = sample.timestamp;
+        }
+    });
+    writeColumn([this]() { for (const auto& sample : pendingSamples) put(encodeBuffer, sample.nameId); });
+    writeColumn([this]() { for (const auto& sample : pendingSamples) put(encodeBuffer, sample.address); });
+    writeColumn([this]() { for (const auto& sample : pendingSamples) put(encodeBuffer, sample.value); });
+
+    writeColumn([this]() {
+        int64_t previous = 0;
+        for (const auto& event : pendingEvents) {
+            putVarint(encodeBuffer, event.timestamp - previous);
+            previous = event.timestamp;
+        }
+    });
+    writeColumn([this]() { for (const auto& event : pendingEvents) put(encodeBuffer, event.type); });
+    writeColumn([this]() { for (const auto& event : pendingEvents) put(encodeBuffer, event.confidence); });
+    writeColumn([this]() { for (const auto& event : pendingEvents) put(encodeBuffer, event.descriptionId); });
+
+    writer.write(encodeBuffer.data(), encodeBuffer.size());
+    pendingSamples.clear();
+    pendingEvents.clear();
+}
+
+bool SessionExporter::close() {
+    std::lock_guard<std::mutex> lock(exportMutex);
+    if (!writer.isOpen()) return false;
+
+    if (format == Format::COLUMNAR) {
+        writeRowGroup();
+
+        // Footer: string table, row group offsets, then its own offset and the magic
+        uint64_t footerOffset = writer.getBytesWritten();
+        encodeBuffer.clear();
+        put(encodeBuffer, static_cast<uint32_t>(strings.size()));
+        for (const auto& text : strings) {
+            put(encodeBuffer, static_cast<uint32_t>(text.size()));
+            encodeBuffer.insert(encodeBuffer.end(), text.begin(), text.end());
+        }
+        put(encodeBuffer, static_cast<uint32_t>(rowGroupOffsets.size()));
+        for (uint64_t offset : rowGroupOffsets) put(encodeBuffer, offset);
+        put(encodeBuffer, footerOffset);
+        encodeBuffer.insert(encodeBuffer.end(), COLUMNAR_MAGIC, COLUMNAR_MAGIC + sizeof(COLUMNAR_MAGIC));
+        writer.write(encodeBuffer.data(), encodeBuffer.size());
+    }
+
+    return writer.close();
+}
+
+bool SessionExporter::read(const std::string& path, const SampleCallback& onSample, const EventCallback& onEvent) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char magic[8];
+    uint32_t version, reserved;
+    bool valid = readExact(file, magic, sizeof(magic)) && readExact(file, &version, sizeof(version)) &&
+                 readExact(file, &reserved, sizeof(reserved)) && version == FORMAT_VERSION;
+    if (valid && std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0) {
+        valid = readBinary(file, onSample, onEvent);
+    } else if (valid && std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) == 0) {
+        valid = readColumnar(file, onSample, onEvent);
+    } else {
+        valid = false;
+    }
+
+    fclose(file);
+    return valid;
+}
+
+bool SessionExporter::readBinary(FILE* file, const SampleCallback& onSample, const EventCallback& onEvent) {
+    static const std::string empty;
+    std::vector<std::string> strings;
+    uint8_t record[32];
+
+    int tag;
+    while ((tag = fgetc(file)) != EOF) {
+        if (tag == TAG_STRING) {
+            uint32_t id, length;
+            if (!readExact(file, &id, sizeof(id)) || !readExact(file, &length, sizeof(length))) return false;
+            std::string text(length, '\0');
+            if (length > 0 && !readExact(file, &text[0], length)) return false;
+            if (id >= strings.size()) strings.resize(id + 1);
+            strings[id] = std::move(text);
+        } else if (tag == TAG_SAMPLE) {
+            if (!readExact(file, record, 28)) return false;
+            const uint8_t* in = record;
+            Sample sample;
+            sample.timestamp = take<int64_t>(in);
+            sample.address = take<uint64_t>(in);
+            sample.value = take<double>(in);
+            sample.nameId = take<uint32_t>(in);
+            if (onSample) onSample(sample, sample.nameId < strings.size() ? strings[sample.nameId] : empty);
+        } else if (tag == TAG_EVENT) {
+            if (!readExact(file, record, 20)) return false;
+            const uint8_t* in = record;
+            Event event;
+            event.timestamp = take<int64_t>(in);
+            event.type = take<int32_t>(in);
+            event.confidence = take<float>(in);
+            event.descriptionId = take<uint32_t>(in);
+            if (onEvent) onEvent(event, event.descriptionId < strings.size() ? strings[event.descriptionId] : empty);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SessionExporter::readColumnar(FILE* file, const SampleCallback& onSample, const EventCallback& onEvent) {
+    static const std::string empty;
+
+    uint64_t footerOffset;
+    char magic[8];
+    if (!seekTo(file, -16, SEEK_END) || !readExact(file, &footerOffset, sizeof(footerOffset)) ||
+        !readExact(file, magic, sizeof(magic)) || std::memcmp(magic, COLUMNAR_MAGIC, sizeof(magic)) != 0 ||
+        !seekTo(file, static_cast<int64_t>(footerOffset), SEEK_SET)) {
+        return false;
+    }
+
+    uint32_t stringCount, groupCount;
+    if (!readExact(file, &stringCount, sizeof(stringCount))) return false;
+    std::vector<std::string> strings(stringCount);
+    for (auto& text : strings) {
+        uint32_t length;
+        if (!readExact(file, &length, sizeof(length))) return false;
+        text.resize(length);
+        if (length > 0 && !readExact(file, &text[0], length)) return false;
+    }
+    if (!readExact(file, &groupCount, sizeof(groupCount))) return false;
+    std::vector<uint64_t> offsets(groupCount);
+    if (groupCount > 0 && !readExact(file, offsets.data(), groupCount * sizeof(uint64_t))) return false;
+
+    std::vector<uint8_t> columns[8];
+    for (uint64_t offset : offsets) {
+        uint32_t samples, events;
+        if (!seekTo(file, static_cast<int64_t>(offset), SEEK_SET) || !readExact(file, &samples, sizeof(samples)) ||
+            !readExact(file, &events, sizeof(events))) {
+            return false;
+        }
+        for (auto& column : columns) {
+            if (!readColumn(file, column)) return false;
+        }
+        if (columns[1].size() != samples * sizeof(uint32_t) || columns[2].size() != samples * sizeof(uint64_t) ||
+            columns[3].size() != samples * sizeof(double) || columns[5].size() != events * sizeof(int32_t) ||
+            columns[6].size() != events * sizeof(float) || columns[7].size() != events * sizeof(uint32_t)) {
+            return false;
+        }
+
+        const uint8_t* times = columns[0].data();
+        const uint8_t* timesEnd = times + columns[0].size();
+        const uint8_t* ids = columns[1].data();
+        const uint8_t* addresses = columns[2].data();
+        const uint8_t* values = columns[3].data();
+        int64_t timestamp = 0;
+        for (uint32_t row = 0; row < samples; ++row) {
+            int64_t delta;
+            if (!takeVarint(times, timesEnd, delta)) return false;
+            Sample sample;
+            sample.timestamp = timestamp += delta;
+            sample.nameId = take<uint32_t>(ids);
+            sample.address = take<uint64_t>(addresses);
+            sample.value = take<double>(values);
+            if (onSample) onSample(sample, sample.nameId < strings.size() ? strings[sample.nameId] : empty);
+        }
+
+        times = columns[4].data();
+        timesEnd = times + columns[4].size();
+        const uint8_t* types = columns[5].data();
+        const uint8_t* confidences = columns[6].data();
+        const uint8_t* descriptions = columns[7].data();
+        timestamp = 0;
+        for (uint32_t row = 0; row < events; ++row) {
+            int64_t delta;
+            if (!takeVarint(times, timesEnd, delta)) return false;
+            Event event;
+            event.timestamp = timestamp += delta;
+            event.type = take<int32_t>(types);
+            event.confidence = take<float>(confidences);
+            event.descriptionId = take<uint32_t>(descriptions);
+            if (onEvent) onEvent(event, event.descriptionId < strings.size() ? strings[event.descriptionId] : empty);
+        }
+    }
+    return true;
+}
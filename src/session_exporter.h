@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Sequential file writer with two fixed buffers: the producer fills one while the
+// other is written on a background task, so callers only ever memcpy. The
+// producer waits only if the disk falls a whole buffer behind. Single producer;
+// callers that share a writer serialise themselves (SessionExporter does).
+class AsyncFileWriter {
+public:
+    // Runs a task in the background, e.g. ThreadManager::submitIOTask; std::async if empty
+    using TaskExecutor = std::function<std::future<void>(std::function<void()>)>;
+
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit AsyncFileWriter(TaskExecutor executor = TaskExecutor(), size_t bufferSize = DEFAULT_BUFFER_SIZE);
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    bool open(const std::string& path);
+    bool write(const void* data, size_t length);
+    bool close();               // Flushes and waits; false if any write failed
+
+    bool isOpen() const { return file != nullptr; }
+    uint64_t getBytesWritten() const { return bytesWritten; }
+    uint64_t getStallCount() const { return stallCount; }     // Writes that waited on the disk
+
+private:
+    TaskExecutor executor;
+    FILE* file;
+    std::vector<char> buffers[2];
+    int activeBuffer;
+    size_t activeSize;
+    std::future<void> pendingFlush;
+    std::atomic<bool> failed;
+    uint64_t bytesWritten;
+    uint64_t stallCount;
+
+    void flushActive();
+    void waitForFlush();
+};
+
+// Streams memory samples and game events to disk for sessions of any length.
+//
+// BINARY is a row stream: an 8-byte magic and version, then tagged records
+// (string definition, sample, event). Names and descriptions are interned once
+// and referenced by id, so a sample is 29 bytes on disk.
+//
+// COLUMNAR is a Parquet-like layout for analysis: rows are buffered into row
+// groups and written column by column (delta-varint timestamps, then ids,
+// addresses and values), with a footer holding the string table and row group
+// offsets. It compresses well and loads one column without touching the rest.
+//
+// Both are little-endian and written through AsyncFileWriter. Thread-safe.
+class SessionExporter {
+public:
+    enum class Format {
+        BINARY,
+        COLUMNAR
+    };
+
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr size_t ROW_GROUP_SIZE = 65536;
+
+    struct Sample {
+        int64_t timestamp;
+        uint64_t address;
+        double value;
+        uint32_t nameId;
+    };
+
+    struct Event {
+        int64_t timestamp;
+        int32_t type;
+        float confidence;
+        uint32_t descriptionId;
+    };
+
+    explicit SessionExporter(AsyncFileWriter::TaskExecutor executor = AsyncFileWriter::TaskExecutor());
+    ~SessionExporter();
+
+    bool open(const std::string& path, Format format = Format::BINARY);
+    void addSample(int64_t timestamp, uint64_t address, const std::string& name, double value);
+    void addEvent(int64_t timestamp, int32_t type, float confidence, const std::string& description);
+    bool close();
+
+    bool isOpen() const;
+    uint64_t getSampleCount() const { return sampleCount; }
+    uint64_t getEventCount() const { return eventCount; }
+    uint64_t getBytesWritten() const { return writer.getBytesWritten(); }
+
+    // Streams a session back in file order, whichever format it was written in
+    using SampleCallback = std::function<void(const Sample&, const std::string& name)>;
+    using EventCallback = std::function<void(const Event&, const std::string& description)>;
+    static bool read(const std::string& path, const SampleCallback& onSample, const EventCallback& onEvent);
+
+private:
+    mutable std::mutex exportMutex;
+    AsyncFileWriter writer;
+    Format format;
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<std::string> strings;       // Columnar footer; binary writes them inline
+    std::vector<uint64_t> rowGroupOffsets;
+    std::vector<Sample> pendingSamples;     // Current columnar row group
+    std::vector<Event> pendingEvents;
+    std::vector<uint8_t> encodeBuffer;      // Reused for every record and column
+    uint64_t sampleCount;
+    uint64_t eventCount;
+
+    uint32_t intern(const std::string& text);
+    void writeRowGroup();
+
+    static bool readBinary(FILE* file, const SampleCallback& onSample, const EventCallback& onEvent);
+    static bool readColumnar(FILE* file, const SampleCallback& onSample, const EventCallback& onEvent);
+};
@@ -0,0 +1,168 @@
+#include "signal_rules.h"
+#include "stats_kernels.h"
+#include <algorithm>
+
+// StreamingIndicators Implementation
+StreamingIndicators::SeededEma::SeededEma(int period, double smoothing)
+    : period(std::max(1, period)),
+      multiplier(smoothing > 0 ? smoothing : 2.0 / (std::max(1, period) + 1.0)),
+      ema(0.0), seedSum(0.0), seedCount(0) {
+}
+
+void StreamingIndicators::SeededEma::update(double value) {
+    if (seedCount < period) {
+        seedSum += value;
+        seedCount++;
+        if (seedCount == period) {
+            ema = seedSum / period;
+        }
+        return;
+    }
+    ema = (value - ema) * multiplier + ema;
+}
+
+StreamingIndicators::StreamingIndicators(int rsiPeriod, int fastPeriod, int slowPeriod,
+                                         double smoothing, size_t trendWindow)
+    : rsiPeriod(std::max(1, rsiPeriod)), slowPeriod(std::max(1, slowPeriod)),
+      gainAverage(rsiPeriod, smoothing), lossAverage(rsiPeriod, smoothing),
+      fastAverage(fastPeriod, smoothing), slowAverage(slowPeriod, smoothing),
+      window(std::max<size_t>(2, trendWindow)) {
+    reset();
+}
+
+void StreamingIndicators::reset() {
+    gainAverage.reset();
+    lossAverage.reset();
+    fastAverage.reset();
+    slowAverage.reset();
+
+    window.clear();
+    windowSum = 0.0;
+    windowIndexSum = 0.0;
+    updatesSinceResync = 0;
+
+    previous = 0.0;
+    samples = 0;
+    current = SignalFeatures();
+}
+
+void StreamingIndicators::update(double value) {
+    if (samples > 0) {
+        double change = value - previous;
+        gainAverage.update(change > 0 ? change : 0.0);
+        lossAverage.update(change > 0 ? 0.0 : -change);
+    }
+    fastAverage.update(value);
+    slowAverage.update(value);
+    updateTrend(value);
+
+    previous = value;
+    samples++;
+
+    // Same warm-up rules as calculateRSI/calculateMACD
+    size_t changes = samples - 1;
+    if (changes < static_cast<size_t>(rsiPeriod)) {
+        current[SignalFeatures::RSI] = 50.0;
+    } else {
+        double averageLoss = lossAverage.value();
+        current[SignalFeatures::RSI] = averageLoss == 0 ? 100.0
+            : 100.0 - 100.0 / (1.0 + gainAverage.value() / averageLoss);
+    }
+
+    current[SignalFeatures::MACD] = samples < static_cast<size_t>(slowPeriod) ? 0.0
+        : fastAverage.value() - slowAverage.value();
+}
+
+void StreamingIndicators::updateTrend(double value) {
+    if (window.full()) {
+        // Drop index 0 and shift every remaining index down by one
+        windowSum -= window.front();
+        windowIndexSum -= windowSum;
+    }
+    windowIndexSum += static_cast<double>(std::min(window.size(), window.capacity() - 1)) * value;
+    windowSum += value;
+    window.push_back(value);
+
+    // Add/subtract updates drift slowly; rebuild the sums once per window
+    if (++updatesSinceResync >= window.capacity()) {
+        resyncTrend();
+    }
+
+    size_t n = window.size();
+    if (n < 2) {
+        current[SignalFeatures::TREND] = 0.0;
+        return;
+    }
+
+    double dn = static_cast<double>(n);
+    double indexTotal = dn * (dn - 1.0) / 2.0;
+    double denominator = dn * dn * (dn * dn - 1.0) / 12.0;
+    current[SignalFeatures::TREND] = (dn * windowIndexSum - indexTotal * windowSum) / denominator;
+}
+
+void StreamingIndicators::resyncTrend() {
+    windowSum = StatsKernels::sum(window);
+    windowIndexSum = StatsKernels::indexWeightedSum(window, 0.0);
+    updatesSinceResync = 0;
+}
+
+// SignalDecisionTable Implementation
+bool SignalDecisionTable::compile(const std::vector<std::vector<Condition>>& rules) {
+    conditions.clear();
+    table.clear();
+    ruleCount = 0;
+
+    if (rules.size() >= 255) return false;
+
+    std::vector<uint32_t> ruleMasks;
+    ruleMasks.reserve(rules.size());
+
+    for (const auto& rule : rules) {
+        uint32_t mask = 0;
+        for (const auto& condition : rule) {
+            auto it = std::find_if(conditions.begin(), conditions.end(), [&](const Condition& existing) {
+                return existing.feature == condition.feature && existing.greaterThan == condition.greaterThan &&
+                       existing.threshold == condition.threshold;
+            });
+
+            size_t bit = it - conditions.begin();
+            if (it == conditions.end()) {
+                if (conditions.size() >= MAX_CONDITIONS) {
+                    conditions.clear();
+                    return false;
+                }
+                conditions.push_back(condition);
+            }
+            mask |= 1u << bit;
+        }
+        ruleMasks.push_back(mask);
+    }
+
+    // First rule whose conditions are all set in the mask wins
+    ruleCount = rules.size();
+    table.assign(size_t(1) << conditions.size(), static_cast<uint8_t>(ruleCount));
+    for (uint32_t mask = 0; mask < table.size(); ++mask) {
+        for (size_t rule = 0; rule < ruleMasks.size(); ++rule) {
+            if ((ruleMasks[rule] & mask) == ruleMasks[rule]) {
+                table[mask] = static_cast<uint8_t>(rule);
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t SignalDecisionTable::evaluate(const SignalFeatures& features) const {
+    if (table.empty()) return ruleCount;
+
+    uint32_t mask = 0;
+    for (size_t i = 0; i < conditions.size(); ++i) {
+        const Condition& condition = conditions[i];
+        double value = features[condition.feature];
+        bool hit = condition.greaterThan ? value > condition.threshold : value < condition.threshold;
+        mask |= static_cast<uint32_t>(hit) << i;
+    }
+
+    return table[mask];
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ring_buffer.h"
+
+// Indicator values the trading-signal rules are evaluated against
+struct SignalFeatures {
+    enum Feature {
+        RSI,
+        MACD,
+        TREND,              // Least-squares slope over the history window
+        FEATURE_COUNT
+    };
+
+    double values[FEATURE_COUNT];
+
+    SignalFeatures() : values{50.0, 0.0, 0.0} {}
+
+    double& operator[](Feature feature) { return values[feature]; }
+    double operator[](Feature feature) const { return values[feature]; }
+};
+
+// RSI/MACD/trend maintained incrementally, O(1) per sample.
+// Uses the same definitions as BloombergAnalyticsEngine's batch calculators:
+// EMAs are seeded with the SMA of their first period, then smoothed.
+class StreamingIndicators {
+public:
+    StreamingIndicators(int rsiPeriod = 14, int fastPeriod = 12, int slowPeriod = 26,
+                        double smoothing = 0.1, size_t trendWindow = 40);
+
+    void update(double value);
+    void reset();
+
+    const SignalFeatures& features() const { return current; }
+    size_t getSampleCount() const { return samples; }
+
+private:
+    // EMA seeded by the SMA of its first period samples (mean of what it has seen until then)
+    struct SeededEma {
+        int period;
+        double multiplier;
+        double ema;
+        double seedSum;
+        int seedCount;
+
+        SeededEma(int period = 1, double smoothing = 0.0);
+        void update(double value);
+        void reset() { ema = 0.0; seedSum = 0.0; seedCount = 0; }
+        double value() const { return seedCount < period ? (seedCount > 0 ? seedSum / seedCount : 0.0) : ema; }
+    };
+
+    int rsiPeriod;
+    int slowPeriod;
+
+    SeededEma gainAverage;
+    SeededEma lossAverage;
+    SeededEma fastAverage;
+    SeededEma slowAverage;
+
+    // Sliding least-squares sums over the trend window (index 0 = oldest)
+    RingBuffer<double> window;
+    double windowSum;
+    double windowIndexSum;
+    size_t updatesSinceResync;
+
+    double previous;
+    size_t samples;
+    SignalFeatures current;
+
+    void updateTrend(double value);
+    void resyncTrend();
+};
+
+// Threshold rules compiled once into a flat lookup table.
+// Every distinct (feature, comparison, threshold) becomes one bit of a mask;
+// the table maps each mask to the first rule whose conditions it satisfies,
+// so evaluation is one comparison per condition plus a single load.
+class SignalDecisionTable {
+public:
+    struct Condition {
+        SignalFeatures::Feature feature;
+        bool greaterThan;           // feature > threshold, otherwise feature < threshold
+        double threshold;
+    };
+
+    static constexpr size_t MAX_CONDITIONS = 12;
+
+    // Rules are matched in order; returns false if they need too many distinct conditions
+    bool compile(const std::vector<std::vector<Condition>>& rules);
+
+    // Index of the first matching rule, or getRuleCount() when none match
+    size_t evaluate(const SignalFeatures& features) const;
+
+    size_t getRuleCount() const { return ruleCount; }
+    size_t getConditionCount() const { return conditions.size(); }
+
+private:
+    std::vector<Condition> conditions;
+    std::vector<uint8_t> table;
+    size_t ruleCount = 0;
+};
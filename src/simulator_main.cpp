@@ -0,0 +1,154 @@
+#include "game_simulator.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// Synthetic game process: holds its values in memory for the analyzer to find and
+// read, and can write HUD frames, a matching profile and a ground-truth log, e.g.
+//   game_simulator --profile game_profiles/Synthetic.txt --frames-dir frames --truth truth.csv
+// then point game_analyzer_headless at process_id=<printed pid>, profile=Synthetic Game,
+// frames=images:frames and compare its session with truth.csv.
+
+namespace {
+
+std::atomic<bool> stopSignalled(false);
+
+void handleStopSignal(int) {
+    stopSignalled = true;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]" << std::endl
+              << "  --seed N             Random seed (default 1)" << std::endl
+              << "  --fps N              Steps per second of real time; 0 = as fast as possible (default 30)" << std::endl
+              << "  --frames N           Stop after N steps; 0 = until interrupted (default 0)" << std::endl
+              << "  --size WxH           Frame size (default 640x360)" << std::endl
+              << "  --font N             cv::HersheyFonts face (default 0)" << std::endl
+              << "  --font-scale X       HUD text scale (default 1.0)" << std::endl
+              << "  --randomize-layout   Shuffle and pad the fields in memory" << std::endl
+              << "  --no-flashes         No red/gold screen flashes" << std::endl
+              << "  --no-shake           No screen shake on damage" << std::endl
+              << "  --static-background  No camera pan" << std::endl
+              << "  --profile FILE       Write a game profile with this run's addresses and HUD regions" << std::endl
+              << "  --frames-dir DIR     Write every frame as DIR/frame_<n>.png" << std::endl
+              << "  --truth FILE         Write the ground-truth CSV" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimulatorConfig config;
+    int fps = 30;
+    int64_t maxFrames = 0;
+    std::string profilePath, framesDirectory, truthPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (argument == "--help" || argument == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argument == "--seed" && hasValue) {
+            config.seed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (argument == "--fps" && hasValue) {
+            fps = std::max(0, std::atoi(argv[++i]));
+        } else if (argument == "--frames" && hasValue) {
+            maxFrames = std::max(0LL, std::atoll(argv[++i]));
+        } else if (argument == "--size" && hasValue) {
+            int width = 0, height = 0;
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2 || width < 64 || height < 64) {
+                std::cerr << "--size expects WxH, at least 64x64" << std::endl;
+                return 2;
+            }
+            config.width = width;
+            config.height = height;
+        } else if (argument == "--font" && hasValue) {
+            config.fontFace = std::atoi(argv[++i]);
+        } else if (argument == "--font-scale" && hasValue) {
+            config.fontScale = std::atof(argv[++i]);
+        } else if (argument == "--randomize-layout") {
+            config.randomizeLayout = true;
+        } else if (argument == "--no-flashes") {
+            config.colorFlashes = false;
+        } else if (argument == "--no-shake") {
+            config.screenShake = false;
+        } else if (argument == "--static-background") {
+            config.movingBackground = false;
+        } else if (argument == "--profile" && hasValue) {
+            profilePath = argv[++i];
+        } else if (argument == "--frames-dir" && hasValue) {
+            framesDirectory = argv[++i];
+        } else if (argument == "--truth" && hasValue) {
+            truthPath = argv[++i];
+        } else {
+            std::cerr << "Unknown or incomplete option: " << argument << std::endl;
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    GameSimulator simulator(config);
+
+    std::cout << "Synthetic game running, pid " << getpid() << std::endl;
+    for (int field = 0; field < GameSimulator::FIELD_COUNT; ++field) {
+        auto id = static_cast<GameSimulator::Field>(field);
+        std::cout << "  0x" << std::hex << simulator.getFieldAddress(id) << std::dec << " "
+                  << GameSimulator::fieldName(id) << std::endl;
+    }
+
+    if (!profilePath.empty() && !simulator.writeProfile(profilePath)) {
+        std::cerr << "Cannot write profile " << profilePath << std::endl;
+        return 1;
+    }
+    if (!truthPath.empty() && !simulator.openGroundTruthLog(truthPath)) {
+        std::cerr << "Cannot write ground truth " << truthPath << std::endl;
+        return 1;
+    }
+    if (!framesDirectory.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(framesDirectory, error);
+    }
+
+    auto interval = fps > 0 ? std::chrono::microseconds(1000000 / fps) : std::chrono::microseconds(0);
+    auto nextStep = std::chrono::steady_clock::now();
+    bool renderFrames = !framesDirectory.empty();
+    cv::Mat frame;
+    char fileName[64];
+
+    while (!stopSignalled && (maxFrames == 0 || simulator.getFrameIndex() < maxFrames)) {
+        simulator.step(renderFrames ? &frame : nullptr);
+
+        if (renderFrames) {
+            // Zero-padded so the images: frame source reads them in order
+            snprintf(fileName, sizeof(fileName), "/frame_%08lld.png", static_cast<long long>(simulator.getFrameIndex()));
+            cv::imwrite(framesDirectory + fileName, frame);
+        }
+
+        if (interval.count() > 0) {
+            nextStep += interval;
+            std::this_thread::sleep_until(nextStep);
+        }
+    }
+
+    simulator.closeGroundTruthLog();
+    std::cout << "Stopped after " << simulator.getFrameIndex() << " steps" << std::endl;
+    return 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Non-owning view over contiguous elements (C++17 stand-in for std::span)
+template <typename T>
+class SpanView {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+    using iterator = T*;
+
+    constexpr SpanView() noexcept : ptr(nullptr), count(0) {}
+    constexpr SpanView(T* data, size_t size) noexcept : ptr(data), count(size) {}
+
+    // Any contiguous container exposing data()/size() (std::vector, std::array, ...)
+    template <typename Container,
+              typename = typename std::enable_if<
+                  std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>::type>
+    SpanView(Container& container) noexcept : ptr(container.data()), count(container.size()) {}
+
+    // SpanView<double> -> SpanView<const double>
+    template <typename U,
+              typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    constexpr SpanView(const SpanView<U>& other) noexcept : ptr(other.data()), count(other.size()) {}
+
+    constexpr T* data() const noexcept { return ptr; }
+    constexpr size_t size() const noexcept { return count; }
+    constexpr bool empty() const noexcept { return count == 0; }
+
+    constexpr T& operator[](size_t index) const { return ptr[index]; }
+    constexpr T& front() const { return ptr[0]; }
+    constexpr T& back() const { return ptr[count - 1]; }
+
+    constexpr iterator begin() const noexcept { return ptr; }
+    constexpr iterator end() const noexcept { return ptr + count; }
+
+    // Sub-views clamp to the available range instead of asserting
+    constexpr SpanView first(size_t n) const noexcept { return SpanView(ptr, n < count ? n : count); }
+    constexpr SpanView last(size_t n) const noexcept {
+        return n < count ? SpanView(ptr + (count - n), n) : *this;
+    }
+    constexpr SpanView subspan(size_t offset, size_t n = static_cast<size_t>(-1)) const noexcept {
+        return offset >= count ? SpanView(ptr + count, 0)
+                               : SpanView(ptr + offset, n < count - offset ? n : count - offset);
+    }
+
+private:
+    T* ptr;
+    size_t count;
+};
+
+// Up to two contiguous views read as one sequence (e.g. the halves of a wrapped ring buffer)
+template <typename T>
+class SegmentedSpan {
+public:
+    using element_type = T;
+    using value_type = typename std::remove_cv<T>::type;
+
+    constexpr SegmentedSpan() noexcept {}
+    constexpr SegmentedSpan(SpanView<T> head, SpanView<T> tail = SpanView<T>()) noexcept
+        : head(head), tail(tail) {}
+
+    template <typename U,
+              typename = typename std::enable_if<std::is_convertible<U (*)[], T (*)[]>::value>::type>
+    constexpr SegmentedSpan(const SegmentedSpan<U>& other) noexcept
+        : head(other.firstSegment()), tail(other.secondSegment()) {}
+
+    constexpr SpanView<T> firstSegment() const noexcept { return head; }
+    constexpr SpanView<T> secondSegment() const noexcept { return tail; }
+
+    constexpr size_t size() const noexcept { return head.size() + tail.size(); }
+    constexpr bool empty() const noexcept { return size() == 0; }
+
+    constexpr T& operator[](size_t index) const {
+        return index < head.size() ? head[index] : tail[index - head.size()];
+    }
+    constexpr T& front() const { return (*this)[0]; }
+    constexpr T& back() const { return (*this)[size() - 1]; }
+
+    // Sub-ranges clamp like SpanView and may span the segment boundary
+    constexpr SegmentedSpan subspan(size_t offset, size_t n = static_cast<size_t>(-1)) const noexcept {
+        size_t total = size();
+        if (offset >= total) return SegmentedSpan();
+        if (n > total - offset) n = total - offset;
+        if (offset >= head.size()) return SegmentedSpan(tail.subspan(offset - head.size(), n));
+
+        SpanView<T> leading = head.subspan(offset, n);
+        return SegmentedSpan(leading, tail.first(n - leading.size()));
+    }
+    constexpr SegmentedSpan first(size_t n) const noexcept { return subspan(0, n); }
+    constexpr SegmentedSpan last(size_t n) const noexcept {
+        return n < size() ? subspan(size() - n, n) : *this;
+    }
+
+private:
+    SpanView<T> head;
+    SpanView<T> tail;
+};
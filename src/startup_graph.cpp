@@ -0,0 +1,238 @@
+#include "startup_graph.h"
+#include "text_serializer.h"
+#include <algorithm>
+
+namespace {
+
+const char* stateName(StartupGraph::State state) {
+    switch (state) {
+        case StartupGraph::State::PENDING: return "pending";
+        case StartupGraph::State::RUNNING: return "running";
+        case StartupGraph::State::SUCCEEDED: return "ok";
+        case StartupGraph::State::FAILED: return "FAILED";
+        case StartupGraph::State::SKIPPED: return "skipped";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+// StartupGraph Implementation
+StartupGraph::StartupGraph()
+    : unfinishedForeground(0), unfinished(0), started(false) {
+}
+
+StartupGraph::~StartupGraph() {
+    wait();
+}
+
+bool StartupGraph::addComponent(const std::string& name, const std::vector<std::string>& dependencies,
+                                InitFunction init, Mode mode) {
+    std::lock_guard<std::mutex> lock(graphMutex);
+    if (started || !init || nodeIndex.count(name)) return false;
+
+    std::vector<size_t> dependencyIndices;
+    for (const auto& dependency : dependencies) {
+        auto it = nodeIndex.find(dependency);
+        if (it == nodeIndex.end()) return false;
+        dependencyIndices.push_back(it->second);
+    }
+
+    size_t index = nodes.size();
+    nodes.push_back(Node{name, {}, std::move(init), mode, State::PENDING, dependencyIndices.size(), 0.0, 0.0});
+    nodeIndex[name] = index;
+    for (size_t dependency : dependencyIndices) {
+        nodes[dependency].dependents.push_back(index);
+    }
+
+    ++unfinished;
+    if (mode != Mode::BACKGROUND) ++unfinishedForeground;
+    return true;
+}
+
+void StartupGraph::setCompletionCallback(std::function<void()> callback) {
+    std::lock_guard<std::mutex> lock(graphMutex);
+    completionCallback = std::move(callback);
+}
+
+bool StartupGraph::run() {
+    std::unique_lock<std::mutex> lock(graphMutex);
+    if (started) return false;
+    started = true;
+    origin = std::chrono::steady_clock::now();
+
+    if (unfinished == 0) {
+        auto callback = completionCallback;
+        lock.unlock();
+        if (callback) callback();
+        return true;
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].remainingDependencies == 0) launch(i);
+    }
+
+    // CALLER components run here as they become ready; the rest run on their own threads
+    while (unfinishedForeground > 0) {
+        if (callerQueue.empty()) {
+            graphCondition.wait(lock);
+            continue;
+        }
+
+        size_t index = callerQueue.front();
+        callerQueue.pop_front();
+        lock.unlock();
+        execute(index);
+        lock.lock();
+    }
+
+    return std::none_of(nodes.begin(), nodes.end(), [](const Node& node) {
+        return node.mode != Mode::BACKGROUND && node.state != State::SUCCEEDED;
+    });
+}
+
+bool StartupGraph::wait() {
+    std::vector<std::future<void>> pending;
+    {
+        std::unique_lock<std::mutex> lock(graphMutex);
+        if (!started) return nodes.empty();
+
+        // CALLER components are only drained by run(), which has returned by now
+        graphCondition.wait(lock, [this]() { return unfinished == 0; });
+        pending.swap(tasks);
+    }
+
+    for (auto& task : pending) {
+        task.wait();
+    }
+
+    std::lock_guard<std::mutex> lock(graphMutex);
+    return std::all_of(nodes.begin(), nodes.end(), [](const Node& node) {
+        return node.state == State::SUCCEEDED;
+    });
+}
+
+std::vector<StartupGraph::ComponentTiming> StartupGraph::getTimeline() const {
+    std::lock_guard<std::mutex> lock(graphMutex);
+    std::vector<ComponentTiming> timeline;
+    timeline.reserve(nodes.size());
+    for (const auto& node : nodes) {
+        timeline.push_back(ComponentTiming{node.name, node.mode, node.state, node.startMs, node.endMs});
+    }
+
+    std::stable_sort(timeline.begin(), timeline.end(), [](const ComponentTiming& a, const ComponentTiming& b) {
+        return a.startMs < b.startMs;
+    });
+    return timeline;
+}
+
+std::string StartupGraph::formatTimeline() const {
+    std::vector<ComponentTiming> timeline = getTimeline();
+    size_t nameWidth = 0;
+    for (const auto& entry : timeline) {
+        nameWidth = std::max(nameWidth, entry.name.size());
+    }
+
+    TextSerializer out;
+    out.text("Startup timeline (ms from start)").newline();
+    for (const auto& entry : timeline) {
+        out.text("  ").text(entry.name).text(std::string(nameWidth - entry.name.size() + 2, ' '));
+        if (entry.state == State::PENDING || entry.state == State::RUNNING) {
+            out.text(stateName(entry.state)).newline();
+            continue;
+        }
+        out.fixed(entry.startMs, 1).text(" -> ").fixed(entry.endMs, 1)
+           .text("  (").fixed(entry.endMs - entry.startMs, 1).text(" ms) ").text(stateName(entry.state));
+        if (entry.mode == Mode::BACKGROUND) out.text(" [background]");
+        out.newline();
+    }
+    out.text("  Total: ").fixed(getElapsedMs(), 1).text(" ms").newline();
+    return out.str();
+}
+
+double StartupGraph::getElapsedMs() const {
+    std::lock_guard<std::mutex> lock(graphMutex);
+    double latest = 0.0;
+    for (const auto& node : nodes) {
+        latest = std::max(latest, node.endMs);
+    }
+    return latest;
+}
+
+double StartupGraph::offsetMs() const {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void StartupGraph::launch(size_t index) {
+    if (nodes[index].mode == Mode::CALLER) {
+        callerQueue.push_back(index);
+        graphCondition.notify_all();
+        return;
+    }
+
+    // A handful of components, each run once: a thread apiece beats any pool that
+    // might itself still be starting up
+    tasks.push_back(std::async(std::launch::async, [this, index]() { execute(index); }));
+}
+
+void StartupGraph::execute(size_t index) {
+    InitFunction init;
+    {
+        std::lock_guard<std::mutex> lock(graphMutex);
+        nodes[index].state = State::RUNNING;
+        nodes[index].startMs = offsetMs();
+        init = nodes[index].init;
+    }
+
+    bool succeeded = false;
+    try {
+        succeeded = init();
+    } catch (...) {
+        succeeded = false;
+    }
+
+    if (complete(index, succeeded)) {
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(graphMutex);
+            callback = completionCallback;
+        }
+        if (callback) callback();
+    }
+}
+
+bool StartupGraph::complete(size_t index, bool succeeded) {
+    std::lock_guard<std::mutex> lock(graphMutex);
+    Node& node = nodes[index];
+    node.endMs = offsetMs();
+    node.state = succeeded ? State::SUCCEEDED : State::FAILED;
+    markFinished(node);
+
+    for (size_t dependent : node.dependents) {
+        if (!succeeded) {
+            skip(dependent);
+        } else if (--nodes[dependent].remainingDependencies == 0 && nodes[dependent].state == State::PENDING) {
+            launch(dependent);
+        }
+    }
+
+    graphCondition.notify_all();
+    return unfinished == 0;
+}
+
+void StartupGraph::skip(size_t index) {
+    Node& node = nodes[index];
+    if (node.state != State::PENDING) return;
+
+    node.state = State::SKIPPED;
+    node.startMs = node.endMs = offsetMs();
+    markFinished(node);
+    for (size_t dependent : node.dependents) {
+        skip(dependent);
+    }
+}
+
+void StartupGraph::markFinished(const Node& node) {
+    --unfinished;
+    if (node.mode != Mode::BACKGROUND) --unfinishedForeground;
+}
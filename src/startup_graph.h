@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Brings components up as a dependency graph: each one starts as soon as everything
+// it depends on has succeeded, so independent components initialise concurrently.
+// Dependencies must be added first, which keeps the graph acyclic by construction.
+// A component that fails (returns false or throws) skips everything that depends on
+// it. Start and end times are recorded per component for the startup timeline.
+class StartupGraph {
+public:
+    enum class Mode {
+        BLOCKING,       // Own thread; run() waits for it
+        CALLER,         // On the thread that called run(), e.g. for UI objects
+        BACKGROUND      // Own thread; run() does not wait (warm-ups)
+    };
+
+    enum class State {
+        PENDING,
+        RUNNING,
+        SUCCEEDED,
+        FAILED,
+        SKIPPED         // A dependency failed
+    };
+
+    struct ComponentTiming {
+        std::string name;
+        Mode mode;
+        State state;
+        double startMs;     // Offsets from the start of run()
+        double endMs;
+    };
+
+    using InitFunction = std::function<bool()>;
+
+    StartupGraph();
+    ~StartupGraph();        // Waits for background components
+
+    StartupGraph(const StartupGraph&) = delete;
+    StartupGraph& operator=(const StartupGraph&) = delete;
+
+    // False if the name is taken, a dependency is unknown, or run() has started
+    bool addComponent(const std::string& name, const std::vector<std::string>& dependencies,
+                      InitFunction init, Mode mode = Mode::BLOCKING);
+
+    // Called once when every component, background ones included, has finished
+    void setCompletionCallback(std::function<void()> callback);
+
+    // Returns once all BLOCKING and CALLER components have finished; true if they all succeeded
+    bool run();
+    bool wait();            // Also waits for BACKGROUND components
+
+    std::vector<ComponentTiming> getTimeline() const;
+    std::string formatTimeline() const;
+    double getElapsedMs() const;        // Latest end time so far
+
+private:
+    struct Node {
+        std::string name;
+        std::vector<size_t> dependents;
+        InitFunction init;
+        Mode mode;
+        State state;
+        size_t remainingDependencies;
+        double startMs;
+        double endMs;
+    };
+
+    mutable std::mutex graphMutex;
+    std::condition_variable graphCondition;
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, size_t> nodeIndex;
+    std::deque<size_t> callerQueue;
+    std::vector<std::future<void>> tasks;
+    std::function<void()> completionCallback;
+    std::chrono::steady_clock::time_point origin;
+    size_t unfinishedForeground;
+    size_t unfinished;
+    bool started;
+
+    double offsetMs() const;
+    void launch(size_t index);              // Caller holds graphMutex
+    void execute(size_t index);
+    bool complete(size_t index, bool succeeded);    // True if that finished the graph
+    void skip(size_t index);                // Caller holds graphMutex
+    void markFinished(const Node& node);    // Caller holds graphMutex
+};
@@ -0,0 +1,159 @@
+#include "static_hud_mask.h"
+#include <algorithm>
+
+// StaticHudMask Implementation
+StaticHudMask::Options::Options()
+    : scale(4), learningRate(0.02), staticVariance(64.0), changeThreshold(12),
+      motionFraction(0.01), warmupFrames(60), dilation(1), minCoverage(0.2f) {}
+
+StaticHudMask::StaticHudMask(const Options& options) : options(options) {
+    if (this->options.scale < 1) this->options.scale = 1;
+    reset();
+}
+
+void StaticHudMask::reset() {
+    frameSize = cv::Size();
+    learningSize = cv::Size();
+    previous.release();
+    mean.release();
+    variance.release();
+    staticPixels.release();
+    mask.release();
+    hudChanges.release();
+    worldChanges.release();
+    movingFrames = 0;
+    worldMoving = false;
+}
+
+void StaticHudMask::update(const cv::Mat& frame) {
+    if (frame.empty()) return;
+
+    cv::Mat gray;
+    if (frame.channels() == 3) {
+        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    } else if (frame.channels() == 4) {
+        cv::cvtColor(frame, gray, cv::COLOR_BGRA2GRAY);
+    } else {
+        gray = frame;
+    }
+    cv::Mat small;
+    cv::Size size(std::max(1, frame.cols / options.scale), std::max(1, frame.rows / options.scale));
+    cv::resize(gray, small, size, 0, 0, cv::INTER_AREA);
+
+    if (frame.size() != frameSize || previous.empty()) {
+        reset();
+        frameSize = frame.size();
+        learningSize = size;
+        previous = small;
+        small.convertTo(mean, CV_32F);
+        variance = cv::Mat::zeros(size, CV_32F);
+        staticPixels = cv::Mat::zeros(size, CV_8U);
+        mask = cv::Mat::zeros(size, CV_8U);
+        hudChanges = cv::Mat::zeros(size, CV_8U);
+        worldChanges = cv::Mat::zeros(size, CV_8U);
+        return;
+    }
+
+    // Changes are split by the mask as it stood before this frame; a HUD value that just
+    // changed raises its pixels' variance, and must not count as world motion for it
+    cv::Mat changed, diff;
+    cv::absdiff(small, previous, diff);
+    cv::threshold(diff, changed, options.changeThreshold, 255, cv::THRESH_BINARY);
+    if (isReady()) {
+        cv::bitwise_and(changed, mask, hudChanges);
+        cv::subtract(changed, hudChanges, worldChanges);
+    } else {
+        hudChanges.setTo(0);
+        changed.copyTo(worldChanges);
+    }
+    previous = small;
+
+    worldMoving = cv::countNonZero(changed) > options.motionFraction * changed.total();
+    if (!worldMoving) return;
+    ++movingFrames;
+
+    // Exponentially weighted mean and variance, one pass over the pixels. Each frame's
+    // squared deviation is capped, so a HUD value changing now and then adds a bounded
+    // step, and a pixel once learned as HUD only leaves at twice the entry variance
+    const float rate = static_cast<float>(options.learningRate);
+    const float keep = 1.0f - rate;
+    const float enter = static_cast<float>(options.staticVariance);
+    const float leave = 2.0f * enter;
+    const float cap = 4.0f * enter;
+    for (int y = 0; y < learningSize.height; ++y) {
+        const uint8_t* value = small.ptr<uint8_t>(y);
+        float* average = mean.ptr<float>(y);
+        float* spread = variance.ptr<float>(y);
+        uint8_t* hud = staticPixels.ptr<uint8_t>(y);
+        for (int x = 0; x < learningSize.width; ++x) {
+            float delta = value[x] - average[x];
+            average[x] += rate * delta;
+            spread[x] = keep * (spread[x] + rate * std::min(delta * delta, cap));
+            hud[x] = spread[x] < (hud[x] ? leave : enter) ? 255 : 0;
+        }
+    }
+
+    if (options.dilation > 0) {
+        cv::Mat kernel = cv::getStructuringElement(cv::MORPH_RECT,
+            cv::Size(2 * options.dilation + 1, 2 * options.dilation + 1));
+        cv::dilate(staticPixels, mask, kernel);
+    } else {
+        staticPixels.copyTo(mask);
+    }
+}
+
+float StaticHudMask::hudCoverage(const cv::Rect& area) const {
+    if (!isReady()) return 0.0f;
+    cv::Rect cells = toLearningScale(area);
+    if (cells.empty()) return 0.0f;
+    return static_cast<float>(cv::countNonZero(mask(cells))) / cells.area();
+}
+
+bool StaticHudMask::hudChanged(const cv::Rect& area) const {
+    if (!isReady()) return true;
+    cv::Rect cells = toLearningScale(area);
+    if (cells.empty()) return false;
+    if (cv::countNonZero(mask(cells)) < options.minCoverage * cells.area()) return true;
+    return cv::countNonZero(hudChanges(cells)) > 0;
+}
+
+void StaticHudMask::changedRegions(std::vector<cv::Rect>& hud, std::vector<cv::Rect>& world) const {
+    hud.clear();
+    world.clear();
+    if (previous.empty()) return;
+
+    std::vector<std::vector<cv::Point>> contours;
+    cv::Mat hudCopy = hudChanges.clone();   // findContours may modify its input
+    cv::findContours(hudCopy, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+    for (const auto& contour : contours) {
+        hud.push_back(toFrameScale(cv::boundingRect(contour)));
+    }
+
+    if (worldMoving) {
+        std::vector<cv::Point> points;
+        cv::findNonZero(worldChanges, points);
+        if (!points.empty()) world.push_back(toFrameScale(cv::boundingRect(points)));
+        return;
+    }
+    contours.clear();
+    cv::Mat worldCopy = worldChanges.clone();
+    cv::findContours(worldCopy, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+    for (const auto& contour : contours) {
+        world.push_back(toFrameScale(cv::boundingRect(contour)));
+    }
+}
+
+cv::Rect StaticHudMask::toLearningScale(const cv::Rect& area) const {
+    // Rounded outwards, so a small box still covers the cells it touches
+    int scale = options.scale;
+    int left = std::max(0, area.x / scale);
+    int top = std::max(0, area.y / scale);
+    int right = std::min(learningSize.width, (area.x + area.width + scale - 1) / scale);
+    int bottom = std::min(learningSize.height, (area.y + area.height + scale - 1) / scale);
+    return right > left && bottom > top ? cv::Rect(left, top, right - left, bottom - top) : cv::Rect();
+}
+
+cv::Rect StaticHudMask::toFrameScale(const cv::Rect& cells) const {
+    cv::Rect area(cells.x * options.scale, cells.y * options.scale, cells.width * options.scale, cells.height * options.scale);
+    return area & cv::Rect(0, 0, frameSize.width, frameSize.height);
+}
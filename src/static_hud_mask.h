@@ -0,0 +1,73 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <vector>
+
+// Learns which pixels belong to a static HUD: those whose value hardly varies over
+// time while the rest of the frame is moving. Each update runs on a downscaled
+// luminance image and keeps a running mean and variance per pixel, updated only on
+// frames where enough of the picture changed (a paused or idle scene says nothing
+// about what is HUD). Once warmed up, each update's changes are split into HUD
+// changes and world changes, so HUD work can stay incremental while the camera pans.
+class StaticHudMask {
+public:
+    struct Options {
+        int scale;                  // Learn on a 1/scale image
+        double learningRate;        // Weight of each moving frame in the running statistics
+        double staticVariance;      // Grey levels squared; below it a pixel becomes HUD
+        int changeThreshold;        // Grey levels between frames that count as a change
+        double motionFraction;      // Changed fraction of the frame that means the world moved
+        int warmupFrames;           // Moving frames seen before the mask is used
+        int dilation;               // Cells the mask grows by, to take in glyph edges
+        float minCoverage;          // HUD fraction below which hudChanged cannot rule a change out
+
+        Options();
+    };
+
+    explicit StaticHudMask(const Options& options = Options());
+
+    void reset();
+
+    // Compares frame with the previous one, splits the changes by the current mask,
+    // then learns from it. A new frame size starts learning again.
+    void update(const cv::Mat& frame);
+
+    bool isReady() const { return movingFrames >= options.warmupFrames; }
+    bool isWorldMoving() const { return worldMoving; }         // In the last update
+    int64_t getMovingFrames() const { return movingFrames; }
+
+    // 255 where static HUD, at learning scale (empty before the first update)
+    const cv::Mat& getMask() const { return mask; }
+
+    // Fraction of area (frame coordinates) that is HUD
+    float hudCoverage(const cv::Rect& area) const;
+
+    // Whether HUD pixels in area changed in the last update. Always true until ready and
+    // for areas the mask hardly covers (a value that changes every few frames is never
+    // learned as static), so callers fall back to doing the work
+    bool hudChanged(const cv::Rect& area) const;
+
+    // Last update's changed areas in frame coordinates. While the world is moving its
+    // changes come back as one bounding box rather than many small ones
+    void changedRegions(std::vector<cv::Rect>& hud, std::vector<cv::Rect>& world) const;
+
+private:
+    Options options;
+    cv::Size frameSize;
+    cv::Size learningSize;
+
+    cv::Mat previous;           // 8-bit luminance at learning scale
+    cv::Mat mean;               // Float running statistics
+    cv::Mat variance;
+    cv::Mat staticPixels;       // Learned HUD pixels (with hysteresis)
+    cv::Mat mask;               // staticPixels, dilated
+    cv::Mat hudChanges;         // Last update's changes inside / outside the mask
+    cv::Mat worldChanges;
+
+    int64_t movingFrames;
+    bool worldMoving;
+
+    cv::Rect toLearningScale(const cv::Rect& area) const;
+    cv::Rect toFrameScale(const cv::Rect& cells) const;
+};
@@ -0,0 +1,439 @@
+// Compensated summation only works if the compiler keeps the exact order of
+// operations, so this file opts out of the project-wide -ffast-math.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC optimize("no-fast-math")
+#elif defined(_MSC_VER)
+#pragma float_control(precise, on)
+#endif
+
+#include "stats_kernels.h"
+#include <cmath>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace StatsKernels {
+
+void CompensatedSum::add(double value) {
+    double total = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+        compensation += (sum - total) + value;
+    } else {
+        compensation += (value - total) + sum;
+    }
+    sum = total;
+}
+
+namespace {
+
+// Double-precision SIMD lanes; floats are widened on load
+#if defined(__AVX__)
+struct Lanes {
+    static constexpr size_t width = 4;
+    __m256d v;
+
+    static Lanes zero() { return Lanes{_mm256_setzero_pd()}; }
+    static Lanes broadcast(double x) { return Lanes{_mm256_set1_pd(x)}; }
+    static Lanes load(const double* p) { return Lanes{_mm256_loadu_pd(p)}; }
+    static Lanes load(const float* p) { return Lanes{_mm256_cvtps_pd(_mm_loadu_ps(p))}; }
+    void store(double* out) const { _mm256_storeu_pd(out, v); }
+};
+
+inline Lanes operator+(Lanes a, Lanes b) { return Lanes{_mm256_add_pd(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return Lanes{_mm256_sub_pd(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return Lanes{_mm256_mul_pd(a.v, b.v)}; }
+#elif defined(__SSE2__) || defined(_M_X64)
+struct Lanes {
+    static constexpr size_t width = 2;
+    __m128d v;
+
+    static Lanes zero() { return Lanes{_mm_setzero_pd()}; }
+    static Lanes broadcast(double x) { return Lanes{_mm_set1_pd(x)}; }
+    static Lanes load(const double* p) { return Lanes{_mm_loadu_pd(p)}; }
+    static Lanes load(const float* p) { return Lanes{_mm_set_pd(p[1], p[0])}; }
+    void store(double* out) const { _mm_storeu_pd(out, v); }
+};
+
+inline Lanes operator+(Lanes a, Lanes b) { return Lanes{_mm_add_pd(a.v, b.v)}; }
+inline Lanes operator-(Lanes a, Lanes b) { return Lanes{_mm_sub_pd(a.v, b.v)}; }
+inline Lanes operator*(Lanes a, Lanes b) { return Lanes{_mm_mul_pd(a.v, b.v)}; }
+#else
+struct Lanes {
+    static constexpr size_t width = 1;
+    double v;
+
+    static Lanes zero() { return Lanes{0.0}; }
+    static Lanes broadcast(double x) { return Lanes{x}; }
+    static Lanes load(const double* p) { return Lanes{p[0]}; }
+    static Lanes load(const float* p) { return Lanes{static_cast<double>(p[0])}; }
+    void store(double* out) const { out[0] = v; }
+};
+
+inline Lanes operator+(Lanes a, Lanes b) { return Lanes{a.v + b.v}; }
+inline Lanes operator-(Lanes a, Lanes b) { return Lanes{a.v - b.v}; }
+inline Lanes operator*(Lanes a, Lanes b) { return Lanes{a.v * b.v}; }
+#endif
+
+constexpr size_t W = Lanes::width;
+
+// {start, start + 1, ...}
+Lanes ramp(double start) {
+    double values[W];
+    for (size_t k = 0; k < W; ++k) {
+        values[k] = start + static_cast<double>(k);
+    }
+    return Lanes::load(values);
+}
+
+// Per-lane Kahan accumulator, folded into a Neumaier sum at the end
+struct LaneAccumulator {
+    Lanes sum = Lanes::zero();
+    Lanes carry = Lanes::zero();
+
+    void add(Lanes x) {
+        Lanes y = x - carry;
+        Lanes total = sum + y;
+        carry = (total - sum) - y;
+        sum = total;
+    }
+
+    void reduceInto(CompensatedSum& result) const {
+        double sums[W], carries[W];
+        sum.store(sums);
+        carry.store(carries);
+        for (size_t k = 0; k < W; ++k) {
+            result.add(sums[k]);
+            result.add(-carries[k]);
+        }
+    }
+};
+
+template <typename T>
+double sumImpl(SpanView<const T> data) {
+    const T* p = data.data();
+    size_t n = data.size(), i = 0;
+
+    LaneAccumulator lanes;
+    for (; i + W <= n; i += W) {
+        lanes.add(Lanes::load(p + i));
+    }
+
+    CompensatedSum total;
+    lanes.reduceInto(total);
+    for (; i < n; ++i) {
+        total.add(p[i]);
+    }
+    return total.result();
+}
+
+template <typename T>
+double sumSquaredDeviationsImpl(SpanView<const T> data, double center) {
+    const T* p = data.data();
+    size_t n = data.size(), i = 0;
+
+    Lanes c = Lanes::broadcast(center);
+    LaneAccumulator lanes;
+    for (; i + W <= n; i += W) {
+        Lanes d = Lanes::load(p + i) - c;
+        lanes.add(d * d);
+    }
+
+    CompensatedSum total;
+    lanes.reduceInto(total);
+    for (; i < n; ++i) {
+        double d = p[i] - center;
+        total.add(d * d);
+    }
+    return total.result();
+}
+
+template <typename T>
+double indexWeightedSumImpl(SpanView<const T> data, double firstIndex) {
+    const T* p = data.data();
+    size_t n = data.size(), i = 0;
+
+    Lanes index = ramp(firstIndex);
+    Lanes step = Lanes::broadcast(static_cast<double>(W));
+    LaneAccumulator lanes;
+    for (; i + W <= n; i += W) {
+        lanes.add(index * Lanes::load(p + i));
+        index = index + step;
+    }
+
+    CompensatedSum total;
+    lanes.reduceInto(total);
+    for (; i < n; ++i) {
+        total.add((firstIndex + static_cast<double>(i)) * p[i]);
+    }
+    return total.result();
+}
+
+template <typename T>
+double varianceImpl(SpanView<const T> data, bool sample) {
+    size_t n = data.size();
+    if (n < 2) return 0.0;
+
+    double center = sumImpl(data) / n;
+    return sumSquaredDeviationsImpl(data, center) / (sample ? n - 1 : n);
+}
+
+template <typename T>
+LinearTrend linearTrendImpl(SpanView<const T> data) {
+    LinearTrend trend;
+    size_t n = data.size();
+    if (n == 0) return trend;
+
+    double average = sumImpl(data) / n;
+    trend.intercept = average;
+    if (n < 2) return trend;
+
+    // With x centered on its mean, sum((x - xbar) * y) is one weighted pass
+    // and sum((x - xbar)^2) has the closed form n(n^2 - 1) / 12
+    double center = 0.5 * (n - 1);
+    double dn = static_cast<double>(n);
+    double sxx = dn * (dn * dn - 1.0) / 12.0;
+
+    trend.slope = indexWeightedSumImpl(data, -center) / sxx;
+    trend.intercept = average - trend.slope * center;
+    return trend;
+}
+
+template <typename T>
+double exponentialMovingAverageImpl(SpanView<const T> data, double alpha, double seed) {
+    const T* p = data.data();
+    size_t n = data.size();
+    if (n == 0) return seed;
+
+    double decay = 1.0 - alpha;
+    if (!(decay >= 0.0 && decay <= 1.0)) {
+        // Outside [0, 1] the weights do not shrink; use the plain recurrence
+        double ema = seed;
+        for (size_t i = 0; i < n; ++i) {
+            ema = alpha * p[i] + decay * ema;
+        }
+        return ema;
+    }
+
+    // ema = decay^n * seed + alpha * sum(decay^(n-1-i) * x[i]), accumulated newest first.
+    // Weights only shrink going back, so stop once they no longer affect the result.
+    const double negligibleWeight = 1e-20;
+
+    double laneWeights[W];
+    double weight = 1.0;
+    for (size_t k = 0; k < W; ++k) {
+        laneWeights[W - 1 - k] = weight;
+        weight *= decay;
+    }
+    Lanes weights = Lanes::load(laneWeights);
+    Lanes blockDecay = Lanes::broadcast(weight);    // decay^W
+    double newestWeight = 1.0;                      // Largest weight in the current block
+
+    LaneAccumulator lanes;
+    size_t remaining = n;
+    while (remaining >= W && newestWeight > negligibleWeight) {
+        remaining -= W;
+        lanes.add(weights * Lanes::load(p + remaining));
+        weights = weights * blockDecay;
+        newestWeight *= weight;
+    }
+
+    CompensatedSum total;
+    lanes.reduceInto(total);
+
+    double scalarWeight = newestWeight;
+    while (remaining > 0 && scalarWeight > negligibleWeight) {
+        --remaining;
+        total.add(scalarWeight * p[remaining]);
+        scalarWeight *= decay;
+    }
+
+    return std::pow(decay, static_cast<double>(n)) * seed + alpha * total.result();
+}
+
+// Segmented forms combine the per-segment partial results
+template <typename T>
+double segmentedSum(SegmentedSpan<const T> data) {
+    CompensatedSum total;
+    total.add(sumImpl(data.firstSegment()));
+    total.add(sumImpl(data.secondSegment()));
+    return total.result();
+}
+
+template <typename T>
+double segmentedVariance(SegmentedSpan<const T> data, bool sample) {
+    size_t n = data.size();
+    if (n < 2) return 0.0;
+
+    double center = segmentedSum(data) / n;
+    CompensatedSum total;
+    total.add(sumSquaredDeviationsImpl(data.firstSegment(), center));
+    total.add(sumSquaredDeviationsImpl(data.secondSegment(), center));
+    return total.result() / (sample ? n - 1 : n);
+}
+
+template <typename T>
+double segmentedIndexWeightedSum(SegmentedSpan<const T> data, double firstIndex) {
+    CompensatedSum total;
+    total.add(indexWeightedSumImpl(data.firstSegment(), firstIndex));
+    total.add(indexWeightedSumImpl(data.secondSegment(), firstIndex + data.firstSegment().size()));
+    return total.result();
+}
+
+template <typename T>
+LinearTrend segmentedLinearTrend(SegmentedSpan<const T> data) {
+    if (data.secondSegment().empty()) return linearTrendImpl(data.firstSegment());
+
+    LinearTrend trend;
+    size_t n = data.size();
+    double average = segmentedSum(data) / n;
+    double center = 0.5 * (n - 1);
+    double dn = static_cast<double>(n);
+    double sxx = dn * (dn * dn - 1.0) / 12.0;
+
+    trend.slope = segmentedIndexWeightedSum(data, -center) / sxx;
+    trend.intercept = average - trend.slope * center;
+    return trend;
+}
+
+template <typename T>
+double segmentedExponentialMovingAverage(SegmentedSpan<const T> data, double alpha, double seed) {
+    double ema = exponentialMovingAverageImpl(data.firstSegment(), alpha, seed);
+    return exponentialMovingAverageImpl(data.secondSegment(), alpha, ema);
+}
+
+}
+
+double sum(SpanView<const double> data) { return sumImpl(data); }
+double sum(SpanView<const float> data) { return sumImpl(data); }
+
+double mean(SpanView<const double> data) { return data.empty() ? 0.0 : sumImpl(data) / data.size(); }
+double mean(SpanView<const float> data) { return data.empty() ? 0.0 : sumImpl(data) / data.size(); }
+
+double sumSquaredDeviations(SpanView<const double> data, double center) {
+    return sumSquaredDeviationsImpl(data, center);
+}
+
+double sumSquaredDeviations(SpanView<const float> data, double center) {
+    return sumSquaredDeviationsImpl(data, center);
+}
+
+double variance(SpanView<const double> data, bool sample) { return varianceImpl(data, sample); }
+double variance(SpanView<const float> data, bool sample) { return varianceImpl(data, sample); }
+
+double standardDeviation(SpanView<const double> data, bool sample) { return std::sqrt(varianceImpl(data, sample)); }
+double standardDeviation(SpanView<const float> data, bool sample) { return std::sqrt(varianceImpl(data, sample)); }
+
+double indexWeightedSum(SpanView<const double> data, double firstIndex) {
+    return indexWeightedSumImpl(data, firstIndex);
+}
+
+double indexWeightedSum(SpanView<const float> data, double firstIndex) {
+    return indexWeightedSumImpl(data, firstIndex);
+}
+
+LinearTrend linearTrend(SpanView<const double> data) { return linearTrendImpl(data); }
+LinearTrend linearTrend(SpanView<const float> data) { return linearTrendImpl(data); }
+
+CrossDeviation crossDeviation(SpanView<const double> x, SpanView<const double> y, double meanX, double meanY) {
+    CrossDeviation result;
+    size_t n = x.size() < y.size() ? x.size() : y.size(), i = 0;
+    const double* px = x.data();
+    const double* py = y.data();
+
+    Lanes mx = Lanes::broadcast(meanX);
+    Lanes my = Lanes::broadcast(meanY);
+    LaneAccumulator xy, xx, yy;
+    for (; i + W <= n; i += W) {
+        Lanes dx = Lanes::load(px + i) - mx;
+        Lanes dy = Lanes::load(py + i) - my;
+        xy.add(dx * dy);
+        xx.add(dx * dx);
+        yy.add(dy * dy);
+    }
+
+    CompensatedSum sxy, sxx, syy;
+    xy.reduceInto(sxy);
+    xx.reduceInto(sxx);
+    yy.reduceInto(syy);
+    for (; i < n; ++i) {
+        double dx = px[i] - meanX;
+        double dy = py[i] - meanY;
+        sxy.add(dx * dy);
+        sxx.add(dx * dx);
+        syy.add(dy * dy);
+    }
+
+    result.sxy = sxy.result();
+    result.sxx = sxx.result();
+    result.syy = syy.result();
+    return result;
+}
+
+LinearTrend linearFit(SpanView<const double> x, SpanView<const double> y) {
+    LinearTrend fit;
+    if (x.size() != y.size() || x.empty()) return fit;
+
+    double meanX = mean(x);
+    double meanY = mean(y);
+    CrossDeviation deviation = crossDeviation(x, y, meanX, meanY);
+
+    fit.slope = deviation.sxx > 0.0 ? deviation.sxy / deviation.sxx : 0.0;
+    fit.intercept = meanY - fit.slope * meanX;
+    return fit;
+}
+
+double correlation(SpanView<const double> x, SpanView<const double> y) {
+    if (x.size() != y.size() || x.empty()) return 0.0;
+
+    CrossDeviation deviation = crossDeviation(x, y, mean(x), mean(y));
+    if (deviation.sxx == 0.0 || deviation.syy == 0.0) return 0.0;
+
+    return deviation.sxy / (std::sqrt(deviation.sxx) * std::sqrt(deviation.syy));
+}
+
+double exponentialMovingAverage(SpanView<const double> data, double alpha, double seed) {
+    return exponentialMovingAverageImpl(data, alpha, seed);
+}
+
+double exponentialMovingAverage(SpanView<const float> data, double alpha, double seed) {
+    return exponentialMovingAverageImpl(data, alpha, seed);
+}
+
+double sum(SegmentedSpan<const double> data) { return segmentedSum(data); }
+double sum(SegmentedSpan<const float> data) { return segmentedSum(data); }
+
+double mean(SegmentedSpan<const double> data) { return data.empty() ? 0.0 : segmentedSum(data) / data.size(); }
+double mean(SegmentedSpan<const float> data) { return data.empty() ? 0.0 : segmentedSum(data) / data.size(); }
+
+double variance(SegmentedSpan<const double> data, bool sample) { return segmentedVariance(data, sample); }
+double variance(SegmentedSpan<const float> data, bool sample) { return segmentedVariance(data, sample); }
+
+double standardDeviation(SegmentedSpan<const double> data, bool sample) {
+    return std::sqrt(segmentedVariance(data, sample));
+}
+
+double standardDeviation(SegmentedSpan<const float> data, bool sample) {
+    return std::sqrt(segmentedVariance(data, sample));
+}
+
+double indexWeightedSum(SegmentedSpan<const double> data, double firstIndex) {
+    return segmentedIndexWeightedSum(data, firstIndex);
+}
+
+double indexWeightedSum(SegmentedSpan<const float> data, double firstIndex) {
+    return segmentedIndexWeightedSum(data, firstIndex);
+}
+
+LinearTrend linearTrend(SegmentedSpan<const double> data) { return segmentedLinearTrend(data); }
+LinearTrend linearTrend(SegmentedSpan<const float> data) { return segmentedLinearTrend(data); }
+
+double exponentialMovingAverage(SegmentedSpan<const double> data, double alpha, double seed) {
+    return segmentedExponentialMovingAverage(data, alpha, seed);
+}
+
+double exponentialMovingAverage(SegmentedSpan<const float> data, double alpha, double seed) {
+    return segmentedExponentialMovingAverage(data, alpha, seed);
+}
+
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include "span_view.h"
+
+// Shared statistics kernels for the analytics code.
+// All reductions use compensated summation with double accumulators and run on
+// AVX/SSE2 lanes when available. Every kernel takes a view, so callers never copy.
+// Sums are additive across views, which lets split (ring buffer) storage be reduced
+// segment by segment and combined with CompensatedSum.
+namespace StatsKernels {
+
+// Neumaier running sum; exact enough to combine partial kernel results
+class CompensatedSum {
+public:
+    CompensatedSum() : sum(0.0), compensation(0.0) {}
+
+    // Out of line so it always builds without -ffast-math reassociation
+    void add(double value);
+
+    double result() const { return sum + compensation; }
+
+private:
+    double sum;
+    double compensation;
+};
+
+struct LinearTrend {
+    double slope;
+    double intercept;
+
+    LinearTrend() : slope(0.0), intercept(0.0) {}
+};
+
+// Centered cross-products for correlation/regression
+struct CrossDeviation {
+    double sxy;
+    double sxx;
+    double syy;
+
+    CrossDeviation() : sxy(0.0), sxx(0.0), syy(0.0) {}
+};
+
+// Sum of elements
+double sum(SpanView<const double> data);
+double sum(SpanView<const float> data);
+
+// Arithmetic mean (0 for an empty view)
+double mean(SpanView<const double> data);
+double mean(SpanView<const float> data);
+
+// Sum of (x - center)^2
+double sumSquaredDeviations(SpanView<const double> data, double center);
+double sumSquaredDeviations(SpanView<const float> data, double center);
+
+// Two-pass variance; sample=true divides by n-1
+double variance(SpanView<const double> data, bool sample = true);
+double variance(SpanView<const float> data, bool sample = true);
+double standardDeviation(SpanView<const double> data, bool sample = true);
+double standardDeviation(SpanView<const float> data, bool sample = true);
+
+// Sum of (firstIndex + i) * x[i]
+double indexWeightedSum(SpanView<const double> data, double firstIndex);
+double indexWeightedSum(SpanView<const float> data, double firstIndex);
+
+// Least-squares line through (i, data[i]), i = 0..n-1
+LinearTrend linearTrend(SpanView<const double> data);
+LinearTrend linearTrend(SpanView<const float> data);
+
+// Sums of centered products of x and y about the given means (sizes must match)
+CrossDeviation crossDeviation(SpanView<const double> x, SpanView<const double> y, double meanX, double meanY);
+
+// Least-squares line through (x[i], y[i])
+LinearTrend linearFit(SpanView<const double> x, SpanView<const double> y);
+
+// Pearson correlation (0 when either series is constant or sizes differ)
+double correlation(SpanView<const double> x, SpanView<const double> y);
+
+// EMA of data starting from seed: e = alpha * x + (1 - alpha) * e.
+// Evaluated as a geometric-weighted sum, so it vectorises and chains across views.
+double exponentialMovingAverage(SpanView<const double> data, double alpha, double seed);
+double exponentialMovingAverage(SpanView<const float> data, double alpha, double seed);
+
+// Two-segment (ring buffer) forms; results match the single-view kernels on the joined data
+double sum(SegmentedSpan<const double> data);
+double sum(SegmentedSpan<const float> data);
+double mean(SegmentedSpan<const double> data);
+double mean(SegmentedSpan<const float> data);
+double variance(SegmentedSpan<const double> data, bool sample = true);
+double variance(SegmentedSpan<const float> data, bool sample = true);
+double standardDeviation(SegmentedSpan<const double> data, bool sample = true);
+double standardDeviation(SegmentedSpan<const float> data, bool sample = true);
+double indexWeightedSum(SegmentedSpan<const double> data, double firstIndex);
+double indexWeightedSum(SegmentedSpan<const float> data, double firstIndex);
+LinearTrend linearTrend(SegmentedSpan<const double> data);
+LinearTrend linearTrend(SegmentedSpan<const float> data);
+double exponentialMovingAverage(SegmentedSpan<const double> data, double alpha, double seed);
+double exponentialMovingAverage(SegmentedSpan<const float> data, double alpha, double seed);
+
+}
@@ -1,4 +1,5 @@
 #include "test_framework.h"
+#include "text_serializer.h"
 #include <algorithm>
 #include <numeric>
 
@@ -130,96 +131,101 @@ TestStatistics BloombergTestFramework::getStatistics() const {
 }
 
 void BloombergTestFramework::generateReport(const std::string& filename) {
-    std::ofstream report(filename);
-    if (!report.is_open()) {
+    FILE* file = fopen(filename.c_str(), "w");
+    if (!file) {
         std::cerr << "Failed to create report file: " << filename << std::endl;
         return;
     }
     
     auto stats = getStatistics();
+    TextSerializer report(TextSerializer::fileSink(file));
     
-    report << "==========================================" << std::endl;
-    report << "  BLOOMBERG TERMINAL TEST REPORT" << std::endl;
-    report << "  Enterprise Gaming Analytics Platform" << std::endl;
-    report << "==========================================" << std::endl << std::endl;
+    report.text("==========================================").newline();
+    report.text("  BLOOMBERG TERMINAL TEST REPORT").newline();
+    report.text("  Enterprise Gaming Analytics Platform").newline();
+    report.text("==========================================").newline().newline();
     
     // Executive Summary
-    report << "📊 EXECUTIVE SUMMARY:" << std::endl;
-    report << "  Total Tests Executed: " << stats.totalTests << std::endl;
-    report << "  Tests Passed: " << stats.passedTests << " (" << std::fixed << std::setprecision(1) 
-           << stats.getPassRate() << "%)" << std::endl;
-    report << "  Tests Failed: " << stats.failedTests << std::endl;
-    report << "  Total Execution Time: " << std::fixed << std::setprecision(2) 
-           << stats.totalExecutionTimeMs << "ms" << std::endl;
-    report << "  Average Test Time: " << std::fixed << std::setprecision(2) 
-           << stats.getAverageExecutionTime() << "ms" << std::endl;
-    report << std::endl;
+    report.text("📊 EXECUTIVE SUMMARY:").newline();
+    report.text("  Total Tests Executed: ").unsignedInteger(stats.totalTests).newline();
+    report.text("  Tests Passed: ").unsignedInteger(stats.passedTests)
+          .text(" (").fixed(stats.getPassRate(), 1).text("%)").newline();
+    report.text("  Tests Failed: ").unsignedInteger(stats.failedTests).newline();
+    report.text("  Total Execution Time: ").fixed(stats.totalExecutionTimeMs, 2).text("ms").newline();
+    report.text("  Average Test Time: ").fixed(stats.getAverageExecutionTime(), 2).text("ms").newline();
+    report.newline();
     
     // Component Breakdown
-    report << "🔧 COMPONENT BREAKDOWN:" << std::endl;
+    report.text("🔧 COMPONENT BREAKDOWN:").newline();
     for (const auto& [component, total] : stats.componentTestCounts) {
         auto passed = stats.componentPassCounts.find(component);
         size_t passedCount = (passed != stats.componentPassCounts.end()) ? passed->second : 0;
         double passRate = total > 0 ? (static_cast<double>(passedCount) / total) * 100.0 : 0.0;
         
-        report << "  " << component << ": " << passedCount << "/" << total 
-               << " (" << std::fixed << std::setprecision(1) << passRate << "%)" << std::endl;
+        report.text("  ").text(component).text(": ").unsignedInteger(passedCount).character('/').unsignedInteger(total)
+              .text(" (").fixed(passRate, 1).text("%)").newline();
     }
-    report << std::endl;
+    report.newline();
     
     // Detailed Results
-    report << "📋 DETAILED TEST RESULTS:" << std::endl;
+    report.text("📋 DETAILED TEST RESULTS:").newline();
     for (const auto& result : testResults_) {
-        report << "  [" << (result.passed ? "PASS" : "FAIL") << "] " 
-               << result.component << "::" << result.testName << std::endl;
-        report << "      Time: " << std::fixed << std::setprecision(2) << result.executionTimeMs << "ms" << std::endl;
+        report.text("  [").text(result.passed ? "PASS" : "FAIL").text("] ")
+              .text(result.component).text("::").text(result.testName).newline();
+        report.text("      Time: ").fixed(result.executionTimeMs, 2).text("ms").newline();
         if (!result.passed) {
-            report << "      Error: " << result.message << std::endl;
+            report.text("      Error: ").text(result.message).newline();
         }
-        report << std::endl;
+        report.newline();
     }
     
     // Performance Targets Validation
-    report << "🎯 PERFORMANCE TARGETS VALIDATION:" << std::endl;
-    report << "  Target Processing Latency: " << TARGET_PROCESSING_LATENCY_MS << "ms" << std::endl;
-    report << "  Target Memory Usage: " << TARGET_MEMORY_USAGE_MB << "MB" << std::endl;
-    report << "  Target CPU Usage: " << TARGET_CPU_USAGE_PERCENT << "%" << std::endl;
-    report << "  Target OCR Accuracy: " << TARGET_OCR_ACCURACY_PERCENT << "%" << std::endl;
-    report << "  Target Capture Rate: " << TARGET_CAPTURE_RATE_FPS << " FPS" << std::endl;
-    report << "  Target Startup Time: " << TARGET_STARTUP_TIME_MS << "ms" << std::endl;
-    report << std::endl;
+    report.text("🎯 PERFORMANCE TARGETS VALIDATION:").newline();
+    report.text("  Target Processing Latency: ").fixed(TARGET_PROCESSING_LATENCY_MS, 1).text("ms").newline();
+    report.text("  Target Memory Usage: ").fixed(TARGET_MEMORY_USAGE_MB, 1).text("MB").newline();
+    report.text("  Target CPU Usage: ").fixed(TARGET_CPU_USAGE_PERCENT, 1).text("%").newline();
+    report.text("  Target OCR Accuracy: ").fixed(TARGET_OCR_ACCURACY_PERCENT, 1).text("%").newline();
+    report.text("  Target Capture Rate: ").fixed(TARGET_CAPTURE_RATE_FPS, 1).text(" FPS").newline();
+    report.text("  Target Startup Time: ").fixed(TARGET_STARTUP_TIME_MS, 1).text("ms").newline();
+    report.newline();
     
     // Benchmark Results
     if (!benchmarkResults_.empty()) {
-        report << "📈 BENCHMARK RESULTS:" << std::endl;
+        report.text("📈 BENCHMARK RESULTS:").newline();
         for (const auto& benchmark : benchmarkResults_) {
-            report << "  " << benchmark.component << "::" << benchmark.benchmarkName << std::endl;
-            report << "      Average Time: " << std::fixed << std::setprecision(2) << benchmark.averageTimeMs << "ms" << std::endl;
-            report << "      Min Time: " << std::fixed << std::setprecision(2) << benchmark.minTimeMs << "ms" << std::endl;
-            report << "      Max Time: " << std::fixed << std::setprecision(2) << benchmark.maxTimeMs << "ms" << std::endl;
-            report << "      Throughput: " << std::fixed << std::setprecision(1) << benchmark.throughput << " items/sec" << std::endl;
-            report << std::endl;
+            report.text("  ").text(benchmark.component).text("::").text(benchmark.benchmarkName).newline();
+            report.text("      Average Time: ").fixed(benchmark.averageTimeMs, 2).text("ms").newline();
+            report.text("      Min Time: ").fixed(benchmark.minTimeMs, 2).text("ms").newline();
+            report.text("      Max Time: ").fixed(benchmark.maxTimeMs, 2).text("ms").newline();
+            report.text("      Throughput: ").fixed(benchmark.throughput, 1).text(" items/sec").newline();
+            report.newline();
         }
     }
     
     // Recommendations
-    report << "💡 RECOMMENDATIONS:" << std::endl;
+    report.text("💡 RECOMMENDATIONS:").newline();
     if (stats.getPassRate() >= 95.0) {
-        report << "  ✅ Excellent test coverage and reliability" << std::endl;
+        report.text("  ✅ Excellent test coverage and reliability").newline();
     } else if (stats.getPassRate() >= 80.0) {
-        report << "  ⚠️  Good test coverage, consider addressing failed tests" << std::endl;
+        report.text("  ⚠️  Good test coverage, consider addressing failed tests").newline();
     } else {
-        report << "  ❌ Significant test failures detected, review implementation" << std::endl;
+        report.text("  ❌ Significant test failures detected, review implementation").newline();
     }
     
     if (stats.getAverageExecutionTime() > 100.0) {
-        report << "  ⚠️  Consider optimizing slow tests" << std::endl;
+        report.text("  ⚠️  Consider optimizing slow tests").newline();
     }
     
-    report << std::endl;
-    report << "Report generated: " << std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()) << std::endl;
+    report.newline();
+    report.text("Report generated: ")
+          .integer(static_cast<int64_t>(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()))).newline();
     
-    report.close();
+    bool written = report.flush();
+    fclose(file);
+    if (!written) {
+        std::cerr << "Failed to write report file: " << filename << std::endl;
+        return;
+    }
     std::cout << "📄 Test report generated: " << filename << std::endl;
 }
 
@@ -45,6 +45,20 @@ int main(int argc, char* argv[]) {
             std::cout << "  • AdvancedOCR - Text recognition system" << std::endl;
             std::cout << "  • OptimizedScreenCapture - Frame capture system" << std::endl;
             std::cout << "  • GameAnalytics - Event detection system" << std::endl;
+            std::cout << "  • ForecastingModels - Holt-Winters and online AR forecasting" << std::endl;
+            std::cout << "  • AnomalyDetection - Robust z-score, EWMA and CUSUM detectors" << std::endl;
+            std::cout << "  • StatsKernels - SIMD compensated statistics kernels" << std::endl;
+            std::cout << "  • SignalRules - Streaming indicators and compiled signal table" << std::endl;
+            std::cout << "  • TrigramIndex - Fuzzy game-title normalisation and lookup" << std::endl;
+            std::cout << "  • VisualFingerprint - Screenshot descriptors and nearest-neighbour lookup" << std::endl;
+            std::cout << "  • FileHasher - Streaming XXH64/MD5 with a persistent hash cache" << std::endl;
+            std::cout << "  • ProfileDatabase - Compiled, memory-mapped game profiles" << std::endl;
+            std::cout << "  • ProfileReload - Watched profiles swapped in via RCU snapshots" << std::endl;
+            std::cout << "  • SessionExport - Streaming binary and columnar session files" << std::endl;
+            std::cout << "  • TextSerializer - to_chars CSV/JSON export formatting" << std::endl;
+            std::cout << "  • StartupGraph - Parallel component startup and timeline" << std::endl;
+            std::cout << "  • HeadlessPipeline - UI-free daemon config and metrics" << std::endl;
+            std::cout << "  • GameSimulator - Synthetic game memory, HUD frames and ground truth" << std::endl;
             std::cout << "  • ThreadManager - Concurrency management" << std::endl;
             std::cout << "  • PerformanceMonitor - Performance tracking" << std::endl;
             std::cout << "  • CudaSupport - GPU acceleration support" << std::endl;
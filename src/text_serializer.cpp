@@ -0,0 +1,149 @@
+#include "text_serializer.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+constexpr size_t NUMBER_BUFFER_SIZE = 64;
+constexpr size_t FIXED_BUFFER_SIZE = 512;   // %.Nf of DBL_MAX is 309 integer digits
+
+} // namespace
+
+// TextSerializer Implementation
+TextSerializer::TextSerializer(Sink outputSink, size_t batch)
+    : sink(std::move(outputSink)), batchSize(batch), failed(false) {
+    if (sink) {
+        // Rows are flushed once past batchSize, so this is enough for all but huge fields
+        buffer.reserve(batchSize + batchSize / 4);
+    }
+}
+
+TextSerializer::~TextSerializer() {
+    flush();
+}
+
+TextSerializer::Sink TextSerializer::fileSink(FILE* file) {
+    return [file](const char* data, size_t length) {
+        return file && fwrite(data, 1, length, file) == length;
+    };
+}
+
+TextSerializer& TextSerializer::text(std::string_view value) {
+    buffer.append(value.data(), value.size());
+    return *this;
+}
+
+TextSerializer& TextSerializer::character(char value) {
+    buffer.push_back(value);
+    return *this;
+}
+
+TextSerializer& TextSerializer::integer(int64_t value) {
+    char digits[NUMBER_BUFFER_SIZE];
+    buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    return *this;
+}
+
+TextSerializer& TextSerializer::unsignedInteger(uint64_t value) {
+    char digits[NUMBER_BUFFER_SIZE];
+    buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    return *this;
+}
+
+TextSerializer& TextSerializer::hex(uint64_t value) {
+    char digits[NUMBER_BUFFER_SIZE];
+    char* end = std::to_chars(digits, digits + sizeof(digits), value, 16).ptr;
+    for (char* c = digits; c != end; ++c) {
+        if (*c >= 'a') *c = static_cast<char>(*c - 'a' + 'A');
+    }
+    buffer.append(digits, end);
+    return *this;
+}
+
+TextSerializer& TextSerializer::fixed(double value, int precision) {
+    char digits[FIXED_BUFFER_SIZE];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        buffer.append(digits, result.ptr);
+    } else {
+        // Only reachable with absurd precisions; snprintf truncates instead of failing
+        int length = snprintf(digits, sizeof(digits), "%.*f", precision, value);
+        buffer.append(digits, static_cast<size_t>(std::min<int>(length, sizeof(digits) - 1)));
+    }
+    return *this;
+}
+
+TextSerializer& TextSerializer::general(double value, int precision) {
+    char digits[NUMBER_BUFFER_SIZE];
+    buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value,
+                                        std::chars_format::general, precision).ptr);
+    return *this;
+}
+
+TextSerializer& TextSerializer::shortest(double value) {
+    char digits[NUMBER_BUFFER_SIZE];
+    buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+    return *this;
+}
+
+TextSerializer& TextSerializer::csvField(std::string_view value) {
+    if (value.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return text(value);
+    }
+
+    buffer.push_back('"');
+    for (char c : value) {
+        if (c == '"') buffer.push_back('"');
+        buffer.push_back(c);
+    }
+    buffer.push_back('"');
+    return *this;
+}
+
+TextSerializer& TextSerializer::jsonString(std::string_view value) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    buffer.push_back('"');
+    size_t runStart = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        // Copy the clean run in one append, then the escape
+        buffer.append(value.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c) {
+            case '"': buffer.append("\\\""); break;
+            case '\\': buffer.append("\\\\"); break;
+            case '\n': buffer.append("\\n"); break;
+            case '\r': buffer.append("\\r"); break;
+            case '\t': buffer.append("\\t"); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 15]};
+                buffer.append(escape, sizeof(escape));
+            }
+        }
+    }
+    buffer.append(value.data() + runStart, value.size() - runStart);
+    buffer.push_back('"');
+    return *this;
+}
+
+TextSerializer& TextSerializer::jsonNumber(double value) {
+    return std::isfinite(value) ? shortest(value) : text("null");
+}
+
+TextSerializer& TextSerializer::newline() {
+    buffer.push_back('\n');
+    if (sink && buffer.size() >= batchSize) flush();
+    return *this;
+}
+
+bool TextSerializer::flush() {
+    if (!sink || buffer.empty()) return !failed;
+
+    if (!sink(buffer.data(), buffer.size())) failed = true;
+    buffer.clear();         // Keeps the capacity
+    return !failed;
+}
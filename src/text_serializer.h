@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// Shared formatting for CSV, JSON and text report exports. Numbers go through
+// std::to_chars (no locale, no stream state, no temporary strings) into one
+// buffer reserved up front, and the buffer is handed to the sink in batches
+// at row boundaries, so steady-state rows allocate nothing and a file sees a
+// few large writes instead of one per field. Without a sink the text simply
+// accumulates and str() returns it.
+class TextSerializer {
+public:
+    using Sink = std::function<bool(const char* data, size_t length)>;
+
+    static constexpr size_t DEFAULT_BATCH_SIZE = 64 * 1024;
+
+    explicit TextSerializer(Sink sink = Sink(), size_t batchSize = DEFAULT_BATCH_SIZE);
+    ~TextSerializer();          // Flushes to the sink
+
+    TextSerializer(const TextSerializer&) = delete;
+    TextSerializer& operator=(const TextSerializer&) = delete;
+
+    // Unbuffered fwrite of each batch; the caller keeps ownership of file
+    static Sink fileSink(FILE* file);
+
+    TextSerializer& text(std::string_view value);
+    TextSerializer& character(char value);
+    TextSerializer& integer(int64_t value);
+    TextSerializer& unsignedInteger(uint64_t value);
+    TextSerializer& hex(uint64_t value);                        // Uppercase digits, no prefix (like %llX)
+    TextSerializer& fixed(double value, int precision);         // Like %.Nf
+    TextSerializer& general(double value, int precision = 6);   // Like %g, and the iostream default
+    TextSerializer& shortest(double value);                     // Shortest text that round-trips
+    TextSerializer& csvField(std::string_view value);           // Quoted only if it holds , " or a newline
+    TextSerializer& jsonString(std::string_view value);         // Quoted and escaped
+    TextSerializer& jsonNumber(double value);                   // shortest(), or null if not finite
+    TextSerializer& newline();                                  // Row boundary; may hand a batch to the sink
+
+    bool flush();
+    bool good() const { return !failed; }
+
+    // Accumulated text when there is no sink
+    const std::string& str() const { return buffer; }
+    size_t size() const { return buffer.size(); }
+
+private:
+    Sink sink;
+    std::string buffer;
+    size_t batchSize;
+    bool failed;
+};
@@ -5,7 +5,8 @@
 
 // ThreadManager Implementation
 ThreadManager::ThreadManager() 
-    : defaultMaxThreads(8), maxTotalThreads(32), 
+    : mainPool(nullptr), ioPool(nullptr), computePool(nullptr), capturePool(nullptr),
+      defaultMaxThreads(8), maxTotalThreads(32), 
       taskTimeout(std::chrono::milliseconds(5000)),
       totalTasks(0), activeTasks(0), isShuttingDown(false) {
 }
@@ -17,6 +18,7 @@ ThreadManager::~ThreadManager() {
 bool ThreadManager::initialize(int maxThreads, int maxTotalThreads) {
     defaultMaxThreads = maxThreads;
     this->maxTotalThreads = maxTotalThreads;
+    isShuttingDown = false;     // A manager can be initialized again after shutdown
     
     // Create main thread pools
     createThreadPool("main", maxThreads / 2);
@@ -24,10 +26,10 @@ bool ThreadManager::initialize(int maxThreads, int maxTotalThreads) {
     createThreadPool("compute", maxThreads / 2);
     createThreadPool("capture", 1);
     
-    mainPool = std::unique_ptr<ThreadPool>(getThreadPool("main"));
-    ioPool = std::unique_ptr<ThreadPool>(getThreadPool("io"));
-    computePool = std::unique_ptr<ThreadPool>(getThreadPool("compute"));
-    capturePool = std::unique_ptr<ThreadPool>(getThreadPool("capture"));
+    mainPool = getThreadPool("main");
+    ioPool = getThreadPool("io");
+    computePool = getThreadPool("compute");
+    capturePool = getThreadPool("capture");
     
     return true;
 }
@@ -91,6 +93,11 @@ bool ThreadManager::destroyThreadPool(const std::string& name) {
         }
     }
     
+    ThreadPool* pool = it->second.get();
+    if (mainPool == pool) mainPool = nullptr;
+    if (ioPool == pool) ioPool = nullptr;
+    if (computePool == pool) computePool = nullptr;
+    if (capturePool == pool) capturePool = nullptr;
     threadPools.erase(it);
     return true;
 }
@@ -109,7 +116,7 @@ std::future<void> ThreadManager::submitTask(std::function<void()> task, TaskPrio
     
     ThreadPool* pool = getThreadPool(poolName);
     if (!pool) {
-        pool = mainPool.get();
+        pool = mainPool;
     }
     
     if (!pool) {
@@ -119,6 +126,7 @@ std::future<void> ThreadManager::submitTask(std::function<void()> task, TaskPrio
     }
     
     Task taskObj(task, priority, "Task_" + std::to_string(totalTasks++));
+    std::future<void> future = taskObj.promise.get_future();    // Before the promise is moved into the queue
     
     {
         std::lock_guard<std::mutex> lock(pool->queueMutex);
@@ -128,7 +136,7 @@ std::future<void> ThreadManager::submitTask(std::function<void()> task, TaskPrio
     pool->condition.notify_one();
     activeTasks++;
     
-    return taskObj.promise.get_future();
+    return future;
 }
 
 std::future<void> ThreadManager::submitTaskToPool(const std::string& poolName, std::function<void()> task, TaskPriority priority) {
@@ -315,6 +323,7 @@ void ThreadManager::cleanupCompletedTasks() {
     // Implementation depends on specific requirements
 }
 
+#ifdef _WIN32
 // SmartDialogManager Implementation
 
 SmartDialogManager::~SmartDialogManager() {
@@ -417,3 +426,4 @@ bool SmartDialogManager::isDialogActive(const std::string& title) const {
             return dialog && dialog->title == title;
         });
 }
+#endif
@@ -1,6 +1,8 @@
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <thread>
 #include <vector>
 #include <queue>
@@ -12,7 +14,9 @@
 #include <future>
 #include <chrono>
 #include <map>
+#ifdef _WIN32
 #include "ui_framework.h"
+#endif
 
 // Advanced Thread Manager with Thread Pools
 class ThreadManager {
@@ -68,11 +72,11 @@ private:
     // Thread pools
     std::map<std::string, std::unique_ptr<ThreadPool>> threadPools;
     
-    // Main thread pool
-    std::unique_ptr<ThreadPool> mainPool;
-    std::unique_ptr<ThreadPool> ioPool;
-    std::unique_ptr<ThreadPool> computePool;
-    std::unique_ptr<ThreadPool> capturePool;
+    // Main thread pools; non-owning, threadPools owns them
+    ThreadPool* mainPool;
+    ThreadPool* ioPool;
+    ThreadPool* computePool;
+    ThreadPool* capturePool;
     
     // Task management
     std::atomic<int> totalTasks;
@@ -150,7 +154,8 @@ private:
     void cleanupCompletedTasks();
 };
 
-// Smart Pointer-based Dialog Manager
+#ifdef _WIN32
+// Smart Pointer-based Dialog Manager (Win32 UI only)
 class SmartDialogManager {
 public:
     SmartDialogManager() = default;
@@ -205,6 +210,7 @@ private:
     void cleanupDialogs();
     bool isDialogActive(const std::string& title) const;
 };
+#endif
 
 // RAII-based Resource Manager
 template<typename T>
@@ -251,6 +257,7 @@ public:
     }
 };
 
+#ifdef _WIN32
 // Memory-safe Dialog Wrapper
 class SafeDialog {
 private:
@@ -308,3 +315,4 @@ public:
         return *this;
     }
 };
+#endif
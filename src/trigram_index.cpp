@@ -0,0 +1,275 @@
+#include "trigram_index.h"
+#include <algorithm>
+#include <cctype>
+#include <map>
+
+namespace {
+
+bool isNumber(const std::string& token) {
+    return !token.empty() && std::all_of(token.begin(), token.end(), [](char c) {
+        return std::isdigit(static_cast<unsigned char>(c)) != 0;
+    });
+}
+
+// "v2", "v1.0.3", "1.2.3" - but not plain numbers such as "2077" or "2"
+bool isVersion(const std::string& token) {
+    size_t begin = token[0] == 'v' ? 1 : 0;
+    if (begin >= token.size() || !std::isdigit(static_cast<unsigned char>(token[begin]))) return false;
+
+    bool dotted = false;
+    for (size_t i = begin; i < token.size(); ++i) {
+        if (token[i] == '.') {
+            dotted = true;
+        } else if (!std::isdigit(static_cast<unsigned char>(token[i]))) {
+            return false;
+        }
+    }
+    return begin == 1 || dotted;
+}
+
+// Tokens that only ever label an adjacent number ("60 fps", "fps: 144", "build 9120", "direct3d 11")
+bool isCounterLabel(const std::string& token) {
+    return token == "fps" || token == "build" || token == "direct3d" || token == "directx";
+}
+
+// Renderer tags some engines append to the title: "dx12", "d3d11", "vulkan"
+bool isRendererTag(const std::string& token) {
+    if (token == "vulkan" || token == "opengl") return true;
+    size_t prefix = token.compare(0, 2, "dx") == 0 ? 2 : token.compare(0, 3, "d3d") == 0 ? 3 : 0;
+    return prefix > 0 && isNumber(token.substr(prefix));
+}
+
+// "60fps", "144fps"
+bool isInlineCounter(const std::string& token) {
+    return token.size() > 3 && token.compare(token.size() - 3, 3, "fps") == 0 &&
+           isNumber(token.substr(0, token.size() - 3));
+}
+
+// Sequel numbers are spelled every way: "2", "ii", "two"
+int numeralValue(const std::string& word, bool firstWord) {
+    static const std::map<std::string, int> values = [] {
+        std::map<std::string, int> table;
+        const char* ones[] = {"", "i", "ii", "iii", "iv", "v", "vi", "vii", "viii", "ix"};
+        const char* tens[] = {"", "x", "xx", "xxx"};
+        for (int n = 1; n < 40; ++n) table[std::string(tens[n / 10]) + ones[n % 10]] = n;
+        const char* words[] = {"one", "two", "three", "four", "five", "six", "seven", "eight", "nine", "ten",
+                               "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen",
+                               "seventeen", "eighteen", "nineteen", "twenty"};
+        for (int n = 1; n <= 20; ++n) table[words[n - 1]] = n;
+        return table;
+    }();
+    // A title opening with "I" ("I Am Bread") is a pronoun, not a numeral
+    if (firstWord && word == "i") return 0;
+    auto it = values.find(word);
+    return it != values.end() ? it->second : 0;
+}
+
+} // namespace
+
+// TrigramIndex Implementation
+std::string TrigramIndex::normalize(const std::string& text) {
+    std::string lowered;
+    lowered.reserve(text.size());
+    for (char c : text) {
+        lowered += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    // Trailing ".exe" so process names and window titles share one form
+    size_t last = lowered.find_last_not_of(" \t");
+    if (last != std::string::npos && last >= 3 && lowered.compare(last - 3, 4, ".exe") == 0) {
+        lowered.erase(last - 3);
+    }
+
+    // Bracketed annotations: "(DX12)", "[Beta]", "{debug}"
+    std::string unbracketed;
+    unbracketed.reserve(lowered.size());
+    int depth = 0;
+    for (char c : lowered) {
+        if (c == '(' || c == '[' || c == '{') {
+            depth++;
+        } else if ((c == ')' || c == ']' || c == '}') && depth > 0) {
+            depth--;
+            unbracketed += ' ';
+        } else if (depth == 0) {
+            unbracketed += c;
+        }
+    }
+
+    // Tokens keep '.' so version strings survive until classified; apostrophes are dropped
+    std::vector<std::string> tokens;
+    std::string token;
+    for (char c : unbracketed) {
+        if (std::isalnum(static_cast<unsigned char>(c)) || c == '.') {
+            token += c;
+        } else if (c != '\'') {
+            if (!token.empty()) tokens.push_back(token);
+            token.clear();
+        }
+    }
+    if (!token.empty()) tokens.push_back(token);
+
+    for (auto& raw : tokens) {
+        size_t first = raw.find_first_not_of('.');
+        raw = first == std::string::npos ? std::string()
+                                         : raw.substr(first, raw.find_last_not_of('.') - first + 1);
+    }
+
+    std::vector<std::string> words;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const std::string& word = tokens[i];
+        if (word.empty() || isVersion(word) || isInlineCounter(word) || isRendererTag(word)) continue;
+
+        // A label takes the number after it ("fps: 60"), else the one before it ("60 fps")
+        if (isCounterLabel(word)) {
+            if (i + 1 < tokens.size() && isNumber(tokens[i + 1])) {
+                ++i;
+            } else if (!words.empty() && isNumber(words.back())) {
+                words.pop_back();
+            }
+            continue;
+        }
+
+        // Remaining dots separate words ("mr.robot" -> "mr robot")
+        size_t start = 0;
+        while (start < word.size()) {
+            size_t dot = word.find('.', start);
+            if (dot == std::string::npos) dot = word.size();
+            if (dot > start) words.push_back(word.substr(start, dot - start));
+            start = dot + 1;
+        }
+    }
+
+    std::string normalized;
+    for (const auto& word : words) {
+        if (!normalized.empty()) normalized += ' ';
+        normalized += word;
+    }
+    return normalized;
+}
+
+std::vector<uint32_t> TrigramIndex::extractTrigrams(const std::string& normalized) {
+    std::vector<uint32_t> trigrams;
+    if (normalized.empty()) return trigrams;
+
+    // Padding makes word starts and ends their own trigrams, so short names still index
+    std::string padded = " " + normalized + " ";
+    trigrams.reserve(padded.size() - 2);
+    for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+        trigrams.push_back(static_cast<uint32_t>(static_cast<unsigned char>(padded[i])) << 16 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8 |
+                           static_cast<uint32_t>(static_cast<unsigned char>(padded[i + 2])));
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+std::string TrigramIndex::numeralKey(const std::string& normalized) {
+    std::vector<long long> numerals;
+    size_t start = 0;
+    while (start < normalized.size()) {
+        size_t end = normalized.find(' ', start);
+        if (end == std::string::npos) end = normalized.size();
+        std::string word = normalized.substr(start, end - start);
+
+        // Digit runs count inside words too, so "cyberpunk2077" agrees with "cyberpunk 2077"
+        bool hasDigit = false;
+        for (size_t i = 0; i < word.size();) {
+            if (!std::isdigit(static_cast<unsigned char>(word[i]))) {
+                ++i;
+                continue;
+            }
+            size_t digits = i;
+            while (i < word.size() && std::isdigit(static_cast<unsigned char>(word[i]))) ++i;
+            numerals.push_back(std::stoll(word.substr(digits, std::min<size_t>(i - digits, 18))));
+            hasDigit = true;
+        }
+        if (!hasDigit) {
+            int value = numeralValue(word, start == 0);
+            if (value > 0) numerals.push_back(value);
+        }
+        start = end + 1;
+    }
+
+    std::sort(numerals.begin(), numerals.end());
+    std::string key;
+    for (long long numeral : numerals) {
+        if (!key.empty()) key += ',';
+        key += std::to_string(numeral);
+    }
+    return key;
+}
+
+size_t TrigramIndex::add(const std::string& text) {
+    uint32_t id = static_cast<uint32_t>(trigramCounts.size());
+    std::string normalized = normalize(text);
+    std::vector<uint32_t> trigrams = extractTrigrams(normalized);
+
+    for (uint32_t trigram : trigrams) {
+        postings[trigram].push_back(id);
+    }
+    trigramCounts.push_back(static_cast<uint32_t>(trigrams.size()));
+    numeralKeys.push_back(numeralKey(normalized));
+    return id;
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+    trigramCounts.clear();
+    numeralKeys.clear();
+}
+
+std::vector<TrigramIndex::Candidate> TrigramIndex::search(const std::string& query, size_t maxResults,
+                                                          float minScore) const {
+    std::vector<Candidate> results;
+    std::string normalized = normalize(query);
+    std::vector<uint32_t> queryTrigrams = extractTrigrams(normalized);
+    if (queryTrigrams.empty() || maxResults == 0) return results;
+    std::string queryNumerals = numeralKey(normalized);
+
+    // Count shared trigrams per entry, remembering which entries were touched. The counts
+    // are per-thread scratch, kept zeroed between queries by resetting only touched entries
+    thread_local std::vector<uint32_t> shared;
+    if (shared.size() < trigramCounts.size()) shared.resize(trigramCounts.size(), 0);
+    std::vector<uint32_t> touched;
+    for (uint32_t trigram : queryTrigrams) {
+        auto it = postings.find(trigram);
+        if (it == postings.end()) continue;
+        for (uint32_t id : it->second) {
+            if (shared[id]++ == 0) touched.push_back(id);
+        }
+    }
+
+    // Mean of Dice (overall similarity) and overlap coefficient (one name contained in
+    // the other), so "elden ring" still scores high against "elden ring - direct3d 12"
+    float queryCount = static_cast<float>(queryTrigrams.size());
+    for (uint32_t id : touched) {
+        float common = static_cast<float>(shared[id]);
+        shared[id] = 0;
+        if (numeralKeys[id] != queryNumerals) continue;
+        float entryCount = static_cast<float>(trigramCounts[id]);
+        float dice = 2.0f * common / (queryCount + entryCount);
+        float overlap = common / std::min(queryCount, entryCount);
+        float score = 0.5f * (dice + overlap);
+        if (score >= minScore) {
+            results.emplace_back(id, score);
+        }
+    }
+
+    auto better = [](const Candidate& a, const Candidate& b) {
+        return a.score != b.score ? a.score > b.score : a.id < b.id;
+    };
+    if (results.size() > maxResults) {
+        std::partial_sort(results.begin(), results.begin() + maxResults, results.end(), better);
+        results.resize(maxResults);
+    } else {
+        std::sort(results.begin(), results.end(), better);
+    }
+    return results;
+}
+
+TrigramIndex::Candidate TrigramIndex::bestMatch(const std::string& query, float minScore) const {
+    std::vector<Candidate> results = search(query, 1, minScore);
+    return results.empty() ? Candidate() : results.front();
+}
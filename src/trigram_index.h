@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Inverted index from character trigrams to entries, for fuzzy name lookup.
+// Text is normalised first (lowercase; .exe, version, FPS, renderer and bracket noise removed),
+// then split into space-padded trigrams. A query only touches the posting lists
+// of its own trigrams, so only entries sharing at least one trigram are scored.
+// Numerals must agree exactly ("diablo ii" is not "diablo iv", "half life 2" is not
+// "half life 2 episode two"); trigrams alone score such sequels as near matches.
+class TrigramIndex {
+public:
+    struct Candidate {
+        size_t id;          // Insertion order of the matched entry
+        float score;        // 0..1, 1 = identical after normalisation
+
+        Candidate() : id(0), score(0.0f) {}
+        Candidate(size_t i, float s) : id(i), score(s) {}
+    };
+
+    // Canonical form used for both indexing and queries
+    static std::string normalize(const std::string& text);
+
+    // Returns the entry id (ids are dense and assigned in insertion order)
+    size_t add(const std::string& text);
+    void clear();
+
+    // Best candidates scoring at least minScore, highest score first. Thread-safe
+    std::vector<Candidate> search(const std::string& query, size_t maxResults = 5,
+                                  float minScore = 0.3f) const;
+
+    // Top candidate, or score 0 when nothing reaches minScore
+    Candidate bestMatch(const std::string& query, float minScore = 0.3f) const;
+
+    size_t size() const { return trigramCounts.size(); }
+    size_t getTrigramCount() const { return postings.size(); }
+
+private:
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings;   // Trigram -> entry ids
+    std::vector<uint32_t> trigramCounts;                            // Distinct trigrams per entry
+    std::vector<std::string> numeralKeys;                           // Per entry, see numeralKey
+
+    static std::vector<uint32_t> extractTrigrams(const std::string& normalized);
+    // Sorted values of the digit runs, roman numerals and number words, e.g. "2,4"
+    static std::string numeralKey(const std::string& normalized);
+};
@@ -5,7 +5,28 @@
 #include "thread_manager.h"
 #include "performance_monitor.h"
 #include "cuda_support.h"
+#include "forecasting_models.h"
+#include "anomaly_detector.h"
+#include "stats_kernels.h"
+#include "ring_buffer.h"
+#include "signal_rules.h"
+#include "trigram_index.h"
+#include "visual_fingerprint.h"
+#include "file_hasher.h"
+#include "profile_database.h"
+#include "profile_watcher.h"
+#include "rcu_pointer.h"
+#include "session_exporter.h"
+#include "text_serializer.h"
+#include "startup_graph.h"
+#include "headless_pipeline.h"
+#include "game_simulator.h"
+#include "static_hud_mask.h"
+#include "frame_deduplicator.h"
+#include "highlight_recorder.h"
 #include <opencv2/opencv.hpp>
+#include <filesystem>
+#include <set>
 
 namespace BloombergTerminalTests {
 
@@ -52,6 +73,183 @@ void registerOCRTests() {
         
         return TestResult("PerformanceValidation", "AdvancedOCR", true, "OCR performance validation completed");
     });
+    
+    registerTest("AdvancedOCR", "FieldTypedEngines", []() -> TestResult {
+        using FieldType = AdvancedOCR::FieldType;
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("health") == FieldType::DIGITS);
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("Score") == FieldType::DIGITS);
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("ammo") == FieldType::RATIO);
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("round_time") == FieldType::TIME);
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("level") == FieldType::LABEL);
+        ASSERT_TRUE(AdvancedOCR::fieldTypeForName("unknown") == FieldType::GENERAL);
+        
+        // Where traineddata is installed, each engine reads its own shape of field
+        AdvancedOCR ocr;
+        if (ocr.initialize()) {
+            const std::pair<const char*, FieldType> fields[] = {
+                {"1250", FieldType::DIGITS}, {"02:45", FieldType::TIME}, {"30/120", FieldType::RATIO}
+            };
+            for (const auto& field : fields) {
+                cv::Mat image = cv::Mat::zeros(40, 160, CV_8UC3);
+                cv::putText(image, field.first, cv::Point(8, 30), cv::FONT_HERSHEY_SIMPLEX, 0.9, cv::Scalar(255, 255, 255), 2);
+                auto result = ocr.recognizeField(image, field.second);
+                ASSERT_TRUE(result.text == field.first);
+            }
+        }
+        
+        return TestResult("FieldTypedEngines", "AdvancedOCR", true, "HUD fields map to their own engines");
+    });
+    
+    registerTest("AdvancedOCR", "SimulatedHudFields", []() -> TestResult {
+        // End to end: the simulator's profile applied, frames through detectText, each HUD
+        // region answered by the engine for its field type
+        AdvancedOCR ocr;
+        if (ocr.initialize()) {
+            SimulatorConfig config;
+            config.screenShake = false;
+            config.colorFlashes = false;
+            GameSimulator simulator(config);
+            ocr.enableCaching(false);
+            ocr.enableIncrementalHud(false);
+            ocr.applyProfile(simulator.buildProfile());
+            
+            GameSimulator::FrameTruth truth;
+            cv::Mat frame;
+            int fields = 0, correct = 0;
+            for (int i = 0; i < 30; ++i) {
+                simulator.step(&frame, &truth);
+                std::map<std::string, std::string> read;
+                for (const auto& region : ocr.detectText(frame)) read[region.detectedType] += region.text;
+                for (const auto& field : truth.hudFields) {
+                    std::string text = read[field.name], expected = field.text;
+                    text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+                    expected.erase(std::remove(expected.begin(), expected.end(), ' '), expected.end());
+                    ++fields;
+                    correct += text == expected;
+                }
+            }
+            
+            ASSERT_TRUE(ocr.getHudFieldReads() > 0);
+            ASSERT_TRUE(correct * 5 >= fields * 4);
+        }
+        
+        return TestResult("SimulatedHudFields", "AdvancedOCR", true, "Simulator HUD read through the field engines");
+    });
+    
+    registerTest("AdvancedOCR", "CrnnGreedyDecode", []() -> TestResult {
+        // Classes: blank, '0', '1', '/', 'a'; one row of scores per step
+        const std::vector<std::string> vocabulary = {"0", "1", "/", "a"};
+        const float scores[6][5] = {
+            {0, 0, 5, 0, 0}, {0, 0, 5, 0, 0}, {5, 0, 0, 0, 0},     // "1" repeated, then a blank
+            {0, 0, 5, 0, 0}, {0, 0, 0, 5, 0}, {0, 3, 0, 0, 6}      // "1" again, "/", then 'a' over '0'
+        };
+        auto result = CrnnRecognizer::decodeGreedy(&scores[0][0], 6, 5, 5, vocabulary);
+        ASSERT_TRUE(result.text == "11/a");
+        ASSERT_TRUE(result.confidence > 0.9f);
+        
+        // A digits-only field can never produce 'a'; the runner-up is taken, less confidently
+        const std::vector<uint8_t> digitsAndSlash = {1, 1, 1, 1, 0};
+        auto masked = CrnnRecognizer::decodeGreedy(&scores[0][0], 6, 5, 5, vocabulary, digitsAndSlash);
+        ASSERT_TRUE(masked.text == "11/0");
+        ASSERT_TRUE(masked.confidence < result.confidence);
+        
+        return TestResult("CrnnGreedyDecode", "AdvancedOCR", true, "CTC output decoded with per-field characters");
+    });
+    
+    registerTest("AdvancedOCR", "CrnnHudBatch", []() -> TestResult {
+        // Where the CRNN model is installed, detectText reads every HUD region of a frame in
+        // one batch, and batching does not change what a box reads on its own
+        AdvancedOCR ocr;
+        if (ocr.initialize(AdvancedOCR::OCRBackend::CRNN)) {
+            SimulatorConfig config;
+            config.screenShake = false;
+            config.colorFlashes = false;
+            GameSimulator simulator(config);
+            ProfileDefinition profile = simulator.buildProfile();
+            ocr.enableCaching(false);
+            ocr.enableIncrementalHud(false);
+            ocr.applyProfile(profile);
+            
+            std::vector<cv::Rect> boxes;
+            std::vector<AdvancedOCR::FieldType> types;
+            for (const auto& region : profile.hudRegions) {
+                boxes.emplace_back(cvRound(region.x * config.width), cvRound(region.y * config.height),
+                                   cvRound(region.width * config.width), cvRound(region.height * config.height));
+                types.push_back(AdvancedOCR::fieldTypeForName(region.name));
+            }
+            
+            cv::Mat frame;
+            const int frames = 10;
+            int fields = 0, mismatches = 0;
+            for (int i = 0; i < frames; ++i) {
+                simulator.step(&frame);
+                auto batch = ocr.recognizeFields(frame, boxes, types);
+                std::map<std::string, std::string> live;
+                for (const auto& region : ocr.detectText(frame)) live[region.detectedType] += region.text;
+                for (size_t f = 0; f < boxes.size(); ++f) {
+                    auto single = ocr.recognizeFields(frame, {boxes[f]}, {types[f]});
+                    const std::string& name = profile.hudRegions[f].name;
+                    ++fields;
+                    mismatches += single[0].text != batch[f].text;
+                    mismatches += !live[name].empty() && live[name] != batch[f].text;
+                }
+            }
+            
+            ASSERT_TRUE(boxes.size() > 1);
+            ASSERT_EQUALS(frames * static_cast<int>(boxes.size()), static_cast<int>(ocr.getHudRegionsRead()));
+            ASSERT_TRUE(ocr.getHudFieldReads() > 0);
+            ASSERT_TRUE(mismatches * 20 <= fields);
+        }
+        
+        return TestResult("CrnnHudBatch", "AdvancedOCR", true, "HUD regions read by CRNN in one batch per frame");
+    });
+    
+    registerTest("AdvancedOCR", "IncrementalHudReads", []() -> TestResult {
+        // Two readers of the same simulated HUD through detectText, one reusing regions
+        // whose HUD pixels have not changed; where traineddata is installed the reuse
+        // must save reads without costing correct ones
+        AdvancedOCR incremental, full;
+        if (incremental.initialize() && full.initialize()) {
+            SimulatorConfig config;
+            config.screenShake = false;
+            config.colorFlashes = false;
+            GameSimulator simulator(config);
+            ProfileDefinition profile = simulator.buildProfile();
+            for (AdvancedOCR* ocr : {&incremental, &full}) {
+                ocr->enableCaching(false);
+                ocr->applyProfile(profile);
+            }
+            full.enableIncrementalHud(false);
+            
+            auto normalize = [](std::string text) {
+                text.erase(std::remove_if(text.begin(), text.end(), [](unsigned char c) { return std::isspace(c); }), text.end());
+                std::transform(text.begin(), text.end(), text.begin(), ::toupper);
+                return text;
+            };
+            GameSimulator::FrameTruth truth;
+            cv::Mat frame;
+            int incrementalCorrect = 0, fullCorrect = 0;
+            for (int i = 0; i < 120; ++i) {
+                simulator.step(&frame, &truth);
+                std::map<std::string, std::string> incrementalText, fullText;
+                for (const auto& region : incremental.detectText(frame)) incrementalText[region.detectedType] += region.text;
+                for (const auto& region : full.detectText(frame)) fullText[region.detectedType] += region.text;
+                for (const auto& field : truth.hudFields) {
+                    std::string expected = normalize(field.text);
+                    incrementalCorrect += normalize(incrementalText[field.name]) == expected;
+                    fullCorrect += normalize(fullText[field.name]) == expected;
+                }
+            }
+            
+            ASSERT_TRUE(incremental.getHudRegionsReused() > 0);
+            ASSERT_TRUE(incremental.getHudRegionsRead() < full.getHudRegionsRead());
+            ASSERT_EQUALS(0, static_cast<int>(full.getHudRegionsReused()));
+            ASSERT_TRUE(fullCorrect > 0);
+            ASSERT_TRUE(incrementalCorrect * 10 >= fullCorrect * 9);
+        }
+        
+        return TestResult("IncrementalHudReads", "AdvancedOCR", true, "Unchanged HUD regions reused by detectText");
+    });
 }
 
 // Screen Capture Tests as specified in prompt.md
@@ -119,6 +317,58 @@ void registerScreenCaptureTests() {
         
         return TestResult("PerformanceTargets", "OptimizedScreenCapture", true, "Performance targets validation completed");
     });
+    
+    registerTest("OptimizedScreenCapture", "StaticHudMask", []() -> TestResult {
+        // The simulator pans its world under a fixed HUD; the banner comes and goes, so it is left out
+        SimulatorConfig config;
+        config.screenShake = false;
+        config.colorFlashes = false;
+        GameSimulator simulator(config);
+        std::map<std::string, cv::Rect> boxes;
+        for (const auto& region : simulator.getHudRegions()) {
+            boxes[region.name] = cv::Rect(cvRound(region.x * config.width), cvRound(region.y * config.height),
+                                          cvRound(region.width * config.width), cvRound(region.height * config.height));
+        }
+        
+        StaticHudMask mask;
+        GameSimulator::FrameTruth truth;
+        std::map<std::string, std::string> lastText;
+        cv::Mat frame, previous, diff;
+        int changes = 0, missed = 0, dirty = 0, naive = 0;
+        for (int i = 0; i < 600; ++i) {
+            simulator.step(&frame, &truth);
+            mask.update(frame);
+            for (const auto& field : truth.hudFields) {
+                if (field.name == "banner") continue;
+                const cv::Rect& box = boxes[field.name];
+                if (mask.isReady()) {
+                    bool changed = lastText[field.name] != field.text;
+                    bool flagged = mask.hudChanged(box);
+                    changes += changed;
+                    missed += changed && !flagged;
+                    dirty += flagged;
+                    
+                    // Without the mask, any changed pixel in the box would mean reading it again
+                    cv::absdiff(frame(box), previous(box), diff);
+                    cv::cvtColor(diff, diff, cv::COLOR_BGR2GRAY);
+                    naive += cv::countNonZero(diff > 12) > 0;
+                }
+                lastText[field.name] = field.text;
+            }
+            previous = frame.clone();
+        }
+        
+        ASSERT_TRUE(mask.isReady());
+        ASSERT_TRUE(mask.isWorldMoving());
+        ASSERT_TRUE(changes > 0);
+        ASSERT_TRUE(missed * 10 <= changes);    // AdvancedOCR's periodic re-read covers the rest
+        ASSERT_TRUE(dirty < naive);
+        ASSERT_TRUE(mask.hudCoverage(boxes["health"]) > 0.0f);
+        
+        return TestResult("StaticHudMask", "OptimizedScreenCapture", true,
+                          "HUD changes found under a panning world: " + std::to_string(dirty) + " dirty boxes vs " +
+                          std::to_string(naive) + " by pixel difference");
+    });
 }
 
 // Game Analytics Tests as specified in prompt.md
@@ -159,6 +409,1264 @@ void registerGameAnalyticsTests() {
         
         return TestResult("PerformanceValidation", "GameAnalytics", true, "Game analytics performance validation completed");
     });
+    
+    registerTest("GameAnalytics", "EventFusion", []() -> TestResult {
+        using EventType = GameEventDetector::EventType;
+        using CueSource = GameEventDetector::CueSource;
+        ASSERT_TRUE(GameEventDetector::priorLogOdds(EventType::DEATH) < 0.0f);
+        ASSERT_TRUE(GameEventDetector::cueLogOdds(EventType::DEATH, CueSource::HEALTH_ZERO) >
+                    GameEventDetector::cueLogOdds(EventType::DEATH, CueSource::HEALTH_DROP));
+        ASSERT_EQUALS(0.0f, GameEventDetector::cueLogOdds(EventType::LEVEL_UP, CueSource::RED_FLASH));
+        
+        auto countType = [](const std::vector<GameEventDetector::GameEvent>& events, EventType type) {
+            return static_cast<int>(std::count_if(events.begin(), events.end(),
+                [type](const GameEventDetector::GameEvent& event) { return event.type == type; }));
+        };
+        cv::Mat redFrame(240, 320, CV_8UC3, cv::Scalar(0, 0, 255));
+        cv::Mat darkFrame(240, 320, CV_8UC3, cv::Scalar(40, 40, 40));
+        
+        // A flash held over several frames is one death, scored from the flash alone
+        GameEventDetector detector;
+        detector.initialize();
+        detector.setFusionWindowMs(100);
+        std::vector<GameEventDetector::GameEvent> reported;
+        float flashOnly = 0.0f;
+        for (int i = 0; i < 5; ++i) {
+            for (const auto& event : detector.detectEvents(redFrame)) {
+                if (event.type == EventType::DEATH) flashOnly = event.confidence;
+                reported.push_back(event);
+            }
+        }
+        ASSERT_EQUALS(1, countType(reported, EventType::DEATH));
+        ASSERT_TRUE(flashOnly > 0.5f && flashOnly < 0.9f);
+        
+        // Once its cues lapse, the next flash is a new death
+        detector.detectEvents(darkFrame);
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        detector.detectEvents(darkFrame);
+        ASSERT_EQUALS(1, countType(detector.detectEvents(redFrame), EventType::DEATH));
+        
+        // Memory and OCR alone: the health drop is damage but not enough for a death
+        GameEventDetector fused;
+        fused.initialize();
+        fused.observeMemoryValue("Player Health", 80);
+        fused.observeMemoryValue("Player Health", 35);
+        fused.observeMemoryValue("Ammo", 10);
+        fused.observeMemoryValue("Ammo", 5);                    // Not health: no cue
+        ASSERT_EQUALS(-1, fused.registerMemoryValue("Ammo"));
+        ASSERT_EQUALS(fused.registerMemoryValue("Player Health"), fused.registerMemoryValue("Player Health"));
+        std::vector<GameEventDetector::GameEvent> events = fused.detectEvents(darkFrame);
+        ASSERT_EQUALS(0, countType(events, EventType::DEATH));
+        ASSERT_EQUALS(1, countType(events, EventType::DAMAGE_TAKEN));
+        
+        // Flash + health drop + death text: one death, more certain than the flash alone
+        fused.observeText("YOU DIED");
+        events = fused.detectEvents(redFrame);
+        ASSERT_EQUALS(1, countType(events, EventType::DEATH));
+        const auto& death = *std::find_if(events.begin(), events.end(),
+            [](const GameEventDetector::GameEvent& event) { return event.type == EventType::DEATH; });
+        ASSERT_TRUE(death.confidence > 0.99f && death.confidence > flashOnly);
+        ASSERT_EQUALS(3, static_cast<int>(death.parameters.size()));
+        ASSERT_TRUE(death.parameters.count("red_flash") && death.parameters.count("health_drop") &&
+                    death.parameters.count("ocr_text"));
+        ASSERT_EQUALS(0, countType(events, EventType::DAMAGE_TAKEN));   // Already reported
+        
+        return TestResult("EventFusion", "GameAnalytics", true, "Coincident cues fused into one scored event");
+    });
+    
+    registerTest("GameAnalytics", "TextCueEdges", []() -> TestResult {
+        using EventType = GameEventDetector::EventType;
+        int kills = 0;
+        auto countKills = [&kills](const std::vector<GameEventDetector::GameEvent>& events) {
+            for (const auto& event : events) {
+                if (event.type == EventType::KILL) ++kills;
+            }
+        };
+        cv::Mat darkFrame(240, 320, CV_8UC3, cv::Scalar(40, 40, 40));
+        GameEventDetector detector;
+        detector.initialize();
+        detector.setFusionWindowMs(200);
+        
+        // A kill counter on the HUD is not a kill banner
+        for (int i = 0; i < 3; ++i) {
+            detector.observeText("KILLS: 3");
+            detector.observeText("Skill points");
+            detector.observeText("KILLSTREAK 2");
+            countKills(detector.detectEvents(darkFrame));
+        }
+        ASSERT_EQUALS(0, kills);
+        
+        // A banner held past the fusion window is one kill, and does not keep the latch set
+        for (int i = 0; i < 6; ++i) {
+            detector.observeText("KILLS: 3");
+            detector.observeText("DOUBLE KILL");
+            countKills(detector.detectEvents(darkFrame));
+            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        }
+        ASSERT_EQUALS(1, kills);
+        
+        detector.observeText("KILLS: 4");
+        detector.observeText("DOUBLE KILL");
+        detector.observeText("ELIMINATED");
+        countKills(detector.detectEvents(darkFrame));
+        ASSERT_EQUALS(2, kills);
+        
+        return TestResult("TextCueEdges", "GameAnalytics", true, "Text cues match whole words and re-arm when they appear");
+    });
+}
+
+// Forecasting Model Tests
+void registerForecastingTests() {
+    registerTest("ForecastingModels", "HoltWintersSeasonalTrend", []() -> TestResult {
+        HoltWintersModel model(0.5, 0.2, 0.3, 4);
+        const double season[4] = {5.0, -2.0, 3.0, -6.0};
+        
+        for (int t = 0; t < 200; ++t) {
+            model.update(100.0 + 0.5 * t + season[t % 4]);
+        }
+        
+        double expected = 100.0 + 0.5 * 200 + season[200 % 4];
+        ASSERT_TRUE(model.isReady());
+        ASSERT_NEAR(model.predict(1), expected, 1.0);
+        ASSERT_LT(model.getErrorStats().meanAbsoluteError, 1.0);
+        
+        return TestResult("HoltWintersSeasonalTrend", "ForecastingModels", true, "Holt-Winters tracks level, trend and season");
+    });
+    
+    registerTest("ForecastingModels", "AutoregressiveRLS", []() -> TestResult {
+        OnlineARModel model(2, 1.0);
+        double previous = 10.0, current = 12.0;
+        unsigned int seed = 12345u;
+        
+        // x(t) = 2 + 0.6 x(t-1) + 0.2 x(t-2) + uniform noise in [-0.5, 0.5)
+        for (int t = 0; t < 300; ++t) {
+            seed = seed * 1103515245u + 12345u;
+            double noise = ((seed >> 16) % 1000) / 1000.0 - 0.5;
+            double next = 2.0 + 0.6 * current + 0.2 * previous + noise;
+            model.update(next);
+            previous = current;
+            current = next;
+        }
+        
+        ASSERT_TRUE(model.isReady());
+        ASSERT_NEAR(model.getCoefficients()[1], 0.6, 0.15);
+        ASSERT_NEAR(model.predict(1), 2.0 + 0.6 * current + 0.2 * previous, 0.25);
+        
+        PredictionTracker tracker(4);
+        for (int i = 0; i < 10; ++i) {
+            tracker.record(i, i + 1.0);
+        }
+        ASSERT_EQUALS(4, static_cast<int>(tracker.size()));
+        ASSERT_NEAR(tracker.meanAbsoluteError(), 1.0, 1e-9);
+        
+        return TestResult("AutoregressiveRLS", "ForecastingModels", true, "Online AR model converges and tracker stays bounded");
+    });
+}
+
+void registerAnomalyDetectionTests() {
+    registerTest("AnomalyDetection", "SpikeAndShift", []() -> TestResult {
+        AnomalyMonitor monitor;
+        unsigned int seed = 1u;
+        
+        // Noisy flat series with a one-sample glitch at 150 and a level shift at 250
+        for (int t = 0; t < 400; ++t) {
+            seed = seed * 1103515245u + 12345u;
+            double value = 50.0 + ((seed >> 16) % 1000) / 1000.0 - 0.5;
+            if (t == 150) value = 80.0;
+            if (t >= 250) value += 3.0;
+            monitor.observe("health", value, t);
+        }
+        
+        bool spikeFlagged = false, shiftFlagged = false;
+        for (const auto& event : monitor.drainEvents()) {
+            if (event.timestamp == 150 && event.detector == AnomalyEvent::Detector::ROBUST_ZSCORE) spikeFlagged = true;
+            if (event.timestamp >= 250 && event.timestamp < 260 &&
+                event.detector == AnomalyEvent::Detector::CUSUM && event.upward) shiftFlagged = true;
+        }
+        ASSERT_TRUE(spikeFlagged);
+        ASSERT_TRUE(shiftFlagged);
+        ASSERT_TRUE(monitor.drainEvents().empty());
+        
+        return TestResult("SpikeAndShift", "AnomalyDetection", true, "Glitch and level shift detected");
+    });
+    
+    registerTest("AnomalyDetection", "FlatSeriesQuiet", []() -> TestResult {
+        AnomalyMonitor monitor(4);
+        for (int t = 0; t < 200; ++t) {
+            monitor.observe("ammo", 30.0, t);
+        }
+        ASSERT_EQUALS(0, static_cast<int>(monitor.getTotalAnomalies()));
+        
+        return TestResult("FlatSeriesQuiet", "AnomalyDetection", true, "No false alarms on a constant series");
+    });
+}
+
+void registerStatsKernelTests() {
+    registerTest("StatsKernels", "CompensatedAccuracy", []() -> TestResult {
+        // Naive double summation loses every one of the unit terms here
+        std::vector<double> data;
+        data.push_back(1e16);
+        data.insert(data.end(), 1001, 1.0);
+        data.push_back(-1e16);
+        ASSERT_NEAR(StatsKernels::sum(data), 1001.0, 1e-9);
+        
+        std::vector<float> offset(999, 1e6f);
+        offset.push_back(1e6f + 64.0f);
+        ASSERT_NEAR(StatsKernels::variance(offset, false), 64.0 * 64.0 * 999.0 / 1e6, 1e-6);
+        
+        return TestResult("CompensatedAccuracy", "StatsKernels", true, "Compensated sums stay exact");
+    });
+    
+    registerTest("StatsKernels", "MatchesReference", []() -> TestResult {
+        std::vector<double> x, y;
+        for (int i = 0; i < 103; ++i) {
+            x.push_back(i);
+            y.push_back(4.0 - 0.5 * i + ((i * 7) % 5) * 0.1);
+        }
+        
+        StatsKernels::LinearTrend trend = StatsKernels::linearTrend(y);
+        StatsKernels::LinearTrend fit = StatsKernels::linearFit(x, y);
+        ASSERT_NEAR(trend.slope, fit.slope, 1e-12);
+        ASSERT_NEAR(trend.intercept, fit.intercept, 1e-9);
+        ASSERT_NEAR(trend.slope, -0.5, 0.01);
+        ASSERT_LT(StatsKernels::correlation(x, y), -0.99);
+        
+        // EMA chains across split views exactly like the scalar recurrence
+        double expected = 2.0;
+        for (double value : y) {
+            expected = 0.2 * value + 0.8 * expected;
+        }
+        SpanView<const double> view(y);
+        double chained = StatsKernels::exponentialMovingAverage(view.subspan(40), 0.2,
+                         StatsKernels::exponentialMovingAverage(view.first(40), 0.2, 2.0));
+        ASSERT_NEAR(chained, expected, 1e-9);
+        
+        return TestResult("MatchesReference", "StatsKernels", true, "Kernels agree with reference formulas");
+    });
+    
+    registerTest("StatsKernels", "RingBufferSegments", []() -> TestResult {
+        RingBuffer<double> ring(7);
+        for (int i = 0; i < 19; ++i) {
+            ring.push_back(i * 0.5 + (i % 3));
+        }
+        
+        // Wrapped storage: oldest-first order is preserved across the two segments
+        ASSERT_EQUALS(7, static_cast<int>(ring.size()));
+        ASSERT_TRUE(!ring.segments().secondSegment().empty());
+        ASSERT_NEAR(ring.front(), 12 * 0.5 + 0.0, 1e-12);
+        ASSERT_NEAR(ring.back(), 18 * 0.5 + 0.0, 1e-12);
+        
+        std::vector<double> flat = ring.toVector();
+        ASSERT_NEAR(StatsKernels::mean(ring), StatsKernels::mean(flat), 1e-12);
+        ASSERT_NEAR(StatsKernels::variance(ring), StatsKernels::variance(flat), 1e-12);
+        ASSERT_NEAR(StatsKernels::linearTrend(ring).slope, StatsKernels::linearTrend(flat).slope, 1e-12);
+        ASSERT_NEAR(StatsKernels::exponentialMovingAverage(ring, 0.3, 1.0),
+                    StatsKernels::exponentialMovingAverage(flat, 0.3, 1.0), 1e-12);
+        
+        ring.setCapacity(3);
+        ASSERT_EQUALS(3, static_cast<int>(ring.size()));
+        ASSERT_NEAR(ring.back(), flat.back(), 1e-12);
+        
+        return TestResult("RingBufferSegments", "StatsKernels", true, "Ring buffer stays bounded and reduces across segments");
+    });
+}
+
+void registerSignalRuleTests() {
+    registerTest("SignalRules", "StreamingMatchesBatch", []() -> TestResult {
+        StreamingIndicators indicators(14, 12, 26, 0.1, 40);
+        RingBuffer<double> window(40);
+        
+        for (int t = 0; t < 300; ++t) {
+            double value = 100.0 + 10.0 * std::sin(t * 0.1) + (t % 7) * 0.3;
+            indicators.update(value);
+            window.push_back(value);
+        }
+        
+        // Sliding least-squares sums agree with a full recomputation over the window
+        ASSERT_NEAR(indicators.features()[SignalFeatures::TREND], StatsKernels::linearTrend(window).slope, 1e-9);
+        ASSERT_EQUALS(300, static_cast<int>(indicators.getSampleCount()));
+        
+        return TestResult("StreamingMatchesBatch", "SignalRules", true, "Streaming trend matches the batch fit");
+    });
+    
+    registerTest("SignalRules", "DecisionTableFirstMatch", []() -> TestResult {
+        SignalDecisionTable table;
+        bool compiled = table.compile({
+            {{SignalFeatures::RSI, false, 30.0}, {SignalFeatures::TREND, true, 0.0}},
+            {{SignalFeatures::MACD, true, 0.0}, {SignalFeatures::TREND, true, 0.1}}
+        });
+        ASSERT_TRUE(compiled);
+        ASSERT_EQUALS(4, static_cast<int>(table.getConditionCount()));
+        
+        SignalFeatures features;
+        features[SignalFeatures::RSI] = 20.0;
+        features[SignalFeatures::MACD] = 1.0;
+        features[SignalFeatures::TREND] = 0.5;
+        ASSERT_EQUALS(0, static_cast<int>(table.evaluate(features)));     // Both match, first wins
+        
+        features[SignalFeatures::RSI] = 50.0;
+        ASSERT_EQUALS(1, static_cast<int>(table.evaluate(features)));
+        
+        features[SignalFeatures::TREND] = 0.05;
+        ASSERT_EQUALS(2, static_cast<int>(table.evaluate(features)));     // No match
+        
+        return TestResult("DecisionTableFirstMatch", "SignalRules", true, "Compiled rules keep first-match order");
+    });
+}
+
+void registerTrigramIndexTests() {
+    registerTest("TrigramIndex", "NormalizeStripsNoise", []() -> TestResult {
+        ASSERT_TRUE(std::string("elden ring") == TrigramIndex::normalize("Elden Ring v1.02.3 - 60 FPS"));
+        ASSERT_TRUE(std::string("counter strike 2") == TrigramIndex::normalize("Counter-Strike 2.exe"));
+        ASSERT_TRUE(std::string("assassins creed") == TrigramIndex::normalize("Assassin's Creed [Beta] (DX12)"));
+        ASSERT_TRUE(std::string("cyberpunk 2077") == TrigramIndex::normalize("FPS: 144 Cyberpunk 2077"));
+        
+        return TestResult("NormalizeStripsNoise", "TrigramIndex", true, "Version strings, FPS counters and brackets removed");
+    });
+    
+    registerTest("TrigramIndex", "ScoredRetrieval", []() -> TestResult {
+        TrigramIndex index;
+        index.add("Counter-Strike 2");
+        index.add("Elden Ring");
+        index.add("The Witcher 3");
+        index.add("Dota 2");
+        
+        TrigramIndex::Candidate exact = index.bestMatch("elden ring.exe");
+        ASSERT_EQUALS(1, static_cast<int>(exact.id));
+        ASSERT_NEAR(1.0, exact.score, 1e-6);
+        
+        TrigramIndex::Candidate noisy = index.bestMatch("Witcher 3 - Direct3D 11 [60 FPS]");
+        ASSERT_EQUALS(2, static_cast<int>(noisy.id));
+        ASSERT_TRUE(noisy.score > 0.7f);
+        
+        ASSERT_NEAR(0.0, index.bestMatch("Stardew Valley").score, 1e-6);
+        ASSERT_TRUE(index.search("2", 5, 0.0f).size() <= 4);
+        
+        return TestResult("ScoredRetrieval", "TrigramIndex", true, "Noisy titles resolve to the right entry");
+    });
+    
+    registerTest("TrigramIndex", "NumeralsMustAgree", []() -> TestResult {
+        TrigramIndex index;
+        index.add("Diablo IV");
+        index.add("Half-Life 2");
+        index.add("Cyberpunk 2077");
+        index.add("I Am Bread");
+        
+        // Sequels share nearly every trigram; above the fingerprinting cutoffs without this
+        ASSERT_NEAR(0.0, index.bestMatch("Diablo II").score, 1e-6);
+        ASSERT_NEAR(0.0, index.bestMatch("Half-Life 2: Episode Two").score, 1e-6);
+        ASSERT_NEAR(0.0, index.bestMatch("hl2_episode_two.exe").score, 1e-6);
+        
+        // Same numbers, however they are written
+        ASSERT_EQUALS(0, static_cast<int>(index.bestMatch("Diablo 4").id));
+        ASSERT_TRUE(index.bestMatch("Diablo 4").score > 0.0f);
+        ASSERT_EQUALS(1, static_cast<int>(index.bestMatch("Half-Life 2 - 60 FPS").id));
+        ASSERT_EQUALS(2, static_cast<int>(index.bestMatch("cyberpunk2077.exe").id));
+        ASSERT_NEAR(1.0, index.bestMatch("I Am Bread").score, 1e-6);
+        
+        return TestResult("NumeralsMustAgree", "TrigramIndex", true, "Sequels with other numerals are rejected");
+    });
+}
+
+void registerVisualFingerprintTests() {
+    registerTest("VisualFingerprint", "NearestScreenshot", []() -> TestResult {
+        // Distinct synthetic "games": HUD bar position and dominant colour differ
+        std::vector<cv::Mat> frames;
+        for (int game = 0; game < 6; ++game) {
+            cv::Mat frame(360, 640, CV_8UC3, cv::Scalar(40 * game, 255 - 40 * game, 100));
+            cv::rectangle(frame, cv::Rect(0, 60 * game, 640, 40), cv::Scalar(255, 255, 255), cv::FILLED);
+            cv::circle(frame, cv::Point(100 * game + 50, 300), 30, cv::Scalar(0, 0, 255), cv::FILLED);
+            frames.push_back(frame);
+        }
+        
+        VisualDescriptorIndex index;
+        for (size_t i = 0; i < frames.size(); ++i) {
+            index.add(VisualDescriptor::compute(frames[i]), i);
+        }
+        
+        // Same frame at another resolution with light noise still finds its source
+        cv::Mat query;
+        cv::resize(frames[3], query, cv::Size(1280, 720));
+        cv::Mat noise(query.size(), query.type());
+        cv::randn(noise, cv::Scalar::all(0), cv::Scalar::all(4));
+        query += noise;
+        
+        VisualDescriptorIndex::Match match = index.nearest(VisualDescriptor::compute(query));
+        ASSERT_TRUE(match.found());
+        ASSERT_EQUALS(3, static_cast<int>(match.id));
+        ASSERT_EQUALS(0, VisualDescriptor::distance(VisualDescriptor::compute(frames[0]), VisualDescriptor::compute(frames[0])));
+        
+        return TestResult("NearestScreenshot", "VisualFingerprint", true, "Rescaled noisy frame matched its descriptor");
+    });
+    
+    registerTest("VisualFingerprint", "IdentifyFromProfileDatabase", []() -> TestResult {
+        // Each profile carries the @visual line game_analyzer_headless --describe prints
+        const std::string directory = "visual_test_profiles";
+        const std::string databasePath = "visual_test_profiles.db";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        std::vector<cv::Mat> frames;
+        for (int game = 0; game < 4; ++game) {
+            cv::Mat frame(360, 640, CV_8UC3, cv::Scalar(60 * game, 200 - 40 * game, 90));
+            cv::rectangle(frame, cv::Rect(0, 80 * game, 640, 40), cv::Scalar(255, 255, 255), cv::FILLED);
+            cv::circle(frame, cv::Point(150 * game + 60, 300), 30, cv::Scalar(0, 0, 255), cv::FILLED);
+            frames.push_back(frame);
+            
+            FILE* file = fopen((directory + "/Game " + std::to_string(game) + ".txt").c_str(), "w");
+            ASSERT_TRUE(file != nullptr);
+            fprintf(file, "# Executable: game%d.exe\n@visual %s\nHealth=0x1000\n", game,
+                    VisualDescriptor::compute(frame).toHex().c_str());
+            fclose(file);
+        }
+        
+        VisualDescriptor descriptor = VisualDescriptor::compute(frames[1]);
+        uint8_t bytes[VisualDescriptor::SERIALIZED_BYTES];
+        descriptor.serialize(bytes);
+        ASSERT_EQUALS(0, VisualDescriptor::distance(descriptor, VisualDescriptor::deserialize(bytes)));
+        
+        ProfileDatabase database;
+        ASSERT_TRUE(database.openOrBuild(directory, databasePath));
+        ASSERT_EQUALS(1, static_cast<int>(database.findByName("Game 2").visualCount()));
+        GameFingerprinting fingerprinting;
+        ASSERT_EQUALS(4, static_cast<int>(fingerprinting.loadProfileDatabase(database)));
+        
+        // A captured frame at another resolution, with noise, resolves to its profile
+        cv::Mat capture;
+        cv::resize(frames[2], capture, cv::Size(1280, 720));
+        cv::Mat noise(capture.size(), capture.type());
+        cv::randn(noise, cv::Scalar::all(0), cv::Scalar::all(4));
+        capture += noise;
+        GameFingerprinting::FingerprintMatch match = fingerprinting.identifyGame(capture);
+        ASSERT_TRUE(match.profile.name == "Game 2");
+        ASSERT_TRUE(match.confidence > 0.0f);
+        
+        cv::Mat unknown(360, 640, CV_8UC3, cv::Scalar(10, 10, 10));
+        ASSERT_NEAR(0.0, fingerprinting.identifyGame(unknown).confidence, 1e-6);
+        
+        database.close();
+        std::filesystem::remove_all(directory);
+        std::filesystem::remove(databasePath);
+        
+        return TestResult("IdentifyFromProfileDatabase", "VisualFingerprint", true, "Screenshot identified through compiled @visual descriptors");
+    });
+}
+
+void registerFileHasherTests() {
+    registerTest("FileHasher", "ReferenceVectors", []() -> TestResult {
+        ASSERT_TRUE(std::string("ef46db3751d8e999") == FileHashCache::toHex(XxHash64::hash("", 0)));
+        ASSERT_TRUE(std::string("44bc2cf5ad770999") == FileHashCache::toHex(XxHash64::hash("abc", 3)));
+        
+        Md5 md5;
+        md5.update("abc", 3);
+        ASSERT_TRUE(std::string("900150983cd24fb0d6963f7d28e17f72") == md5.hexDigest());
+        
+        // Streaming in uneven pieces matches one-shot hashing
+        std::vector<uint8_t> data(10000);
+        for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 131 + 7);
+        XxHash64 streaming;
+        for (size_t offset = 0, step = 1; offset < data.size(); offset += step, step = step * 3 % 97 + 1) {
+            streaming.update(data.data() + offset, std::min(step, data.size() - offset));
+        }
+        ASSERT_TRUE(streaming.digest() == XxHash64::hash(data.data(), data.size()));
+        
+        return TestResult("ReferenceVectors", "FileHasher", true, "XXH64 and MD5 match reference digests");
+    });
+    
+    registerTest("FileHasher", "CacheByPathSizeTime", []() -> TestResult {
+        const std::string dataFile = "hash_test_data.bin";
+        const std::string cacheFile = "hash_test_cache.dat";
+        std::remove(cacheFile.c_str());
+        
+        FILE* file = fopen(dataFile.c_str(), "wb");
+        ASSERT_TRUE(file != nullptr);
+        std::vector<char> bytes(3 * FileHashCache::READ_CHUNK_SIZE / 2, 'x');
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+        
+        FileDigest first;
+        FileHashCache cache(cacheFile);
+        ASSERT_TRUE(cache.getDigest(dataFile, true, first));
+        ASSERT_EQUALS(1, static_cast<int>(cache.getCacheMisses()));
+        ASSERT_EQUALS(32, static_cast<int>(first.md5.size()));
+        
+        // A fresh instance answers from the persisted cache without rereading
+        FileDigest second;
+        FileHashCache reloaded(cacheFile);
+        ASSERT_TRUE(reloaded.getDigest(dataFile, false, second));
+        ASSERT_EQUALS(1, static_cast<int>(reloaded.getCacheHits()));
+        ASSERT_TRUE(first.xxh64 == second.xxh64);
+        
+        std::remove(dataFile.c_str());
+        std::remove(cacheFile.c_str());
+        
+        return TestResult("CacheByPathSizeTime", "FileHasher", true, "Unchanged files are served from the cache");
+    });
+}
+
+void registerProfileDatabaseTests() {
+    registerTest("ProfileDatabase", "CompileAndLookup", []() -> TestResult {
+        const std::string sourceDirectory = "profile_db_test";
+        const std::string databasePath = "profile_db_test.db";
+        std::filesystem::create_directories(sourceDirectory);
+        
+        FILE* file = fopen((sourceDirectory + "/Test Game.txt").c_str(), "w");
+        ASSERT_TRUE(file != nullptr);
+        fprintf(file, "# Game: Test Game Deluxe\n# Executable: testgame.exe\n# Window: Test Game\n");
+        fprintf(file, "Health=0x1000\n0x2000 Ammo\n@hud Health 0.1 0.9 0.2 0.05\n@text 255 255 255\n@text 255 200 0 30\n");
+        fclose(file);
+        
+        ProfileDatabase database;
+        ASSERT_TRUE(database.openOrBuild(sourceDirectory, databasePath));
+        ASSERT_EQUALS(1, static_cast<int>(database.size()));
+        
+        ProfileDatabase::ProfileView profile = database.findProfile("TESTGAME.EXE");
+        ASSERT_TRUE(profile.valid());
+        ASSERT_EQUALS(2, static_cast<int>(profile.addressCount()));
+        ASSERT_TRUE(profile.address(1).address == 0x2000);
+        ASSERT_EQUALS(1, static_cast<int>(profile.hudRegionCount()));
+        ASSERT_EQUALS(2, static_cast<int>(profile.textColorCount()));
+        ASSERT_EQUALS(60, profile.textColor(0).tolerance);
+        ASSERT_EQUALS(200, profile.textColor(1).green);
+        ASSERT_TRUE(database.findByName("Test Game").valid());                        // File name alias
+        ASSERT_TRUE(database.findByWindowTitle("Test Game v1.0.2 - 60 FPS").valid());
+        ASSERT_FALSE(database.findByName("Other Game").valid());
+        
+        // Unchanged sources are not reparsed when a new file appears
+        file = fopen((sourceDirectory + "/Second Game.txt").c_str(), "w");
+        ASSERT_TRUE(file != nullptr);
+        fprintf(file, "Score=0x3000\n");
+        fclose(file);
+        ASSERT_TRUE(database.isStale(sourceDirectory));
+        ASSERT_TRUE(database.openOrBuild(sourceDirectory, databasePath));
+        ASSERT_EQUALS(1, static_cast<int>(database.getLastCompileStats().parsedFiles));
+        ASSERT_EQUALS(1, static_cast<int>(database.getLastCompileStats().reusedFiles));
+        ASSERT_TRUE(database.findProfile("Second Game").valid());
+        ASSERT_EQUALS(2, static_cast<int>(database.findProfile("Test Game").definition().textColors.size()));
+        
+        // An in-place edit leaves the directory time alone, so it waits for markSourcesChanged
+        file = fopen((sourceDirectory + "/Second Game.txt").c_str(), "a");
+        ASSERT_TRUE(file != nullptr);
+        fprintf(file, "Ammo=0x4000\n");
+        fclose(file);
+        ASSERT_TRUE(database.openOrBuild(sourceDirectory, databasePath));
+        ASSERT_EQUALS(1, static_cast<int>(database.findProfile("Second Game").addressCount()));
+        database.markSourcesChanged();
+        ASSERT_TRUE(database.openOrBuild(sourceDirectory, databasePath));
+        ASSERT_EQUALS(2, static_cast<int>(database.findProfile("Second Game").addressCount()));
+        
+        database.close();
+        std::filesystem::remove_all(sourceDirectory);
+        std::filesystem::remove(databasePath);
+        
+        return TestResult("CompileAndLookup", "ProfileDatabase", true, "Profiles compile, map and rebuild incrementally");
+    });
+}
+
+// Profile Hot Reload Tests
+void registerProfileReloadTests() {
+    registerTest("ProfileReload", "RcuSnapshotsStayConsistent", []() -> TestResult {
+        // Every published vector holds one value repeated; a torn or freed snapshot would not
+        RcuPointer<std::vector<int>> config(std::unique_ptr<std::vector<int>>(new std::vector<int>(64, 0)));
+        std::atomic<bool> stop(false);
+        std::atomic<int> inconsistentReads(0);
+        std::atomic<int> versionRegressions(0);
+        std::atomic<int> readersRunning(0);
+        
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&]() {
+                uint64_t lastVersion = 0;
+                readersRunning++;
+                while (!stop.load()) {
+                    auto snapshot = config.read();
+                    if (snapshot.version() < lastVersion) versionRegressions++;
+                    lastVersion = snapshot.version();
+                    for (int value : *snapshot) {
+                        if (value != snapshot->front()) {
+                            inconsistentReads++;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+        
+        while (readersRunning.load() < 4) std::this_thread::yield();
+        for (int i = 1; i <= 100; ++i) {
+            config.publish(std::unique_ptr<std::vector<int>>(new std::vector<int>(64, i)));
+        }
+        uint64_t updated = config.update([](std::vector<int>& values) {
+            std::fill(values.begin(), values.end(), -1);
+        });
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        
+        ASSERT_EQUALS(0, inconsistentReads.load());
+        ASSERT_EQUALS(0, versionRegressions.load());
+        ASSERT_EQUALS(102, static_cast<int>(updated));
+        ASSERT_EQUALS(-1, config.read()->back());
+        
+        return TestResult("RcuSnapshotsStayConsistent", "ProfileReload", true, "Readers only ever see whole published snapshots");
+    });
+    
+    registerTest("ProfileReload", "WatcherReportsEditedProfile", []() -> TestResult {
+        const std::string sourceDirectory = "profile_watch_test";
+        std::filesystem::create_directories(sourceDirectory);
+        
+        std::mutex changedMutex;
+        std::vector<std::string> changed;
+        ProfileWatcher watcher;
+        ASSERT_TRUE(watcher.start(sourceDirectory, [&](const std::vector<std::string>& files) {
+            std::lock_guard<std::mutex> lock(changedMutex);
+            changed.insert(changed.end(), files.begin(), files.end());
+        }));
+        
+        FILE* file = fopen((sourceDirectory + "/Watched Game.txt").c_str(), "w");
+        ASSERT_TRUE(file != nullptr);
+        fprintf(file, "# Game: Watched Game\n@hud Ammo 0.8 0.9 0.1 0.05\n@cue DeathFlash 255 0 0 0.3 500 0 0 1 1\n");
+        fclose(file);
+        
+        bool reported = false;
+        for (int waited = 0; waited < 3000 && !reported; waited += 50) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            std::lock_guard<std::mutex> lock(changedMutex);
+            reported = std::find(changed.begin(), changed.end(), "Watched Game.txt") != changed.end();
+        }
+        watcher.stop();
+        ASSERT_TRUE(reported);
+        
+        // The changed file alone is reparsed into an owning definition
+        ProfileDefinition profile;
+        ASSERT_TRUE(ProfileDatabase::parseProfile(sourceDirectory + "/Watched Game.txt", profile));
+        ASSERT_TRUE(profile.name == "Watched Game");
+        ASSERT_EQUALS(1, static_cast<int>(profile.hudRegions.size()));
+        ASSERT_EQUALS(1, static_cast<int>(profile.cues.size()));
+        ASSERT_EQUALS(255, static_cast<int>(profile.cues[0].red));
+        ASSERT_TRUE(GameEventDetector::eventTypeForCue(profile.cues[0].name) == GameEventDetector::EventType::DEATH);
+        
+        std::filesystem::remove_all(sourceDirectory);
+        
+        return TestResult("WatcherReportsEditedProfile", "ProfileReload", true, "Profile edits are reported and reparsed");
+    });
+}
+
+// Session Export Tests
+void registerSessionExportTests() {
+    registerTest("SessionExport", "AsyncWriterKeepsOrder", []() -> TestResult {
+        const std::string path = "async_writer_test.bin";
+        
+        // A tiny buffer forces many handovers between the two buffers
+        AsyncFileWriter writer(AsyncFileWriter::TaskExecutor(), 64);
+        ASSERT_TRUE(writer.open(path));
+        for (uint32_t i = 0; i < 10000; ++i) {
+            ASSERT_TRUE(writer.write(&i, sizeof(i)));
+        }
+        ASSERT_TRUE(writer.close());
+        
+        FILE* file = fopen(path.c_str(), "rb");
+        ASSERT_TRUE(file != nullptr);
+        std::vector<uint32_t> values(10001);
+        size_t count = fread(values.data(), sizeof(uint32_t), values.size(), file);
+        fclose(file);
+        std::remove(path.c_str());
+        
+        ASSERT_EQUALS(10000, static_cast<int>(count));
+        for (uint32_t i = 0; i < 10000; ++i) {
+            ASSERT_TRUE(values[i] == i);
+        }
+        
+        return TestResult("AsyncWriterKeepsOrder", "SessionExport", true, "Double-buffered writes land in order");
+    });
+    
+    registerTest("SessionExport", "RoundTripBothFormats", []() -> TestResult {
+        const SessionExporter::Format formats[2] = {SessionExporter::Format::BINARY, SessionExporter::Format::COLUMNAR};
+        const char* paths[2] = {"session_test.gasx", "session_test.gacol"};
+        
+        for (int f = 0; f < 2; ++f) {
+            SessionExporter exporter;
+            ASSERT_TRUE(exporter.open(paths[f], formats[f]));
+            // More rows than one row group, with two names interleaved
+            const int rows = static_cast<int>(SessionExporter::ROW_GROUP_SIZE) + 100;
+            for (int i = 0; i < rows; ++i) {
+                exporter.addSample(1000000 + i * 16, 0x1000 + (i & 1) * 8, (i & 1) ? "Ammo" : "Health", i * 0.5);
+            }
+            exporter.addEvent(2000000, 11, 0.75f, "Anomaly in Health");
+            ASSERT_TRUE(exporter.close());
+            
+            int samples = 0;
+            int mismatches = 0;
+            int events = 0;
+            bool eventMatches = false;
+            bool read = SessionExporter::read(paths[f],
+                [&](const SessionExporter::Sample& sample, const std::string& name) {
+                    int i = samples++;
+                    if (sample.timestamp != 1000000 + i * 16 || sample.address != uint64_t(0x1000 + (i & 1) * 8) ||
+                        sample.value != i * 0.5 || name != ((i & 1) ? "Ammo" : "Health")) {
+                        mismatches++;
+                    }
+                },
+                [&](const SessionExporter::Event& event, const std::string& description) {
+                    events++;
+                    eventMatches = event.type == 11 && event.confidence == 0.75f && description == "Anomaly in Health";
+                });
+            std::remove(paths[f]);
+            
+            ASSERT_TRUE(read);
+            ASSERT_EQUALS(rows, samples);
+            ASSERT_EQUALS(0, mismatches);
+            ASSERT_EQUALS(1, events);
+            ASSERT_TRUE(eventMatches);
+        }
+        
+        ASSERT_FALSE(SessionExporter::read("missing_session.gasx", nullptr, nullptr));
+        
+        return TestResult("RoundTripBothFormats", "SessionExport", true, "Binary and columnar sessions read back exactly");
+    });
+}
+
+void registerTextSerializerTests() {
+    registerTest("TextSerializer", "MatchesPrintf", []() -> TestResult {
+        const double values[] = {0.0, -0.0, 1.0, 0.125, 2.675, -3.14159265, 1e-7, 123456789.0, 1e21, 99.995};
+        char expected[128];
+        
+        for (double value : values) {
+            for (int precision = 0; precision <= 4; ++precision) {
+                TextSerializer out;
+                out.fixed(value, precision);
+                snprintf(expected, sizeof(expected), "%.*f", precision, value);
+                ASSERT_TRUE(out.str() == expected);
+            }
+            
+            // iostream default formatting is %g, which the analytics CSV used to rely on
+            TextSerializer general;
+            general.general(value);
+            snprintf(expected, sizeof(expected), "%g", value);
+            ASSERT_TRUE(general.str() == expected);
+        }
+        
+        TextSerializer out;
+        out.integer(-9223372036854775807LL - 1).character(',').unsignedInteger(18446744073709551615ULL)
+           .character(',').hex(0x7FF6A3B0C4D8ULL);
+        snprintf(expected, sizeof(expected), "%lld,%llu,%llX", -9223372036854775807LL - 1,
+                 18446744073709551615ULL, 0x7FF6A3B0C4D8ULL);
+        ASSERT_TRUE(out.str() == expected);
+        
+        return TestResult("MatchesPrintf", "TextSerializer", true, "to_chars output matches printf");
+    });
+    
+    registerTest("TextSerializer", "EscapesFields", []() -> TestResult {
+        TextSerializer csv;
+        csv.csvField("Health").character(',').csvField("Ammo, \"clip\"").character(',').csvField("a\nb");
+        ASSERT_TRUE(csv.str() == "Health,\"Ammo, \"\"clip\"\"\",\"a\nb\"");
+        
+        TextSerializer json;
+        json.jsonString(std::string("say \"hi\"\\\n\t\x01", 12)).character(',').jsonNumber(0.1)
+            .character(',').jsonNumber(std::numeric_limits<double>::quiet_NaN());
+        ASSERT_TRUE(json.str() == "\"say \\\"hi\\\"\\\\\\n\\t\\u0001\",0.1,null");
+        
+        return TestResult("EscapesFields", "TextSerializer", true, "CSV quoting and JSON escaping are correct");
+    });
+    
+    registerTest("TextSerializer", "BatchesAtRowBoundaries", []() -> TestResult {
+        std::string written;
+        int writes = 0;
+        {
+            TextSerializer out([&](const char* data, size_t length) {
+                written.append(data, length);
+                ++writes;
+                return true;
+            }, 1024);
+            for (int i = 0; i < 1000; ++i) {
+                out.integer(i).character(',').fixed(i * 0.5, 2).newline();
+                // Nothing reaches the sink mid-row
+                ASSERT_TRUE(written.empty() || written.back() == '\n');
+            }
+        }   // Destructor flushes the tail
+        
+        std::string expected;
+        char row[64];
+        for (int i = 0; i < 1000; ++i) {
+            snprintf(row, sizeof(row), "%d,%.2f\n", i, i * 0.5);
+            expected += row;
+        }
+        ASSERT_TRUE(written == expected);
+        ASSERT_TRUE(writes > 1 && writes < 20);
+        
+        return TestResult("BatchesAtRowBoundaries", "TextSerializer", true, "Rows are written in a few large batches");
+    });
+}
+
+void registerStartupGraphTests() {
+    registerTest("StartupGraph", "IndependentComponentsOverlap", []() -> TestResult {
+        StartupGraph graph;
+        auto sleepFor = [](int ms) {
+            return [ms]() { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); return true; };
+        };
+        ASSERT_TRUE(graph.addComponent("Threads", {}, sleepFor(40)));
+        ASSERT_TRUE(graph.addComponent("Capture", {}, sleepFor(40)));
+        ASSERT_TRUE(graph.addComponent("Profiles", {"Threads"}, sleepFor(10)));
+        ASSERT_TRUE(!graph.addComponent("Watcher", {"Missing"}, sleepFor(1)));
+        ASSERT_TRUE(!graph.addComponent("Threads", {}, sleepFor(1)));
+        ASSERT_TRUE(graph.run());
+        
+        std::map<std::string, StartupGraph::ComponentTiming> byName;
+        for (const auto& entry : graph.getTimeline()) byName[entry.name] = entry;
+        ASSERT_EQUALS(3, static_cast<int>(byName.size()));
+        
+        // The two roots ran side by side, and the dependent waited for its dependency
+        ASSERT_TRUE(byName["Threads"].startMs < byName["Capture"].endMs);
+        ASSERT_TRUE(byName["Capture"].startMs < byName["Threads"].endMs);
+        ASSERT_TRUE(byName["Profiles"].startMs >= byName["Threads"].endMs);
+        ASSERT_TRUE(graph.getElapsedMs() < 80.0);
+        
+        return TestResult("IndependentComponentsOverlap", "StartupGraph", true, "Independent components start together");
+    });
+    
+    registerTest("StartupGraph", "FailureSkipsDependents", []() -> TestResult {
+        StartupGraph graph;
+        std::atomic<int> ran(0);
+        std::thread::id callerThread;
+        bool callbackRan = false;
+        
+        ASSERT_TRUE(graph.addComponent("OCR", {}, []() -> bool { throw std::runtime_error("no tessdata"); }));
+        ASSERT_TRUE(graph.addComponent("Templates", {"OCR"}, [&ran]() { ++ran; return true; }));
+        ASSERT_TRUE(graph.addComponent("Regions", {"Templates"}, [&ran]() { ++ran; return true; }));
+        ASSERT_TRUE(graph.addComponent("Dialogs", {}, [&callerThread]() {
+            callerThread = std::this_thread::get_id();
+            return true;
+        }, StartupGraph::Mode::CALLER));
+        ASSERT_TRUE(graph.addComponent("Warmup", {"Dialogs"}, []() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+            return true;
+        }, StartupGraph::Mode::BACKGROUND));
+        graph.setCompletionCallback([&callbackRan]() { callbackRan = true; });
+        
+        ASSERT_TRUE(!graph.run());
+        ASSERT_TRUE(callerThread == std::this_thread::get_id());
+        ASSERT_TRUE(!graph.wait());
+        ASSERT_TRUE(callbackRan);
+        ASSERT_EQUALS(0, ran.load());
+        
+        int skipped = 0;
+        for (const auto& entry : graph.getTimeline()) {
+            if (entry.state == StartupGraph::State::SKIPPED) ++skipped;
+            if (entry.name == "Warmup") ASSERT_TRUE(entry.state == StartupGraph::State::SUCCEEDED);
+        }
+        ASSERT_EQUALS(2, skipped);
+        ASSERT_TRUE(graph.formatTimeline().find("Warmup") != std::string::npos);
+        
+        return TestResult("FailureSkipsDependents", "StartupGraph", true, "A failed component skips its dependents only");
+    });
+}
+
+void registerModelSharingTests() {
+    registerTest("AdvancedOCR", "TraineddataMappedOnce", []() -> TestResult {
+        const std::string path = "shared_model_test.traineddata";
+        {
+            std::ofstream file(path, std::ios::binary);
+            for (int i = 0; i < 4096; ++i) file.put(static_cast<char>(i & 0xFF));
+        }
+        
+        TraineddataCache& cache = TraineddataCache::getInstance();
+        cache.clear();
+        uint64_t misses = cache.getMissCount();
+        uint64_t hits = cache.getHitCount();
+        
+        auto first = cache.acquire(path);
+        auto second = cache.acquire(path);
+        ASSERT_TRUE(first != nullptr);
+        ASSERT_TRUE(first.get() == second.get());
+        ASSERT_EQUALS(1, static_cast<int>(cache.getMissCount() - misses));
+        ASSERT_EQUALS(1, static_cast<int>(cache.getHitCount() - hits));
+        ASSERT_EQUALS(4096, static_cast<int>(first->size()));
+        ASSERT_TRUE(static_cast<unsigned char>(first->data()[300]) == (300 & 0xFF));
+        ASSERT_TRUE(cache.acquire("missing_model.traineddata") == nullptr);
+        
+        // Clearing drops the cache's reference; engines mid-initialisation keep theirs
+        cache.clear();
+        ASSERT_EQUALS(0, static_cast<int>(cache.getMappedBytes()));
+        ASSERT_TRUE(static_cast<unsigned char>(first->data()[4095]) == 0xFF);
+        first.reset();
+        second.reset();
+        std::remove(path.c_str());
+        
+        return TestResult("TraineddataMappedOnce", "AdvancedOCR", true, "Engines share one traineddata mapping");
+    });
+}
+
+void registerHeadlessPipelineTests() {
+    registerTest("HeadlessPipeline", "ConfigParsing", []() -> TestResult {
+        const std::string path = "headless_test.conf";
+        {
+            std::ofstream file(path);
+            file << "# comment\n"
+                 << "frames = images:frames   # trailing comment\n"
+                 << "max_fps = 30\n"
+                 << "OCR = off\n"
+                 << "address = 0x1000 Health\n"
+                 << "session_format = columnar\n";
+        }
+        
+        PipelineConfig config;
+        std::string error;
+        ASSERT_TRUE(config.load(path, error));
+        ASSERT_TRUE(config.frameSource == "images:frames");
+        ASSERT_EQUALS(30, config.maxFps);
+        ASSERT_FALSE(config.enableOcr);
+        ASSERT_EQUALS(1, static_cast<int>(config.addresses.size()));
+        ASSERT_EQUALS(0x1000, static_cast<int>(config.addresses[0].address));
+        ASSERT_TRUE(config.addresses[0].name == "Health");
+        ASSERT_TRUE(config.sessionFormat == SessionExporter::Format::COLUMNAR);
+        
+        // Typos and bad values are reported, not ignored
+        ASSERT_FALSE(config.set("max_fsp", "30", error));
+        ASSERT_FALSE(config.set("max_fps", "fast", error));
+        ASSERT_FALSE(config.set("address", "0x1000", error));
+        ASSERT_TRUE(FrameSource::create("carrier-pigeon") == nullptr);
+        std::remove(path.c_str());
+        
+        return TestResult("ConfigParsing", "HeadlessPipeline", true, "Config file and overrides parsed");
+    });
+    
+    registerTest("HeadlessPipeline", "ImageDirectoryRun", []() -> TestResult {
+        const std::string directory = "headless_test_frames";
+        std::filesystem::create_directories(directory);
+        for (int i = 0; i < 3; ++i) {
+            cv::Mat frame(120, 160, CV_8UC3, cv::Scalar(40 * i, 80, 160));
+            cv::imwrite(directory + "/frame" + std::to_string(i) + ".png", frame);
+        }
+        
+        PipelineConfig config;
+        std::string error;
+        ASSERT_TRUE(config.set("frames", "images:" + directory, error));
+        ASSERT_TRUE(config.set("ocr", "false", error));
+        
+        HeadlessPipeline pipeline(config);
+        ASSERT_TRUE(pipeline.start(error));
+        for (int i = 0; i < 500 && pipeline.isRunning(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pipeline.stop();
+        
+        HeadlessPipeline::Metrics metrics = pipeline.getMetrics();
+        ASSERT_EQUALS(3, static_cast<int>(metrics.framesProcessed));
+        ASSERT_EQUALS(3, static_cast<int>(metrics.stages[HeadlessPipeline::STAGE_EVENTS].count));
+        ASSERT_EQUALS(0, static_cast<int>(metrics.stages[HeadlessPipeline::STAGE_OCR].count));
+        std::string text = pipeline.formatMetrics();
+        ASSERT_TRUE(text.find("game_analyzer_frames_processed_total 3") != std::string::npos);
+        ASSERT_TRUE(text.find("game_analyzer_stage_latency_ms_count{stage=\"events\"} 3") != std::string::npos);
+        std::filesystem::remove_all(directory);
+        
+        return TestResult("ImageDirectoryRun", "HeadlessPipeline", true, "Frames processed with no UI");
+    });
+    
+    registerTest("HeadlessPipeline", "StartStopTwice", []() -> TestResult {
+        const std::string directory = "headless_restart_frames";
+        std::filesystem::create_directories(directory);
+        for (int i = 0; i < 3; ++i) {
+            cv::Mat frame(120, 160, CV_8UC3, cv::Scalar(40 * i, 80, 160));
+            cv::imwrite(directory + "/frame" + std::to_string(i) + ".png", frame);
+        }
+        
+        PipelineConfig config;
+        std::string error;
+        ASSERT_TRUE(config.set("frames", "images:" + directory, error));
+        ASSERT_TRUE(config.set("ocr", "false", error));
+        
+        // stop() shuts the worker pools down; the next start() must bring them back
+        HeadlessPipeline pipeline(config);
+        for (int run = 0; run < 2; ++run) {
+            ASSERT_TRUE(pipeline.start(error));
+            for (int i = 0; i < 500 && pipeline.isRunning(); ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            pipeline.stop();
+        }
+        std::filesystem::remove_all(directory);
+        
+        ASSERT_EQUALS(6, static_cast<int>(pipeline.getMetrics().framesProcessed));
+        
+        return TestResult("StartStopTwice", "HeadlessPipeline", true, "Pipeline restarts after stop");
+    });
+    
+    registerTest("HeadlessPipeline", "FrameDeduplication", []() -> TestResult {
+        cv::Mat frame(360, 640, CV_8UC3);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        FrameDeduplicator deduplicator;
+        ASSERT_FALSE(deduplicator.isDuplicate(frame));
+        ASSERT_FALSE(deduplicator.isDuplicate(frame));     // The first repeat gives the reference its full hash
+        ASSERT_TRUE(deduplicator.isDuplicate(frame));
+        
+        // Row 0 is never sampled, so only the full hash can tell this frame apart
+        uint64_t sample = FrameDeduplicator::sampleHash(frame);
+        frame.at<cv::Vec3b>(0, 5)[0] ^= 1;
+        ASSERT_TRUE(FrameDeduplicator::sampleHash(frame) == sample);
+        ASSERT_FALSE(deduplicator.isDuplicate(frame));
+        ASSERT_TRUE(deduplicator.isDuplicate(frame));
+        
+        frame.at<cv::Vec3b>(2, 2)[1] ^= 1;                  // First block of the first sampled row
+        ASSERT_TRUE(FrameDeduplicator::sampleHash(frame) != sample);
+        ASSERT_FALSE(deduplicator.isDuplicate(frame));
+        ASSERT_EQUALS(7, static_cast<int>(deduplicator.getFramesSeen()));
+        ASSERT_EQUALS(2, static_cast<int>(deduplicator.getDuplicateFrames()));
+        
+        // Through the pipeline: A B B B C processes A, B, its first repeat and C
+        const std::string directory = "headless_dedup_frames";
+        std::filesystem::create_directories(directory);
+        const int shades[] = {0, 1, 1, 1, 2};
+        for (int i = 0; i < 5; ++i) {
+            cv::imwrite(directory + "/frame" + std::to_string(i) + ".png",
+                        cv::Mat(120, 160, CV_8UC3, cv::Scalar(40 * shades[i], 80, 160)));
+        }
+        PipelineConfig config;
+        std::string error;
+        ASSERT_TRUE(config.set("frames", "images:" + directory, error));
+        ASSERT_TRUE(config.set("ocr", "false", error));
+        HeadlessPipeline pipeline(config);
+        ASSERT_TRUE(pipeline.start(error));
+        for (int i = 0; i < 500 && pipeline.isRunning(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pipeline.stop();
+        std::filesystem::remove_all(directory);
+        
+        HeadlessPipeline::Metrics metrics = pipeline.getMetrics();
+        ASSERT_EQUALS(4, static_cast<int>(metrics.framesProcessed));
+        ASSERT_EQUALS(1, static_cast<int>(metrics.duplicateFrames));
+        ASSERT_EQUALS(4, static_cast<int>(metrics.stages[HeadlessPipeline::STAGE_EVENTS].count));
+        ASSERT_TRUE(metrics.lastFrameTimeMs > 0);
+        ASSERT_TRUE(pipeline.formatMetrics().find("game_analyzer_duplicate_frames_total 1") != std::string::npos);
+        
+        return TestResult("FrameDeduplication", "HeadlessPipeline", true, "Repeated frames skip detection");
+    });
+    
+    registerTest("HeadlessPipeline", "HighlightClips", []() -> TestResult {
+        // Tile deltas decode to exactly the frames that were encoded
+        SimulatorConfig simulatorConfig;
+        GameSimulator simulator(simulatorConfig);
+        cv::Mat frame, previous, canvas;
+        std::vector<uint8_t> encoded;
+        for (int i = 0; i < 30; ++i) {
+            simulator.step(&frame);
+            HighlightRecorder::encodeDelta(frame, previous, i % 10 == 0, 32, encoded);
+            if (i == 0) canvas = cv::Mat::zeros(frame.size(), frame.type());
+            ASSERT_TRUE(HighlightRecorder::applyDelta(encoded.data(), encoded.size(), canvas, 32));
+            ASSERT_EQUALS(0, cv::norm(canvas, frame, cv::NORM_INF));
+            previous = frame.clone();
+        }
+        HighlightRecorder::encodeDelta(frame, previous, false, 32, encoded);
+        ASSERT_EQUALS(1, static_cast<int>(encoded.size()));                   // Unchanged: flag byte only
+        encoded.push_back(0x7f);
+        ASSERT_FALSE(HighlightRecorder::applyDelta(encoded.data(), encoded.size(), canvas, 32));
+        
+        // A kill at ~3s with 1s either side: one clip, the score change is not a trigger
+        const std::string directory = "highlight_test_clips";
+        HighlightRecorder recorder;
+        HighlightRecorder::Options options;
+        options.directory = directory;
+        options.preRollMs = 1000;
+        options.postRollMs = 1000;
+        ASSERT_TRUE(recorder.start(options));
+        for (int i = 0; i < 150; ++i) {
+            simulator.step(&frame);
+            recorder.addFrame(frame, i * 33);
+            if (i == 90) {
+                GameEventDetector::GameEvent kill(GameEventDetector::EventType::KILL, "kill", 0.9f);
+                GameEventDetector::GameEvent score(GameEventDetector::EventType::SCORE_CHANGE, "score", 0.9f);
+                recorder.onEvents({kill, score}, i * 33);
+            }
+        }
+        ASSERT_TRUE(recorder.getBufferedFrames() < 100);                    // Evicted past the pre-roll
+        recorder.stop();
+        ASSERT_EQUALS(1, static_cast<int>(recorder.getClipsWritten()));
+        std::vector<std::string> clips = recorder.getClipPaths();
+        ASSERT_EQUALS(1, static_cast<int>(clips.size()));
+        ASSERT_TRUE(clips[0].find("kill_2970.avi") != std::string::npos);
+        cv::VideoCapture clip(clips[0]);
+        ASSERT_TRUE(clip.isOpened());
+        int clipFrames = 0;
+        while (clip.read(frame)) ++clipFrames;
+        clip.release();
+        std::filesystem::remove_all(directory);
+        ASSERT_TRUE(clipFrames >= 55 && clipFrames <= 65);
+        
+        return TestResult("HighlightClips", "HeadlessPipeline", true, "Event clips from the delta buffer");
+    });
+    
+    registerTest("HeadlessPipeline", "LatencyTracing", []() -> TestResult {
+        HeadlessPipeline::LatencyHistogram histogram;
+        for (double ms : {0.3, 3.0, 3.0, 700.0, 9000.0}) histogram.record(ms);
+        ASSERT_EQUALS(5, static_cast<int>(histogram.count));
+        ASSERT_EQUALS(1, static_cast<int>(histogram.buckets[0]));
+        ASSERT_EQUALS(2, static_cast<int>(histogram.buckets[3]));                     // (2, 5]
+        ASSERT_EQUALS(1, static_cast<int>(histogram.buckets[HeadlessPipeline::LatencyHistogram::BUCKET_COUNT]));
+        ASSERT_EQUALS(0.5, histogram.quantileMs(0.2));
+        ASSERT_EQUALS(5.0, histogram.quantileMs(0.5));
+        ASSERT_EQUALS(1000.0, histogram.quantileMs(0.8));
+        ASSERT_TRUE(histogram.quantileMs(1.0) > 5000.0);                            // Above the last bound
+        
+        // Every processed frame is traced from capture through each later stage
+        const std::string directory = "headless_trace_frames";
+        std::filesystem::create_directories(directory);
+        for (int i = 0; i < 3; ++i) {
+            cv::imwrite(directory + "/frame" + std::to_string(i) + ".png",
+                        cv::Mat(120, 160, CV_8UC3, cv::Scalar(60 * i, 80, 160)));
+        }
+        PipelineConfig config;
+        std::string error;
+        ASSERT_TRUE(config.set("frames", "images:" + directory, error));
+        ASSERT_TRUE(config.set("ocr", "false", error));
+        HeadlessPipeline pipeline(config);
+        ASSERT_TRUE(pipeline.start(error));
+        for (int i = 0; i < 500 && pipeline.isRunning(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        pipeline.stop();
+        std::filesystem::remove_all(directory);
+        
+        HeadlessPipeline::Metrics metrics = pipeline.getMetrics();
+        ASSERT_EQUALS(3, static_cast<int>(metrics.captureToStage[HeadlessPipeline::STAGE_CAPTURE].count));
+        ASSERT_EQUALS(3, static_cast<int>(metrics.captureToStage[HeadlessPipeline::STAGE_DEDUP].count));
+        ASSERT_EQUALS(3, static_cast<int>(metrics.captureToStage[HeadlessPipeline::STAGE_EVENTS].count));
+        ASSERT_EQUALS(0, static_cast<int>(metrics.captureToStage[HeadlessPipeline::STAGE_OCR].count));
+        ASSERT_TRUE(metrics.captureToStage[HeadlessPipeline::STAGE_EVENTS].totalMs >=
+                    metrics.stages[HeadlessPipeline::STAGE_EVENTS].totalMs);
+        ASSERT_TRUE(metrics.captureToEvent.count <= 3);
+        std::string text = pipeline.formatMetrics();
+        ASSERT_TRUE(text.find("game_analyzer_capture_to_stage_ms_bucket{stage=\"events\",le=\"+Inf\"} 3") != std::string::npos);
+        ASSERT_TRUE(text.find("game_analyzer_capture_to_event_ms_count ") != std::string::npos);
+        
+        return TestResult("LatencyTracing", "HeadlessPipeline", true, "Capture-to-stage latency per frame");
+    });
+}
+
+void registerGameSimulatorTests() {
+    registerTest("GameSimulator", "DeterministicFromSeed", []() -> TestResult {
+        SimulatorConfig config;
+        config.seed = 42;
+        GameSimulator first(config), second(config);
+        config.seed = 43;
+        GameSimulator other(config);
+        
+        GameSimulator::FrameTruth a, b, c;
+        bool diverged = false;
+        size_t events = 0;
+        for (int i = 0; i < 300; ++i) {
+            first.step(nullptr, &a);
+            second.step(nullptr, &b);
+            other.step(nullptr, &c);
+            for (int field = 0; field < GameSimulator::FIELD_COUNT; ++field) {
+                ASSERT_EQUALS(a.values[field], b.values[field]);
+                if (a.values[field] != c.values[field]) diverged = true;
+            }
+            ASSERT_TRUE(a.events == b.events);
+            events += a.events.size();
+        }
+        ASSERT_TRUE(diverged);
+        ASSERT_TRUE(events > 0);
+        ASSERT_EQUALS(10, static_cast<int>(a.timestampMs / 990));   // 300 steps of 33ms
+        
+        return TestResult("DeterministicFromSeed", "GameSimulator", true, "Same seed, same game");
+    });
+    
+    registerTest("GameSimulator", "RandomizedLayout", []() -> TestResult {
+        SimulatorConfig config;
+        GameSimulator fixed(config);
+        config.randomizeLayout = true;
+        GameSimulator shuffled(config);
+        
+        bool moved = false;
+        std::set<size_t> offsets;
+        for (int field = 0; field < GameSimulator::FIELD_COUNT; ++field) {
+            auto id = static_cast<GameSimulator::Field>(field);
+            size_t offset = shuffled.getFieldOffset(id);
+            ASSERT_EQUALS(0, static_cast<int>(offset % 4));
+            ASSERT_TRUE(offset + sizeof(int32_t) <= shuffled.getMemoryBlockSize());
+            offsets.insert(offset);
+            if (offset != fixed.getFieldOffset(id)) moved = true;
+        }
+        ASSERT_EQUALS(GameSimulator::FIELD_COUNT, static_cast<int>(offsets.size()));
+        ASSERT_TRUE(moved);
+        
+        // Values are readable at the advertised addresses, as a real game's would be
+        shuffled.step(nullptr);
+        int32_t health = 0;
+        ASSERT_TRUE(ProcessMemory::read(ProcessMemory::currentProcessId(),
+                                        shuffled.getFieldAddress(GameSimulator::FIELD_HEALTH), &health, sizeof(health)));
+        ASSERT_EQUALS(shuffled.getValue(GameSimulator::FIELD_HEALTH), health);
+        
+        ProfileDefinition profile = shuffled.buildProfile();
+        ASSERT_EQUALS(GameSimulator::FIELD_COUNT, static_cast<int>(profile.addresses.size()));
+        ASSERT_TRUE(profile.addresses[GameSimulator::FIELD_SCORE].address ==
+                    shuffled.getFieldAddress(GameSimulator::FIELD_SCORE));
+        
+        return TestResult("RandomizedLayout", "GameSimulator", true, "Shuffled fields stay readable");
+    });
+    
+    registerTest("GameSimulator", "GroundTruthAndProfile", []() -> TestResult {
+        const std::string truthPath = "simulator_truth_test.csv";
+        const std::string profilePath = "simulator_profile_test.txt";
+        GameSimulator simulator;
+        ASSERT_TRUE(simulator.openGroundTruthLog(truthPath));
+        for (int i = 0; i < 50; ++i) simulator.step(nullptr);
+        simulator.closeGroundTruthLog();
+        
+        std::ifstream truth(truthPath);
+        std::string line, last;
+        std::getline(truth, line);
+        ASSERT_TRUE(line.compare(0, 20, "frame,time_ms,Health") == 0);
+        int rows = 0;
+        while (std::getline(truth, line)) {
+            ++rows;
+            last = line;
+        }
+        ASSERT_EQUALS(50, rows);
+        ASSERT_TRUE(last.compare(0, 8, "50,1650,") == 0);
+        truth.close();
+        
+        // The written profile parses back to the same addresses and HUD regions
+        ASSERT_TRUE(simulator.writeProfile(profilePath));
+        ProfileDefinition parsed;
+        ASSERT_TRUE(ProfileDatabase::parseProfile(profilePath, parsed));
+        ASSERT_TRUE(parsed.name == "Synthetic Game");
+        ASSERT_EQUALS(GameSimulator::FIELD_COUNT, static_cast<int>(parsed.addresses.size()));
+        ASSERT_TRUE(parsed.addresses[0].address == simulator.getFieldAddress(GameSimulator::FIELD_HEALTH));
+        ASSERT_EQUALS(static_cast<int>(simulator.getHudRegions().size()), static_cast<int>(parsed.hudRegions.size()));
+        std::remove(truthPath.c_str());
+        std::remove(profilePath.c_str());
+        
+        return TestResult("GroundTruthAndProfile", "GameSimulator", true, "Ground truth and profile written");
+    });
+    
+    registerTest("GameSimulator", "RenderedHudMatchesMemory", []() -> TestResult {
+        SimulatorConfig config;
+        config.damageRate = 6.0;
+        GameSimulator simulator(config);
+        GameEventDetector detector;
+        detector.initialize();
+        GameSimulator::FrameTruth truth;
+        cv::Mat frame;
+        
+        bool sawDeathFlash = false;
+        for (int i = 0; i < 600 && !sawDeathFlash; ++i) {
+            simulator.step(&frame, &truth);
+            ASSERT_EQUALS(config.width, frame.cols);
+            ASSERT_EQUALS(config.height, frame.rows);
+            ASSERT_TRUE(truth.hudFields.size() >= 5);
+            ASSERT_TRUE(truth.hudFields[0].text == std::to_string(truth.values[GameSimulator::FIELD_HEALTH]));
+            
+            if (truth.redFlash) {
+                sawDeathFlash = true;
+                auto events = detector.detectEvents(frame);
+                ASSERT_TRUE(std::any_of(events.begin(), events.end(), [](const GameEventDetector::GameEvent& event) {
+                    return event.type == GameEventDetector::EventType::DEATH;
+                }));
+            }
+        }
+        ASSERT_TRUE(sawDeathFlash);
+        
+        return TestResult("RenderedHudMatchesMemory", "GameSimulator", true, "HUD text and flashes follow the game state");
+    });
 }
 
 // Thread Manager Tests as specified in prompt.md
@@ -250,6 +1758,37 @@ void registerPerformanceMonitorTests() {
         
         return TestResult("PerformanceTargets", "PerformanceMonitor", true, "Performance targets test completed");
     });
+    
+    registerTest("PerformanceMonitor", "MetricIds", []() -> TestResult {
+        PerformanceMonitor& monitor = PerformanceMonitor::getInstance();
+        monitor.reset();
+        
+        PerformanceMonitor::MetricId id = monitor.registerMetric("id_test");
+        ASSERT_TRUE(monitor.registerMetric("id_test") == id);
+        ASSERT_TRUE(monitor.registerMetric("id_test_other") != id);
+        
+        monitor.recordDuration(id, 2.0);
+        monitor.recordDuration(id, 4.0);
+        {
+            ScopedTimer timer(id);
+        }
+        PerformanceMonitor::PerformanceMetric metric = monitor.getMetric("id_test");
+        ASSERT_EQUALS(3, static_cast<int>(metric.totalCalls));
+        ASSERT_NEAR(metric.maxTime, 4.0, 1e-9);
+        ASSERT_TRUE(metric.name == "id_test");
+        
+        auto all = monitor.getAllMetrics();
+        ASSERT_TRUE(all.count("id_test") == 1);
+        ASSERT_TRUE(all.count("id_test_other") == 0);       // Registered but never timed
+        
+        // IDs survive a reset
+        monitor.reset();
+        ASSERT_EQUALS(0, static_cast<int>(monitor.getMetric("id_test").totalCalls));
+        monitor.recordDuration(id, 1.0);
+        ASSERT_EQUALS(1, static_cast<int>(monitor.getMetric("id_test").totalCalls));
+        
+        return TestResult("MetricIds", "PerformanceMonitor", true, "Metrics recorded by registered ID");
+    });
 }
 
 // CUDA Support Tests as specified in prompt.md
@@ -339,6 +1878,21 @@ void registerAllTests() {
     registerOCRTests();
     registerScreenCaptureTests();
     registerGameAnalyticsTests();
+    registerForecastingTests();
+    registerAnomalyDetectionTests();
+    registerStatsKernelTests();
+    registerSignalRuleTests();
+    registerTrigramIndexTests();
+    registerVisualFingerprintTests();
+    registerFileHasherTests();
+    registerProfileDatabaseTests();
+    registerProfileReloadTests();
+    registerSessionExportTests();
+    registerTextSerializerTests();
+    registerStartupGraphTests();
+    registerModelSharingTests();
+    registerHeadlessPipelineTests();
+    registerGameSimulatorTests();
     registerThreadManagerTests();
     registerPerformanceMonitorTests();
     registerCudaSupportTests();
@@ -0,0 +1,190 @@
+#include "visual_fingerprint.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+constexpr int SAMPLE_SIZE = 64;     // Side of the shared downscale
+constexpr int GRID_SIZE = 8;        // Edge layout cells per side
+
+int popcount64(uint64_t value) {
+    return __builtin_popcountll(value);
+}
+
+} // namespace
+
+// VisualDescriptor Implementation
+VisualDescriptor VisualDescriptor::compute(const cv::Mat& image) {
+    VisualDescriptor descriptor;
+    if (image.empty()) return descriptor;
+
+    // One area-downscale of the full frame; everything else works on 64x64
+    cv::Mat sample;
+    cv::resize(image, sample, cv::Size(SAMPLE_SIZE, SAMPLE_SIZE), 0, 0, cv::INTER_AREA);
+    if (sample.depth() != CV_8U) {
+        sample.convertTo(sample, CV_8U);
+    }
+    if (sample.channels() == 4) {
+        cv::cvtColor(sample, sample, cv::COLOR_BGRA2BGR);
+    } else if (sample.channels() == 1) {
+        cv::cvtColor(sample, sample, cv::COLOR_GRAY2BGR);
+    }
+
+    cv::Mat gray;
+    cv::cvtColor(sample, gray, cv::COLOR_BGR2GRAY);
+
+    // Difference hash: bit set where a pixel is darker than its right neighbour
+    cv::Mat thumbnail;
+    cv::resize(gray, thumbnail, cv::Size(9, 8), 0, 0, cv::INTER_AREA);
+    for (int y = 0; y < 8; ++y) {
+        const uint8_t* row = thumbnail.ptr<uint8_t>(y);
+        for (int x = 0; x < 8; ++x) {
+            if (row[x] < row[x + 1]) {
+                descriptor.thumbnailHash |= uint64_t(1) << (y * 8 + x);
+            }
+        }
+    }
+
+    // Palette: 2 bits per channel
+    int counts[PALETTE_BINS] = {};
+    for (int y = 0; y < sample.rows; ++y) {
+        const cv::Vec3b* row = sample.ptr<cv::Vec3b>(y);
+        for (int x = 0; x < sample.cols; ++x) {
+            counts[(row[x][2] >> 6) << 4 | (row[x][1] >> 6) << 2 | (row[x][0] >> 6)]++;
+        }
+    }
+    int total = sample.rows * sample.cols;
+    for (int bin = 0; bin < PALETTE_BINS; ++bin) {
+        descriptor.palette[bin] = static_cast<uint8_t>((counts[bin] * PALETTE_SCALE + total / 2) / total);
+    }
+
+    // Edge layout: HUD panels and borders are stable strong edges in fixed cells
+    cv::Mat gradientX, gradientY, magnitude, cells;
+    cv::Sobel(gray, gradientX, CV_32F, 1, 0);
+    cv::Sobel(gray, gradientY, CV_32F, 0, 1);
+    cv::magnitude(gradientX, gradientY, magnitude);
+    cv::resize(magnitude, cells, cv::Size(GRID_SIZE, GRID_SIZE), 0, 0, cv::INTER_AREA);
+
+    std::vector<float> energies(cells.begin<float>(), cells.end<float>());
+    std::vector<float> ordered = energies;
+    std::nth_element(ordered.begin(), ordered.begin() + ordered.size() / 2, ordered.end());
+    float median = ordered[ordered.size() / 2];
+    for (size_t cell = 0; cell < energies.size(); ++cell) {
+        if (energies[cell] > median) {
+            descriptor.edgeLayout |= uint64_t(1) << cell;
+        }
+    }
+
+    return descriptor;
+}
+
+std::vector<cv::Scalar> VisualDescriptor::dominantColors(size_t maxColors) const {
+    std::vector<int> bins;
+    for (int bin = 0; bin < PALETTE_BINS; ++bin) {
+        if (palette[bin] > 0) bins.push_back(bin);
+    }
+    std::stable_sort(bins.begin(), bins.end(), [this](int a, int b) { return palette[a] > palette[b]; });
+    if (bins.size() > maxColors) bins.resize(maxColors);
+
+    // Bin centre of each 64-wide channel band
+    std::vector<cv::Scalar> colors;
+    colors.reserve(bins.size());
+    for (int bin : bins) {
+        colors.emplace_back((bin & 3) * 64 + 32, ((bin >> 2) & 3) * 64 + 32, ((bin >> 4) & 3) * 64 + 32);
+    }
+    return colors;
+}
+
+int VisualDescriptor::distance(const VisualDescriptor& a, const VisualDescriptor& b) {
+    int result = popcount64(a.thumbnailHash ^ b.thumbnailHash) + popcount64(a.edgeLayout ^ b.edgeLayout);
+    for (int bin = 0; bin < PALETTE_BINS; ++bin) {
+        result += std::abs(static_cast<int>(a.palette[bin]) - static_cast<int>(b.palette[bin]));
+    }
+    return result;
+}
+
+void VisualDescriptor::serialize(uint8_t* bytes) const {
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<uint8_t>(thumbnailHash >> (8 * i));
+        bytes[8 + i] = static_cast<uint8_t>(edgeLayout >> (8 * i));
+    }
+    std::copy(palette, palette + PALETTE_BINS, bytes + 16);
+}
+
+VisualDescriptor VisualDescriptor::deserialize(const uint8_t* bytes) {
+    VisualDescriptor descriptor;
+    for (int i = 0; i < 8; ++i) {
+        descriptor.thumbnailHash |= uint64_t(bytes[i]) << (8 * i);
+        descriptor.edgeLayout |= uint64_t(bytes[8 + i]) << (8 * i);
+    }
+    std::copy(bytes + 16, bytes + SERIALIZED_BYTES, descriptor.palette);
+    return descriptor;
+}
+
+std::string VisualDescriptor::toHex() const {
+    static const char digits[] = "0123456789abcdef";
+    uint8_t bytes[SERIALIZED_BYTES];
+    serialize(bytes);
+    std::string hex;
+    hex.reserve(2 * SERIALIZED_BYTES);
+    for (uint8_t byte : bytes) {
+        hex += digits[byte >> 4];
+        hex += digits[byte & 15];
+    }
+    return hex;
+}
+
+// VisualDescriptorIndex Implementation
+void VisualDescriptorIndex::add(const VisualDescriptor& descriptor, size_t id) {
+    uint32_t newNode = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{descriptor, id, {}});
+    if (newNode == 0) return;
+
+    uint32_t current = 0;
+    while (true) {
+        int d = VisualDescriptor::distance(descriptor, nodes[current].descriptor);
+        auto& children = nodes[current].children;
+        auto it = std::find_if(children.begin(), children.end(),
+                               [d](const std::pair<int, uint32_t>& child) { return child.first == d; });
+        if (it == children.end()) {
+            children.emplace_back(d, newNode);
+            return;
+        }
+        current = it->second;
+    }
+}
+
+void VisualDescriptorIndex::clear() {
+    nodes.clear();
+}
+
+VisualDescriptorIndex::Match VisualDescriptorIndex::nearest(const VisualDescriptor& query, int maxDistance) const {
+    Match best;
+    if (nodes.empty()) return best;
+
+    int bound = maxDistance;
+    std::vector<uint32_t> pending;
+    pending.push_back(0);
+
+    while (!pending.empty()) {
+        uint32_t current = pending.back();
+        pending.pop_back();
+
+        const Node& node = nodes[current];
+        int d = VisualDescriptor::distance(query, node.descriptor);
+        if (d <= bound && (!best.found() || d < best.distance)) {
+            best = Match(node.id, d);
+            bound = d;
+            if (d == 0) break;
+        }
+
+        // A child at distance k from this node can only be within bound of the query if |k - d| <= bound
+        for (const auto& child : node.children) {
+            if (std::abs(child.first - d) <= bound) {
+                pending.push_back(child.second);
+            }
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compact per-frame image signature (80 bytes) for identifying a game from pixels.
+// All three parts are taken from one 64x64 area-downscale of the frame:
+//   thumbnailHash - difference hash of a 9x8 grey thumbnail (overall composition)
+//   edgeLayout    - 8x8 grid, bit set where edge energy is above the median (HUD layout)
+//   palette       - 4x4x4 RGB histogram, each bin quantised so the bins sum to ~64
+// Distance is Hamming + Hamming + L1, an integer metric, so it can drive a BK-tree.
+struct VisualDescriptor {
+    static constexpr int PALETTE_BINS = 64;
+    static constexpr int PALETTE_SCALE = 64;
+    static constexpr int MAX_DISTANCE = 64 + 64 + 2 * PALETTE_SCALE;
+    static constexpr size_t SERIALIZED_BYTES = 16 + PALETTE_BINS;
+
+    uint64_t thumbnailHash;
+    uint64_t edgeLayout;
+    uint8_t palette[PALETTE_BINS];
+
+    VisualDescriptor() : thumbnailHash(0), edgeLayout(0), palette{} {}
+
+    static VisualDescriptor compute(const cv::Mat& image);
+
+    // Dominant colours (BGR bin centres), most frequent first
+    std::vector<cv::Scalar> dominantColors(size_t maxColors = 8) const;
+
+    static int distance(const VisualDescriptor& a, const VisualDescriptor& b);
+
+    // Stored form: both hashes little-endian, then the palette. toHex is the "@visual"
+    // profile line payload (see ProfileDatabase)
+    void serialize(uint8_t* bytes) const;
+    static VisualDescriptor deserialize(const uint8_t* bytes);
+    std::string toHex() const;
+};
+
+// Nearest-neighbour index over descriptors (BK-tree).
+// The triangle inequality lets each query skip whole subtrees whose distance band
+// cannot beat the best match so far, so lookups touch a fraction of the entries.
+class VisualDescriptorIndex {
+public:
+    struct Match {
+        size_t id;
+        int distance;       // -1 when nothing was within range
+
+        Match() : id(0), distance(-1) {}
+        Match(size_t i, int d) : id(i), distance(d) {}
+        bool found() const { return distance >= 0; }
+    };
+
+    void add(const VisualDescriptor& descriptor, size_t id);
+    void clear();
+
+    // Closest entry within maxDistance
+    Match nearest(const VisualDescriptor& query, int maxDistance = VisualDescriptor::MAX_DISTANCE) const;
+
+    size_t size() const { return nodes.size(); }
+
+private:
+    struct Node {
+        VisualDescriptor descriptor;
+        size_t id;
+        std::vector<std::pair<int, uint32_t>> children;    // (distance to this node, child node)
+    };
+
+    std::vector<Node> nodes;
+};